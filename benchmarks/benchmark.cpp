@@ -0,0 +1,128 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "benchmarks/benchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fmt/core.h>
+#include <fmt/ostream.h>
+#include <fstream>
+#include <numeric>
+
+namespace giada::bench
+{
+Runner::Runner(int iterations, int warmup, const std::string& filter)
+: m_iterations(iterations)
+, m_warmup(warmup)
+, m_filter(filter)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Runner::run(const std::string& name, const std::string& params, const std::function<void()>& f,
+    int iterations)
+{
+	if (!m_filter.empty() && name.find(m_filter) == std::string::npos)
+		return;
+
+	if (iterations <= 0)
+		iterations = m_iterations;
+
+	for (int i = 0; i < std::min(m_warmup, iterations); i++)
+		f();
+
+	std::vector<double> samples(iterations);
+	for (double& sample : samples)
+	{
+		const auto t0 = std::chrono::steady_clock::now();
+		f();
+		const auto t1 = std::chrono::steady_clock::now();
+		sample        = std::chrono::duration<double, std::micro>(t1 - t0).count();
+	}
+
+	const Result& result = m_results.emplace_back(Result{name, params, iterations, computeStats(samples)});
+	print(result);
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Runner::writeCsv(const std::string& path) const
+{
+	std::ofstream out(path);
+	if (!out.is_open())
+		return false;
+
+	fmt::print(out, "name,params,iterations,min_us,median_us,mean_us,p95_us,max_us,stddev_us\n");
+	for (const Result& r : m_results)
+		fmt::print(out, "{},\"{}\",{},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f}\n", r.name, r.params,
+		    r.iterations, r.stats.min, r.stats.median, r.stats.mean, r.stats.p95, r.stats.max, r.stats.stddev);
+
+	return out.good();
+}
+
+/* -------------------------------------------------------------------------- */
+
+const std::vector<Result>& Runner::getResults() const
+{
+	return m_results;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Stats Runner::computeStats(std::vector<double>& samples) const
+{
+	if (samples.empty())
+		return {};
+
+	std::sort(samples.begin(), samples.end());
+
+	const std::size_t n    = samples.size();
+	const double      mean = std::accumulate(samples.begin(), samples.end(), 0.0) / n;
+
+	double variance = 0.0;
+	for (double s : samples)
+		variance += (s - mean) * (s - mean);
+	variance /= n;
+
+	return {
+	    samples.front(),
+	    samples[n / 2],
+	    mean,
+	    samples[std::min(n - 1, static_cast<std::size_t>(n * 0.95))],
+	    samples.back(),
+	    std::sqrt(variance)};
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Runner::print(const Result& r) const
+{
+	fmt::print("{:<28} {:<48} median={:>10.2f}us mean={:>10.2f}us p95={:>10.2f}us stddev={:>8.2f}us\n",
+	    r.name, r.params, r.stats.median, r.stats.mean, r.stats.p95, r.stats.stddev);
+}
+} // namespace giada::bench
@@ -0,0 +1,92 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_BENCH_BENCHMARK_H
+#define G_BENCH_BENCHMARK_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace giada::bench
+{
+/* Stats
+Statistics of a benchmark run, in microseconds per iteration. */
+
+struct Stats
+{
+	double min    = 0.0;
+	double median = 0.0;
+	double mean   = 0.0;
+	double p95    = 0.0;
+	double max    = 0.0;
+	double stddev = 0.0;
+};
+
+struct Result
+{
+	std::string name;
+	std::string params;
+	int         iterations;
+	Stats       stats;
+};
+
+/* Runner
+Times a function over a number of iterations, after a warm-up phase, and
+collects the results for printing or CSV export. */
+
+class Runner
+{
+public:
+	Runner(int iterations, int warmup, const std::string& filter);
+
+	/* run
+	Times 'f' if 'name' matches the filter. 'params' is a free-form description
+	of the scenario (e.g. "channels=32 bufferSize=256"). Pass 'iterations' > 0
+	to override the default number of iterations for slow functions. */
+
+	void run(const std::string& name, const std::string& params, const std::function<void()>& f,
+	    int iterations = 0);
+
+	/* writeCsv
+	Writes all collected results to file. Returns false on failure. */
+
+	bool writeCsv(const std::string& path) const;
+
+	const std::vector<Result>& getResults() const;
+
+private:
+	Stats computeStats(std::vector<double>& samples) const;
+	void  print(const Result&) const;
+
+	int                 m_iterations;
+	int                 m_warmup;
+	std::string         m_filter;
+	std::vector<Result> m_results;
+};
+} // namespace giada::bench
+
+#endif
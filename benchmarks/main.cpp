@@ -0,0 +1,201 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "benchmarks/benchmark.h"
+#include "benchmarks/session.h"
+#include "core/const.h"
+#include "utils/log.h"
+#include <cstdlib>
+#include <filesystem>
+#include <fmt/core.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* g_engine, g_ui
+Referenced by the glue layer, which is linked in along with the rest of the
+core. Never used by the benchmarks. */
+
+namespace giada::m
+{
+class Engine;
+}
+namespace giada::v
+{
+class Ui;
+}
+
+giada::m::Engine* g_engine = nullptr;
+giada::v::Ui*     g_ui     = nullptr;
+
+namespace
+{
+struct Args
+{
+	int         iterations = 1000;
+	int         warmup     = 100;
+	std::string filter     = "";
+	std::string csvPath    = "";
+};
+
+/* -------------------------------------------------------------------------- */
+
+void printUsage_()
+{
+	fmt::print("Usage: giada-bench [--iterations N] [--warmup N] [--filter NAME] [--csv PATH]\n");
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool parseArgs_(int argc, char** argv, Args& args)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string arg  = argv[i];
+		const bool        last = i == argc - 1;
+
+		if (arg == "--iterations" && !last)
+			args.iterations = std::max(1, std::atoi(argv[++i]));
+		else if (arg == "--warmup" && !last)
+			args.warmup = std::max(0, std::atoi(argv[++i]));
+		else if (arg == "--filter" && !last)
+			args.filter = argv[++i];
+		else if (arg == "--csv" && !last)
+			args.csvPath = argv[++i];
+		else
+			return false;
+	}
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* makeScenarios_
+Returns the synthetic sessions to benchmark: a few channel layouts, each one
+rendered with small, medium and large buffer sizes. */
+
+std::vector<giada::bench::Session::Config> makeScenarios_()
+{
+	const std::vector<giada::bench::Session::Config> layouts = {
+	    // samples, pitched, midi, tracks, actions
+	    {8, 0, 0, 1, 0},
+	    {0, 8, 0, 1, 0},
+	    {0, 0, 16, 4, 256},
+	    {32, 8, 16, 8, 128},
+	};
+
+	std::vector<giada::bench::Session::Config> out;
+	for (int bufferSize : {64, 256, 1024})
+	{
+		for (giada::bench::Session::Config c : layouts)
+		{
+			c.bufferSize = bufferSize;
+			out.push_back(c);
+		}
+	}
+	return out;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* runRealtime_
+Benchmarks the realtime code paths. Must run on a thread registered as
+realtime in the Model, as the audio thread does. */
+
+void runRealtime_(giada::bench::Session& session, giada::bench::Runner& runner)
+{
+	session.registerThread(giada::Thread::AUDIO, /*isRealtime=*/true);
+
+	const std::string params = session.getConfig().toString();
+
+	runner.run("Renderer::render", params, [&session]()
+	    { session.render(); });
+	runner.run("Sequencer::advance", params, [&session]()
+	    { session.advanceSequencer(); });
+	runner.run("Mixer::render", params, [&session]()
+	    { session.renderMixer(); });
+}
+
+/* -------------------------------------------------------------------------- */
+
+void runNonRealtime_(giada::bench::Session& session, giada::bench::Runner& runner, int iterations)
+{
+	const std::string params    = session.getConfig().toString();
+	const std::string patchPath = (std::filesystem::temp_directory_path() / "giada-bench.gptc").string();
+
+	runner.run("Model::swap", params, [&session]()
+	    { session.swap(); });
+
+	/* Patch round trips hit the disk: keep the number of iterations lower. */
+
+	runner.run("patchFactory round trip", params, [&session, &patchPath]()
+	    { session.storeAndLoadPatch(patchPath); },
+	    std::max(1, iterations / 10));
+
+	std::filesystem::remove(patchPath);
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+int main(int argc, char** argv)
+{
+	using namespace giada;
+
+	Args args;
+	if (!parseArgs_(argc, argv, args))
+	{
+		printUsage_();
+		return EXIT_FAILURE;
+	}
+
+	u::log::init(LOG_MODE_MUTE);
+
+	bench::Runner runner(args.iterations, args.warmup, args.filter);
+
+	for (const bench::Session::Config& config : makeScenarios_())
+	{
+		bench::Session session(config);
+
+		std::thread audioThread([&session, &runner]()
+		    { runRealtime_(session, runner); });
+		audioThread.join();
+
+		runNonRealtime_(session, runner, args.iterations);
+	}
+
+	u::log::close();
+
+	if (!args.csvPath.empty() && !runner.writeCsv(args.csvPath))
+	{
+		fmt::print(stderr, "Unable to write CSV file {}\n", args.csvPath);
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,285 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "benchmarks/session.h"
+#include "core/channels/channel.h"
+#include "core/channels/channelShared.h"
+#include "core/conf.h"
+#include "core/const.h"
+#include "core/model/transaction.h"
+#include "core/patch.h"
+#include "core/patchFactory.h"
+#include "core/wave.h"
+#include "core/waveFactory.h"
+#include <cmath>
+#include <fmt/core.h>
+
+namespace giada::bench
+{
+namespace
+{
+/* WAVE_SECONDS
+Length of each synthetic sample. Long enough to never hit the end of the Wave
+during a single block, so that looping logic is exercised only occasionally as
+it would be in a real session. */
+
+constexpr int WAVE_SECONDS = 4;
+
+/* PITCH
+Pitch applied to 'pitchedChannels', so that the resampler is involved. */
+
+constexpr float PITCH = 1.5f;
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+std::string Session::Config::toString() const
+{
+	return fmt::format("samples={} pitched={} midi={} tracks={} actions={} bufferSize={} sampleRate={}",
+	    sampleChannels, pitchedChannels, midiChannels, tracks, actionsPerChannel, bufferSize, sampleRate);
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Session::Session(const Config& c)
+: m_config(c)
+, m_profiler()
+, m_kernelMidi(m_model)
+, m_midiMapper(m_kernelMidi)
+, m_midiSynchronizer(m_kernelMidi)
+, m_sequencer(m_model, m_midiSynchronizer, m_jackTransport)
+, m_mixer(m_model)
+, m_actionRecorder(m_model)
+, m_channelManager(m_model, m_midiMapper, m_actionRecorder, m_kernelMidi)
+, m_pluginHost(m_model, m_profiler)
+, m_triggerQueue(/*size=*/64, /*max_explicit_producers=*/0, /*max_implicit_producers=*/8)
+, m_aheadPluginHost(m_model, m_profiler)
+#ifdef WITH_AUDIO_JACK
+, m_renderer(m_sequencer, m_mixer, m_pluginHost, m_jackSynchronizer, m_jackTransport, m_kernelMidi, m_triggerQueue, m_renderAheadQueue, m_aheadPluginHost, m_profiler)
+#else
+, m_renderer(m_sequencer, m_mixer, m_pluginHost, m_kernelMidi, m_triggerQueue, m_renderAheadQueue, m_aheadPluginHost, m_profiler)
+#endif
+, m_recBufferWorker(G_REC_BUFFER_REFILL_RATE_MS)
+{
+	registerThread(Thread::MAIN, /*isRealtime=*/false);
+
+	/* No-op callbacks: there are no UI nor devices to notify. Some components
+	assert on them, though. */
+
+	m_sequencer.onAboutStart           = [](SeqStatus) {};
+	m_sequencer.onAboutStop            = []() {};
+	m_channelManager.onChannelsAltered = []() {};
+	m_mixer.onSignalTresholdReached    = []() {};
+	m_mixer.onEndOfRecording           = []() {};
+
+	m::Conf conf;
+	conf.samplerate = c.sampleRate;
+	conf.buffersize = c.bufferSize;
+
+	m_model.init();
+	m_model.load(conf);
+
+	m_mixer.reset(c.bufferSize);
+	m_channelManager.reset(c.bufferSize);
+	m_sequencer.reset(c.sampleRate);
+	m_pluginHost.reset(c.bufferSize);
+
+	/* No render-ahead worker: every track is rendered by the calling thread, as
+	the audio thread would do with render-ahead disabled. */
+
+	m_renderAheadQueue.reset(c.bufferSize, m::rendering::RenderAheadQueue::computeDepth(c.bufferSize, c.sampleRate));
+	m_aheadPluginHost.setBufferSize(c.bufferSize);
+
+	m_out.alloc(c.bufferSize, G_MAX_IO_CHANS);
+	m_in.alloc(c.bufferSize, G_MAX_IO_CHANS);
+
+	/* Some quiet input signal, so that the Mixer input stage has something to
+	chew on. */
+
+	for (int i = 0; i < m_in.countFrames(); i++)
+		for (int j = 0; j < m_in.countChannels(); j++)
+			m_in[i][j] = 0.01f;
+
+	build_();
+
+	/* Input recording memory: the first chunks right away, then in the
+	background while the take grows. */
+
+	m_mixer.refillRecBuffer();
+	m_recBufferWorker.start([this]()
+	{
+		m_mixer.refillRecBuffer();
+	});
+
+	m_mixer.enable();
+	m_sequencer.start();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Session::build_()
+{
+	const Config&               c           = m_config;
+	const m::model::Transaction transaction = m_model.beginTransaction();
+
+	/* Bring the number of visible tracks to the requested amount. Track 0 is
+	the internal one (master channels, preview). */
+
+	const std::size_t numTracks = std::max(1, c.tracks);
+	while (m_model.get().tracks.getAll().size() - 1 < numTracks)
+		m_channelManager.addTrack(c.bufferSize);
+	while (m_model.get().tracks.getAll().size() - 1 > numTracks)
+		m_channelManager.removeTrack(m_model.get().tracks.getAll().size() - 1);
+
+	/* Sample channels, looping forever. The ones past 'sampleChannels' are
+	pitched. */
+
+	const int numSampleChannels = c.sampleChannels + c.pitchedChannels;
+	for (int i = 0; i < numSampleChannels; i++)
+	{
+		/* Grab the ID right away: the returned reference is invalidated by any
+		later model change. */
+
+		const std::size_t trackIndex = 1 + (i % numTracks);
+		const ID          channelId  = m_channelManager.addChannel(ChannelType::SAMPLE, trackIndex, c.bufferSize).id;
+
+		std::unique_ptr<m::Wave> wave = m::waveFactory::createEmpty(c.sampleRate * WAVE_SECONDS, G_MAX_IO_CHANS,
+		    c.sampleRate, fmt::format("bench-{}", i));
+		fillWave_(*wave, i);
+
+		m_channelManager.loadSampleChannel(channelId, m_model.addWave(std::move(wave)));
+		m_channelManager.setSamplePlayerMode(channelId, SamplePlayerMode::LOOP_BASIC);
+		m_channelManager.setPitch(channelId, i < c.sampleChannels ? 1.0f : PITCH);
+		m_channelManager.getChannel(channelId).shared->playStatus.store(ChannelStatus::PLAY);
+	}
+
+	/* MIDI channels, each one with 'actionsPerChannel' notes evenly spread
+	across the loop. */
+
+	const Frame framesInLoop = m_sequencer.getFramesInLoop();
+	for (int i = 0; i < c.midiChannels; i++)
+	{
+		const std::size_t trackIndex = 1 + ((numSampleChannels + i) % numTracks);
+		const ID          channelId  = m_channelManager.addChannel(ChannelType::MIDI, trackIndex, c.bufferSize).id;
+
+		if (c.actionsPerChannel > 0)
+		{
+			const Frame step = std::max<Frame>(2, framesInLoop / c.actionsPerChannel);
+			for (int a = 0; a < c.actionsPerChannel; a++)
+			{
+				const Frame f1 = (a * step) % framesInLoop;
+				const Frame f2 = std::min(f1 + step / 2, framesInLoop - 1);
+				m_actionRecorder.recordMidiAction(channelId, 36 + (a % 48), 0.8f, f1, f2, framesInLoop);
+			}
+		}
+
+		m::ChannelShared& shared = *m_channelManager.getChannel(channelId).shared;
+		shared.readActions.store(true);
+		shared.playStatus.store(ChannelStatus::PLAY);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Session::render()
+{
+	m_out.clear();
+	m_renderer.render(m_out, m_in, m_model);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Session::advanceSequencer()
+{
+	const m::model::DocumentLock documentLock = m_model.get_RT();
+	const m::model::Document&    document_RT  = documentLock.get();
+
+	m_sequencer.advance(document_RT.sequencer, m_config.bufferSize, m_config.sampleRate, document_RT.actions);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Session::renderMixer()
+{
+	const m::model::DocumentLock documentLock = m_model.get_RT();
+	const m::model::Document&    document_RT  = documentLock.get();
+
+	m_mixer.render(m_in, document_RT, m_sequencer.getFramesInLoop());
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Session::swap()
+{
+	m_model.swap(m::model::SwapType::HARD);
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Session::storeAndLoadPatch(const std::string& path)
+{
+	m::Patch patch;
+	m_model.get().store(patch);
+
+	if (!m::patchFactory::serialize(patch, path))
+		return false;
+
+	const m::Patch loaded = m::patchFactory::deserialize(path);
+	return loaded.status == G_FILE_OK;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Session::registerThread(Thread t, bool isRealtime) const
+{
+	m_model.registerThread(t, isRealtime);
+}
+
+/* -------------------------------------------------------------------------- */
+
+const Session::Config& Session::getConfig() const
+{
+	return m_config;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Session::fillWave_(m::Wave& w, int seed) const
+{
+	/* A plain sine per channel, at a different frequency for each Wave. */
+
+	mcl::AudioBuffer& buffer = w.getBuffer();
+	const float       freq   = 110.0f * (1 + seed % 8);
+
+	for (int i = 0; i < buffer.countFrames(); i++)
+		for (int j = 0; j < buffer.countChannels(); j++)
+			buffer[i][j] = 0.1f * std::sin(2.0f * 3.14159265f * freq * i / m_config.sampleRate);
+}
+} // namespace giada::bench
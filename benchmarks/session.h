@@ -0,0 +1,146 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_BENCH_SESSION_H
+#define G_BENCH_SESSION_H
+
+#include "core/actions/actionRecorder.h"
+#include "core/channels/channelManager.h"
+#include "core/jackTransport.h"
+#include "core/kernelMidi.h"
+#include "core/midiMapper.h"
+#include "core/midiSynchronizer.h"
+#include "core/mixer.h"
+#include "core/model/model.h"
+#include "core/plugins/pluginHost.h"
+#include "core/profiler.h"
+#include "core/rendering/renderAheadQueue.h"
+#include "core/rendering/renderer.h"
+#include "core/rendering/trigger.h"
+#include "core/sequencer.h"
+#include "core/worker.h"
+#ifdef WITH_AUDIO_JACK
+#include "core/jackSynchronizer.h"
+#endif
+#include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <string>
+
+namespace giada::bench
+{
+/* Session
+A synthetic, in-memory Giada session built without audio or MIDI devices. It
+owns the same engine sub-components the real Engine owns, wired together the
+same way, so that the real-time code paths can be timed in isolation. */
+
+class Session
+{
+public:
+	struct Config
+	{
+		int sampleChannels    = 8; // Sample channels with pitch == 1.0
+		int pitchedChannels   = 0; // Sample channels with pitch != 1.0 (resampled)
+		int midiChannels      = 0;
+		int tracks            = 1;
+		int actionsPerChannel = 0; // MIDI notes recorded in each MIDI channel
+		int bufferSize        = 256;
+		int sampleRate        = 44100;
+
+		std::string toString() const;
+	};
+
+	Session(const Config&);
+
+	/* render
+	Renders one block through the whole Renderer pipeline, as the audio callback
+	would do. Call it from a thread registered as realtime. */
+
+	void render();
+
+	/* advanceSequencer
+	Parses one block of sequencer events and actions. */
+
+	void advanceSequencer();
+
+	/* renderMixer
+	Runs the Mixer input stage on one block. */
+
+	void renderMixer();
+
+	/* swap
+	Swaps the Document, as any non-realtime edit does. */
+
+	void swap();
+
+	/* storeAndLoadPatch
+	Stores the Document into a Patch, serializes it to 'path' and reads it back.
+	Returns false on failure. */
+
+	bool storeAndLoadPatch(const std::string& path);
+
+	void registerThread(Thread, bool isRealtime) const;
+
+	const Config& getConfig() const;
+
+private:
+	/* build_
+	Fills the Document with tracks, channels and actions as per Config. */
+
+	void build_();
+
+	void fillWave_(m::Wave&, int seed) const;
+
+	Config m_config;
+
+	m::model::Model              m_model;
+	m::Profiler                  m_profiler;
+	m::KernelMidi                m_kernelMidi;
+	m::MidiMapper<m::KernelMidi> m_midiMapper;
+	m::JackTransport             m_jackTransport;
+	m::MidiSynchronizer          m_midiSynchronizer;
+	m::Sequencer                 m_sequencer;
+	m::Mixer                     m_mixer;
+	m::ActionRecorder            m_actionRecorder;
+	m::ChannelManager            m_channelManager;
+	m::PluginHost                m_pluginHost;
+#ifdef WITH_AUDIO_JACK
+	m::JackSynchronizer m_jackSynchronizer;
+#endif
+	m::rendering::TriggerQueue     m_triggerQueue;
+	m::rendering::RenderAheadQueue m_renderAheadQueue;
+	m::PluginHost                  m_aheadPluginHost;
+	m::rendering::Renderer         m_renderer;
+
+	mcl::AudioBuffer m_out;
+	mcl::AudioBuffer m_in;
+
+	/* m_recBufferWorker
+	Keeps the input recording buffer filled with empty chunks, as Engine does. */
+
+	Worker m_recBufferWorker;
+};
+} // namespace giada::bench
+
+#endif
@@ -36,13 +36,19 @@ struct Action
 {
 	ID        id = 0; // Invalid
 	ID        channelId;
-	Frame     frame;
+	Tick      tick; // Position in the loop, in musical ticks (see G_PPQ)
 	MidiEvent event;
 	ID        pluginId    = -1;
 	int       pluginParam = -1;
 	ID        prevId      = 0;
 	ID        nextId      = 0;
 
+	/* frame
+	Position in the loop at the current tempo. Not stored in the model: it is
+	computed by ActionRecorder when actions are handed over to the UI. */
+
+	Frame frame = 0;
+
 	bool isValid() const
 	{
 		return id != 0;
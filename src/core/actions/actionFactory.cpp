@@ -25,7 +25,10 @@
  * -------------------------------------------------------------------------- */
 
 #include "core/actions/actionFactory.h"
+#include "core/const.h"
 #include "core/midiEvent.h"
+#include "utils/time.h"
+#include <algorithm>
 #include <cassert>
 
 namespace giada::m::actionFactory
@@ -46,18 +49,29 @@ void reset()
 
 /* -------------------------------------------------------------------------- */
 
-Action makeAction(ID id, ID channelId, Frame frame, MidiEvent e)
+Action makeAction(ID id, ID channelId, Tick tick, MidiEvent e)
 {
-	Action out{actionId_.generate(id), channelId, frame, e, -1, -1};
+	return makeAction(id, channelId, tick, e, -1, -1);
+}
+
+Action makeAction(ID id, ID channelId, Tick tick, MidiEvent e, ID pluginId, int pluginParam)
+{
+	Action out{actionId_.generate(id), channelId, tick, e, pluginId, pluginParam};
 	actionId_.set(id);
 	return out;
 }
 
-Action makeAction(const Patch::Action& a)
+Action makeAction(const Patch::Action& a, int framesInBeat)
 {
+	/* The raw event holds a 7-bit value only: use the precise one if stored. */
+
+	MidiEvent e = MidiEvent::makeFromRaw(a.event, /*numBytes=*/3);
+	if (a.value.has_value())
+		e.setVelocityFloat(std::clamp(*a.value, 0.0f, G_MAX_VELOCITY_FLOAT));
+
 	actionId_.set(a.id);
-	return Action{a.id, a.channelId, a.frame,
-	    MidiEvent::makeFromRaw(a.event, /*numBytes=*/3), -1, -1, a.prevId, a.nextId};
+	return Action{a.id, a.channelId, u::time::frameToTick(a.frame, framesInBeat),
+	    e, a.pluginId, a.pluginParam, a.prevId, a.nextId};
 }
 
 /* -------------------------------------------------------------------------- */
@@ -69,17 +83,20 @@ ID getNewActionId()
 
 /* -------------------------------------------------------------------------- */
 
-model::Actions::Map deserializeActions(const std::vector<Patch::Action>& pactions)
+model::Actions::Map deserializeActions(const std::vector<Patch::Action>& pactions, int framesInBeat)
 {
 	model::Actions::Map out;
 	for (const Patch::Action& paction : pactions)
-		out[paction.frame].push_back(makeAction(paction));
+	{
+		const Action action = makeAction(paction, framesInBeat);
+		out[action.tick].push_back(action);
+	}
 	return out;
 }
 
 /* -------------------------------------------------------------------------- */
 
-std::vector<Patch::Action> serializeActions(const model::Actions::Map& actions)
+std::vector<Patch::Action> serializeActions(const model::Actions::Map& actions, int framesInBeat)
 {
 	std::vector<Patch::Action> out;
 	for (const auto& kv : actions) // TODO - const auto& [_, actionsInFrame]
@@ -89,10 +106,13 @@ std::vector<Patch::Action> serializeActions(const model::Actions::Map& actions)
 			out.push_back({
 			    a.id,
 			    a.channelId,
-			    a.frame,
+			    u::time::tickToFrame(a.tick, framesInBeat),
 			    a.event.getRaw(),
 			    a.prevId,
 			    a.nextId,
+			    a.pluginId,
+			    a.pluginParam,
+			    a.pluginId != -1 || a.isVolumeEnvelope() ? std::optional(a.event.getVelocityFloat()) : std::nullopt,
 			});
 		}
 	}
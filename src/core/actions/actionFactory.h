@@ -40,10 +40,12 @@ Resets internal ID generator. */
 void reset();
 
 /* makeAction
-Makes a new action given some data. */
+Makes a new action given some data. Plug-in parameter actions carry the
+parameter value in the event's float velocity. */
 
-Action makeAction(ID id, ID channelId, Frame frame, MidiEvent e);
-Action makeAction(const Patch::Action&);
+Action makeAction(ID id, ID channelId, Tick tick, MidiEvent e);
+Action makeAction(ID id, ID channelId, Tick tick, MidiEvent e, ID pluginId, int pluginParam);
+Action makeAction(const Patch::Action&, int framesInBeat);
 
 /* getNewActionId
 Returns a new action ID, internally generated. */
@@ -51,10 +53,11 @@ Returns a new action ID, internally generated. */
 ID getNewActionId();
 
 /* (de)serializeActions
-Creates new Actions given the patch raw data and vice versa. */
+Creates new Actions given the patch raw data and vice versa. Patches store
+actions in frames: 'framesInBeat' is the beat length the frames refer to. */
 
-model::Actions::Map        deserializeActions(const std::vector<Patch::Action>&);
-std::vector<Patch::Action> serializeActions(const model::Actions::Map&);
+model::Actions::Map        deserializeActions(const std::vector<Patch::Action>&, int framesInBeat);
+std::vector<Patch::Action> serializeActions(const model::Actions::Map&, int framesInBeat);
 } // namespace giada::m::actionFactory
 
 #endif
@@ -35,7 +35,6 @@
 #include "utils/ver.h"
 #include <algorithm>
 #include <cassert>
-#include <cmath>
 #include <cstddef>
 #include <unordered_map>
 
@@ -43,10 +42,6 @@ namespace giada::m
 {
 namespace
 {
-constexpr int MAX_LIVE_RECS_CHUNK = 128;
-
-/* -------------------------------------------------------------------------- */
-
 std::tuple<Frame, Frame> sanitizeFrames_(Frame f1, Frame f2, int framesInLoop)
 {
 	if (f2 == 0)
@@ -68,6 +63,15 @@ Frame sanitizeFrame_(Frame f, int framesInLoop)
 {
 	return std::min(f, framesInLoop - 1);
 }
+
+/* -------------------------------------------------------------------------- */
+
+MidiEvent makeEnvelopeEvent_(float value)
+{
+	MidiEvent e = MidiEvent::makeFrom3Bytes(MidiEvent::CHANNEL_CC, 0, 0);
+	e.setVelocityFloat(value);
+	return e;
+}
 } // namespace
 
 /* -------------------------------------------------------------------------- */
@@ -77,7 +81,6 @@ Frame sanitizeFrame_(Frame f, int framesInLoop)
 ActionRecorder::ActionRecorder(model::Model& m)
 : m_model(m)
 {
-	m_liveActions.reserve(MAX_LIVE_RECS_CHUNK);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -92,58 +95,20 @@ void ActionRecorder::reset()
 
 /* -------------------------------------------------------------------------- */
 
-#if 0
 bool ActionRecorder::isBoundaryEnvelopeAction(const Action& a) const
 {
-	assert(a.prev != nullptr);
-	assert(a.next != nullptr);
-	return a.prev->frame > a.frame || a.next->frame < a.frame;
-}
-#endif
-
-/* -------------------------------------------------------------------------- */
-
-void ActionRecorder::updateBpm(float ratio, int quantizerStep)
-{
-	if (ratio == 1.0f)
-		return;
-
-	m_model.get().actions.updateKeyFrames([=](Frame old)
-	{
-		/* The division here cannot be precise. A new frame can be 44099 and the
-		quantizer set to 44100. That would mean two recs completely useless. So we
-		compute a reject value ('delta'): if it's lower than 6 frames the new frame
-		is collapsed with a quantized frame. FIXME - maybe 6 frames are too low. */
-		Frame frame = static_cast<Frame>(old * ratio);
-		if (frame != 0)
-		{
-			Frame delta = quantizerStep % frame;
-			if (delta > 0 && delta <= 6)
-				frame = frame + delta;
-		}
-		return frame;
-	});
-
-	m_model.swap(model::SwapType::NONE);
-}
-
-/* -------------------------------------------------------------------------- */
-
-void ActionRecorder::updateSamplerate(int systemRate, int patchRate)
-{
-	if (systemRate == patchRate)
-		return;
+	const Action prev = findAction(a.prevId);
+	const Action next = findAction(a.nextId);
 
-	float ratio = systemRate / (float)patchRate;
+	assert(prev.isValid());
+	assert(next.isValid());
 
-	m_model.get().actions.updateKeyFrames([=](Frame old)
-	{ return floorf(old * ratio); });
-	m_model.swap(model::SwapType::NONE);
+	return prev.tick > a.tick || next.tick < a.tick;
 }
 
 /* -------------------------------------------------------------------------- */
 
-bool ActionRecorder::cloneActions(ID channelId, ID newChannelId)
+bool ActionRecorder::cloneActions(ID channelId, ID newChannelId, const std::unordered_map<ID, ID>& pluginIds)
 {
 	bool                       cloned = false;
 	std::vector<Action>        actions;
@@ -153,6 +118,8 @@ bool ActionRecorder::cloneActions(ID channelId, ID newChannelId)
 	{
 		if (a.channelId != channelId)
 			return;
+		if (a.pluginId != -1 && !pluginIds.contains(a.pluginId))
+			return;
 
 		ID newActionId = actionFactory::getNewActionId();
 
@@ -161,6 +128,8 @@ bool ActionRecorder::cloneActions(ID channelId, ID newChannelId)
 		Action clone(a);
 		clone.id        = newActionId;
 		clone.channelId = newChannelId;
+		if (clone.pluginId != -1)
+			clone.pluginId = pluginIds.at(a.pluginId);
 
 		actions.push_back(clone);
 		cloned = true;
@@ -177,7 +146,7 @@ bool ActionRecorder::cloneActions(ID channelId, ID newChannelId)
 	}
 
 	m_model.get().actions.rec(actions);
-	m_model.get().tracks.getChannel(newChannelId).hasActions = true;
+	m_model.get().tracks.getChannel(newChannelId).hasActions = cloned;
 	m_model.swap(model::SwapType::HARD);
 
 	return cloned;
@@ -189,30 +158,38 @@ void ActionRecorder::liveRec(ID channelId, MidiEvent e, Frame globalFrame)
 {
 	assert(e.isNoteOnOff()); // Can't record any other kind of events for now
 
-	/* TODO - this might allocate on the MIDI thread */
-	if (m_liveActions.size() >= m_liveActions.capacity())
-		m_liveActions.reserve(m_liveActions.size() + MAX_LIVE_RECS_CHUNK);
+	/* Action IDs are assigned later on by consolidate(), on the main thread.
+	The position is converted to ticks right away instead, with the tempo the
+	action has been played at. */
 
-	m_liveActions.push_back(actionFactory::makeAction(actionFactory::getNewActionId(), channelId, globalFrame, e));
+	m_liveActions.push(channelId, m_model.get().sequencer.frameToTick(globalFrame), e);
 }
 
 /* -------------------------------------------------------------------------- */
 
-#if 0
-void ActionRecorder::recordEnvelopeAction(ID channelId, Frame frame, int value, Frame lastFrameInLoop)
+void ActionRecorder::liveRecPluginParam(ID channelId, ID pluginId, int paramIndex, float value, Frame globalFrame)
 {
-	assert(value >= 0 && value <= G_MAX_VELOCITY);
+	MidiEvent e = MidiEvent::makeFrom3Bytes(MidiEvent::CHANNEL_CC, 0, 0);
+	e.setVelocityFloat(value);
+
+	m_liveActions.push(channelId, m_model.get().sequencer.frameToTick(globalFrame), e, pluginId, paramIndex);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void ActionRecorder::recordEnvelopeAction(ID channelId, Frame frame, float value, Frame lastFrameInLoop)
+{
+	assert(value >= 0.0f && value <= G_MAX_VELOCITY_FLOAT);
 
 	/* First action ever? Add actions at boundaries. Else, find action right
-	before frame 'f' and inject a new action in there. Vertical envelope points 
+	before frame 'f' and inject a new action in there. Vertical envelope points
 	are forbidden for now. */
 
-	if (!hasActions(channelId, MidiEvent::CHANNEL_CC))
+	if (m_model.get().actions.getVolumeEnvelope(channelId) == nullptr)
 		recordFirstEnvelopeAction(channelId, frame, value, lastFrameInLoop);
 	else
 		recordNonFirstEnvelopeAction(channelId, frame, value);
 }
-#endif
 
 /* -------------------------------------------------------------------------- */
 
@@ -279,44 +256,31 @@ void ActionRecorder::deleteSampleAction(ID channelId, const Action& a)
 
 /* -------------------------------------------------------------------------- */
 
-#if 0
 void ActionRecorder::deleteEnvelopeAction(ID channelId, const Action& a)
 {
 	/* Deleting a boundary action wipes out everything. */
-	/* TODO - FIX*/
 
 	if (isBoundaryEnvelopeAction(a))
 	{
-		if (a.isVolumeEnvelope())
-		{
-			// TODO reset all channel's volume vars to 1.0
-		}
-		clearActions(channelId, a.event.getStatus());
-	}
-	else
-	{
-		assert(a.prev != nullptr);
-		assert(a.next != nullptr);
-
-		const Action a1     = *a.prev;
-		const Action a1prev = *a1.prev;
-		const Action a3     = *a.next;
-		const Action a3next = *a3.next;
-
-		/* Original status:   a1--->a--->a3
-		   Modified status:   a1-------->a3 
-		Order is important, here: first update siblings, then delete the action.
-		Otherwise ActionRecorder::deleteAction() would complain of missing 
-		prevId/nextId no longer found. */
-
-		updateSiblings(a1.id, a1prev.id, a3.id);
-		updateSiblings(a3.id, a1.id, a3next.id);
-		deleteAction(channelId, a.id);
+		m_model.get().actions.clearVolumeEnvelope(channelId);
+		m_model.get().tracks.getChannel(channelId).hasActions = hasActions(channelId);
+		m_model.swap(model::SwapType::HARD);
+		return;
 	}
 
-	m_model.swap(model::SwapType::SOFT);
+	const Action a1 = findAction(a.prevId);
+	const Action a3 = findAction(a.nextId);
+
+	/* Original status:   a1--->a--->a3
+	   Modified status:   a1-------->a3
+	Order is important, here: first update siblings, then delete the action.
+	Otherwise ActionRecorder::deleteAction() would complain of missing
+	prevId/nextId no longer found. */
+
+	updateSiblings(a1.id, a1.prevId, a3.id);
+	updateSiblings(a3.id, a1.id, a3.nextId);
+	deleteAction(channelId, a.id);
 }
-#endif
 
 /* -------------------------------------------------------------------------- */
 
@@ -341,23 +305,19 @@ void ActionRecorder::updateSampleAction(ID channelId, const Action& a, int type,
 
 /* -------------------------------------------------------------------------- */
 
-#if 0
-void ActionRecorder::updateEnvelopeAction(ID channelId, const Action& a, Frame f, int value, Frame lastFrameInLoop)
+void ActionRecorder::updateEnvelopeAction(ID channelId, const Action& a, Frame f, float value, Frame lastFrameInLoop)
 {
 	/* Update the action directly if it is a boundary one. Else, delete the
 	previous one and record a new action. */
 
 	if (isBoundaryEnvelopeAction(a))
-		updateEvent(a.id, MidiEvent::makeFrom3Bytes(MidiEvent::CHANNEL_CC, 0, value));
+		updateEvent(a.id, makeEnvelopeEvent_(value));
 	else
 	{
 		deleteEnvelopeAction(channelId, a);
 		recordEnvelopeAction(channelId, f, value, lastFrameInLoop);
 	}
-
-	m_model.swap(model::SwapType::SOFT);
 }
-#endif
 
 /* -------------------------------------------------------------------------- */
 
@@ -372,17 +332,27 @@ void ActionRecorder::updateVelocity(const Action& a, float value)
 
 std::unordered_set<ID> ActionRecorder::consolidate()
 {
-	for (auto it = m_liveActions.begin(); it != m_liveActions.end(); ++it)
-		consolidate(*it, it - m_liveActions.begin()); // Pass current index
+	const std::size_t                         dropped = m_liveActions.getDropped();
+	const std::vector<LiveActionBuffer::Entry> entries = m_liveActions.drain();
 
-	m_model.get().actions.rec(m_liveActions);
-	m_model.swap(model::SwapType::SOFT);
+	if (dropped > 0)
+		u::log::print("[ActionRecorder::consolidate] {} live actions dropped, buffer full or no lane left\n", dropped);
+
+	std::vector<Action> actions;
+	actions.reserve(entries.size());
+	for (const LiveActionBuffer::Entry& entry : entries)
+		actions.push_back(actionFactory::makeAction(0, entry.channelId, entry.tick, entry.event,
+		    entry.pluginId, entry.pluginParam));
+
+	linkComposites(actions);
 
 	std::unordered_set<ID> out;
-	for (const Action& action : m_liveActions)
+	for (const Action& action : actions)
 		out.insert(action.channelId);
 
-	m_liveActions.clear();
+	m_model.get().actions.rec(actions);
+	m_model.swap(model::SwapType::SOFT);
+
 	return out;
 }
 
@@ -428,36 +398,50 @@ bool ActionRecorder::isSinglePressMode(ID channelId) const
 
 /* -------------------------------------------------------------------------- */
 
-void ActionRecorder::consolidate(const Action& a1, std::size_t i)
+void ActionRecorder::linkComposites(std::vector<Action>& actions) const
 {
-	/* This algorithm must start searching from the element next to 'a1': since
-	live actions are recorded in linear sequence, the potential partner of 'a1'
-	always lies beyond a1 itself. Without this trick (i.e. if it loops from
-	vector.begin() each time) the algorithm would end up matching wrong partners. */
+	/* Live actions are in recording order, so the partner of a NOTE_ON always
+	lies beyond the NOTE_ON itself. Keep the NOTE_ONs still waiting for their
+	NOTE_OFF in a map keyed by channel and note: each NOTE_OFF closes all of
+	them in one go. */
 
-	for (auto it = m_liveActions.begin() + i; it != m_liveActions.end(); ++it)
-	{
+	std::unordered_map<uint64_t, std::vector<std::size_t>> pending;
 
-		const Action& a2 = *it;
+	for (std::size_t i = 0; i < actions.size(); i++)
+	{
+		Action&        a   = actions[i];
+		const uint64_t key = (static_cast<uint64_t>(a.channelId) << 8) | static_cast<uint64_t>(a.event.getNote());
 
-		if (!areComposite(a1, a2))
+		if (a.event.getStatus() == MidiEvent::CHANNEL_NOTE_ON)
+		{
+			pending[key].push_back(i);
 			continue;
+		}
 
-		const_cast<Action&>(a1).nextId = a2.id;
-		const_cast<Action&>(a2).prevId = a1.id;
+		auto it = pending.find(key);
+		if (it == pending.end() || it->second.empty())
+			continue;
 
-		break;
+		for (std::size_t j : it->second)
+		{
+			assert(areComposite(actions[j], a));
+			actions[j].nextId = a.id;
+			a.prevId          = actions[j].id;
+		}
+		it->second.clear();
 	}
 }
 
 /* -------------------------------------------------------------------------- */
 
-#if 0
-void ActionRecorder::recordFirstEnvelopeAction(ID channelId, Frame frame, int value, Frame lastFrameInLoop)
+void ActionRecorder::recordFirstEnvelopeAction(ID channelId, Frame frame, float value, Frame lastFrameInLoop)
 {
-	// TODO - use MidiEvent's float velocity
-	const MidiEvent e1 = MidiEvent::makeFrom3Bytes(MidiEvent::CHANNEL_CC, 0, G_MAX_VELOCITY);
-	const MidiEvent e2 = MidiEvent::makeFrom3Bytes(MidiEvent::CHANNEL_CC, 0, value);
+	const MidiEvent e1 = makeEnvelopeEvent_(G_MAX_VELOCITY_FLOAT);
+	const MidiEvent e2 = makeEnvelopeEvent_(value);
+
+	/* Keep the new point away from the boundaries. */
+
+	frame = std::clamp(frame, 1, lastFrameInLoop - 1);
 
 	const Action a1 = rec(channelId, 0, e1);
 	const Action a2 = rec(channelId, frame, e2);
@@ -467,15 +451,14 @@ void ActionRecorder::recordFirstEnvelopeAction(ID channelId, Frame frame, int va
 	updateSiblings(a2.id, /*prev=*/a1.id, /*next=*/a3.id);
 	updateSiblings(a3.id, /*prev=*/a2.id, /*next=*/a1.id); // Circular loop (end)
 }
-#endif
 
 /* -------------------------------------------------------------------------- */
 
-#if 0
-void ActionRecorder::recordNonFirstEnvelopeAction(ID channelId, Frame frame, int value)
+void ActionRecorder::recordNonFirstEnvelopeAction(ID channelId, Frame frame, float value)
 {
-	const Action a1 = m_model.get().actions.getClosestAction(channelId, frame, MidiEvent::CHANNEL_CC);
-	const Action a3 = a1.next != nullptr ? *a1.next : Action{};
+	const Tick   tick = m_model.get().sequencer.frameToTick(frame);
+	const Action a1   = fillFrame(m_model.get().actions.getClosestAction(channelId, tick, MidiEvent::CHANNEL_CC));
+	const Action a3   = findAction(a1.nextId);
 
 	assert(a1.isValid());
 	assert(a3.isValid());
@@ -484,19 +467,25 @@ void ActionRecorder::recordNonFirstEnvelopeAction(ID channelId, Frame frame, int
 	if (frame == -1) // Vertical points, nothing to do here
 		return;
 
-	// TODO - use MidiEvent's float velocity
-	MidiEvent    e2 = MidiEvent::makeFrom3Bytes(MidiEvent::CHANNEL_CC, 0, value);
-	const Action a2 = rec(channelId, frame, e2);
+	const Action a2 = rec(channelId, frame, makeEnvelopeEvent_(value));
 
 	updateSiblings(a2.id, a1.id, a3.id);
 }
-#endif
 
 /* -------------------------------------------------------------------------- */
 
-const Action* ActionRecorder::findAction(ID id) const
+Action ActionRecorder::fillFrame(Action a) const
 {
-	return m_model.get().actions.findAction(id);
+	a.frame = m_model.get().sequencer.tickToFrame(a.tick);
+	return a;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Action ActionRecorder::findAction(ID id) const
+{
+	const Action* a = m_model.get().actions.findAction(id);
+	return a != nullptr ? fillFrame(*a) : Action{};
 }
 
 bool ActionRecorder::hasActions(ID channelId, int type) const
@@ -506,7 +495,10 @@ bool ActionRecorder::hasActions(ID channelId, int type) const
 
 std::vector<Action> ActionRecorder::getActionsOnChannel(ID channelId) const
 {
-	return m_model.get().actions.getActionsOnChannel(channelId);
+	std::vector<Action> out = m_model.get().actions.getActionsOnChannel(channelId);
+	for (Action& a : out)
+		a = fillFrame(a);
+	return out;
 }
 
 void ActionRecorder::clearChannel(ID channelId)
@@ -523,19 +515,30 @@ void ActionRecorder::clearActions(ID channelId, int type)
 	m_model.swap(model::SwapType::HARD);
 }
 
+void ActionRecorder::clearPluginActions(ID channelId, ID pluginId)
+{
+	m_model.get().actions.clearPluginActions(channelId, pluginId);
+	m_model.get().tracks.getChannel(channelId).hasActions = hasActions(channelId);
+	m_model.swap(model::SwapType::HARD);
+}
+
 Action ActionRecorder::rec(ID channelId, Frame frame, MidiEvent e)
 {
-	Action action = m_model.get().actions.rec(channelId, frame, e);
+	const Tick tick   = m_model.get().sequencer.frameToTick(frame);
+	Action     action = m_model.get().actions.rec(channelId, tick, e);
 
 	m_model.get().tracks.getChannel(channelId).hasActions = true;
 	m_model.swap(model::SwapType::HARD);
-	return action;
+	return fillFrame(action);
 }
 
 void ActionRecorder::rec(ID channelId, Frame f1, Frame f2, MidiEvent e1, MidiEvent e2)
 {
+	const Tick t1 = m_model.get().sequencer.frameToTick(f1);
+	const Tick t2 = m_model.get().sequencer.frameToTick(f2);
+
 	m_model.get().tracks.getChannel(channelId).hasActions = true;
-	m_model.get().actions.rec(channelId, f1, f2, e1, e2);
+	m_model.get().actions.rec(channelId, t1, t2, e1, e2);
 	m_model.swap(model::SwapType::HARD);
 }
 
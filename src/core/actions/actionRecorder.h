@@ -27,10 +27,12 @@
 #ifndef G_ACTION_RECORDER_H
 #define G_ACTION_RECORDER_H
 
+#include "core/actions/liveActionBuffer.h"
 #include "core/midiEvent.h"
 #include "core/model/model.h"
 #include "core/types.h"
 #include <cstddef>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace giada::patch
@@ -51,34 +53,30 @@ public:
 
 	void reset();
 
-	/* updateBpm
-	Changes actions position by calculating the new bpm value. */
-
-	void updateBpm(float ratio, int quantizerStep);
-
-	/* updateSamplerate
-	Changes actions position by taking in account the new samplerate. If
-	f_system == f_patch nothing will change, otherwise the conversion is
-	mandatory. */
-
-	void updateSamplerate(int systemRate, int patchRate);
-
 	/* cloneActions
-	Clones actions in channel 'channelId', giving them a new channel ID. Returns
+	Clones actions in channel 'channelId', giving them a new channel ID. Plug-in
+	automation follows the cloned plug-ins through 'pluginIds' (old plug-in ID ->
+	new plug-in ID): automation of plug-ins not in there is not cloned. Returns
 	whether any action has been cloned. */
 
-	bool cloneActions(ID channelId, ID newChannelId);
+	bool cloneActions(ID channelId, ID newChannelId, const std::unordered_map<ID, ID>& pluginIds);
 
 	/* liveRec
-	Records a user-generated action. NOTE_ON or NOTE_OFF only for now. */
+	Records a user-generated action. NOTE_ON or NOTE_OFF only for now. Safe to
+	call from any input thread: it never locks nor allocates. */
 
 	void liveRec(ID channelId, MidiEvent e, Frame global);
 
-	/* record*Action */
+	/* liveRecPluginParam
+	Records a change of a plug-in parameter as a CHANNEL_CC action, for
+	automation. Same thread-safety guarantees as liveRec(). */
 
-#if 0
-	void recordEnvelopeAction(ID channelId, Frame frame, int value, Frame lastFrameInLoop);
-#endif
+	void liveRecPluginParam(ID channelId, ID pluginId, int paramIndex, float value, Frame global);
+
+	/* record*Action
+	Envelope actions (only volume for now) take a gain value in [0.0, 1.0]. */
+
+	void recordEnvelopeAction(ID channelId, Frame frame, float value, Frame lastFrameInLoop);
 	void recordMidiAction(ID channelId, int note, float velocity, Frame f1, Frame f2, Frame framesInLoop);
 	void recordSampleAction(ID channelId, int type, Frame f1, Frame f2, Frame framesInLoop);
 
@@ -86,22 +84,18 @@ public:
 
 	void deleteMidiAction(ID channelId, const Action&);
 	void deleteSampleAction(ID channelId, const Action&);
-#if 0
 	void deleteEnvelopeAction(ID channelId, const Action&);
-#endif
 
 	/* update*Action */
 
 	void updateMidiAction(ID channelId, const Action&, int note, float velocity, Frame f1, Frame f2, Frame framesInLoop);
 	void updateSampleAction(ID channelId, const Action&, int type, Frame f1, Frame f2, Frame framesInLoop);
-#if 0
-	void updateEnvelopeAction(ID channelId, const Action&, Frame f, int value, Frame lastFrameInLoop);
-#endif
+	void updateEnvelopeAction(ID channelId, const Action&, Frame f, float value, Frame lastFrameInLoop);
 	void updateVelocity(const Action&, float value);
 
 	/* consolidate
 	Records all live actions. Returns a set of channels IDs that have been
-	recorded. */
+	recorded. Main thread only. */
 
 	std::unordered_set<ID> consolidate();
 
@@ -110,13 +104,15 @@ public:
 
 	void clearAllActions();
 
-	/* Pass-thru functions. See Actions.h */
+	/* Pass-thru functions. See Actions.h. Positions are in frames at the current
+	tempo, converted from and to the ticks actions are stored in. */
 
-	const Action*       findAction(ID) const;
+	Action              findAction(ID) const; // Invalid action if not found
 	bool                hasActions(ID channelId, int type = 0) const;
 	std::vector<Action> getActionsOnChannel(ID channelId) const;
 	void                clearChannel(ID channelId);
 	void                clearActions(ID channelId, int type);
+	void                clearPluginActions(ID channelId, ID pluginId);
 	Action              rec(ID channelId, Frame frame, MidiEvent e);
 	void                rec(ID channelId, Frame f1, Frame f2, MidiEvent e1, MidiEvent e2);
 	void                updateSiblings(ID id, ID prevId, ID nextId);
@@ -133,29 +129,36 @@ private:
 	Frame fixVerticalEnvActions(Frame f, const Action& a1, const Action& a2) const;
 	bool  isSinglePressMode(ID channelId) const;
 
+	/* fillFrame
+	Returns a copy of the action with the 'frame' field computed from its tick
+	at the current tempo. */
+
+	Action fillFrame(Action) const;
+
 	/* recordFirstEnvelopeAction
 	First action ever? Add actions at boundaries. */
-#if 0
-	void recordFirstEnvelopeAction(ID channelId, Frame frame, int value, Frame lastFrameInLoop);
+
+	void recordFirstEnvelopeAction(ID channelId, Frame frame, float value, Frame lastFrameInLoop);
 
 	/* recordNonFirstEnvelopeAction
-	Find action right before frame 'frame' and inject a new action in there. 
+	Find action right before frame 'frame' and inject a new action in there.
 	Vertical envelope points are forbidden. */
 
-	void recordNonFirstEnvelopeAction(ID channelId, Frame frame, int value);
-#endif
-	/* consolidate
-	Given an action 'a1' tries to find the matching NOTE_OFF and updates the
-	action accordingly. */
+	void recordNonFirstEnvelopeAction(ID channelId, Frame frame, float value);
+
+	/* linkComposites
+	Pairs each NOTE_ON with the first NOTE_OFF on the same note and channel that
+	follows it. Actions must be in recording order. */
 
-	void consolidate(const Action& a1, std::size_t i);
+	void linkComposites(std::vector<Action>&) const;
+
+	/* isBoundaryEnvelopeAction
+	Boundary actions are the first and the last one of an envelope. */
 
-#if 0
 	bool isBoundaryEnvelopeAction(const Action&) const;
-#endif
 
-	model::Model&       m_model;
-	std::vector<Action> m_liveActions;
+	model::Model&    m_model;
+	LiveActionBuffer m_liveActions;
 };
 } // namespace giada::m
 
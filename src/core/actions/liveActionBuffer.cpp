@@ -0,0 +1,222 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/actions/liveActionBuffer.h"
+#include <algorithm>
+#include <cassert>
+#include <optional>
+
+namespace giada::m
+{
+namespace
+{
+/* role_
+Role of the current thread, if registered. */
+
+thread_local std::optional<Thread> role_;
+
+/* NUM_ROLE_LANES_
+Number of lanes reserved to thread roles, i.e. the number of Thread values. */
+
+constexpr std::size_t NUM_ROLE_LANES_ = static_cast<std::size_t>(Thread::RENDER_AHEAD) + 1;
+
+static_assert(NUM_ROLE_LANES_ < LiveActionBuffer::MAX_LANES);
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+LiveActionBuffer::LiveActionBuffer()
+: m_sequence(0)
+, m_dropped(0)
+{
+	for (Lane& lane : m_lanes)
+	{
+		lane.storage.push_back(std::make_unique<Chunk>());
+		lane.head = lane.storage.back().get();
+		lane.tail = lane.head;
+		grow(lane, INITIAL_CHUNKS - 1);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void LiveActionBuffer::registerThread(Thread t)
+{
+	role_ = t;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool LiveActionBuffer::push(ID channelId, Tick tick, const MidiEvent& e, ID pluginId, int pluginParam)
+{
+	Lane* lane = getLane();
+	if (lane == nullptr)
+	{
+		m_dropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	Chunk*            chunk = lane->tail;
+	const std::size_t count = chunk->count.load(std::memory_order_relaxed);
+
+	if (count == CHUNK_SIZE)
+	{
+		Chunk* next = acquire(*lane);
+		if (next == nullptr)
+		{
+			lane->starved.store(true, std::memory_order_relaxed);
+			m_dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		chunk->next.store(next, std::memory_order_release);
+		lane->tail = next;
+		return push(channelId, tick, e, pluginId, pluginParam);
+	}
+
+	chunk->entries[count] = {channelId, tick, e, m_sequence.fetch_add(1, std::memory_order_relaxed), pluginId, pluginParam};
+	chunk->count.store(count + 1, std::memory_order_release);
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::vector<LiveActionBuffer::Entry> LiveActionBuffer::drain()
+{
+	std::vector<Entry> out;
+	for (Lane& lane : m_lanes)
+		consume(lane, &out);
+
+	std::sort(out.begin(), out.end(), [](const Entry& a, const Entry& b)
+	{ return a.sequence < b.sequence; });
+
+	m_dropped.store(0);
+	return out;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void LiveActionBuffer::clear()
+{
+	for (Lane& lane : m_lanes)
+		consume(lane, nullptr);
+	m_dropped.store(0);
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::size_t LiveActionBuffer::getDropped() const
+{
+	return m_dropped.load();
+}
+
+/* -------------------------------------------------------------------------- */
+
+LiveActionBuffer::Lane* LiveActionBuffer::getLane()
+{
+	if (role_.has_value())
+		return &m_lanes[static_cast<std::size_t>(*role_)];
+
+	const std::thread::id self = std::this_thread::get_id();
+
+	for (std::size_t i = NUM_ROLE_LANES_; i < MAX_LANES; i++)
+		if (m_lanes[i].owner.load(std::memory_order_acquire) == self)
+			return &m_lanes[i];
+
+	for (std::size_t i = NUM_ROLE_LANES_; i < MAX_LANES; i++)
+	{
+		std::thread::id none = {};
+		if (m_lanes[i].owner.compare_exchange_strong(none, self, std::memory_order_acq_rel))
+			return &m_lanes[i];
+	}
+
+	return nullptr;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void LiveActionBuffer::consume(Lane& lane, std::vector<Entry>* out)
+{
+	while (true)
+	{
+		Chunk*            chunk = lane.head;
+		const std::size_t count = chunk->count.load(std::memory_order_acquire);
+
+		if (out != nullptr)
+			out->insert(out->end(), chunk->entries.begin() + lane.readIndex, chunk->entries.begin() + count);
+		lane.readIndex = count;
+
+		/* A chunk can be recycled only once the writer has moved past it. */
+
+		Chunk* next = chunk->next.load(std::memory_order_acquire);
+		if (count < CHUNK_SIZE || next == nullptr)
+			break;
+
+		lane.head      = next;
+		lane.readIndex = 0;
+		recycle(lane, chunk);
+	}
+
+	if (lane.starved.exchange(false))
+		grow(lane, lane.storage.size());
+}
+
+/* -------------------------------------------------------------------------- */
+
+void LiveActionBuffer::grow(Lane& lane, std::size_t count)
+{
+	for (std::size_t i = 0; i < count && lane.storage.size() < MAX_CHUNKS; i++)
+	{
+		lane.storage.push_back(std::make_unique<Chunk>());
+		recycle(lane, lane.storage.back().get());
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void LiveActionBuffer::recycle(Lane& lane, Chunk* chunk)
+{
+	const std::size_t w = lane.freeWrite.load(std::memory_order_relaxed);
+	assert(w - lane.freeRead.load(std::memory_order_acquire) < MAX_CHUNKS);
+
+	lane.freeChunks[w % MAX_CHUNKS] = chunk;
+	lane.freeWrite.store(w + 1, std::memory_order_release);
+}
+
+LiveActionBuffer::Chunk* LiveActionBuffer::acquire(Lane& lane)
+{
+	const std::size_t r = lane.freeRead.load(std::memory_order_relaxed);
+	if (r == lane.freeWrite.load(std::memory_order_acquire))
+		return nullptr;
+
+	Chunk* chunk = lane.freeChunks[r % MAX_CHUNKS];
+	chunk->count.store(0, std::memory_order_relaxed);
+	chunk->next.store(nullptr, std::memory_order_relaxed);
+	lane.freeRead.store(r + 1, std::memory_order_release);
+	return chunk;
+}
+} // namespace giada::m
@@ -0,0 +1,183 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_LIVE_ACTION_BUFFER_H
+#define G_LIVE_ACTION_BUFFER_H
+
+#include "core/midiEvent.h"
+#include "core/types.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace giada::m
+{
+/* LiveActionBuffer
+Temporary storage for actions recorded live, filled by the input threads (MIDI,
+UI, ...) and drained by the main thread when the action recording session is
+over. Each writing thread gets its own lane: a list of fixed-size chunks taken
+from a preallocated per-lane pool. Threads registered with a role (see
+registerThread()) always write into the lane of that role, so that threads
+re-created by the engine (e.g. when audio or MIDI devices are reopened) don't
+use up the lanes. Other threads claim one of the remaining lanes for good. Pushing is lock-free and never allocates;
+the main thread recycles the drained chunks. A lane that ran out of chunks
+drops the entries in excess: its pool is doubled on the next drain() or clear(),
+so the following recording session has room for them. */
+
+class LiveActionBuffer final
+{
+public:
+	struct Entry
+	{
+		ID        channelId   = 0;
+		Tick      tick        = 0;
+		MidiEvent event       = {};
+		uint64_t  sequence    = 0; // Global recording order
+		ID        pluginId    = -1;
+		int       pluginParam = -1;
+	};
+
+	/* CHUNK_SIZE
+	Number of entries in a single chunk. */
+
+	static constexpr std::size_t CHUNK_SIZE = 128;
+
+	/* MAX_LANES
+	Maximum number of lanes. The first ones are reserved to thread roles, one
+	per Thread value. */
+
+	static constexpr std::size_t MAX_LANES = 8;
+
+	/* INITIAL_CHUNKS, MAX_CHUNKS
+	Number of chunks each lane starts with and may grow to. */
+
+	static constexpr std::size_t INITIAL_CHUNKS = 8;
+	static constexpr std::size_t MAX_CHUNKS     = 256;
+
+	LiveActionBuffer();
+	LiveActionBuffer(const LiveActionBuffer&)            = delete;
+	LiveActionBuffer& operator=(const LiveActionBuffer&) = delete;
+
+	/* registerThread
+	Tells all LiveActionBuffers the role of the calling thread. There must be
+	only one living thread per role at any given time. */
+
+	static void registerThread(Thread);
+
+	/* push
+	Stores a new entry in the lane of the calling thread. Lock-free and
+	allocation-free. Returns false if the entry has been dropped because the
+	lane is full or no lane is left for this thread. */
+
+	bool push(ID channelId, Tick tick, const MidiEvent&, ID pluginId = -1, int pluginParam = -1);
+
+	/* drain
+	Returns all entries pushed so far, sorted by recording order, and recycles
+	the consumed chunks. Main thread only. */
+
+	std::vector<Entry> drain();
+
+	/* clear
+	Discards all entries pushed so far. Main thread only. */
+
+	void clear();
+
+	/* getDropped
+	Returns the number of entries dropped since the last drain() or clear(). */
+
+	std::size_t getDropped() const;
+
+private:
+	struct Chunk
+	{
+		std::array<Entry, CHUNK_SIZE> entries;
+		std::atomic<std::size_t>       count = 0;
+		std::atomic<Chunk*>            next  = nullptr;
+	};
+
+	struct Lane
+	{
+		std::atomic<std::thread::id> owner = {};
+
+		/* Writer side: the chunk being filled. */
+
+		Chunk* tail = nullptr;
+
+		/* Reader side: the oldest chunk not yet recycled, and the first entry
+		in it not yet drained. */
+
+		Chunk*      head      = nullptr;
+		std::size_t readIndex = 0;
+
+		/* Single-producer (main thread), single-consumer (writer thread) ring
+		of recycled chunks. Its capacity is MAX_CHUNKS, so it never overflows. */
+
+		std::array<Chunk*, MAX_CHUNKS> freeChunks = {};
+		std::atomic<std::size_t>       freeWrite  = 0;
+		std::atomic<std::size_t>       freeRead   = 0;
+
+		/* Set by the writer when no free chunk was left. */
+
+		std::atomic<bool> starved = false;
+
+		/* Chunks owned by this lane. Main thread only. */
+
+		std::vector<std::unique_ptr<Chunk>> storage;
+	};
+
+	/* getLane
+	Returns the lane of the calling thread's role, if any. Otherwise returns
+	the lane owned by the calling thread, claiming a free one on first use.
+	Returns nullptr if all lanes are taken. */
+
+	Lane* getLane();
+
+	/* consume
+	Walks the lane from the reader position, passing new entries to 'out' (if
+	not null) and recycling fully consumed chunks. Grows the pool if the lane
+	has been starved. */
+
+	void consume(Lane&, std::vector<Entry>* out);
+
+	/* grow
+	Adds new chunks to the lane's free ring, up to MAX_CHUNKS. */
+
+	void grow(Lane&, std::size_t count);
+
+	void   recycle(Lane&, Chunk*);
+	Chunk* acquire(Lane&);
+
+	std::array<Lane, MAX_LANES> m_lanes;
+	std::atomic<uint64_t>       m_sequence;
+	std::atomic<std::size_t>    m_dropped;
+};
+} // namespace giada::m
+
+#endif
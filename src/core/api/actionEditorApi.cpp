@@ -31,8 +31,9 @@
 
 namespace giada::m
 {
-ActionEditorApi::ActionEditorApi(Engine& e, Sequencer& s, ActionRecorder& ar)
+ActionEditorApi::ActionEditorApi(Engine& e, model::Model& m, Sequencer& s, ActionRecorder& ar)
 : m_engine(e)
+, m_model(m)
 , m_sequencer(s)
 , m_actionRecorder(ar)
 {
@@ -47,7 +48,7 @@ std::vector<Action> ActionEditorApi::getActionsOnChannel(ID channelId) const
 
 /* -------------------------------------------------------------------------- */
 
-const Action* ActionEditorApi::findAction(ID id) const
+Action ActionEditorApi::findAction(ID id) const
 {
 	return m_actionRecorder.findAction(id);
 }
@@ -56,6 +57,8 @@ const Action* ActionEditorApi::findAction(ID id) const
 
 void ActionEditorApi::recordMidiAction(ID channelId, int note, float velocity, Frame f1, Frame f2)
 {
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	m_actionRecorder.recordMidiAction(channelId, note, velocity, f1, f2, m_sequencer.getFramesInLoop());
 }
 
@@ -63,12 +66,14 @@ void ActionEditorApi::recordMidiAction(ID channelId, int note, float velocity, F
 
 void ActionEditorApi::deleteMidiAction(ID channelId, const Action& a)
 {
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	/* Send a note-off first in case we are deleting it in a middle of a
 	key_on/key_off sequence. Only if it exists (i.e. it's not orphaned). */
 
-	const Action* noteOff = m_actionRecorder.findAction(a.nextId);
-	if (noteOff != nullptr)
-		m_engine.getChannelsApi().sendMidi(channelId, noteOff->event);
+	const Action noteOff = m_actionRecorder.findAction(a.nextId);
+	if (noteOff.isValid())
+		m_engine.getChannelsApi().sendMidi(channelId, noteOff.event);
 
 	m_actionRecorder.deleteMidiAction(channelId, a);
 }
@@ -77,6 +82,8 @@ void ActionEditorApi::deleteMidiAction(ID channelId, const Action& a)
 
 void ActionEditorApi::updateMidiAction(ID channelId, const Action& a, int note, float velocity, Frame f1, Frame f2)
 {
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	m_actionRecorder.updateMidiAction(channelId, a, note, velocity, f1, f2, m_sequencer.getFramesInLoop());
 }
 
@@ -84,6 +91,8 @@ void ActionEditorApi::updateMidiAction(ID channelId, const Action& a, int note,
 
 void ActionEditorApi::recordSampleAction(ID channelId, int type, Frame f1, Frame f2)
 {
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	m_actionRecorder.recordSampleAction(channelId, type, f1, f2, m_sequencer.getFramesInLoop());
 }
 
@@ -91,6 +100,8 @@ void ActionEditorApi::recordSampleAction(ID channelId, int type, Frame f1, Frame
 
 void ActionEditorApi::updateSampleAction(ID channelId, const Action& a, int type, Frame f1, Frame f2)
 {
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	m_actionRecorder.updateSampleAction(channelId, a, type, f1, f2, m_sequencer.getFramesInLoop());
 }
 
@@ -98,15 +109,17 @@ void ActionEditorApi::updateSampleAction(ID channelId, const Action& a, int type
 
 void ActionEditorApi::deleteSampleAction(ID channelId, const Action& a)
 {
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	m_actionRecorder.deleteSampleAction(channelId, a);
 }
 
 /* -------------------------------------------------------------------------- */
 
-#if 0
-
-void ActionEditorApi::recordEnvelopeAction(ID channelId, Frame f, int value)
+void ActionEditorApi::recordEnvelopeAction(ID channelId, Frame f, float value)
 {
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	m_actionRecorder.recordEnvelopeAction(channelId, f, value, m_sequencer.getFramesInLoop() - 1);
 }
 
@@ -114,22 +127,26 @@ void ActionEditorApi::recordEnvelopeAction(ID channelId, Frame f, int value)
 
 void ActionEditorApi::deleteEnvelopeAction(ID channelId, const Action& a)
 {
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	m_actionRecorder.deleteEnvelopeAction(channelId, a);
 }
 
 /* -------------------------------------------------------------------------- */
 
-void ActionEditorApi::updateEnvelopeAction(ID channelId, const Action& a, Frame f, int value)
+void ActionEditorApi::updateEnvelopeAction(ID channelId, const Action& a, Frame f, float value)
 {
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	m_actionRecorder.updateEnvelopeAction(channelId, a, f, value, m_sequencer.getFramesInLoop() - 1);
 }
 
-#endif
-
 /* -------------------------------------------------------------------------- */
 
 void ActionEditorApi::updateVelocity(const Action& a, float value)
 {
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	m_actionRecorder.updateVelocity(a, value);
 }
 } // namespace giada::m
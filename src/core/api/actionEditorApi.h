@@ -32,6 +32,11 @@
 #include "core/types.h"
 #include <vector>
 
+namespace giada::m::model
+{
+class Model;
+}
+
 namespace giada::m
 {
 class Engine;
@@ -40,10 +45,10 @@ class ActionRecorder;
 class ActionEditorApi
 {
 public:
-	ActionEditorApi(Engine&, Sequencer&, ActionRecorder&);
+	ActionEditorApi(Engine&, model::Model&, Sequencer&, ActionRecorder&);
 
 	std::vector<Action> getActionsOnChannel(ID channelId) const;
-	const Action*       findAction(ID) const;
+	Action              findAction(ID) const;
 
 	void recordMidiAction(ID channelId, int note, float velocity, Frame f1, Frame f2);
 	void deleteMidiAction(ID channelId, const Action&);
@@ -51,15 +56,14 @@ public:
 	void recordSampleAction(ID channelId, int type, Frame f1, Frame f2);
 	void updateSampleAction(ID channelId, const Action&, int type, Frame f1, Frame f2);
 	void deleteSampleAction(ID channelId, const Action&);
-#if 0
-	void recordEnvelopeAction(ID channelId, Frame f, int value);
+	void recordEnvelopeAction(ID channelId, Frame f, float value);
 	void deleteEnvelopeAction(ID channelId, const Action&);
-	void updateEnvelopeAction(ID channelId, const Action&, Frame f, int value);
-#endif
+	void updateEnvelopeAction(ID channelId, const Action&, Frame f, float value);
 	void updateVelocity(const Action&, float value);
 
 private:
 	Engine&         m_engine;
+	model::Model&   m_model;
 	Sequencer&      m_sequencer;
 	ActionRecorder& m_actionRecorder;
 };
@@ -30,13 +30,17 @@
 #include "core/kernelAudio.h"
 #include "core/midiSynchronizer.h"
 #include "core/mixer.h"
+#include "core/rendering/renderer.h"
+#include "core/waveFactory.h"
+#include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
 #include "utils/fs.h"
+#include <unordered_map>
 
 namespace giada::m
 {
 ChannelsApi::ChannelsApi(model::Model& m, KernelAudio& k, Mixer& mx, Sequencer& s,
     ChannelManager& cm, Recorder& r, ActionRecorder& ar, PluginHost& ph, PluginManager& pm,
-    rendering::Reactor& re)
+    rendering::Reactor& re, const rendering::Renderer& rn, Journal& j)
 : m_model(m)
 , m_kernelAudio(k)
 , m_mixer(mx)
@@ -47,6 +51,8 @@ ChannelsApi::ChannelsApi(model::Model& m, KernelAudio& k, Mixer& mx, Sequencer&
 , m_pluginHost(ph)
 , m_pluginManager(pm)
 , m_reactor(re)
+, m_renderer(rn)
+, m_journal(j)
 {
 }
 
@@ -69,6 +75,11 @@ bool ChannelsApi::canRemoveTrack(std::size_t trackIndex) const
 	return m_channelManager.canRemoveTrack(trackIndex);
 }
 
+bool ChannelsApi::canSend(ID channelId, ID returnId) const
+{
+	return m_channelManager.canSend(channelId, returnId);
+}
+
 /* -------------------------------------------------------------------------- */
 
 Channel& ChannelsApi::get(ID channelId)
@@ -107,6 +118,73 @@ void ChannelsApi::setTrackWidth(std::size_t trackIndex, int width)
 
 /* -------------------------------------------------------------------------- */
 
+bool ChannelsApi::freezeTrack(std::size_t trackIndex)
+{
+	const model::Document& document = m_model.get();
+	const model::Track&    track    = document.tracks.getAll()[trackIndex];
+
+	if (track.isInternal() || track.isFrozen())
+		return false;
+
+	const int   sampleRate   = m_kernelAudio.getSampleRate();
+	const int   bufferSize   = m_kernelAudio.getBufferSize();
+	const Frame framesInLoop = document.sequencer.framesInLoop;
+	const Frame latency      = m_renderer.getTrackLatency(track);
+
+	std::unique_ptr<Wave> wave = waveFactory::createEmpty(framesInLoop, G_MAX_IO_CHANS, sampleRate, "FROZEN");
+	mcl::AudioBuffer      block(bufferSize, G_MAX_IO_CHANS);
+
+	/* Rendering is offline, on this thread: the audio thread and the
+	render-ahead worker must stay away from the track's channels and plug-ins in
+	the meantime. Channels start rendering from a clean state, and are put back
+	as they were once done. */
+
+	m_kernelAudio.stopStream();
+	m_renderer.suspendRenderAhead(document.tracks);
+
+	std::vector<ChannelShared::RenderState> channelStates;
+	for (const Channel& c : track.getChannels().getAll())
+	{
+		channelStates.push_back(c.shared->saveRenderState());
+		c.shared->resetRenderState();
+	}
+
+	/* Render one loop from the first beat, plus the track latency. The first
+	'latency' frames are dropped, so that the frozen Wave is already lined up
+	with the sequencer. */
+
+	for (Frame rendered = 0; rendered < framesInLoop + latency; rendered += bufferSize)
+	{
+		m_renderer.renderTrackOffline(block, document, trackIndex, rendered % framesInLoop);
+
+		const Frame srcOffset    = std::max<Frame>(0, latency - rendered);
+		const Frame dstOffset    = std::max<Frame>(0, rendered - latency);
+		const Frame framesToCopy = std::min<Frame>(bufferSize - srcOffset, framesInLoop - dstOffset);
+		if (framesToCopy > 0)
+			wave->getBuffer().set(block, framesToCopy, srcOffset, dstOffset);
+	}
+
+	for (std::size_t i = 0; const Channel& c : track.getChannels().getAll())
+		c.shared->restoreRenderState(channelStates[i++]);
+
+	m_renderer.resumeRenderAhead();
+	m_kernelAudio.startStream();
+
+	m_channelManager.freezeTrack(trackIndex, std::move(wave));
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void ChannelsApi::unfreezeTrack(std::size_t trackIndex)
+{
+	if (!m_model.get().tracks.getAll()[trackIndex].isFrozen())
+		return;
+	m_channelManager.unfreezeTrack(trackIndex);
+}
+
+/* -------------------------------------------------------------------------- */
+
 Channel& ChannelsApi::add(ChannelType type, std::size_t trackIndex)
 {
 	const int bufferSize = m_kernelAudio.getBufferSize();
@@ -138,6 +216,8 @@ void ChannelsApi::loadSampleChannel(ID channelId, Wave& wave)
 
 void ChannelsApi::remove(ID channelId)
 {
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	const std::vector<Plugin*> plugins  = m_channelManager.getChannel(channelId).plugins;
 	const bool                 hasSolos = m_channelManager.hasSolos();
 
@@ -155,6 +235,8 @@ void ChannelsApi::remove(ID channelId)
 
 void ChannelsApi::freeSampleChannel(ID channelId)
 {
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	m_actionRecorder.clearChannel(channelId);
 	m_channelManager.freeSampleChannel(channelId);
 }
@@ -167,44 +249,61 @@ void ChannelsApi::clone(ID channelId)
 	internal workings. */
 
 	const Channel&             ch            = m_channelManager.getChannel(channelId);
+	const bool                 hasActions    = ch.hasActions;
 	const int                  bufferSize    = m_kernelAudio.getBufferSize();
 	const int                  sampleRate    = m_kernelAudio.getSampleRate();
 	const std::vector<Plugin*> plugins       = m_pluginManager.clonePlugins(ch.plugins, sampleRate, bufferSize, m_model);
 	const ID                   nextChannelId = channelFactory::getNextId();
 
+	/* Plug-ins are cloned in order: automation must point to the clones. */
+
+	std::unordered_map<ID, ID> pluginIds;
+	for (std::size_t i = 0; i < plugins.size(); i++)
+		pluginIds[ch.plugins[i]->id] = plugins[i]->id;
+
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	m_channelManager.cloneChannel(channelId, bufferSize, plugins);
-	if (ch.hasActions)
-		m_actionRecorder.cloneActions(channelId, nextChannelId);
+	if (hasActions)
+		m_actionRecorder.cloneActions(channelId, nextChannelId, pluginIds);
 }
 
 /* -------------------------------------------------------------------------- */
 
-void ChannelsApi::press(ID channelId, float velocity)
+void ChannelsApi::press(ID channelId, float velocity, Frame localFrame)
 {
+	const Journal::Scope journal = m_journal.record({Journal::EventType::CHANNEL_PRESS, channelId, velocity, localFrame});
+
 	const bool  canRecordActions = m_recorder.canRecordActions();
 	const bool  canQuantize      = m_sequencer.canQuantize();
 	const Frame currentFrameQ    = m_sequencer.getCurrentFrameQuantized();
-	m_reactor.keyPress(channelId, velocity, canRecordActions, canQuantize, currentFrameQ);
+	m_reactor.keyPress(channelId, velocity, canRecordActions, canQuantize, currentFrameQ, localFrame);
 }
 
-void ChannelsApi::release(ID channelId)
+void ChannelsApi::release(ID channelId, Frame localFrame)
 {
+	const Journal::Scope journal = m_journal.record({Journal::EventType::CHANNEL_RELEASE, channelId, 0.0f, localFrame});
+
 	const bool  canRecordActions = m_recorder.canRecordActions();
 	const Frame currentFrameQ    = m_sequencer.getCurrentFrameQuantized();
-	m_reactor.keyRelease(channelId, canRecordActions, currentFrameQ);
+	m_reactor.keyRelease(channelId, canRecordActions, currentFrameQ, localFrame);
 }
 
-void ChannelsApi::kill(ID channelId)
+void ChannelsApi::kill(ID channelId, Frame localFrame)
 {
+	const Journal::Scope journal = m_journal.record({Journal::EventType::CHANNEL_KILL, channelId, 0.0f, localFrame});
+
 	const bool  canRecordActions = m_recorder.canRecordActions();
 	const Frame currentFrameQ    = m_sequencer.getCurrentFrameQuantized();
-	m_reactor.keyKill(channelId, canRecordActions, currentFrameQ);
+	m_reactor.keyKill(channelId, canRecordActions, currentFrameQ, localFrame);
 }
 
 /* -------------------------------------------------------------------------- */
 
 void ChannelsApi::setVolume(ID channelId, float v)
 {
+	const Journal::Scope journal = m_journal.record({Journal::EventType::CHANNEL_VOLUME, channelId, v});
+
 	m_channelManager.setVolume(channelId, v);
 }
 
@@ -212,6 +311,8 @@ void ChannelsApi::setVolume(ID channelId, float v)
 
 void ChannelsApi::setPitch(ID channelId, float v)
 {
+	const Journal::Scope journal = m_journal.record({Journal::EventType::CHANNEL_PITCH, channelId, v});
+
 	m_channelManager.setPitch(channelId, v);
 }
 
@@ -219,6 +320,8 @@ void ChannelsApi::setPitch(ID channelId, float v)
 
 void ChannelsApi::setPan(ID channelId, float v)
 {
+	const Journal::Scope journal = m_journal.record({Journal::EventType::CHANNEL_PAN, channelId, v});
+
 	m_channelManager.setPan(channelId, v);
 }
 
@@ -226,6 +329,8 @@ void ChannelsApi::setPan(ID channelId, float v)
 
 void ChannelsApi::toggleMute(ID channelId)
 {
+	const Journal::Scope journal = m_journal.record({Journal::EventType::CHANNEL_MUTE, channelId});
+
 	m_reactor.toggleMute(channelId);
 }
 
@@ -233,6 +338,10 @@ void ChannelsApi::toggleMute(ID channelId)
 
 void ChannelsApi::toggleSolo(ID channelId)
 {
+	const Journal::Scope journal = m_journal.record({Journal::EventType::CHANNEL_SOLO, channelId});
+
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	m_reactor.toggleSolo(channelId);
 	m_mixer.updateSoloCount(m_channelManager.hasSolos());
 }
@@ -248,6 +357,8 @@ void ChannelsApi::toggleArm(ID channelId)
 
 void ChannelsApi::toggleReadActions(ID channelId)
 {
+	const Journal::Scope journal = m_journal.record({Journal::EventType::CHANNEL_READ_ACTIONS, channelId});
+
 	m_reactor.toggleReadActions(channelId, m_sequencer.isRunning());
 }
 
@@ -255,6 +366,8 @@ void ChannelsApi::toggleReadActions(ID channelId)
 
 void ChannelsApi::killReadActions(ID channelId)
 {
+	const Journal::Scope journal = m_journal.record({Journal::EventType::CHANNEL_KILL_READ_ACTIONS, channelId});
+
 	m_reactor.killReadActions(channelId);
 }
 
@@ -295,6 +408,13 @@ void ChannelsApi::setName(ID channelId, const std::string& name)
 
 /* -------------------------------------------------------------------------- */
 
+void ChannelsApi::setSend(ID channelId, ID returnId, float level)
+{
+	m_channelManager.setSend(channelId, returnId, level);
+}
+
+/* -------------------------------------------------------------------------- */
+
 void ChannelsApi::clearAllActions(ID channelId)
 {
 	m_actionRecorder.clearChannel(channelId);
@@ -309,6 +429,8 @@ void ChannelsApi::clearAllActions()
 
 void ChannelsApi::freeAllSampleChannels()
 {
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	m_channelManager.freeAllSampleChannels();
 }
 
@@ -316,6 +438,8 @@ void ChannelsApi::freeAllSampleChannels()
 
 void ChannelsApi::sendMidi(ID channelId, const MidiEvent& e)
 {
+	const Journal::Scope journal = m_journal.record(Journal::makeMidiEvent(Journal::EventType::CHANNEL_MIDI, channelId, e));
+
 	const bool  canRecordActions = m_recorder.canRecordActions();
 	const Frame currentFrameQ    = m_sequencer.getCurrentFrameQuantized();
 	m_reactor.processMidiEvent(channelId, e, canRecordActions, currentFrameQ);
@@ -28,6 +28,7 @@
 #define G_CHANNELS_API_H
 
 #include "core/channels/channelFactory.h"
+#include "core/journal.h"
 #include "core/patch.h"
 #include "core/types.h"
 #include <string>
@@ -42,7 +43,8 @@ class Tracks;
 namespace giada::m::rendering
 {
 class Reactor;
-}
+class Renderer;
+} // namespace giada::m::rendering
 
 namespace giada::m
 {
@@ -62,11 +64,13 @@ class ChannelsApi
 {
 public:
 	ChannelsApi(model::Model&, KernelAudio&, Mixer&, Sequencer&, ChannelManager&,
-	    Recorder&, ActionRecorder&, PluginHost&, PluginManager&, rendering::Reactor&);
+	    Recorder&, ActionRecorder&, PluginHost&, PluginManager&, rendering::Reactor&,
+	    const rendering::Renderer&, Journal&);
 
 	bool hasChannelsWithAudioData() const;
 	bool hasChannelsWithActions() const;
 	bool canRemoveTrack(std::size_t trackIndex) const;
+	bool canSend(ID channelId, ID returnId) const;
 
 	Channel&       get(ID);
 	model::Tracks& getTracks();
@@ -74,6 +78,8 @@ public:
 	void     addTrack();
 	void     removeTrack(std::size_t trackIndex);
 	void     setTrackWidth(std::size_t trackIndex, int width);
+	bool     freezeTrack(std::size_t trackIndex);
+	void     unfreezeTrack(std::size_t trackIndex);
 	Channel& add(ChannelType, std::size_t trackIndex);
 	void     move(ID, std::size_t newTrackIndex, std::size_t newPosition);
 	int      loadSampleChannel(ID channelId, const std::string& filePath);
@@ -82,9 +88,9 @@ public:
 	void     freeSampleChannel(ID);
 	void     clone(ID);
 
-	void press(ID, float velocity);
-	void release(ID);
-	void kill(ID);
+	void press(ID, float velocity, Frame localFrame = 0);
+	void release(ID, Frame localFrame = 0);
+	void kill(ID, Frame localFrame = 0);
 	void setVolume(ID, float);
 	void setPitch(ID, float);
 	void setPan(ID, float);
@@ -98,6 +104,7 @@ public:
 	void setSamplePlayerMode(ID, SamplePlayerMode);
 	void setHeight(ID, int);
 	void setName(ID, const std::string&);
+	void setSend(ID channelId, ID returnId, float level);
 	void clearAllActions(ID);
 	void clearAllActions();
 	void freeAllSampleChannels();
@@ -105,16 +112,18 @@ public:
 	bool saveSample(ID, const std::string& filePath);
 
 private:
-	model::Model&       m_model;
-	KernelAudio&        m_kernelAudio;
-	Mixer&              m_mixer;
-	Sequencer&          m_sequencer;
-	ChannelManager&     m_channelManager;
-	Recorder&           m_recorder;
-	ActionRecorder&     m_actionRecorder;
-	PluginHost&         m_pluginHost;
-	PluginManager&      m_pluginManager;
-	rendering::Reactor& m_reactor;
+	model::Model&              m_model;
+	KernelAudio&               m_kernelAudio;
+	Mixer&                     m_mixer;
+	Sequencer&                 m_sequencer;
+	ChannelManager&            m_channelManager;
+	Recorder&                  m_recorder;
+	ActionRecorder&            m_actionRecorder;
+	PluginHost&                m_pluginHost;
+	PluginManager&             m_pluginManager;
+	rendering::Reactor&        m_reactor;
+	const rendering::Renderer& m_renderer;
+	Journal&                   m_journal;
 };
 } // namespace giada::m
 
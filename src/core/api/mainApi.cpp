@@ -30,18 +30,22 @@
 #include "core/kernelAudio.h"
 #include "core/midiSynchronizer.h"
 #include "core/mixer.h"
+#include "core/model/model.h"
 
 namespace giada::m
 {
-MainApi::MainApi(KernelAudio& ka, Mixer& m, Sequencer& s, MidiSynchronizer& ms,
-    ChannelManager& cm, Recorder& r, rendering::Reactor& re)
-: m_kernelAudio(ka)
+MainApi::MainApi(model::Model& mo, KernelAudio& ka, Mixer& m, Sequencer& s, MidiSynchronizer& ms,
+    ChannelManager& cm, Recorder& r, rendering::Reactor& re, Profiler& p, Journal& j)
+: m_model(mo)
+, m_kernelAudio(ka)
 , m_mixer(m)
 , m_sequencer(s)
 , m_midiSynchronizer(ms)
 , m_channelManager(cm)
 , m_recorder(r)
 , m_reactor(re)
+, m_profiler(p)
+, m_journal(j)
 {
 }
 
@@ -129,6 +133,18 @@ Mixer::RecordInfo MainApi::getRecordInfo() const
 
 /* -------------------------------------------------------------------------- */
 
+float MainApi::getDspLoad() const
+{
+	return m_profiler.getDspLoad();
+}
+
+Profiler::Report MainApi::getProfilerReport() const
+{
+	return m_profiler.getReport();
+}
+
+/* -------------------------------------------------------------------------- */
+
 int MainApi::getBeats() const
 {
 	return m_sequencer.getBeats();
@@ -190,6 +206,8 @@ SeqStatus MainApi::getSequencerStatus() const
 
 void MainApi::toggleMetronome()
 {
+	const Journal::Scope journal = m_journal.record({Journal::EventType::METRONOME});
+
 	m_sequencer.toggleMetronome();
 }
 
@@ -197,11 +215,15 @@ void MainApi::toggleMetronome()
 
 void MainApi::setMasterInVolume(float v)
 {
+	const Journal::Scope journal = m_journal.record({Journal::EventType::MASTER_IN_VOLUME, 0, v});
+
 	m_channelManager.setVolume(Mixer::MASTER_IN_CHANNEL_ID, v);
 }
 
 void MainApi::setMasterOutVolume(float v)
 {
+	const Journal::Scope journal = m_journal.record({Journal::EventType::MASTER_OUT_VOLUME, 0, v});
+
 	m_channelManager.setVolume(Mixer::MASTER_OUT_CHANNEL_ID, v);
 }
 
@@ -221,8 +243,13 @@ void MainApi::divideBeats()
 
 void MainApi::setBpm(float bpm)
 {
+	const Journal::Scope journal = m_journal.record({Journal::EventType::BPM, 0, bpm});
+
 	if (m_mixer.isRecordingInput())
 		return;
+
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	m_sequencer.setBpm(bpm, m_kernelAudio.getSampleRate());
 	m_midiSynchronizer.setClockBpm(bpm);
 }
@@ -231,20 +258,22 @@ void MainApi::setBpm(float bpm)
 
 void MainApi::setBeats(int beats, int bars)
 {
+	const Journal::Scope journal = m_journal.record({Journal::EventType::BEATS, 0, 0.0f, beats, bars});
+
 	if (m_mixer.isRecordingInput())
 		return;
 
-	const int sampleRate = m_kernelAudio.getSampleRate();
-	m_sequencer.setBeats(beats, bars, sampleRate);
+	const model::Transaction transaction = m_model.beginTransaction();
 
-	const int maxFramesInLoop = m_sequencer.getMaxFramesInLoop(sampleRate);
-	m_mixer.allocRecBuffer(maxFramesInLoop);
+	m_sequencer.setBeats(beats, bars, m_kernelAudio.getSampleRate());
 }
 
 /* -------------------------------------------------------------------------- */
 
 void MainApi::goToBeat(int beat)
 {
+	const Journal::Scope journal = m_journal.record({Journal::EventType::GO_TO_BEAT, 0, 0.0f, beat});
+
 	m_sequencer.goToBeat(beat, m_kernelAudio.getSampleRate());
 }
 
@@ -252,11 +281,19 @@ void MainApi::goToBeat(int beat)
 
 void MainApi::startSequencer()
 {
+	const Journal::Scope journal = m_journal.record({Journal::EventType::SEQUENCER_START});
+
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	m_sequencer.start();
 }
 
 void MainApi::stopSequencer()
 {
+	const Journal::Scope journal = m_journal.record({Journal::EventType::SEQUENCER_STOP});
+
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	m_sequencer.stop();
 	m_reactor.stopAll();
 }
@@ -268,6 +305,10 @@ void MainApi::toggleSequencer()
 
 void MainApi::rewindSequencer()
 {
+	const Journal::Scope journal = m_journal.record({Journal::EventType::SEQUENCER_REWIND});
+
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	m_sequencer.rewind();
 	m_reactor.rewindAll();
 }
@@ -276,6 +317,8 @@ void MainApi::rewindSequencer()
 
 void MainApi::setQuantize(int v)
 {
+	const Journal::Scope journal = m_journal.record({Journal::EventType::QUANTIZE, 0, 0.0f, v});
+
 	m_sequencer.setQuantize(v, m_kernelAudio.getSampleRate());
 }
 /* -------------------------------------------------------------------------- */
@@ -294,11 +337,19 @@ void MainApi::toggleFreeInputRec() { m_recorder.toggleFreeInputRec(); }
 
 void MainApi::stopActionRecording()
 {
+	const Journal::Scope journal = m_journal.record({Journal::EventType::ACTION_REC_STOP});
+
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	m_recorder.stopActionRec();
 }
 
 void MainApi::toggleActionRecording()
 {
+	const Journal::Scope journal = m_journal.record({Journal::EventType::ACTION_REC});
+
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	m_recorder.toggleActionRec();
 }
 
@@ -306,13 +357,22 @@ void MainApi::toggleActionRecording()
 
 void MainApi::stopInputRecording()
 {
+	const Journal::Scope journal = m_journal.record({Journal::EventType::INPUT_REC_STOP});
+
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	m_recorder.stopInputRec(m_kernelAudio.getSampleRate());
 }
 
 void MainApi::toggleInputRecording()
 {
+	const Journal::Scope journal = m_journal.record({Journal::EventType::INPUT_REC});
+
 	if (!m_kernelAudio.isInputEnabled())
 		return;
+
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	m_recorder.toggleInputRec(m_kernelAudio.getSampleRate());
 
 	if (m_mixer.isRecordingInput() && m_mixer.getInputRecMode() == InputRecMode::FREE && m_sequencer.isMetronomeOn())
@@ -323,6 +383,47 @@ void MainApi::toggleInputRecording()
 
 void MainApi::startActionRecOnCallback()
 {
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	m_recorder.startActionRecOnCallback();
 }
+/* -------------------------------------------------------------------------- */
+
+bool MainApi::dumpProfilerReport(const std::string& path) const
+{
+	return m_profiler.dump(path);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void MainApi::resetProfiler()
+{
+	m_profiler.reset();
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool MainApi::startSessionCapture(const std::string& path)
+{
+	const Journal::Header header = {
+	    m_kernelAudio.getSampleRate(),
+	    static_cast<int>(m_kernelAudio.getBufferSize()),
+	    m_kernelAudio.isInputEnabled() ? m_kernelAudio.getChannelsInCount() : 0,
+	    m_sequencer.getBpm(),
+	    m_sequencer.getBeats(),
+	    m_sequencer.getBars(),
+	    m_sequencer.getQuantizerValue()};
+
+	return m_journal.startCapture(path, header);
+}
+
+bool MainApi::stopSessionCapture()
+{
+	return m_journal.stopCapture();
+}
+
+bool MainApi::isCapturingSession() const
+{
+	return m_journal.isCapturing();
+}
 } // namespace giada::m
@@ -27,7 +27,14 @@
 #ifndef G_MAIN_API_H
 #define G_MAIN_API_H
 
+#include "core/journal.h"
 #include "core/mixer.h"
+#include "core/profiler.h"
+
+namespace giada::m::model
+{
+class Model;
+}
 
 namespace giada::m::rendering
 {
@@ -45,8 +52,8 @@ class Recorder;
 class MainApi
 {
 public:
-	MainApi(KernelAudio&, Mixer&, Sequencer&, MidiSynchronizer&, ChannelManager&, Recorder&,
-	    rendering::Reactor&);
+	MainApi(model::Model&, KernelAudio&, Mixer&, Sequencer&, MidiSynchronizer&, ChannelManager&,
+	    Recorder&, rendering::Reactor&, Profiler&, Journal&);
 
 	bool              isRecordingInput() const;
 	bool              isRecordingActions() const;
@@ -72,6 +79,8 @@ public:
 	int               getFramesInSeq() const;
 	int               getFramesInBeat() const;
 	SeqStatus         getSequencerStatus() const;
+	float             getDspLoad() const;
+	Profiler::Report  getProfilerReport() const;
 
 	void toggleMetronome();
 	void setMasterInVolume(float);
@@ -95,7 +104,23 @@ public:
 	void toggleInputRecording();
 	void startActionRecOnCallback();
 
+	/* dumpProfilerReport
+	Writes the audio thread performance report to file. Returns false on
+	failure. */
+
+	bool dumpProfilerReport(const std::string& path) const;
+	void resetProfiler();
+
+	/* startSessionCapture, stopSessionCapture
+	Start or stop journaling all external inputs and the audio input stream
+	into the directory 'path'. See Journal and Engine::replaySession. */
+
+	bool startSessionCapture(const std::string& path);
+	bool stopSessionCapture();
+	bool isCapturingSession() const;
+
 private:
+	model::Model&       m_model;
 	KernelAudio&        m_kernelAudio;
 	Mixer&              m_mixer;
 	Sequencer&          m_sequencer;
@@ -103,6 +128,8 @@ private:
 	ChannelManager&     m_channelManager;
 	Recorder&           m_recorder;
 	rendering::Reactor& m_reactor;
+	Profiler&           m_profiler;
+	Journal&            m_journal;
 };
 } // namespace giada::m
 
@@ -25,20 +25,29 @@
  * -------------------------------------------------------------------------- */
 
 #include "pluginsApi.h"
+#include "core/actions/actionRecorder.h"
 #include "core/channels/channelManager.h"
 #include "core/engine.h"
 #include "core/kernelAudio.h"
 #include "core/mixer.h"
 #include "core/plugins/pluginFactory.h"
+#include "core/profiler.h"
+#include "core/recorder.h"
+#include "core/sequencer.h"
 #include "utils/fs.h"
 
 namespace giada::m
 {
-PluginsApi::PluginsApi(KernelAudio& ka, PluginManager& pm, PluginHost& ph, model::Model& m)
+PluginsApi::PluginsApi(KernelAudio& ka, PluginManager& pm, PluginHost& ph, model::Model& m, Sequencer& s,
+    Recorder& r, ActionRecorder& ar, const Profiler& p)
 : m_kernelAudio(ka)
 , m_pluginManager(pm)
 , m_pluginHost(ph)
 , m_model(m)
+, m_sequencer(s)
+, m_recorder(r)
+, m_actionRecorder(ar)
+, m_profiler(p)
 {
 }
 
@@ -58,6 +67,13 @@ std::vector<PluginManager::PluginInfo> PluginsApi::getInfo() const
 
 /* -------------------------------------------------------------------------- */
 
+float PluginsApi::getCpuLoad(ID pluginId) const
+{
+	return m_profiler.getPluginLoad(pluginId);
+}
+
+/* -------------------------------------------------------------------------- */
+
 int PluginsApi::countAvailablePlugins() const
 {
 	return m_pluginManager.countAvailablePlugins();
@@ -107,7 +123,10 @@ void PluginsApi::sort(PluginManager::SortMode mode)
 
 void PluginsApi::free(const Plugin& plugin, ID channelId)
 {
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	u::vector::remove(m_model.get().tracks.getChannel(channelId).plugins, &plugin);
+	m_actionRecorder.clearPluginActions(channelId, plugin.id);
 	m_model.swap(model::SwapType::HARD);
 	m_pluginHost.freePlugin(plugin);
 }
@@ -128,9 +147,16 @@ void PluginsApi::toggleBypass(ID pluginId)
 
 /* -------------------------------------------------------------------------- */
 
-void PluginsApi::setParameter(ID pluginId, int paramIndex, float value)
+void PluginsApi::setParameter(ID channelId, ID pluginId, int paramIndex, float value)
 {
 	m_pluginHost.setPluginParameter(pluginId, paramIndex, value);
+
+	/* Master channels don't read actions: nothing to automate there. */
+
+	const bool isMaster = channelId == Mixer::MASTER_OUT_CHANNEL_ID || channelId == Mixer::MASTER_IN_CHANNEL_ID;
+
+	if (channelId != 0 && !isMaster && m_recorder.canRecordActions())
+		m_actionRecorder.liveRecPluginParam(channelId, pluginId, paramIndex, value, m_sequencer.getCurrentFrame());
 }
 
 /* -------------------------------------------------------------------------- */
@@ -145,6 +171,9 @@ void PluginsApi::scan(const std::string& dir, const std::function<bool(float)>&
 
 void PluginsApi::process(mcl::AudioBuffer& outBuf, const std::vector<Plugin*>& plugins, juce::MidiBuffer* events)
 {
-	m_pluginHost.processStack(outBuf, plugins, events);
+	if (events == nullptr)
+		m_pluginHost.processStack(outBuf, plugins);
+	else
+		m_pluginHost.processStack(outBuf, plugins, *events);
 }
 } // namespace giada::m
@@ -43,31 +43,52 @@ class KernelAudio;
 class ChannelManager;
 class PluginHost;
 class Plugin;
+class Sequencer;
+class Recorder;
+class ActionRecorder;
+class Profiler;
 class PluginsApi
 {
 public:
-	PluginsApi(KernelAudio&, PluginManager&, PluginHost&, model::Model&);
+	PluginsApi(KernelAudio&, PluginManager&, PluginHost&, model::Model&, Sequencer&, Recorder&,
+	    ActionRecorder&, const Profiler&);
 
 	const Plugin*                          get(ID pluginId) const;
 	std::vector<PluginManager::PluginInfo> getInfo() const;
 	int                                    countAvailablePlugins() const;
 
+	/* getCpuLoad
+	Returns the fraction of the audio block period spent processing the given
+	plug-in, smoothed over time. */
+
+	float getCpuLoad(ID pluginId) const;
+
 	void add(int pluginListIndex, ID channelId);
 	void swap(const Plugin&, const Plugin&, ID channelId);
 	void sort(PluginManager::SortMode);
 	void free(const Plugin&, ID channelId);
 	void setProgram(ID pluginId, int programIndex);
 	void toggleBypass(ID pluginId);
-	void setParameter(ID pluginId, int paramIndex, float value);
+
+	/* setParameter
+	Sets a new value for a plug-in parameter. The change is also recorded as an
+	action on channel 'channelId' (if any) while recording actions, so that it
+	can be played back as automation. */
+
+	void setParameter(ID channelId, ID pluginId, int paramIndex, float value);
 
 	void scan(const std::string& dir, const std::function<bool(float)>& progress);
 	void process(mcl::AudioBuffer& outBuf, const std::vector<Plugin*>&, juce::MidiBuffer* events = nullptr);
 
 private:
-	KernelAudio&   m_kernelAudio;
-	PluginManager& m_pluginManager;
-	PluginHost&    m_pluginHost;
-	model::Model&  m_model;
+	KernelAudio&    m_kernelAudio;
+	PluginManager&  m_pluginManager;
+	PluginHost&     m_pluginHost;
+	model::Model&   m_model;
+	Sequencer&      m_sequencer;
+	Recorder&       m_recorder;
+	ActionRecorder& m_actionRecorder;
+	const Profiler& m_profiler;
 };
 } // namespace giada::m
 
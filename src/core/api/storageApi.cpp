@@ -115,26 +115,25 @@ model::LoadState StorageApi::loadProject(const std::string& projectPath, std::fu
 	m_mixer.disable();
 	m_engine.reset();
 
-	/* Load the patch into Model. */
+	/* Load the patch into Model. Plug-ins loading takes the 0.3 - 0.6 progress
+	range. */
 
-	const int                sampleRate  = m_kernelAudio.getSampleRate();
-	const int                bufferSize  = m_kernelAudio.getBufferSize();
-	const Resampler::Quality rsmpQuality = m_kernelAudio.getResamplerQuality();
-	const model::LoadState   state       = m_model.load(patch, m_pluginManager, sampleRate, bufferSize, rsmpQuality);
+	const int                sampleRate     = m_kernelAudio.getSampleRate();
+	const int                bufferSize     = m_kernelAudio.getBufferSize();
+	const Resampler::Quality rsmpQuality    = m_kernelAudio.getResamplerQuality();
+	const auto               pluginProgress = [&progress](float v)
+	{ progress(0.3f + v * 0.3f); };
+	const model::LoadState state = m_model.load(patch, m_pluginManager, sampleRate, bufferSize, rsmpQuality, pluginProgress);
 
 	progress(0.6f);
 
-	/* Prepare the engine. Recorder has to recompute the actions positions if
-	the current samplerate != patch samplerate. Clock needs to update frames
-	in sequencer. */
+	/* Prepare the engine. Clock needs to update frames in sequencer. Actions
+	are stored in ticks and don't depend on the sample rate. */
 
-	const int  maxFramesInLoop = m_sequencer.getMaxFramesInLoop(sampleRate);
-	const bool hasSolos        = m_channelManager.hasSolos();
+	const bool hasSolos = m_channelManager.hasSolos();
 
 	m_mixer.updateSoloCount(hasSolos);
-	m_actionRecorder.updateSamplerate(sampleRate, patch.samplerate);
 	m_sequencer.recomputeFrames(sampleRate);
-	m_mixer.allocRecBuffer(maxFramesInLoop);
 
 	progress(0.9f);
 
@@ -76,6 +76,7 @@ Channel::Channel(const Patch::Channel& p, ChannelShared& s, float samplerateRati
 , name(p.name)
 , height(p.height)
 , plugins(plugins)
+, sends(p.sends)
 , midiInput(p)
 , midiLightning(p)
 , m_mute(p.mute)
@@ -83,6 +84,9 @@ Channel::Channel(const Patch::Channel& p, ChannelShared& s, float samplerateRati
 {
 	shared->readActions.store(p.readActions);
 	shared->recStatus.store(p.readActions ? ChannelStatus::PLAY : ChannelStatus::OFF);
+	shared->volume.store(p.volume);
+	shared->pan.store(p.pan);
+	shared->pitch.store(p.pitch);
 
 	switch (type)
 	{
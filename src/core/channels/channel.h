@@ -107,6 +107,7 @@ public:
 	std::string          name;   // TODO - move this to v::Model
 	Pixel                height; // TODO - move this to v::Model
 	std::vector<Plugin*> plugins;
+	std::vector<Send>    sends;
 
 	MidiInput     midiInput;
 	MidiLightning midiLightning;
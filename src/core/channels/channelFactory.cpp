@@ -100,6 +100,10 @@ Data create(const Channel& o, int bufferSize, Resampler::Quality quality)
 	ch.id     = channelId_.generate();
 	ch.shared = shared.get();
 
+	shared->volume.store(o.shared->volume.load());
+	shared->pan.store(o.shared->pan.load());
+	shared->pitch.store(o.shared->pitch.load());
+
 	return {ch, std::move(shared)};
 }
 
@@ -139,6 +143,7 @@ const Patch::Channel serializeChannel(const Channel& c)
 	pc.hasActions        = c.hasActions;
 	pc.readActions       = c.shared->readActions.load();
 	pc.armed             = c.armed;
+	pc.sends             = c.sends;
 	pc.midiIn            = c.midiInput.enabled;
 	pc.midiInFilter      = c.midiInput.filter;
 	pc.midiInKeyPress    = c.midiInput.keyPress.getValue();
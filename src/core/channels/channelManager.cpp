@@ -30,6 +30,8 @@
 #include "core/midiEvent.h"
 #include "core/mixer.h"
 #include "core/model/model.h"
+#include "core/plugins/plugin.h"
+#include "core/recBuffer.h"
 #include "core/rendering/midiOutput.h"
 #include "core/rendering/midiReactions.h"
 #include "core/rendering/sampleReactions.h"
@@ -128,11 +130,16 @@ void ChannelManager::removeTrack(std::size_t trackIndex)
 {
 	assert(canRemoveTrack(trackIndex));
 
-	const Channel& ch = m_model.get().tracks.get(trackIndex).getGroupChannel();
+	const Channel& ch         = m_model.get().tracks.get(trackIndex).getGroupChannel();
+	const Wave*    frozenWave = m_model.get().tracks.get(trackIndex).frozenWave;
 
 	m_model.removeChannelShared(*ch.shared);
+	m_model.get().tracks.removeSendsTo(ch.id);
 	m_model.get().tracks.remove(trackIndex);
 	m_model.swap(model::SwapType::HARD);
+
+	if (frozenWave != nullptr)
+		m_model.removeWave(*frozenWave);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -145,6 +152,43 @@ void ChannelManager::setTrackWidth(std::size_t trackIndex, int width)
 
 /* -------------------------------------------------------------------------- */
 
+void ChannelManager::freezeTrack(std::size_t trackIndex, std::unique_ptr<Wave> wave)
+{
+	model::Track& track = m_model.get().tracks.get(trackIndex);
+	assert(!track.isFrozen());
+
+	track.frozenWave = &m_model.addWave(std::move(wave));
+	for (const Channel& c : track.getChannels().getAll())
+		for (Plugin* p : c.plugins)
+			p->setSuspended(true);
+
+	m_model.swap(model::SwapType::HARD);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void ChannelManager::unfreezeTrack(std::size_t trackIndex)
+{
+	model::Track& track = m_model.get().tracks.get(trackIndex);
+	assert(track.isFrozen());
+
+	const Wave* frozenWave = track.frozenWave;
+
+	track.frozenWave = nullptr;
+	for (const Channel& c : track.getChannels().getAll())
+		for (Plugin* p : c.plugins)
+			p->setSuspended(false);
+
+	m_model.swap(model::SwapType::HARD);
+
+	/* Safe to remove it now: the audio thread is already processing the new
+	Document. */
+
+	m_model.removeWave(*frozenWave);
+}
+
+/* -------------------------------------------------------------------------- */
+
 Channel& ChannelManager::addChannel(ChannelType type, std::size_t trackIndex, int bufferSize)
 {
 	const bool               overdubProtectionDefaultOn = m_model.get().behaviors.overdubProtectionDefaultOn;
@@ -224,6 +268,7 @@ void ChannelManager::cloneChannel(ID channelId, int bufferSize, const std::vecto
 	/* Then push the new channel in the channels vector. */
 
 	m_model.get().tracks.get(trackIndex).addChannel(std::move(newChannelData.channel));
+	m_model.get().tracks.updateReturns();
 	m_model.addChannelShared(std::move(newChannelData.shared));
 	m_model.swap(model::SwapType::HARD);
 }
@@ -282,7 +327,7 @@ void ChannelManager::deleteChannel(ID channelId)
 	const Wave*    wave = ch.sampleChannel ? ch.sampleChannel->getWave() : nullptr;
 
 	m_model.removeChannelShared(*ch.shared);
-	m_model.get().tracks.getByChannel(channelId).removeChannel(channelId);
+	m_model.get().tracks.removeChannel(channelId);
 	m_model.swap(model::SwapType::HARD);
 
 	if (wave != nullptr)
@@ -313,7 +358,7 @@ float ChannelManager::getMasterOutVol() const
 
 /* -------------------------------------------------------------------------- */
 
-void ChannelManager::finalizeInputRec(const mcl::AudioBuffer& buffer, Frame recordedFrames, Frame currentFrame)
+void ChannelManager::finalizeInputRec(const RecBuffer& buffer, Frame recordedFrames, Frame currentFrame)
 {
 	for (Channel* ch : getRecordableChannels())
 		recordChannel(*ch, buffer, recordedFrames, currentFrame);
@@ -335,8 +380,15 @@ void ChannelManager::setInputMonitor(ID channelId, bool value)
 
 void ChannelManager::setVolume(ID channelId, float value)
 {
-	m_model.get().tracks.getChannel(channelId).volume = std::clamp(value, 0.0f, G_MAX_VOLUME);
-	m_model.swap(model::SwapType::SOFT);
+	/* Continuous controls don't need a Document swap: the real-time thread
+	reads the new value from the parameter lane in the shared state. The
+	Document copy is updated silently, it will be published on the next swap. */
+
+	Channel&    ch     = m_model.get().tracks.getChannel(channelId);
+	const float volume = std::clamp(value, 0.0f, G_MAX_VOLUME);
+
+	ch.volume = volume;
+	ch.shared->volume.store(volume);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -345,19 +397,25 @@ void ChannelManager::setPitch(ID channelId, float value)
 {
 	assert(m_model.get().tracks.getChannel(channelId).sampleChannel);
 
-	const float pitch = std::clamp(value, G_MIN_PITCH, G_MAX_PITCH);
+	Channel&    ch        = m_model.get().tracks.getChannel(channelId);
+	Channel&    previewCh = m_model.get().tracks.getChannel(Mixer::PREVIEW_CHANNEL_ID);
+	const float pitch     = std::clamp(value, G_MIN_PITCH, G_MAX_PITCH);
 
-	m_model.get().tracks.getChannel(channelId).sampleChannel->pitch                 = pitch;
-	m_model.get().tracks.getChannel(Mixer::PREVIEW_CHANNEL_ID).sampleChannel->pitch = pitch;
-	m_model.swap(model::SwapType::SOFT);
+	ch.sampleChannel->pitch        = pitch;
+	previewCh.sampleChannel->pitch = pitch;
+	ch.shared->pitch.store(pitch);
+	previewCh.shared->pitch.store(pitch);
 }
 
 /* -------------------------------------------------------------------------- */
 
 void ChannelManager::setPan(ID channelId, float value)
 {
-	m_model.get().tracks.getChannel(channelId).pan = std::clamp(value, 0.0f, G_MAX_PAN);
-	m_model.swap(model::SwapType::SOFT);
+	Channel&    ch  = m_model.get().tracks.getChannel(channelId);
+	const float pan = std::clamp(value, 0.0f, G_MAX_PAN);
+
+	ch.pan = pan;
+	ch.shared->pan.store(pan);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -436,6 +494,49 @@ void ChannelManager::setHeight(ID channelId, Pixel height)
 
 /* -------------------------------------------------------------------------- */
 
+bool ChannelManager::canSend(ID channelId, ID returnId) const
+{
+	const model::Tracks& tracks = m_model.get().tracks;
+
+	const model::Track* source = nullptr;
+	const model::Track* target = nullptr;
+	for (const model::Track& track : tracks.getAll())
+	{
+		if (track.findChannel(channelId) != nullptr)
+			source = &track;
+		if (!track.isInternal() && track.getGroupChannel().id == returnId)
+			target = &track;
+	}
+
+	if (source == nullptr || target == nullptr || source == target || source->isInternal())
+		return false;
+
+	/* No chains of return buses: this also rules out feedback loops. */
+
+	return !source->isReturn() && !target->hasSends();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void ChannelManager::setSend(ID channelId, ID returnId, float value)
+{
+	if (!canSend(channelId, returnId))
+		return;
+
+	Channel&    ch    = m_model.get().tracks.getChannel(channelId);
+	const float level = std::clamp(value, 0.0f, G_MAX_VOLUME);
+
+	std::erase_if(ch.sends, [returnId](const Send& send)
+	{ return send.returnId == returnId; });
+	if (level > 0.0f)
+		ch.sends.push_back({returnId, level});
+	m_model.get().tracks.updateReturns();
+
+	m_model.swap(model::SwapType::SOFT);
+}
+
+/* -------------------------------------------------------------------------- */
+
 void ChannelManager::loadWaveInPreviewChannel(ID channelId)
 {
 	Channel&       previewCh = m_model.get().tracks.getChannel(Mixer::PREVIEW_CHANNEL_ID);
@@ -449,6 +550,7 @@ void ChannelManager::loadWaveInPreviewChannel(ID channelId)
 	previewCh.sampleChannel->begin = sourceCh.sampleChannel->begin;
 	previewCh.sampleChannel->end   = sourceCh.sampleChannel->end;
 	previewCh.sampleChannel->pitch = sourceCh.sampleChannel->pitch;
+	previewCh.shared->pitch.store(sourceCh.sampleChannel->pitch);
 
 	m_model.swap(model::SwapType::SOFT);
 }
@@ -560,13 +662,6 @@ void ChannelManager::loadSampleChannel(Channel& ch, Wave* w, Frame begin, Frame
 
 void ChannelManager::setupChannelCallbacks(const Channel& ch, ChannelShared& shared) const
 {
-	assert(onChannelPlayStatusChanged != nullptr);
-
-	shared.playStatus.onChange = [this, id = ch.id](ChannelStatus status)
-	{
-		onChannelPlayStatusChanged(id, status);
-	};
-
 	if (ch.type == ChannelType ::SAMPLE)
 	{
 		shared.quantizer->schedule(Q_ACTION_PLAY + ch.id, [&shared](Frame delta)
@@ -612,7 +707,7 @@ void ChannelManager::setupChannelPostRecording(Channel& ch, Frame currentFrame)
 
 /* -------------------------------------------------------------------------- */
 
-void ChannelManager::recordChannel(Channel& ch, const mcl::AudioBuffer& buffer, Frame recordedFrames, Frame currentFrame)
+void ChannelManager::recordChannel(Channel& ch, const RecBuffer& buffer, Frame recordedFrames, Frame currentFrame)
 {
 	assert(onChannelRecorded != nullptr);
 
@@ -620,9 +715,10 @@ void ChannelManager::recordChannel(Channel& ch, const mcl::AudioBuffer& buffer,
 
 	G_DEBUG("Created new Wave, size={}", wave->getBuffer().countFrames());
 
-	/* Copy up to wave.getSize() from the mixer's input buffer into wave's. */
+	/* Copy up to wave.getSize() from the mixer's input buffer into wave's, one
+	chunk at a time. */
 
-	wave->getBuffer().set(buffer, wave->getBuffer().countFrames());
+	buffer.copyTo(wave->getBuffer());
 
 	/* Update channel with the new Wave. */
 
@@ -634,7 +730,7 @@ void ChannelManager::recordChannel(Channel& ch, const mcl::AudioBuffer& buffer,
 
 /* -------------------------------------------------------------------------- */
 
-void ChannelManager::overdubChannel(Channel& ch, const mcl::AudioBuffer& buffer, Frame currentFrame)
+void ChannelManager::overdubChannel(Channel& ch, const RecBuffer& buffer, Frame currentFrame)
 {
 	Wave* wave = ch.sampleChannel->getWave();
 
@@ -643,7 +739,7 @@ void ChannelManager::overdubChannel(Channel& ch, const mcl::AudioBuffer& buffer,
 
 	model::SharedLock lock = m_model.lockShared();
 
-	wave->getBuffer().sum(buffer, /*gain=*/1.0f);
+	buffer.sumTo(wave->getBuffer());
 	wave->setLogical(true);
 
 	setupChannelPostRecording(ch, currentFrame);
@@ -55,6 +55,7 @@ class MidiEvent;
 class Engine;
 class ActionRecorder;
 class KernelMidi;
+class RecBuffer;
 class ChannelManager final
 {
 public:
@@ -92,6 +93,13 @@ public:
 
 	bool canRemoveTrack(std::size_t trackIndex) const;
 
+	/* canSend
+	True if the channel can send to the given return bus, i.e. the Group Channel
+	of another track. Returns are one level deep: a track can't be a return bus
+	and send to other return buses at the same time. */
+
+	bool canSend(ID channelId, ID returnId) const;
+
 	float getMasterInVol() const;
 	float getMasterOutVol() const;
 
@@ -120,6 +128,18 @@ public:
 
 	void setTrackWidth(std::size_t trackIndex, int width);
 
+	/* freezeTrack
+	Replaces the rendering of a track with the given Wave, i.e. the track's
+	output rendered offline. Plug-ins in the track are suspended. */
+
+	void freezeTrack(std::size_t trackIndex, std::unique_ptr<Wave>);
+
+	/* unfreezeTrack
+	Brings back the regular rendering of a frozen track and removes its frozen
+	Wave. */
+
+	void unfreezeTrack(std::size_t trackIndex);
+
 	/* addChannel
 	Adds a new channel to the stack. */
 
@@ -154,7 +174,7 @@ public:
 	Fills armed Sample channel with audio data coming from an input recording
 	session. */
 
-	void finalizeInputRec(const mcl::AudioBuffer&, Frame recordedFrames, Frame currentFrame);
+	void finalizeInputRec(const RecBuffer&, Frame recordedFrames, Frame currentFrame);
 
 	void setInputMonitor(ID channelId, bool value);
 	void setVolume(ID channelId, float value);
@@ -166,6 +186,12 @@ public:
 	void setOverdubProtection(ID channelId, bool value);
 	void setSamplePlayerMode(ID channelId, SamplePlayerMode);
 	void setHeight(ID channelId, Pixel height);
+
+	/* setSend
+	Sets the send level from a channel to a return bus. A zero level removes the
+	send. Does nothing if canSend() is false. */
+
+	void setSend(ID channelId, ID returnId, float level);
 	void loadWaveInPreviewChannel(ID sourceChannelId);
 	void freeWaveInPreviewChannel();
 	void setPreviewTracker(Frame f);
@@ -191,11 +217,6 @@ public:
 
 	std::function<std::unique_ptr<Wave>(Frame)> onChannelRecorded;
 
-	/* onChannelPlayStatusChanged
-	Fired when the play status of a Sample channel has changed. */
-
-	std::function<void(ID, ChannelStatus)> onChannelPlayStatusChanged;
-
 private:
 	void loadSampleChannel(Channel&, Wave*, Frame begin = -1, Frame end = -1, Frame shift = -1) const;
 
@@ -216,13 +237,13 @@ private:
 	/* recordChannel
 	Records the current Mixer audio input data into an empty channel. */
 
-	void recordChannel(Channel&, const mcl::AudioBuffer&, Frame recordedFrames, Frame currentFrame);
+	void recordChannel(Channel&, const RecBuffer&, Frame recordedFrames, Frame currentFrame);
 
 	/* overdubChannel
 	Records the current Mixer audio input data into a channel with an existing
 	Wave, overdub mode. */
 
-	void overdubChannel(Channel&, const mcl::AudioBuffer&, Frame currentFrame);
+	void overdubChannel(Channel&, const RecBuffer&, Frame currentFrame);
 
 	void triggerOnChannelsAltered();
 
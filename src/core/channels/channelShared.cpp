@@ -31,7 +31,11 @@ namespace giada::m
 ChannelShared::ChannelShared(ID id, Frame bufferSize)
 : id(id)
 , audioBuffer(bufferSize, G_MAX_IO_CHANS)
+, delayLine(G_MAX_PLUGIN_LATENCY, G_MAX_IO_CHANS)
+, returnBuffer(bufferSize, G_MAX_IO_CHANS)
 {
+	playStatus.publishTo(dirty, DIRTY_PLAY_STATUS);
+	midiBuffer.ensureSize(G_MIDI_BUFFER_BYTES);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -48,5 +52,42 @@ bool ChannelShared::isReadingActions() const
 void ChannelShared::setBufferSize(int bufferSize)
 {
 	audioBuffer.alloc(bufferSize, audioBuffer.countChannels());
+	returnBuffer.alloc(bufferSize, returnBuffer.countChannels());
+}
+
+/* -------------------------------------------------------------------------- */
+
+ChannelShared::RenderState ChannelShared::saveRenderState() const
+{
+	return {tracker.load(), playStatus.load(), lastGainL, lastGainR, envelopeGain, delayLine};
+}
+
+/* -------------------------------------------------------------------------- */
+
+void ChannelShared::restoreRenderState(const RenderState& state)
+{
+	resetRenderState();
+
+	tracker.store(state.tracker);
+	playStatus.store(state.playStatus);
+	lastGainL    = state.lastGainL;
+	lastGainR    = state.lastGainR;
+	envelopeGain = state.envelopeGain;
+	delayLine    = state.delayLine;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void ChannelShared::resetRenderState()
+{
+	lastGainL    = -1.0f;
+	lastGainR    = -1.0f;
+	envelopeGain = G_DEFAULT_VOL;
+	delayLine.clear();
+	paramChanges.clear();
+	if (quantizer)
+		quantizer->clear();
+	if (resampler)
+		resampler->reset();
 }
 } // namespace giada::m
\ No newline at end of file
@@ -28,10 +28,14 @@
 #define G_CHANNELSHARED_H
 
 #include "core/const.h"
+#include "core/delayLine.h"
+#include "core/dirtyFlags.h"
 #include "core/midiEvent.h"
 #include "core/quantizer.h"
 #include "core/rendering/sampleRendering.h"
 #include "core/resampler.h"
+#include "core/ringBuffer.h"
+#include "core/types.h"
 #include "deps/concurrentqueue/concurrentqueue.h"
 #include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
 #include <juce_audio_basics/juce_audio_basics.h>
@@ -41,8 +45,30 @@ namespace giada::m
 {
 struct ChannelShared final
 {
-	using MidiQueue   = moodycamel::ConcurrentQueue<MidiEvent>;
-	using RenderQueue = moodycamel::ConcurrentQueue<rendering::RenderInfo>;
+	using MidiQueue    = moodycamel::ConcurrentQueue<MidiEvent>;
+	using RenderQueue  = moodycamel::ConcurrentQueue<rendering::RenderInfo>;
+	using ParamChanges = RingBuffer<PluginParamChange, G_MAX_PARAM_CHANGES>;
+
+	/* Dirty bits published when the corresponding shared state changes. See
+	StateObserver. */
+
+	static constexpr DirtyFlags::Mask DIRTY_PLAY_STATUS = 1 << 0;
+
+	/* RenderState
+	Copy of the playback and rendering state below. Lets a non-realtime thread
+	render the channel offline (e.g. when freezing a track) and put it back as
+	it was afterwards. Resampler and quantizer can't be copied: they are reset
+	instead. */
+
+	struct RenderState
+	{
+		Frame         tracker;
+		ChannelStatus playStatus;
+		float         lastGainL;
+		float         lastGainR;
+		float         envelopeGain;
+		DelayLine     delayLine;
+	};
 
 	ChannelShared(ID, Frame bufferSize);
 
@@ -53,11 +79,25 @@ struct ChannelShared final
 
 	void setBufferSize(int);
 
+	/* saveRenderState, restoreRenderState
+	Not realtime-safe: the audio thread must stay away from this channel. */
+
+	RenderState saveRenderState() const;
+	void        restoreRenderState(const RenderState&);
+
+	/* resetRenderState
+	Brings resampler, quantizer, delay line, gains and pending plug-in parameter
+	changes back to their initial state. Playback state (tracker and status) is
+	left untouched. Realtime-safe. */
+
+	void resetRenderState();
+
 	ID id; // Must match the corresponding Channel ID
 
 	mcl::AudioBuffer audioBuffer;
-	juce::MidiBuffer midiBuffer;
+	juce::MidiBuffer midiBuffer; // Preallocated, see G_MAX_MIDI_EVENTS
 	MidiQueue        midiQueue{/*size=*/32, 0, /*num_threads=*/8}; // TODO - maximum 8 MIDI threads for now
+	DirtyFlags       dirty;
 
 	WeakAtomic<Frame>         tracker        = 0;
 	WeakAtomic<ChannelStatus> playStatus     = ChannelStatus::OFF;
@@ -65,6 +105,47 @@ struct ChannelShared final
 	WeakAtomic<bool>          readActions    = false;
 	WeakAtomic<float>         volumeInternal = G_DEFAULT_VOL; // Used for velocity-drives-volume mode on Sample Channels
 
+	/* Parameter lanes for continuous controls. Written from any thread with a
+	single atomic store and read by the real-time thread once per block. The
+	corresponding values in the Document (Channel::volume, Channel::pan and
+	SampleChannel::pitch) are kept in sync for storage and UI purposes only. */
+
+	WeakAtomic<float> volume = G_DEFAULT_VOL;
+	WeakAtomic<float> pan    = G_DEFAULT_PAN;
+	WeakAtomic<float> pitch  = G_DEFAULT_PITCH;
+
+	/* Left and right gains applied to the previous audio block. Real-time
+	thread only: used to ramp towards new volume/pan values without zipper
+	noise. Negative values mean 'no previous block'. */
+
+	float lastGainL = -1.0f;
+	float lastGainR = -1.0f;
+
+	/* Gain of the volume envelope at the end of the current block. Real-time
+	thread only: applied together with volume and pan, so that the ramp from
+	the previous block follows the envelope. */
+
+	float envelopeGain = G_DEFAULT_VOL;
+
+	/* Plug-in delay compensation. Real-time thread only: delays the output of
+	this channel to line it up with slower paths (i.e. ones with more plug-in
+	latency). */
+
+	DelayLine delayLine;
+
+	/* Return bus. Real-time thread only: collects the sends pointing to this
+	channel in the current block. Only used by Group Channels of tracks acting
+	as return buses, but preallocated for all channels so that no allocation
+	takes place when a send is added. */
+
+	mcl::AudioBuffer returnBuffer;
+
+	/* Plug-in parameter automation. Real-time thread only: changes read from
+	the recorded actions while advancing the channel, sorted by frame, applied
+	when its plug-ins are processed in the same block. */
+
+	ParamChanges paramChanges;
+
 	std::optional<Quantizer> quantizer;
 
 	/* Optional render queue for sample-based channels. Used by callers on thread
@@ -54,8 +54,17 @@ struct Conf final
 	int                samplerate       = G_DEFAULT_SAMPLERATE;
 	int                buffersize       = G_DEFAULT_BUFSIZE;
 	bool               limitOutput      = false;
+	bool               renderAhead      = false;
 	Resampler::Quality rsmpQuality      = Resampler::Quality::SINC_BEST;
 
+	/* virtualAudio[...]
+	Settings for the built-in virtual audio device, used when soundSystem is
+	RTAUDIO_DUMMY. See VirtualAudioDevice. */
+
+	std::string virtualAudioInput     = "";
+	std::string virtualAudioOutput    = "";
+	bool        virtualAudioFreewheel = false;
+
 	RtMidi::Api midiSystem  = G_DEFAULT_MIDI_API;
 	int         midiPortOut = G_DEFAULT_MIDI_PORT_OUT;
 	int         midiPortIn  = G_DEFAULT_MIDI_PORT_IN;
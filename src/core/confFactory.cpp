@@ -76,7 +76,11 @@ bool serialize(const Conf& conf)
 	j[CONF_KEY_SAMPLERATE]                    = conf.samplerate;
 	j[CONF_KEY_BUFFER_SIZE]                   = conf.buffersize;
 	j[CONF_KEY_LIMIT_OUTPUT]                  = conf.limitOutput;
+	j[CONF_KEY_RENDER_AHEAD]                  = conf.renderAhead;
 	j[CONF_KEY_RESAMPLE_QUALITY]              = conf.rsmpQuality;
+	j[CONF_KEY_VIRTUAL_AUDIO_INPUT]           = conf.virtualAudioInput;
+	j[CONF_KEY_VIRTUAL_AUDIO_OUTPUT]          = conf.virtualAudioOutput;
+	j[CONF_KEY_VIRTUAL_AUDIO_FREEWHEEL]       = conf.virtualAudioFreewheel;
 	j[CONF_KEY_MIDI_SYSTEM]                   = conf.midiSystem;
 	j[CONF_KEY_MIDI_PORT_OUT]                 = conf.midiPortOut;
 	j[CONF_KEY_MIDI_PORT_IN]                  = conf.midiPortIn;
@@ -191,7 +195,11 @@ Conf deserialize()
 	conf.samplerate                 = j.value(CONF_KEY_SAMPLERATE, conf.samplerate);
 	conf.buffersize                 = j.value(CONF_KEY_BUFFER_SIZE, conf.buffersize);
 	conf.limitOutput                = j.value(CONF_KEY_LIMIT_OUTPUT, conf.limitOutput);
+	conf.renderAhead                = j.value(CONF_KEY_RENDER_AHEAD, conf.renderAhead);
 	conf.rsmpQuality                = j.value(CONF_KEY_RESAMPLE_QUALITY, conf.rsmpQuality);
+	conf.virtualAudioInput          = j.value(CONF_KEY_VIRTUAL_AUDIO_INPUT, conf.virtualAudioInput);
+	conf.virtualAudioOutput         = j.value(CONF_KEY_VIRTUAL_AUDIO_OUTPUT, conf.virtualAudioOutput);
+	conf.virtualAudioFreewheel      = j.value(CONF_KEY_VIRTUAL_AUDIO_FREEWHEEL, conf.virtualAudioFreewheel);
 	conf.midiSystem                 = j.value(CONF_KEY_MIDI_SYSTEM, conf.midiSystem);
 	conf.midiPortOut                = j.value(CONF_KEY_MIDI_PORT_OUT, conf.midiPortOut);
 	conf.midiPortIn                 = j.value(CONF_KEY_MIDI_PORT_IN, conf.midiPortIn);
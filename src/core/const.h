@@ -74,6 +74,24 @@ The rate at which KernelMidi spits out MIDI events. Note: this value will
 obviously increase the MIDI output latency, keep it small!*/
 constexpr int G_KERNEL_MIDI_OUTPUT_RATE_MS = 3;
 
+/* G_RENDER_AHEAD_MS, G_RENDER_AHEAD_RATE_MS
+How much audio non-interactive tracks are rendered ahead of the audio thread,
+and the sleep between each cycle of the worker thread that renders them. The
+rate must be well below the duration of an audio block. */
+constexpr int G_RENDER_AHEAD_MS      = 10;
+constexpr int G_RENDER_AHEAD_RATE_MS = 1;
+
+/* G_REC_BUFFER_REFILL_RATE_MS
+The sleep between each cycle of the worker thread that allocates new memory for
+input recording. Must be well below the duration of the chunks kept ready for
+the audio thread (see RecBuffer). */
+constexpr int G_REC_BUFFER_REFILL_RATE_MS = 50;
+
+/* G_PLUGIN_SCAN_TIMEOUT_MS
+How long a plug-in scanner process can take to probe a single file before being
+killed. Files that time out are blocklisted. */
+constexpr int G_PLUGIN_SCAN_TIMEOUT_MS = 30000;
+
 /* -- GUI ------------------------------------------------------------------- */
 constexpr int   G_GUI_FPS            = 30;
 constexpr float G_GUI_REFRESH_RATE   = 1 / static_cast<float>(G_GUI_FPS);
@@ -99,6 +117,7 @@ constexpr int   G_GUI_ZOOM_FACTOR    = 2;
 constexpr float G_MIN_BPM               = 20.0f;
 constexpr float G_MAX_BPM               = 999.0f;
 constexpr int   G_MAX_BEATS             = 32;
+constexpr int   G_PPQ                   = 960000;                 // Ticks per beat, more than frames in a beat at any tempo and rate
 constexpr int   G_MAX_BARS              = 32;
 constexpr int   G_MAX_QUANTIZE          = 8;
 constexpr float G_MIN_DB_SCALE          = 60.0f;
@@ -114,8 +133,13 @@ constexpr int   G_MAX_VELOCITY          = 0x7F;
 constexpr float G_MAX_VELOCITY_FLOAT    = 1.0f;
 constexpr int   G_MAX_MIDI_CHANS        = 16;
 constexpr int   G_MAX_DISPATCHER_EVENTS = 32;
-constexpr int   G_MAX_SEQUENCER_EVENTS  = 128;  // Per block
-constexpr float G_MIN_UI_SCALING        = 0.0f; // Auto: FLTK will figure it out
+constexpr int   G_MAX_SEQUENCER_EVENTS  = 128;                    // Per block
+constexpr int   G_MAX_MIDI_EVENTS       = 256;                    // Per channel, per block
+constexpr int   G_MIDI_BUFFER_BYTES     = G_MAX_MIDI_EVENTS * 12; // Short messages plus JUCE's per-event header
+constexpr int   G_MAX_PLUGIN_LATENCY    = 16384;                  // Frames, the most plug-in delay compensation can make up for
+constexpr int   G_MAX_PARAM_CHANGES     = 256;                    // Plug-in parameter changes, per channel, per block
+constexpr int   G_MIN_PARAM_SEGMENT     = 32;                     // Frames, changes closer than this are applied together
+constexpr float G_MIN_UI_SCALING        = 0.0f;                   // Auto: FLTK will figure it out
 constexpr float G_MAX_UI_SCALING        = 4.0f;
 
 /* -- default values -------------------------------------------------------- */
@@ -292,6 +316,9 @@ constexpr auto PATCH_KEY_CHANNEL_MIDI_OUT_CHAN        = "midi_out_chan";
 constexpr auto PATCH_KEY_CHANNEL_PLUGINS              = "plugins";
 constexpr auto PATCH_KEY_CHANNEL_PLUGIN_ID            = "plugin_id";
 constexpr auto PATCH_KEY_CHANNEL_ARMED                = "armed";
+constexpr auto PATCH_KEY_CHANNEL_SENDS                = "sends";
+constexpr auto PATCH_KEY_CHANNEL_SEND_RETURN_ID       = "return_id";
+constexpr auto PATCH_KEY_CHANNEL_SEND_LEVEL           = "level";
 constexpr auto PATCH_KEY_WAVES                        = "waves";
 constexpr auto PATCH_KEY_WAVE_ID                      = "id";
 constexpr auto PATCH_KEY_WAVE_PATH                    = "path";
@@ -305,16 +332,21 @@ constexpr auto PATCH_KEY_PLUGIN_PATH                  = "path";
 constexpr auto PATCH_KEY_PLUGIN_BYPASS                = "bypass";
 constexpr auto PATCH_KEY_PLUGIN_PARAMS                = "params";
 constexpr auto PATCH_KEY_PLUGIN_STATE                 = "state";
+constexpr auto PATCH_KEY_PLUGIN_STATE_PATH            = "state_path";
 constexpr auto PATCH_KEY_PLUGIN_MIDI_IN_PARAMS        = "midi_in_params";
 constexpr auto PATCH_KEY_TRACK_WIDTH                  = "width";
 constexpr auto PATCH_KEY_TRACK_INTERNAL               = "internal";
 constexpr auto PATCH_KEY_TRACK_CHANNELS               = "channels";
+constexpr auto PATCH_KEY_TRACK_FROZEN_WAVE            = "frozen_wave";
 constexpr auto G_PATCH_KEY_ACTION_ID                  = "id";
 constexpr auto G_PATCH_KEY_ACTION_CHANNEL             = "channel";
 constexpr auto G_PATCH_KEY_ACTION_FRAME               = "frame";
 constexpr auto G_PATCH_KEY_ACTION_EVENT               = "event";
 constexpr auto G_PATCH_KEY_ACTION_PREV                = "prev";
 constexpr auto G_PATCH_KEY_ACTION_NEXT                = "next";
+constexpr auto G_PATCH_KEY_ACTION_PLUGIN              = "plugin";
+constexpr auto G_PATCH_KEY_ACTION_PLUGIN_PARAM        = "plugin_param";
+constexpr auto G_PATCH_KEY_ACTION_VALUE               = "value";
 
 /* JSON config keys */
 
@@ -333,7 +365,11 @@ constexpr auto CONF_KEY_SAMPLERATE                    = "samplerate";
 constexpr auto CONF_KEY_BUFFER_SIZE                   = "buffer_size";
 constexpr auto CONF_KEY_DELAY_COMPENSATION            = "delay_compensation";
 constexpr auto CONF_KEY_LIMIT_OUTPUT                  = "limit_output";
+constexpr auto CONF_KEY_RENDER_AHEAD                  = "render_ahead";
 constexpr auto CONF_KEY_RESAMPLE_QUALITY              = "resample_quality";
+constexpr auto CONF_KEY_VIRTUAL_AUDIO_INPUT           = "virtual_audio_input";
+constexpr auto CONF_KEY_VIRTUAL_AUDIO_OUTPUT          = "virtual_audio_output";
+constexpr auto CONF_KEY_VIRTUAL_AUDIO_FREEWHEEL       = "virtual_audio_freewheel";
 constexpr auto CONF_KEY_MIDI_SYSTEM                   = "midi_system";
 constexpr auto CONF_KEY_MIDI_PORT_OUT                 = "midi_port_out";
 constexpr auto CONF_KEY_MIDI_PORT_IN                  = "midi_port_in";
@@ -0,0 +1,118 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/delayLine.h"
+#include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace giada::m
+{
+DelayLine::DelayLine(Frame maxDelay, int channels)
+: m_data((maxDelay + 1) * channels, 0.0f)
+, m_size(maxDelay + 1)
+, m_channels(channels)
+, m_write(0)
+, m_delay(0)
+, m_idle(true)
+{
+	assert(maxDelay >= 0);
+	assert(channels > 0);
+}
+
+/* -------------------------------------------------------------------------- */
+
+Frame DelayLine::getDelay() const { return m_delay; }
+Frame DelayLine::getMaxDelay() const { return m_size - 1; }
+
+/* -------------------------------------------------------------------------- */
+
+void DelayLine::process(mcl::AudioBuffer& buf, Frame delay)
+{
+	delay = std::clamp(delay, 0, getMaxDelay());
+
+	/* Fast path: no delay now nor in the previous block. */
+
+	if (delay == 0 && m_delay == 0)
+	{
+		m_idle = true;
+		return;
+	}
+
+	/* Coming back from idle: what's in the ring is stale. Start from silence,
+	as if the path had been delayed all along. */
+
+	if (m_idle)
+	{
+		std::fill(m_data.begin(), m_data.end(), 0.0f);
+		m_idle = false;
+	}
+
+	const Frame frames   = buf.countFrames();
+	const int   channels = std::min(buf.countChannels(), m_channels);
+	const Frame oldDelay = m_delay;
+
+	for (Frame i = 0; i < frames; i++)
+	{
+		for (int j = 0; j < channels; j++)
+			at(m_write, j) = buf[i][j];
+
+		const Frame newPos = (m_write - delay + m_size) % m_size;
+
+		if (oldDelay == delay)
+		{
+			for (int j = 0; j < channels; j++)
+				buf[i][j] = at(newPos, j);
+		}
+		else
+		{
+			const Frame oldPos = (m_write - oldDelay + m_size) % m_size;
+			const float t      = static_cast<float>(i) / frames;
+			for (int j = 0; j < channels; j++)
+				buf[i][j] = at(oldPos, j) * (1.0f - t) + at(newPos, j) * t;
+		}
+
+		m_write = (m_write + 1) % m_size;
+	}
+
+	m_delay = delay;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void DelayLine::clear()
+{
+	std::fill(m_data.begin(), m_data.end(), 0.0f);
+	m_write = 0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+float& DelayLine::at(Frame frame, int channel)
+{
+	return m_data[frame * m_channels + channel];
+}
+} // namespace giada::m
@@ -0,0 +1,83 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_DELAY_LINE_H
+#define G_DELAY_LINE_H
+
+#include "core/types.h"
+#include <vector>
+
+namespace mcl
+{
+class AudioBuffer;
+}
+
+namespace giada::m
+{
+/* DelayLine
+Delays interleaved audio by a variable amount of frames, up to a fixed maximum.
+Used for plug-in delay compensation. Memory is allocated once on construction,
+so process() is realtime-safe. When the delay changes, the signals delayed by
+the old and the new amount are crossfaded over one block to avoid clicks. */
+
+class DelayLine final
+{
+public:
+	DelayLine(Frame maxDelay, int channels);
+
+	/* process
+	Delays the content of 'buf' in place by 'delay' frames, clamped to the
+	maximum delay. */
+
+	void process(mcl::AudioBuffer& buf, Frame delay);
+
+	/* clear
+	Empties the ring, keeping the current delay: the next block starts from
+	silence. */
+
+	void clear();
+
+	Frame getDelay() const;
+	Frame getMaxDelay() const;
+
+private:
+	float& at(Frame frame, int channel);
+
+	std::vector<float> m_data; // Interleaved ring of m_size frames
+	Frame              m_size;
+	int                m_channels;
+	Frame              m_write;
+	Frame              m_delay;
+
+	/* m_idle
+	True while the delay is 0: the ring is not fed in the meantime, and gets
+	cleared when a delay is set again. */
+
+	bool m_idle;
+};
+} // namespace giada::m
+
+#endif
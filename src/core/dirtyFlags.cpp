@@ -0,0 +1,57 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/dirtyFlags.h"
+
+namespace giada
+{
+std::atomic<uint64_t> DirtyFlags::s_sequence = 0;
+
+/* -------------------------------------------------------------------------- */
+
+uint64_t DirtyFlags::getSequence()
+{
+	return s_sequence.load(std::memory_order_acquire);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void DirtyFlags::set(Mask mask)
+{
+	/* Publish the bits first, then the sequence number: an observer that sees
+	the new sequence will also see the bits. */
+
+	m_mask.fetch_or(mask, std::memory_order_relaxed);
+	s_sequence.fetch_add(1, std::memory_order_release);
+}
+
+/* -------------------------------------------------------------------------- */
+
+DirtyFlags::Mask DirtyFlags::consume()
+{
+	return m_mask.exchange(0, std::memory_order_relaxed);
+}
+} // namespace giada
@@ -0,0 +1,71 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_DIRTY_FLAGS_H
+#define G_DIRTY_FLAGS_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace giada
+{
+/* DirtyFlags
+Lock-free change publication for state shared with the realtime thread. Writers
+(the realtime thread included) mark bits as dirty with set(); a non-realtime
+observer collects and clears them with consume(). Every set() also bumps a
+global sequence number, so that observers can skip scanning when nothing has
+changed since their last visit. Both operations are wait-free and don't
+allocate. */
+
+class DirtyFlags
+{
+public:
+	using Mask = uint32_t;
+
+	/* getSequence
+	Returns the global sequence number, incremented on each set() call on any
+	DirtyFlags object. */
+
+	static uint64_t getSequence();
+
+	/* set
+	Marks the given bits as dirty. Realtime-safe. */
+
+	void set(Mask);
+
+	/* consume
+	Returns the current dirty bits and clears them. */
+
+	Mask consume();
+
+private:
+	static std::atomic<uint64_t> s_sequence;
+
+	std::atomic<Mask> m_mask = 0;
+};
+} // namespace giada
+
+#endif
@@ -25,15 +25,23 @@
  * -------------------------------------------------------------------------- */
 
 #include "core/engine.h"
+#include "core/actions/liveActionBuffer.h"
 #include "core/conf.h"
 #include "core/confFactory.h"
+#include "core/const.h"
 #include "core/model/model.h"
 #include "core/rendering/midiOutput.h"
+#include "core/virtualAudioDevice.h"
+#include "utils/alloc.h"
 #include "utils/fs.h"
 #include "utils/log.h"
 #include "utils/string.h"
+#include "utils/trace.h"
+#include <algorithm>
+#include <condition_variable>
 #include <fmt/core.h>
 #include <memory>
+#include <mutex>
 
 namespace giada::m
 {
@@ -44,25 +52,30 @@ Engine::Engine()
 , m_kernelAudio(m_model)
 , m_kernelMidi(m_model)
 , m_midiMapper(m_kernelMidi)
-, m_pluginHost(m_model)
+, m_pluginHost(m_model, m_profiler)
 , m_midiSynchronizer(m_kernelMidi)
 , m_sequencer(m_model, m_midiSynchronizer, m_jackTransport)
 , m_mixer(m_model)
 , m_actionRecorder(m_model)
 , m_channelManager(m_model, m_midiMapper, m_actionRecorder, m_kernelMidi)
 , m_recorder(m_sequencer, m_channelManager, m_mixer, m_actionRecorder)
+, m_stateObserver(m_model)
 , m_midiDispatcher(m_model)
+, m_triggerQueue(/*size=*/64, /*max_explicit_producers=*/0, /*max_implicit_producers=*/8)
+, m_aheadPluginHost(m_model, m_profiler)
 #ifdef WITH_AUDIO_JACK
-, m_renderer(m_sequencer, m_mixer, m_pluginHost, m_jackSynchronizer, m_jackTransport, m_kernelMidi)
+, m_renderer(m_sequencer, m_mixer, m_pluginHost, m_jackSynchronizer, m_jackTransport, m_kernelMidi, m_triggerQueue, m_renderAheadQueue, m_aheadPluginHost, m_profiler)
 #else
-, m_renderer(m_sequencer, m_mixer, m_pluginHost, m_kernelMidi)
+, m_renderer(m_sequencer, m_mixer, m_pluginHost, m_kernelMidi, m_triggerQueue, m_renderAheadQueue, m_aheadPluginHost, m_profiler)
 #endif
-, m_reactor(m_model, m_midiMapper, m_actionRecorder, m_kernelMidi)
-, m_mainApi(m_kernelAudio, m_mixer, m_sequencer, m_midiSynchronizer, m_channelManager, m_recorder, m_reactor)
-, m_channelsApi(m_model, m_kernelAudio, m_mixer, m_sequencer, m_channelManager, m_recorder, m_actionRecorder, m_pluginHost, m_pluginManager, m_reactor)
-, m_pluginsApi(m_kernelAudio, m_pluginManager, m_pluginHost, m_model)
+, m_reactor(m_model, m_midiMapper, m_actionRecorder, m_kernelMidi, m_triggerQueue)
+, m_renderAheadWorker(G_RENDER_AHEAD_RATE_MS)
+, m_recBufferWorker(G_REC_BUFFER_REFILL_RATE_MS)
+, m_mainApi(m_model, m_kernelAudio, m_mixer, m_sequencer, m_midiSynchronizer, m_channelManager, m_recorder, m_reactor, m_profiler, m_journal)
+, m_channelsApi(m_model, m_kernelAudio, m_mixer, m_sequencer, m_channelManager, m_recorder, m_actionRecorder, m_pluginHost, m_pluginManager, m_reactor, m_renderer, m_journal)
+, m_pluginsApi(m_kernelAudio, m_pluginManager, m_pluginHost, m_model, m_sequencer, m_recorder, m_actionRecorder, m_profiler)
 , m_sampleEditorApi(m_kernelAudio, m_model, m_channelManager)
-, m_actionEditorApi(*this, m_sequencer, m_actionRecorder)
+, m_actionEditorApi(*this, m_model, m_sequencer, m_actionRecorder)
 , m_ioApi(m_model, m_midiDispatcher)
 , m_storageApi(*this, m_model, m_pluginManager, m_midiSynchronizer, m_mixer, m_channelManager, m_kernelAudio, m_sequencer, m_actionRecorder)
 , m_configApi(m_model, m_kernelAudio, m_kernelMidi, m_midiMapper, m_midiSynchronizer)
@@ -70,12 +83,22 @@ Engine::Engine()
 	m_kernelAudio.onAudioCallback = [this](mcl::AudioBuffer& out, const mcl::AudioBuffer& in)
 	{
 		registerThread(Thread::AUDIO, /*realtime=*/true);
+		G_TRACE("audio callback");
+		m_midiTimestamper.onAudioBlock();
+		m_journal.onAudioBlock(in, out.countFrames());
+		const auto t0 = Profiler::now();
 		m_renderer.render(out, in, m_model);
+		m_profiler.recordRender(Profiler::now() - t0);
 		return 0;
 	};
+	m_kernelAudio.onXrun = [this](bool underflow, bool overflow)
+	{
+		m_profiler.recordXrun(underflow, overflow);
+	};
 	m_kernelAudio.onStreamAboutToOpen = [this]()
 	{
 		m_mixer.disable();
+		stopRenderAhead();
 	};
 	m_kernelAudio.onStreamOpened = [this]()
 	{
@@ -85,10 +108,13 @@ Engine::Engine()
 #endif
 		const int sampleRate = m_kernelAudio.getSampleRate();
 		const int bufferSize = m_kernelAudio.getBufferSize();
-		m_mixer.reset(m_sequencer.getMaxFramesInLoop(sampleRate), bufferSize);
+		m_mixer.reset(bufferSize);
 		m_channelManager.setBufferSize(bufferSize);
 		m_sequencer.setSampleRate(sampleRate);
 		m_pluginHost.setBufferSize(bufferSize);
+		m_midiTimestamper.reset(sampleRate, bufferSize);
+		m_profiler.setBlockPeriod(bufferSize, sampleRate);
+		startRenderAhead();
 		m_mixer.enable();
 	};
 
@@ -97,8 +123,16 @@ Engine::Engine()
 		assert(onMidiReceived != nullptr);
 
 		registerThread(Thread::MIDI, /*realtime=*/false);
-		m_midiDispatcher.dispatch(e);
-		m_midiSynchronizer.receive(e, m_sequencer.getBeats());
+
+		/* Place the event at the right frame offset in the next audio block, so
+		that live MIDI input is rendered sample-accurately. */
+
+		MidiEvent eWithDelta(e);
+		eWithDelta.setDelta(m_midiTimestamper.getFrameOffset(e.getTimestamp()));
+
+		const Journal::Scope journal = m_journal.record(Journal::makeMidiEvent(Journal::EventType::MIDI_IN, 0, eWithDelta));
+
+		processMidiIn(eWithDelta);
 		onMidiReceived();
 	};
 	m_kernelMidi.onMidiSent = [this]()
@@ -109,7 +143,7 @@ Engine::Engine()
 
 	m_midiDispatcher.onEventReceived = [this]()
 	{
-		m_recorder.startActionRecOnCallback();
+		m_mainApi.startActionRecOnCallback();
 	};
 
 	m_midiSynchronizer.onChangePosition = [this](int beat)
@@ -175,6 +209,7 @@ Engine::Engine()
 		m_eventDispatcher.pumpEvent([this]()
 		{
 			registerThread(Thread::EVENTS, /*realtime=*/false);
+			const model::Transaction transaction = m_model.beginTransaction();
 			m_recorder.startInputRecOnCallback();
 		});
 	};
@@ -184,19 +219,24 @@ Engine::Engine()
 			m_eventDispatcher.pumpEvent([this]()
 			{
 				registerThread(Thread::EVENTS, /*realtime=*/false);
-				m_recorder.stopInputRec(m_kernelAudio.getSampleRate());
+				m_mainApi.stopInputRecording();
 			});
 	};
 
-	m_channelManager.onChannelPlayStatusChanged = [this](ID channelId, ChannelStatus status)
+	/* Changes in the channels' shared state are published by the realtime thread
+	as dirty bits, then collected by the State Observer on the Event Dispatcher
+	thread. */
+
+	m_eventDispatcher.onProcess = [this]()
 	{
-		m_eventDispatcher.pumpEvent([this, channelId, status]()
-		{
-			registerThread(Thread::EVENTS, /*realtime=*/false);
-			const Channel& ch = m_model.get().tracks.getChannel(channelId);
-			if (ch.midiLightning.enabled)
-				rendering::sendMidiLightningStatus(ch.id, ch.midiLightning, status, /*isAudible=*/true /* TODO!!! */, m_midiMapper);
-		});
+		registerThread(Thread::EVENTS, /*realtime=*/false);
+		m_stateObserver.poll();
+	};
+	m_stateObserver.onChannelPlayStatusChanged = [this](ID channelId, ChannelStatus status)
+	{
+		const Channel* ch = m_model.get().tracks.findChannel(channelId);
+		if (ch != nullptr && ch->midiLightning.enabled)
+			rendering::sendMidiLightningStatus(ch->id, ch->midiLightning, status, /*isAudible=*/true /* TODO!!! */, m_midiMapper);
 	};
 
 	m_channelManager.onChannelsAltered = [this]()
@@ -226,14 +266,15 @@ Engine::Engine()
 		else if (m_mixer.isRecordingInput())
 			m_recorder.stopInputRec(m_kernelAudio.getSampleRate());
 	};
-	m_sequencer.onBpmChange = [this](float oldVal, float newVal, int quantizerStep)
-	{
-		m_actionRecorder.updateBpm(oldVal / newVal, quantizerStep);
-	};
 
 	m_model.onSwap = [this](model::SwapType t)
 	{
 		assert(onModelSwap != nullptr);
+
+		/* Anything might have changed: tracks rendered ahead go back to the
+		audio thread. */
+
+		m_renderAheadQueue.requestFlush();
 		onModelSwap(t);
 	};
 
@@ -263,11 +304,22 @@ void Engine::init(const Conf& conf)
 
 	m_kernelAudio.init();
 
-	m_mixer.reset(m_sequencer.getMaxFramesInLoop(m_kernelAudio.getSampleRate()), m_kernelAudio.getBufferSize());
+	m_mixer.reset(m_kernelAudio.getBufferSize());
 	m_channelManager.reset(m_kernelAudio.getBufferSize());
 	m_sequencer.reset(m_kernelAudio.getSampleRate());
 	m_pluginHost.reset(m_kernelAudio.getBufferSize());
 	m_pluginManager.reset();
+	m_midiTimestamper.reset(m_kernelAudio.getSampleRate(), m_kernelAudio.getBufferSize());
+	m_profiler.setBlockPeriod(m_kernelAudio.getBufferSize(), m_kernelAudio.getSampleRate());
+	startRenderAhead();
+
+	/* Input recording memory is allocated in the background, while the take
+	grows. */
+
+	m_recBufferWorker.start([this]()
+	{
+		m_mixer.refillRecBuffer();
+	});
 
 	m_mixer.enable();
 	m_kernelAudio.startStream();
@@ -299,11 +351,230 @@ void Engine::reset()
 	const int bufferSize = m_kernelAudio.getBufferSize();
 
 	m_model.reset();
-	m_mixer.reset(m_sequencer.getMaxFramesInLoop(sampleRate), bufferSize);
+	m_mixer.reset(bufferSize);
 	m_channelManager.reset(bufferSize);
 	m_sequencer.reset(sampleRate);
 	m_actionRecorder.reset();
 	m_pluginHost.reset(bufferSize);
+	m_profiler.reset();
+	m_profiler.releaseAllPlugins(); // Plug-ins are gone with the model reset
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Engine::processMidiIn(const MidiEvent& e)
+{
+	m_midiDispatcher.dispatch(e);
+	m_midiSynchronizer.receive(e, m_sequencer.getBeats());
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Engine::applyJournalEvent(const Journal::Event& e)
+{
+	using Type = Journal::EventType;
+
+	switch (e.type)
+	{
+	case Type::MIDI_IN:
+		processMidiIn(Journal::toMidiEvent(e));
+		break;
+	case Type::CHANNEL_PRESS:
+		m_channelsApi.press(e.channelId, e.value, e.arg1);
+		break;
+	case Type::CHANNEL_RELEASE:
+		m_channelsApi.release(e.channelId, e.arg1);
+		break;
+	case Type::CHANNEL_KILL:
+		m_channelsApi.kill(e.channelId, e.arg1);
+		break;
+	case Type::CHANNEL_VOLUME:
+		m_channelsApi.setVolume(e.channelId, e.value);
+		break;
+	case Type::CHANNEL_PITCH:
+		m_channelsApi.setPitch(e.channelId, e.value);
+		break;
+	case Type::CHANNEL_PAN:
+		m_channelsApi.setPan(e.channelId, e.value);
+		break;
+	case Type::CHANNEL_MUTE:
+		m_channelsApi.toggleMute(e.channelId);
+		break;
+	case Type::CHANNEL_SOLO:
+		m_channelsApi.toggleSolo(e.channelId);
+		break;
+	case Type::CHANNEL_READ_ACTIONS:
+		m_channelsApi.toggleReadActions(e.channelId);
+		break;
+	case Type::CHANNEL_KILL_READ_ACTIONS:
+		m_channelsApi.killReadActions(e.channelId);
+		break;
+	case Type::CHANNEL_MIDI:
+		m_channelsApi.sendMidi(e.channelId, Journal::toMidiEvent(e));
+		break;
+	case Type::MASTER_IN_VOLUME:
+		m_mainApi.setMasterInVolume(e.value);
+		break;
+	case Type::MASTER_OUT_VOLUME:
+		m_mainApi.setMasterOutVolume(e.value);
+		break;
+	case Type::BPM:
+		m_mainApi.setBpm(e.value);
+		break;
+	case Type::BEATS:
+		m_mainApi.setBeats(e.arg1, e.arg2);
+		break;
+	case Type::GO_TO_BEAT:
+		m_mainApi.goToBeat(e.arg1);
+		break;
+	case Type::SEQUENCER_START:
+		m_mainApi.startSequencer();
+		break;
+	case Type::SEQUENCER_STOP:
+		m_mainApi.stopSequencer();
+		break;
+	case Type::SEQUENCER_REWIND:
+		m_mainApi.rewindSequencer();
+		break;
+	case Type::QUANTIZE:
+		m_mainApi.setQuantize(e.arg1);
+		break;
+	case Type::METRONOME:
+		m_mainApi.toggleMetronome();
+		break;
+	case Type::ACTION_REC:
+		m_mainApi.toggleActionRecording();
+		break;
+	case Type::ACTION_REC_STOP:
+		m_mainApi.stopActionRecording();
+		break;
+	case Type::INPUT_REC:
+		m_mainApi.toggleInputRecording();
+		break;
+	case Type::INPUT_REC_STOP:
+		m_mainApi.stopInputRecording();
+		break;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Engine::replaySession(const std::string& journalPath, const std::string& outputPath)
+{
+	Journal::Data data = Journal::load(journalPath);
+	if (!data.valid)
+	{
+		u::log::print("[Engine::replaySession] Can't read journal from {}\n", journalPath);
+		return false;
+	}
+	if (m_journal.isCapturing())
+	{
+		u::log::print("[Engine::replaySession] Can't replay while capturing\n");
+		return false;
+	}
+	if (data.header.sampleRate != m_kernelAudio.getSampleRate() ||
+	    data.header.bufferSize != static_cast<int>(m_kernelAudio.getBufferSize()))
+	{
+		u::log::print("[Engine::replaySession] Audio settings mismatch: journal has {} Hz / {} frames\n",
+		    data.header.sampleRate, data.header.bufferSize);
+		return false;
+	}
+
+	/* Events coming from different threads might be slightly out of order in
+	the journal. */
+
+	std::stable_sort(data.events.begin(), data.events.end(),
+	    [](const Journal::Event& a, const Journal::Event& b)
+	{ return a.frame < b.frame; });
+
+	m_kernelAudio.stopStream();
+
+	/* Replays must be deterministic: all tracks are rendered by the audio
+	thread. */
+
+	m_renderer.suspendRenderAhead(m_model.get().tracks);
+
+	/* Bring the sequencer back to the state it had when the capture started. */
+
+	m_mainApi.stopSequencer();
+	m_mainApi.rewindSequencer();
+	m_mainApi.setBpm(data.header.bpm);
+	m_mainApi.setBeats(data.header.beats, data.header.bars);
+	m_mainApi.setQuantize(data.header.quantize);
+
+	const VirtualAudioDevice::Config config = {
+	    static_cast<unsigned int>(data.header.sampleRate),
+	    static_cast<unsigned int>(data.header.bufferSize),
+	    m_kernelAudio.getChannelsOutCount(),
+	    data.header.channelsIn,
+	    data.header.inputPath,
+	    outputPath,
+	    /*freewheel=*/true};
+
+	VirtualAudioDevice device;
+	if (!device.open(config, m_kernelAudio.getResamplerQuality()))
+	{
+		m_renderer.resumeRenderAhead();
+		m_kernelAudio.startStream();
+		return false;
+	}
+
+	/* Recorded events are applied right before rendering the block they were
+	received in, as it happens live, where any change lands on the next block
+	anyway. Events go through the API layer, which must run on this thread: the
+	processing thread hands each block over here and waits. Blocking is fine,
+	the device is in freewheel mode. The output file may end with a few blocks
+	of silence, rendered while the device is being closed. */
+
+	std::mutex              mutex;
+	std::condition_variable cond;
+	Frame                   frame   = 0;
+	bool                    pending = false;
+	bool                    done    = false;
+
+	device.onAudioCallback = [&](mcl::AudioBuffer& out, const mcl::AudioBuffer& in)
+	{
+		registerThread(Thread::AUDIO, /*realtime=*/true);
+		{
+			std::unique_lock lock(mutex);
+			if (done)
+				return 0;
+			pending = true;
+			cond.notify_one();
+			cond.wait(lock, [&pending] { return !pending; });
+		}
+		m_renderer.render(out, in, m_model);
+
+		std::scoped_lock lock(mutex);
+		frame += out.countFrames();
+		done = frame >= data.header.frames;
+		cond.notify_one();
+		return 0;
+	};
+
+	device.start();
+
+	std::size_t next = 0;
+	while (true)
+	{
+		std::unique_lock lock(mutex);
+		cond.wait(lock, [&pending, &done] { return pending || done; });
+		if (done)
+			break;
+		while (next < data.events.size() && data.events[next].frame <= frame)
+			applyJournalEvent(data.events[next++]);
+		pending = false;
+		cond.notify_one();
+	}
+
+	device.close();
+
+	m_renderer.resumeRenderAhead();
+	m_kernelAudio.startStream();
+
+	u::log::print("[Engine::replaySession] Replayed {} events over {} frames into {}\n",
+	    next, frame, outputPath);
+	return true;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -318,6 +589,14 @@ void Engine::shutdown(Conf& conf)
 		u::log::print("[Engine::shutdown] Mixer closed\n");
 	}
 
+	stopRenderAhead();
+	m_recBufferWorker.stop();
+
+#ifdef G_DEBUG_MODE
+	if (u::alloc::getViolations() > 0)
+		u::log::print("[Engine::shutdown] Warning: {} heap allocations in the render path!\n", u::alloc::getViolations());
+#endif
+
 	m_model.store(conf);
 
 	/* It's safer and cleaner to free all plug-ins before closing the app. Some
@@ -349,8 +628,49 @@ void Engine::debug()
 
 /* -------------------------------------------------------------------------- */
 
+void Engine::startRenderAhead()
+{
+	const int sampleRate = m_kernelAudio.getSampleRate();
+	const int bufferSize = m_kernelAudio.getBufferSize();
+
+	m_renderAheadQueue.reset(bufferSize, rendering::RenderAheadQueue::computeDepth(bufferSize, sampleRate));
+	m_aheadPluginHost.setBufferSize(bufferSize);
+	m_renderer.resumeRenderAhead();
+
+	if (!m_model.get().kernelAudio.renderAhead)
+		return;
+
+	m_renderAheadWorker.start([this]()
+	{
+		/* The worker reads the realtime Document: the model must treat it as a
+		realtime thread, so that swaps wait for it. */
+
+		registerThread(Thread::RENDER_AHEAD, /*realtime=*/true);
+		while (m_renderer.renderAhead(m_model))
+			;
+	});
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Engine::stopRenderAhead()
+{
+	m_renderAheadWorker.stop();
+	m_renderer.suspendRenderAhead(m_model.get().tracks);
+}
+
+/* -------------------------------------------------------------------------- */
+
 void Engine::registerThread(Thread t, bool isRealtime) const
 {
+	/* The MIDI thread is not realtime as far as the model is concerned, but
+	MIDI drivers call back on a time-critical thread: keep logging off the
+	output there too. */
+
+	u::log::registerThread(isRealtime || t == Thread::MIDI);
+	u::trace::registerThread(u::string::toString(t));
+	LiveActionBuffer::registerThread(t);
+
 	if (!m_model.registerThread(t, isRealtime))
 	{
 		u::log::print("[Engine::registerThread] Can't register thread {}! Aborting\n", u::string::toString(t));
@@ -41,19 +41,26 @@
 #include "core/eventDispatcher.h"
 #include "core/init.h"
 #include "core/jackTransport.h"
+#include "core/journal.h"
 #include "core/kernelAudio.h"
 #include "core/kernelMidi.h"
 #include "core/midiDispatcher.h"
 #include "core/midiMapper.h"
 #include "core/midiSynchronizer.h"
+#include "core/midiTimestamper.h"
 #include "core/mixer.h"
 #include "core/model/model.h"
 #include "core/plugins/pluginHost.h"
 #include "core/plugins/pluginManager.h"
+#include "core/profiler.h"
 #include "core/recorder.h"
 #include "core/sequencer.h"
+#include "core/stateObserver.h"
 #include "core/waveFactory.h"
+#include "core/worker.h"
 #include "src/core/rendering/reactor.h"
+#include "src/core/rendering/renderAheadQueue.h"
+#include "src/core/rendering/trigger.h"
 #include "src/core/rendering/renderer.h"
 #ifdef WITH_AUDIO_JACK
 #include "core/jackSynchronizer.h"
@@ -96,6 +103,16 @@ public:
 	void suspend();
 	void resume();
 
+	/* replaySession
+	Renders offline a capture made with MainApi::startSessionCapture, feeding
+	the recorded inputs back into the engine at the audio frame they were
+	received at. The result is written to the WAV file 'outputPath'. The
+	replay is meaningful only if the current project is the same one loaded
+	when the capture started. Blocks until done: the audio device is stopped
+	in the meantime. */
+
+	bool replaySession(const std::string& journalPath, const std::string& outputPath);
+
 #ifdef G_DEBUG_MODE
 	void debug();
 #endif
@@ -133,7 +150,28 @@ public:
 private:
 	void registerThread(Thread, bool isRealtime) const;
 
+	/* processMidiIn
+	Dispatches an incoming MIDI event, either live or replayed. */
+
+	void processMidiIn(const MidiEvent&);
+
+	/* applyJournalEvent
+	Feeds a recorded Journal event back into the API layer during a replay. */
+
+	void applyJournalEvent(const Journal::Event&);
+
+	/* [start|stop]RenderAhead
+	Prepares the render-ahead FIFOs for the current audio settings and starts
+	the worker thread that fills them, if enabled in the configuration. Stop
+	takes all tracks back to the audio thread. Call both only when the mixer is
+	disabled or the audio thread is stopped. */
+
+	void startRenderAhead();
+	void stopRenderAhead();
+
 	model::Model           m_model;
+	Profiler               m_profiler;
+	Journal                m_journal;
 	KernelAudio            m_kernelAudio;
 	KernelMidi             m_kernelMidi;
 	MidiMapper<KernelMidi> m_midiMapper;
@@ -147,12 +185,23 @@ private:
 	Recorder               m_recorder;
 	PluginManager          m_pluginManager;
 	EventDispatcher        m_eventDispatcher;
+	StateObserver          m_stateObserver;
 	MidiDispatcher         m_midiDispatcher;
+	MidiTimestamper        m_midiTimestamper;
 #ifdef WITH_AUDIO_JACK
 	JackSynchronizer m_jackSynchronizer;
 #endif
-	rendering::Renderer m_renderer;
-	rendering::Reactor  m_reactor;
+	rendering::TriggerQueue     m_triggerQueue;
+	rendering::RenderAheadQueue m_renderAheadQueue;
+	PluginHost                  m_aheadPluginHost;
+	rendering::Renderer         m_renderer;
+	rendering::Reactor          m_reactor;
+
+	/* m_renderAheadWorker, m_recBufferWorker
+	Declared after the components they use, so that they're stopped first. */
+
+	Worker m_renderAheadWorker;
+	Worker m_recBufferWorker;
 
 	MainApi         m_mainApi;
 	ChannelsApi     m_channelsApi;
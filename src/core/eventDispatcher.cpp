@@ -26,12 +26,14 @@
 
 #include "core/eventDispatcher.h"
 #include "core/const.h"
+#include "utils/trace.h"
 #include <cassert>
 
 namespace giada::m
 {
 EventDispatcher::EventDispatcher()
-: m_worker(G_EVENT_DISPATCHER_RATE_MS)
+: onProcess(nullptr)
+, m_worker(G_EVENT_DISPATCHER_RATE_MS)
 , m_eventQueue(G_MAX_DISPATCHER_EVENTS)
 {
 }
@@ -55,8 +57,13 @@ bool EventDispatcher::pumpEvent(const std::function<void()>& f)
 
 void EventDispatcher::process()
 {
+	G_TRACE("event dispatcher");
+
 	Event e;
 	while (m_eventQueue.try_dequeue(e))
 		e();
+
+	if (onProcess != nullptr)
+		onProcess();
 }
 } // namespace giada::m
\ No newline at end of file
@@ -58,6 +58,12 @@ public:
 
 	bool pumpEvent(const Event&);
 
+	/* onProcess
+	Callback fired on each processing cycle, after all pending events have been
+	consumed. Useful for polling state published by the realtime thread. */
+
+	std::function<void()> onProcess;
+
 private:
 	void process();
 
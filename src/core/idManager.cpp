@@ -47,7 +47,7 @@ ID IdManager::generate(ID id)
 {
 	if (id != 0)
 	{
-		m_id = id;
+		set(id);
 		return id;
 	}
 	return ++m_id;
@@ -43,8 +43,9 @@ public:
 
 	/* generate
 	Generates a new unique id. If 'id' parameter is passed in is valid, it just
-	returns it with no unique id generation. Useful when loading things from the
-	model that already have their own id. */
+	returns it with no unique id generation (the current id is updated as in
+	set()). Useful when loading things from the model that already have their
+	own id, in any order. */
 
 	ID generate(ID id = 0);
 
@@ -29,6 +29,7 @@
 #endif
 #include "core/confFactory.h"
 #include "core/engine.h"
+#include "core/plugins/pluginScanner.h"
 #include "gui/elems/mainWindow/keyboard/keyboard.h"
 #include "gui/elems/mainWindow/mainInput.h"
 #include "gui/elems/mainWindow/mainOutput.h"
@@ -39,11 +40,26 @@
 #define CATCH_CONFIG_RUNNER
 #include "tests/actionRecorder.cpp"
 #include "tests/channelFactory.cpp"
+#include "tests/channelManager.cpp"
+#include "tests/delayLine.cpp"
+#include "tests/dirtyFlags.cpp"
+#include "tests/journal.cpp"
 #include "tests/midiEvent.cpp"
 #include "tests/midiLightning.cpp"
+#include "tests/midiTimestamper.cpp"
+#include "tests/mixing.cpp"
 #include "tests/patch.cpp"
+#include "tests/pluginScanner.cpp"
+#include "tests/pluginState.cpp"
+#include "tests/profiler.cpp"
+#include "tests/reactor.cpp"
+#include "tests/recBuffer.cpp"
+#include "tests/renderAheadQueue.cpp"
 #include "tests/sampleRendering.cpp"
+#include "tests/sequencer.cpp"
+#include "tests/transaction.cpp"
 #include "tests/utils.cpp"
+#include "tests/virtualAudioDevice.cpp"
 #include "tests/wave.cpp"
 #include "tests/waveFactory.cpp"
 #include "tests/waveFx.cpp"
@@ -53,6 +69,7 @@
 #include <vector>
 #endif
 #include <FL/Fl.H>
+#include <cstring>
 
 extern giada::m::Engine* g_engine;
 extern giada::v::Ui*     g_ui;
@@ -106,6 +123,15 @@ int tests(int argc, char** argv)
 
 /* -------------------------------------------------------------------------- */
 
+int pluginScanner(int argc, char** argv)
+{
+	if (argc != 5 || strcmp(argv[1], PluginScanner::HELPER_ARG) != 0)
+		return -1;
+	return PluginScanner::runHelper(argv[2], argv[3], argv[4]);
+}
+
+/* -------------------------------------------------------------------------- */
+
 void startup()
 {
 	g_ui->dispatcher.onEventOccured = []()
@@ -35,6 +35,12 @@ Performs tests, if requested. Returns -1 if no tests are available or the
 
 int tests(int argc, char** argv);
 
+/* pluginScanner
+Runs Giada as a plug-in scanner helper process, if the PluginScanner::HELPER_ARG
+argument has been passed in. Returns -1 otherwise. */
+
+int pluginScanner(int argc, char** argv);
+
 void startup();
 void run();
 void shutdown();
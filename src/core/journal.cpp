@@ -0,0 +1,372 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/journal.h"
+#include "core/midiEvent.h"
+#include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include "utils/fs.h"
+#include "utils/log.h"
+#include "utils/time.h"
+#include <cassert>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <sndfile.h>
+
+namespace giada::m
+{
+namespace
+{
+constexpr auto JOURNAL_FILE = "journal.json";
+constexpr auto INPUT_FILE   = "input.wav";
+
+/* RING_SECONDS
+Seconds of audio input the ring buffer can hold before the writer thread drains
+it. Input blocks are dropped (and reported) if the writer falls behind. */
+
+constexpr int RING_SECONDS = 4;
+
+/* WRITER_SLEEP
+Milliseconds the writer thread waits between two drains. */
+
+constexpr int WRITER_SLEEP = 20;
+
+/* scopeDepth_
+Number of Journal::Scope objects alive on the current thread. */
+
+thread_local int scopeDepth_ = 0;
+
+/* -------------------------------------------------------------------------- */
+
+/* isValidEvent_
+True if 'jevent' is a journal entry: an array of 7 numbers. */
+
+bool isValidEvent_(const nlohmann::json& jevent)
+{
+	if (!jevent.is_array() || jevent.size() != 7)
+		return false;
+	for (const auto& field : jevent)
+		if (!field.is_number())
+			return false;
+	return true;
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Journal::Scope::Scope()
+{
+	scopeDepth_++;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Journal::Scope::~Scope()
+{
+	scopeDepth_--;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Journal::Event Journal::makeMidiEvent(EventType type, ID channelId, const MidiEvent& e)
+{
+	return {type, channelId, 0.0f, e.getNumBytes(), e.getDelta(), e.getRaw()};
+}
+
+/* -------------------------------------------------------------------------- */
+
+MidiEvent Journal::toMidiEvent(const Event& e)
+{
+	MidiEvent out = MidiEvent::makeFromRaw(e.midi, e.arg1);
+	out.setDelta(e.arg2);
+	return out;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Journal::Data Journal::load(const std::string& path)
+{
+	std::ifstream ifs(u::fs::join(path, JOURNAL_FILE));
+	if (!ifs.good())
+		return {};
+
+	nlohmann::json j = nlohmann::json::parse(ifs, nullptr, /*allow_exceptions=*/false);
+	if (j.is_discarded() || !j.is_object())
+		return {};
+
+	Data data;
+	data.valid             = true;
+	data.header.sampleRate = j.value("sample_rate", data.header.sampleRate);
+	data.header.bufferSize = j.value("buffer_size", data.header.bufferSize);
+	data.header.channelsIn = j.value("channels_in", data.header.channelsIn);
+	data.header.bpm        = j.value("bpm", data.header.bpm);
+	data.header.beats      = j.value("beats", data.header.beats);
+	data.header.bars       = j.value("bars", data.header.bars);
+	data.header.quantize   = j.value("quantize", data.header.quantize);
+	data.header.frames     = j.value("frames", data.header.frames);
+	data.header.inputPath  = j.value("input", data.header.inputPath);
+
+	if (!data.header.inputPath.empty())
+		data.header.inputPath = u::fs::join(path, data.header.inputPath);
+
+	const nlohmann::json jevents = j.value("events", nlohmann::json::array());
+	if (!jevents.is_array())
+		return {};
+
+	for (const auto& jevent : jevents)
+	{
+		/* Each event is [frame, type, channelId, value, arg1, arg2, midi]. */
+
+		if (!isValidEvent_(jevent))
+			return {};
+
+		Event e;
+		e.frame     = jevent[0];
+		e.type      = static_cast<EventType>(jevent[1].get<int>());
+		e.channelId = jevent[2];
+		e.value     = jevent[3];
+		e.arg1      = jevent[4];
+		e.arg2      = jevent[5];
+		e.midi      = jevent[6];
+		data.events.push_back(e);
+	}
+
+	return data;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Journal::Journal()
+: m_capturing(false)
+, m_frame(0)
+, m_ringWrite(0)
+, m_ringRead(0)
+, m_droppedFrames(0)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+Journal::~Journal()
+{
+	if (isCapturing())
+		stopCapture();
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Journal::startCapture(const std::string& path, const Header& header)
+{
+	if (isCapturing() || !u::fs::mkdir(path))
+		return false;
+
+	m_path             = path;
+	m_header           = header;
+	m_header.frames    = 0;
+	m_header.inputPath = header.channelsIn > 0 ? INPUT_FILE : "";
+
+	m_events.clear();
+	m_frame.store(0);
+	m_droppedFrames.store(0);
+	m_ringWrite.store(0);
+	m_ringRead.store(0);
+
+	SNDFILE* inputFile = nullptr;
+
+	if (m_header.channelsIn > 0)
+	{
+		m_ring.assign(m_header.sampleRate * m_header.channelsIn * RING_SECONDS, 0.0f);
+
+		SF_INFO info;
+		info.samplerate = m_header.sampleRate;
+		info.channels   = m_header.channelsIn;
+		info.format     = SF_FORMAT_WAV | SF_FORMAT_FLOAT;
+
+		inputFile = sf_open(u::fs::join(path, INPUT_FILE).c_str(), SFM_WRITE, &info);
+		if (inputFile == nullptr)
+		{
+			u::log::print("[Journal::startCapture] unable to open input file: {}\n", sf_strerror(nullptr));
+			return false;
+		}
+	}
+
+	m_capturing.store(true);
+
+	if (inputFile != nullptr)
+		m_writer = std::thread([this, inputFile]()
+		{ writeInput(inputFile); });
+
+	u::log::print("[Journal::startCapture] capture started in {}\n", path);
+
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Journal::stopCapture()
+{
+	if (!isCapturing())
+		return false;
+
+	m_capturing.store(false);
+	if (m_writer.joinable())
+		m_writer.join();
+
+	m_header.frames = m_frame.load();
+
+	if (m_droppedFrames.load() > 0)
+		u::log::print("[Journal::stopCapture] warning: {} input frames dropped, replay won't match\n",
+		    m_droppedFrames.load());
+
+	nlohmann::json j;
+
+	j["sample_rate"] = m_header.sampleRate;
+	j["buffer_size"] = m_header.bufferSize;
+	j["channels_in"] = m_header.channelsIn;
+	j["bpm"]         = m_header.bpm;
+	j["beats"]       = m_header.beats;
+	j["bars"]        = m_header.bars;
+	j["quantize"]    = m_header.quantize;
+	j["frames"]      = m_header.frames;
+	j["input"]       = m_header.inputPath;
+	j["events"]      = nlohmann::json::array();
+
+	{
+		const std::scoped_lock lock(m_mutex);
+		for (const Event& e : m_events)
+			j["events"].push_back({e.frame, static_cast<int>(e.type), e.channelId, e.value, e.arg1, e.arg2, e.midi});
+		u::log::print("[Journal::stopCapture] {} events, {} frames captured\n", m_events.size(), m_header.frames);
+	}
+
+	std::ofstream ofs(u::fs::join(m_path, JOURNAL_FILE));
+	if (!ofs.good())
+		return false;
+
+	ofs << j;
+
+	return ofs.good();
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Journal::isCapturing() const
+{
+	return m_capturing.load();
+}
+
+/* -------------------------------------------------------------------------- */
+
+Journal::Scope Journal::record(Event e)
+{
+	if (scopeDepth_ == 0 && isCapturing())
+	{
+		const std::scoped_lock lock(m_mutex);
+		e.frame = m_frame.load();
+		m_events.push_back(e);
+	}
+	return Scope();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Journal::onAudioBlock(const mcl::AudioBuffer& in, int numFrames)
+{
+	if (!isCapturing())
+		return;
+
+	const int channels = m_header.channelsIn;
+
+	if (channels > 0)
+	{
+		const std::size_t samples = numFrames * channels;
+		const std::size_t write   = m_ringWrite.load(std::memory_order_relaxed);
+		const std::size_t read    = m_ringRead.load(std::memory_order_acquire);
+
+		if (m_ring.size() - (write - read) >= samples)
+		{
+			/* Missing input (e.g. device without input channels) is stored as
+			silence, so that the input file stays aligned with the timeline. */
+
+			const bool hasInput = in.isAllocd() && in.countChannels() == channels;
+
+			for (int i = 0; i < numFrames; i++)
+				for (int j = 0; j < channels; j++)
+					m_ring[(write + i * channels + j) % m_ring.size()] = hasInput ? in[i][j] : 0.0f;
+
+			m_ringWrite.store(write + samples, std::memory_order_release);
+		}
+		else
+		{
+			m_droppedFrames.fetch_add(numFrames, std::memory_order_relaxed);
+		}
+	}
+
+	m_frame.fetch_add(numFrames, std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Journal::writeInput(SNDFILE* file)
+{
+	std::vector<float> chunk;
+
+	while (true)
+	{
+		/* Read the flag before draining, so that the last drain after the stop
+		request catches all the blocks pushed so far. */
+
+		const bool        running   = isCapturing();
+		const std::size_t write     = m_ringWrite.load(std::memory_order_acquire);
+		const std::size_t read      = m_ringRead.load(std::memory_order_relaxed);
+		const std::size_t available = write - read;
+
+		if (available > 0)
+		{
+			chunk.resize(available);
+			for (std::size_t i = 0; i < available; i++)
+				chunk[i] = m_ring[(read + i) % m_ring.size()];
+
+			const sf_count_t frames = available / m_header.channelsIn;
+			if (sf_writef_float(file, chunk.data(), frames) != frames)
+				u::log::print("[Journal::writeInput] warning: incomplete write!\n");
+
+			m_ringRead.store(write, std::memory_order_release);
+		}
+
+		if (!running)
+			break;
+
+		u::time::sleep(WRITER_SLEEP);
+	}
+
+	sf_close(file);
+}
+} // namespace giada::m
@@ -0,0 +1,213 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_JOURNAL_H
+#define G_JOURNAL_H
+
+#include "core/const.h"
+#include "core/types.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <sndfile.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mcl
+{
+class AudioBuffer;
+}
+
+namespace giada::m
+{
+class MidiEvent;
+
+/* Journal
+Captures every external input the engine receives (MIDI in, key presses,
+parameter and transport changes coming from the API layer), each one stamped
+with the audio frame it was received at, together with the audio input stream.
+The resulting capture can be rendered again offline, block by block, with
+Engine::replaySession. Inputs triggered by other inputs (e.g. a sequencer start
+fired by a MIDI clock message) are not recorded: see Journal::Scope. */
+
+class Journal final
+{
+public:
+	enum class EventType : int
+	{
+		MIDI_IN = 0,
+		CHANNEL_PRESS,
+		CHANNEL_RELEASE,
+		CHANNEL_KILL,
+		CHANNEL_VOLUME,
+		CHANNEL_PITCH,
+		CHANNEL_PAN,
+		CHANNEL_MUTE,
+		CHANNEL_SOLO,
+		CHANNEL_READ_ACTIONS,
+		CHANNEL_KILL_READ_ACTIONS,
+		CHANNEL_MIDI,
+		MASTER_IN_VOLUME,
+		MASTER_OUT_VOLUME,
+		BPM,
+		BEATS,
+		GO_TO_BEAT,
+		SEQUENCER_START,
+		SEQUENCER_STOP,
+		SEQUENCER_REWIND,
+		QUANTIZE,
+		METRONOME,
+		ACTION_REC,
+		ACTION_REC_STOP,
+		INPUT_REC,
+		INPUT_REC_STOP
+	};
+
+	/* Event
+	A generic external input. The meaning of 'value' (velocity, volume, bpm,
+	...) and 'arg[1|2]' (local frame, beats, bars, ...) depends on the type.
+	MIDI events store the raw message in 'midi' and the number of bytes and the
+	frame offset in 'arg1' and 'arg2'. */
+
+	struct Event
+	{
+		EventType type      = EventType::MIDI_IN;
+		ID        channelId = 0;
+		float     value     = 0.0f;
+		int       arg1      = 0;
+		int       arg2      = 0;
+		uint32_t  midi      = 0;
+		Frame     frame     = 0; // Filled in by Journal::record()
+	};
+
+	/* Header
+	State of the engine when the capture started, restored before replaying. */
+
+	struct Header
+	{
+		int         sampleRate = G_DEFAULT_SAMPLERATE;
+		int         bufferSize = G_DEFAULT_BUFSIZE;
+		int         channelsIn = 0;
+		float       bpm        = G_DEFAULT_BPM;
+		int         beats      = G_DEFAULT_BEATS;
+		int         bars       = G_DEFAULT_BARS;
+		int         quantize   = G_DEFAULT_QUANTIZE;
+		Frame       frames     = 0;  // Length of the capture, in frames
+		std::string inputPath  = ""; // Audio input file, empty if no input
+	};
+
+	struct Data
+	{
+		bool               valid  = false;
+		Header             header = {};
+		std::vector<Event> events = {};
+	};
+
+	/* Scope
+	Returned by Journal::record(). While alive, any other call to record() on
+	the same thread is ignored, so that only the outermost input gets stored. */
+
+	class Scope
+	{
+	public:
+		Scope();
+		Scope(const Scope&)            = delete;
+		Scope& operator=(const Scope&) = delete;
+		~Scope();
+	};
+
+	/* makeMidiEvent
+	Helper function to build a MIDI_IN or CHANNEL_MIDI Event. */
+
+	static Event makeMidiEvent(EventType, ID channelId, const MidiEvent&);
+
+	/* toMidiEvent
+	The opposite of the above. */
+
+	static MidiEvent toMidiEvent(const Event&);
+
+	/* load
+	Reads a capture from the 'journal.json' file in the directory 'path'. The
+	returned Data is not valid if the file is missing or malformed. */
+
+	static Data load(const std::string& path);
+
+	Journal();
+	~Journal();
+
+	/* startCapture
+	Starts a new capture that will be stored in the directory 'path', created
+	if missing. Returns false on failure. */
+
+	bool startCapture(const std::string& path, const Header&);
+
+	/* stopCapture
+	Stops the current capture and writes it to disk. Returns false on failure. */
+
+	bool stopCapture();
+
+	bool isCapturing() const;
+
+	/* record
+	Stores the event if a capture is in progress. Thread-safe, not realtime-
+	safe. Keep the returned Scope alive while the event is being processed. */
+
+	[[nodiscard]] Scope record(Event);
+
+	/* onAudioBlock
+	Advances the capture timeline and stores the audio input block. Call this
+	from the audio thread on each block. Realtime-safe. */
+
+	void onAudioBlock(const mcl::AudioBuffer& in, int numFrames);
+
+private:
+	/* writeInput
+	Body of the writer thread: drains the input ring into 'file' until the
+	capture is stopped. */
+
+	void writeInput(SNDFILE* file);
+
+	std::string        m_path;
+	Header             m_header;
+	std::vector<Event> m_events;
+	std::mutex         m_mutex;
+
+	std::atomic<bool>  m_capturing;
+	std::atomic<Frame> m_frame;
+
+	/* Single-producer (audio thread), single-consumer (writer thread) ring of
+	interleaved input samples. */
+
+	std::vector<float>       m_ring;
+	std::atomic<std::size_t> m_ringWrite;
+	std::atomic<std::size_t> m_ringRead;
+	std::atomic<Frame>       m_droppedFrames;
+	std::thread              m_writer;
+};
+} // namespace giada::m
+
+#endif
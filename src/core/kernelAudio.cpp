@@ -48,6 +48,12 @@ on Unix, however RtAudio has some magic hardcoded values when it comes to Window
 implementation, so we can safely pass this value below in the options struct.*/
 
 constexpr int RTAUDIO_MAX_PRIORITY = 99;
+
+/* VIRTUAL_DEVICE_ID
+ID of the one and only device exposed by the virtual audio backend. Zero means
+'disabled' for the input device, so start from 1 as RtAudio does. */
+
+constexpr unsigned int VIRTUAL_DEVICE_ID = 1;
 } // namespace
 
 /* -------------------------------------------------------------------------- */
@@ -58,8 +64,18 @@ KernelAudio::KernelAudio(model::Model& model)
 : onAudioCallback(nullptr)
 , onStreamAboutToOpen(nullptr)
 , onStreamOpened(nullptr)
+, onXrun(nullptr)
 , m_model(model)
 {
+	m_virtualDevice.onAudioCallback = [this](mcl::AudioBuffer& out, const mcl::AudioBuffer& in)
+	{
+		return onAudioCallback(out, in);
+	};
+	m_virtualDevice.onXrun = [this]()
+	{
+		if (onXrun != nullptr)
+			onXrun(/*underflow=*/true, /*overflow=*/false);
+	};
 }
 
 /* -------------------------------------------------------------------------- */
@@ -93,8 +109,16 @@ bool KernelAudio::init()
 
 void KernelAudio::setAPI(RtAudio::Api desiredApi)
 {
-	m_model.get().kernelAudio     = {}; // Set API = reset everything
-	m_model.get().kernelAudio.api = setAPI_(desiredApi);
+	/* Set API = reset everything, except for the virtual device and render-ahead
+	settings which are not bound to any API. */
+
+	const model::KernelAudio::VirtualDevice virtualDevice = m_model.get().kernelAudio.virtualDevice;
+	const bool                              renderAhead   = m_model.get().kernelAudio.renderAhead;
+
+	m_model.get().kernelAudio               = {};
+	m_model.get().kernelAudio.api           = setAPI_(desiredApi);
+	m_model.get().kernelAudio.virtualDevice = virtualDevice;
+	m_model.get().kernelAudio.renderAhead   = renderAhead;
 	m_model.swap(model::SwapType::NONE);
 
 	printDevices(getAvailableDevices());
@@ -134,6 +158,9 @@ bool KernelAudio::openStream(
 
 bool KernelAudio::startStream()
 {
+	if (isVirtual())
+		return m_virtualDevice.start();
+
 	if (m_rtAudio->startStream() == RtAudioErrorType::RTAUDIO_NO_ERROR)
 	{
 		u::log::print("[KA] Start stream - latency = {}\n", m_rtAudio->getStreamLatency());
@@ -146,6 +173,12 @@ bool KernelAudio::startStream()
 
 bool KernelAudio::stopStream()
 {
+	if (isVirtual())
+	{
+		m_virtualDevice.stop();
+		return true;
+	}
+
 	if (m_rtAudio->stopStream() == RtAudioErrorType::RTAUDIO_NO_ERROR)
 	{
 		u::log::print("[KA] Stop stream\n");
@@ -158,6 +191,8 @@ bool KernelAudio::stopStream()
 
 void KernelAudio::shutdown()
 {
+	m_virtualDevice.close();
+
 	if (m_rtAudio->isStreamRunning())
 		m_rtAudio->stopStream();
 	if (m_rtAudio->isStreamOpen())
@@ -169,6 +204,8 @@ void KernelAudio::shutdown()
 
 bool KernelAudio::isReady() const
 {
+	if (isVirtual())
+		return m_virtualDevice.isOpen() && m_virtualDevice.isRunning();
 	return m_rtAudio != nullptr && m_rtAudio->isStreamOpen() && m_rtAudio->isStreamRunning();
 }
 
@@ -187,6 +224,9 @@ Resampler::Quality KernelAudio::getResamplerQuality() const { return m_model.get
 
 std::vector<m::KernelAudio::Device> KernelAudio::getAvailableDevices() const
 {
+	if (isVirtual())
+		return {fetchDevice(VIRTUAL_DEVICE_ID)};
+
 	std::vector<Device> out;
 	for (unsigned int i : m_rtAudio->getDeviceIds())
 		out.push_back(fetchDevice(i));
@@ -244,6 +284,8 @@ bool KernelAudio::hasAPI(int API) const
 
 RtAudio::Api KernelAudio::getAPI() const { return m_model.get().kernelAudio.api; }
 
+bool KernelAudio::isVirtual() const { return getAPI() == RtAudio::Api::RTAUDIO_DUMMY; }
+
 /* -------------------------------------------------------------------------- */
 
 void KernelAudio::logCompiledAPIs()
@@ -261,6 +303,21 @@ void KernelAudio::logCompiledAPIs()
 
 m::KernelAudio::Device KernelAudio::fetchDevice(unsigned int deviceId) const
 {
+	if (isVirtual())
+	{
+		return {
+		    VIRTUAL_DEVICE_ID,
+		    "Virtual device",
+		    G_MAX_IO_CHANS,
+		    G_MAX_IO_CHANS,
+		    G_MAX_IO_CHANS,
+		    true,
+		    true,
+		    0,
+		    0,
+		    {22050, 32000, 44100, 48000, 88200, 96000, 192000}};
+	}
+
 	RtAudio::DeviceInfo info = m_rtAudio->getDeviceInfo(deviceId);
 
 	return {
@@ -339,10 +396,14 @@ KernelAudio::OpenStreamResult KernelAudio::openStream_(
 
 	const RtAudio::Api api = m_model.get().kernelAudio.api;
 
-	/* Abort here if devices found are zero, both devices are disabled or
-	current API is dummy. */
+	/* The dummy API is served by the built-in virtual device. */
+
+	if (api == RtAudio::Api::RTAUDIO_DUMMY)
+		return openVirtualStream_(out, in, sampleRate, bufferSize);
 
-	if (m_rtAudio->getDeviceCount() == 0 || (in.id == 0 && out.id == 0) || api == RtAudio::Api::RTAUDIO_DUMMY)
+	/* Abort here if devices found are zero or both devices are disabled. */
+
+	if (m_rtAudio->getDeviceCount() == 0 || (in.id == 0 && out.id == 0))
 		return {};
 
 	/* Close stream before opening another one. Closing a stream frees any
@@ -430,11 +491,53 @@ KernelAudio::OpenStreamResult KernelAudio::openStream_(
 
 /* -------------------------------------------------------------------------- */
 
+KernelAudio::OpenStreamResult KernelAudio::openVirtualStream_(
+    const model::KernelAudio::Device& out,
+    const model::KernelAudio::Device& in,
+    unsigned int                      sampleRate,
+    unsigned int                      bufferSize)
+{
+	const model::KernelAudio&                kernelAudio   = m_model.get().kernelAudio;
+	const model::KernelAudio::VirtualDevice& virtualDevice = kernelAudio.virtualDevice;
+
+	const bool hasOutput = out.id != 0;
+	const bool hasInput  = in.id != 0;
+
+	const VirtualAudioDevice::Config config = {
+	    sampleRate,
+	    bufferSize,
+	    hasOutput ? out.channelsCount : 0,
+	    hasInput ? in.channelsCount : 0,
+	    virtualDevice.inputPath,
+	    virtualDevice.outputPath,
+	    virtualDevice.freewheel};
+
+	if (!m_virtualDevice.open(config, kernelAudio.rsmpQuality))
+		return {};
+
+	u::log::print("[KA] Virtual device opened successfully\n");
+
+	/* Channel offsets make no sense for the virtual device: it always exposes
+	exactly the channels requested. */
+
+	return {
+	    true,
+	    {hasOutput ? static_cast<int>(VIRTUAL_DEVICE_ID) : 0, config.channelsOutCount, 0},
+	    {hasInput ? static_cast<int>(VIRTUAL_DEVICE_ID) : 0, config.channelsInCount, 0},
+	    sampleRate,
+	    bufferSize};
+}
+
+/* -------------------------------------------------------------------------- */
+
 int KernelAudio::audioCallback(void* outBuf, void* inBuf, unsigned bufferSize,
-    double /*streamTime*/, RtAudioStreamStatus /*status*/, void*   data)
+    double /*streamTime*/, RtAudioStreamStatus status, void*   data)
 {
 	const CallbackInfo& info = *static_cast<CallbackInfo*>(data);
 
+	if (status != 0 && info.kernelAudio->onXrun != nullptr)
+		info.kernelAudio->onXrun(status & RTAUDIO_OUTPUT_UNDERFLOW, status & RTAUDIO_INPUT_OVERFLOW);
+
 	mcl::AudioBuffer out(static_cast<float*>(outBuf), bufferSize, info.channelsOutCount);
 	mcl::AudioBuffer in;
 	if (info.channelsInCount > 0)
@@ -28,6 +28,7 @@
 #define G_KERNELAUDIO_H
 
 #include "core/model/model.h"
+#include "core/virtualAudioDevice.h"
 #include "core/weakAtomic.h"
 #include "deps/rtaudio/RtAudio.h"
 #include <cstddef>
@@ -118,6 +119,7 @@ public:
 	int                 getChannelsOutCount() const;
 	int                 getChannelsInCount() const;
 	bool                hasAPI(int API) const;
+	bool                isVirtual() const;
 	RtAudio::Api        getAPI() const;
 	std::vector<Device> getAvailableDevices() const;
 	Device              getCurrentOutDevice() const;
@@ -141,6 +143,12 @@ public:
 
 	std::function<void()> onStreamOpened;
 
+	/* onXrun
+	Callback fired from the audio thread when the backend reports an output
+	underflow and/or an input overflow in the current block. */
+
+	std::function<void(bool underflow, bool overflow)> onXrun;
+
 private:
 	struct CallbackInfo
 	{
@@ -176,6 +184,16 @@ private:
 	    unsigned int                      sampleRate,
 	    unsigned int                      bufferSize);
 
+	/* openVirtualStream_
+	Same as above, for the built-in virtual device (i.e. when the API is
+	RTAUDIO_DUMMY). */
+
+	OpenStreamResult openVirtualStream_(
+	    const model::KernelAudio::Device& out,
+	    const model::KernelAudio::Device& in,
+	    unsigned int                      sampleRate,
+	    unsigned int                      bufferSize);
+
 	static int audioCallback(void*, void*, unsigned, double, RtAudioStreamStatus, void*);
 
 	Device fetchDevice(unsigned int deviceId) const;
@@ -185,6 +203,7 @@ private:
 	JackTransport m_jackTransport;
 #endif
 	std::unique_ptr<RtAudio> m_rtAudio;
+	VirtualAudioDevice       m_virtualDevice;
 	CallbackInfo             m_callbackInfo;
 	model::Model&            m_model;
 };
@@ -29,6 +29,7 @@
 #include "core/midiEvent.h"
 #include "core/model/kernelAudio.h"
 #include "utils/log.h"
+#include "utils/trace.h"
 #include <algorithm>
 #include <cassert>
 #include <chrono>
@@ -125,6 +126,9 @@ void KernelMidi::start()
 		return;
 	m_worker.start([this]()
 	{
+		u::trace::registerThread("MIDI_OUT");
+		G_TRACE("kernel midi out");
+
 		RtMidiMessage msg;
 		while (m_midiQueue.try_dequeue(msg))
 			m_midiOut->sendMessage(&msg);
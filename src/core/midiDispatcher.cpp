@@ -210,12 +210,12 @@ void MidiDispatcher::processChannel(const Channel& c, const MidiEvent& midiEvent
 	if (pure == c.midiInput.keyPress.getValue())
 	{
 		G_DEBUG("   keyPress, ch={} (pure=0x{:0X})", c.id, pure);
-		c::channel::pressChannel(c.id, midiEvent.getVelocityFloat(), Thread::MIDI);
+		c::channel::pressChannel(c.id, midiEvent.getVelocityFloat(), Thread::MIDI, midiEvent.getDelta());
 	}
 	else if (pure == c.midiInput.keyRelease.getValue())
 	{
 		G_DEBUG("   keyRel ch={} (pure=0x{:0X})", c.id, pure);
-		c::channel::releaseChannel(c.id, Thread::MIDI);
+		c::channel::releaseChannel(c.id, Thread::MIDI, midiEvent.getDelta());
 	}
 	else if (pure == c.midiInput.mute.getValue())
 	{
@@ -225,7 +225,7 @@ void MidiDispatcher::processChannel(const Channel& c, const MidiEvent& midiEvent
 	else if (pure == c.midiInput.kill.getValue())
 	{
 		G_DEBUG("   kill ch={} (pure=0x{:0X})", c.id, pure);
-		c::channel::killChannel(c.id, Thread::MIDI);
+		c::channel::killChannel(c.id, Thread::MIDI, midiEvent.getDelta());
 	}
 	else if (pure == c.midiInput.arm.getValue())
 	{
@@ -30,6 +30,7 @@
 #include "core/midiEvent.h"
 #include "core/model/sequencer.h"
 #include "utils/log.h"
+#include "utils/trace.h"
 #include "utils/time.h"
 #include <numeric>
 
@@ -102,6 +103,9 @@ void MidiSynchronizer::startSendClock(float bpm)
 
 	m_worker.start([this, clockEvent]()
 	{
+		u::trace::registerThread("MIDI_CLOCK");
+		G_TRACE("midi clock");
+
 		if (!m_kernelMidi.send(clockEvent))
 			G_DEBUG("Can't send MIDI out message!", );
 	});
@@ -0,0 +1,169 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/midiTimestamper.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numbers>
+
+namespace giada::m
+{
+MidiTimestamper::MidiTimestamper()
+: m_seq(0)
+, m_blockStart(0.0)
+, m_blockPeriod(0.0)
+, m_bufferSize(0)
+, m_nominalPeriod(0.0)
+, m_resetRequested(false)
+, m_t1(0.0)
+, m_e2(0.0)
+, m_b(0.0)
+, m_c(0.0)
+, m_midiToSystem(0.0)
+, m_midiAnchored(false)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+void MidiTimestamper::reset(int sampleRate, int bufferSize)
+{
+	if (sampleRate <= 0 || bufferSize <= 0)
+		return;
+
+	m_bufferSize.store(bufferSize);
+	m_nominalPeriod.store(bufferSize / static_cast<double>(sampleRate));
+	m_blockPeriod.store(0.0); // Audio clock not running until the next block
+	m_resetRequested.store(true);
+	m_midiAnchored = false;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void MidiTimestamper::onAudioBlock()
+{
+	onAudioBlock(now());
+}
+
+/* -------------------------------------------------------------------------- */
+
+void MidiTimestamper::onAudioBlock(double t)
+{
+	if (m_resetRequested.exchange(false))
+	{
+		/* Restart the DLL. See "Using a DLL to filter time", F. Adriaensen,
+		2005. */
+
+		const double omega = 2.0 * std::numbers::pi * DLL_BANDWIDTH;
+
+		m_b  = std::sqrt(2.0) * omega;
+		m_c  = omega * omega;
+		m_e2 = m_nominalPeriod.load();
+		m_t1 = t + m_e2;
+
+		publish(t, m_e2);
+		return;
+	}
+
+	if (m_e2 <= 0.0)
+		return;
+
+	const double t0 = m_t1;
+	const double e  = t - m_t1;
+
+	m_t1 += m_b * e + m_e2;
+	m_e2 += m_c * e;
+
+	publish(t0, m_t1 - t0);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void MidiTimestamper::publish(double blockStart, double blockPeriod)
+{
+	m_seq.fetch_add(1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	m_blockStart.store(blockStart, std::memory_order_relaxed);
+	m_blockPeriod.store(blockPeriod, std::memory_order_relaxed);
+	m_seq.fetch_add(1, std::memory_order_release);
+}
+
+/* -------------------------------------------------------------------------- */
+
+Frame MidiTimestamper::getFrameOffset(double midiTimestamp)
+{
+	return getFrameOffset(midiTimestamp, now());
+}
+
+/* -------------------------------------------------------------------------- */
+
+Frame MidiTimestamper::getFrameOffset(double midiTimestamp, double t)
+{
+	/* Map the MIDI timestamp onto the system clock. MIDI events can only be
+	delivered late, never early: the smallest difference between the two clocks
+	is the best estimate of their offset. Follow slowly any increase to take
+	clock drift into account. */
+
+	const double offset = t - midiTimestamp;
+	if (!m_midiAnchored || offset < m_midiToSystem)
+		m_midiToSystem = offset;
+	else
+		m_midiToSystem += (offset - m_midiToSystem) * MIDI_DRIFT_RATE;
+	m_midiAnchored = true;
+
+	const double eventTime = std::min(t, midiTimestamp + m_midiToSystem);
+
+	/* Read the DLL output published by the audio thread. Retry if a write was
+	in progress. */
+
+	double   blockStart, blockPeriod;
+	uint32_t seq;
+	do
+	{
+		seq         = m_seq.load(std::memory_order_acquire);
+		blockStart  = m_blockStart.load(std::memory_order_relaxed);
+		blockPeriod = m_blockPeriod.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+	} while ((seq & 1) != 0 || seq != m_seq.load(std::memory_order_relaxed));
+
+	const int bufferSize = m_bufferSize.load();
+
+	if (blockPeriod <= 0.0 || bufferSize <= 0)
+		return 0;
+
+	const double position = (eventTime - blockStart) / blockPeriod; // [0.0, 1.0) if on time
+	return std::clamp(static_cast<Frame>(position * bufferSize), 0, bufferSize - 1);
+}
+
+/* -------------------------------------------------------------------------- */
+
+double MidiTimestamper::now()
+{
+	using namespace std::chrono;
+	return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+} // namespace giada::m
@@ -0,0 +1,139 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_MIDI_TIMESTAMPER_H
+#define G_MIDI_TIMESTAMPER_H
+
+#include "core/types.h"
+#include <atomic>
+#include <cstdint>
+
+namespace giada::m
+{
+/* MidiTimestamper
+Maps the timestamp of incoming MIDI events onto the audio timeline, so that
+live MIDI can be delivered at a precise frame offset inside the next audio block
+instead of at the block boundary. Two clocks are reconciled here: the audio
+clock, whose block start times are filtered by a Delay-Locked Loop (DLL) ticked
+by the audio thread, and the MIDI clock (RtMidi timestamps), which is anchored
+to the system clock. An event that arrives at X% of the current block is played
+at X% of the next one: the latency becomes a constant one-block delay, with no
+jitter. */
+
+class MidiTimestamper final
+{
+public:
+	MidiTimestamper();
+
+	/* reset
+	Restarts both clocks. Call this whenever the audio stream is (re)opened,
+	with audio processing suspended. */
+
+	void reset(int sampleRate, int bufferSize);
+
+	/* onAudioBlock (1)
+	Advances the DLL. Must be called by the audio thread at the beginning of
+	each audio callback. */
+
+	void onAudioBlock();
+
+	/* onAudioBlock (2)
+	Same as above, with the block start time 'time' (in seconds, system clock)
+	given explicitly. */
+
+	void onAudioBlock(double time);
+
+	/* getFrameOffset (1)
+	Returns the frame offset in [0, bufferSize) at which a MIDI event with the
+	given RtMidi timestamp (in seconds) should be rendered in the next audio
+	block. Returns 0 if the audio clock is not running yet. Must be called by
+	a single thread only (i.e. the MIDI thread). */
+
+	Frame getFrameOffset(double midiTimestamp);
+
+	/* getFrameOffset (2)
+	Same as above, with the arrival time 'time' (in seconds, system clock) given
+	explicitly. */
+
+	Frame getFrameOffset(double midiTimestamp, double time);
+
+private:
+	/* DLL_BANDWIDTH
+	Bandwidth of the DLL, relative to the block rate. Small values give a smooth
+	but slow-to-converge estimate. */
+
+	static constexpr double DLL_BANDWIDTH = 0.05;
+
+	/* MIDI_DRIFT_RATE
+	How fast the MIDI-to-system clock offset follows a slower delivery of MIDI
+	events, to compensate for the drift between the two clocks. */
+
+	static constexpr double MIDI_DRIFT_RATE = 0.001;
+
+	/* now
+	Returns the current time of the system's monotonic clock, in seconds. */
+
+	static double now();
+
+	/* publish
+	Writes the DLL output for the MIDI thread. */
+
+	void publish(double blockStart, double blockPeriod);
+
+	/* m_seq, m_blockStart, m_blockPeriod
+	DLL output, published by the audio thread through a sequence lock. m_seq is
+	odd while a write is in progress. */
+
+	std::atomic<uint32_t> m_seq;
+	std::atomic<double>   m_blockStart;
+	std::atomic<double>   m_blockPeriod;
+
+	/* m_bufferSize, m_nominalPeriod, m_resetRequested
+	Stream parameters set by reset(). The DLL is actually restarted by the audio
+	thread on the next block, when it finds m_resetRequested == true. */
+
+	std::atomic<int>    m_bufferSize;
+	std::atomic<double> m_nominalPeriod;
+	std::atomic<bool>   m_resetRequested;
+
+	/* m_t1, m_e2, m_b, m_c
+	Internal DLL state, accessed by the audio thread only. */
+
+	double m_t1;
+	double m_e2;
+	double m_b;
+	double m_c;
+
+	/* m_midiToSystem, m_midiAnchored
+	Estimated offset between the MIDI clock and the system clock. Accessed by
+	the MIDI thread only. */
+
+	double m_midiToSystem;
+	bool   m_midiAnchored;
+};
+} // namespace giada::m
+
+#endif
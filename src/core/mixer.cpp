@@ -27,8 +27,10 @@
 #include "core/mixer.h"
 #include "core/const.h"
 #include "core/model/model.h"
+#include "core/recBuffer.h"
 #include "utils/log.h"
 #include "utils/math.h"
+#include <algorithm>
 
 namespace giada::m
 {
@@ -56,16 +58,19 @@ Mixer::Mixer(model::Model& m)
 
 /* -------------------------------------------------------------------------- */
 
-void Mixer::reset(int maxFramesInLoop, int framesInBuffer)
+void Mixer::reset(int framesInBuffer)
 {
-	/* Allocate working buffers. rec buffer has variable size: it depends on how
-	many frames there are in the current loop. */
+	/* Allocate working buffers. rec buffer grows while recording: only prepare
+	the first chunks here, so that a new take can start right away. */
 
-	m_model.get().mixer.getRecBuffer().alloc(maxFramesInLoop, G_MAX_IO_CHANS);
+	RecBuffer& recBuffer = m_model.get().mixer.getRecBuffer();
+
+	recBuffer.clear();
+	recBuffer.refill();
 	m_model.get().mixer.getInBuffer().alloc(framesInBuffer, G_MAX_IO_CHANS);
 
-	u::log::print("[mixer::reset] buffers ready - maxFramesInLoop={}, framesInBuffer={}\n",
-	    maxFramesInLoop, framesInBuffer);
+	u::log::print("[mixer::reset] buffers ready - recChunks={}, framesInBuffer={}\n",
+	    recBuffer.countChunks(), framesInBuffer);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -86,17 +91,23 @@ void Mixer::disable()
 
 /* -------------------------------------------------------------------------- */
 
-void Mixer::allocRecBuffer(int frames)
+void Mixer::refillRecBuffer()
 {
-	m_model.get().mixer.getRecBuffer().alloc(frames, G_MAX_IO_CHANS);
+	m_model.get().mixer.getRecBuffer().refill();
 }
 
 void Mixer::clearRecBuffer()
 {
-	m_model.get().mixer.getRecBuffer().clear();
+	RecBuffer& recBuffer = m_model.get().mixer.getRecBuffer();
+
+	if (recBuffer.getDroppedFrames() > 0)
+		u::log::print("[mixer::clearRecBuffer] Warning: {} frames dropped while recording\n",
+		    recBuffer.getDroppedFrames());
+
+	recBuffer.clear();
 }
 
-const mcl::AudioBuffer& Mixer::getRecBuffer()
+const RecBuffer& Mixer::getRecBuffer()
 {
 	return m_model.get().mixer.getRecBuffer();
 }
@@ -156,12 +167,12 @@ void Mixer::render(const mcl::AudioBuffer& in, const model::Document& document_R
 	mixer.a_setPeakIn({0.0f, 0.0f});
 
 	if (hasInput)
-		processLineIn(mixer, in, masterInCh.volume, recTriggerLevel, seqIsActive);
+		processLineIn(mixer, in, masterInCh.shared->volume.load(), recTriggerLevel, seqIsActive);
 
 	if (shouldLineInRec)
 	{
 		const Frame newTrackerPos = lineInRec(in, mixer.getRecBuffer(),
-		    mixer.a_getInputTracker(), maxFramesToRec, masterInCh.volume,
+		    mixer.a_getInputTracker(), maxFramesToRec, masterInCh.shared->volume.load(),
 		    allowsOverdub);
 		mixer.a_setInputTracker(newTrackerPos);
 	}
@@ -173,7 +184,7 @@ void Mixer::startInputRec(Frame from)
 {
 	m_model.get().mixer.a_setInputTracker(from);
 	m_model.get().mixer.isRecordingInput = true;
-	m_model.swap(model::SwapType::NONE);
+	m_model.swapNow(model::SwapType::NONE);
 }
 
 Frame Mixer::stopInputRec()
@@ -181,7 +192,7 @@ Frame Mixer::stopInputRec()
 	const Frame ret = m_model.get().mixer.a_getInputTracker();
 	m_model.get().mixer.a_setInputTracker(0);
 	m_model.get().mixer.isRecordingInput = false;
-	m_model.swap(model::SwapType::NONE);
+	m_model.swapNow(model::SwapType::NONE);
 	m_signalCbFired   = false;
 	m_endOfRecCbFired = false;
 	return ret;
@@ -214,9 +225,21 @@ bool Mixer::getInToOut() const { return m_model.get().mixer.inToOut; }
 
 Mixer::RecordInfo Mixer::getRecordInfo() const
 {
-	return {
-	    m_model.get().mixer.a_getInputTracker(),
-	    m_model.get().mixer.getRecBuffer().countFrames()};
+	const model::Document& document = m_model.get();
+
+	/* A FREE take has no length until it ends: use a rolling scale that grows
+	one loop at a time, so the progress never reaches the end of the scale. In
+	RIGID mode the take is exactly one loop long. */
+
+	const Frame position     = document.mixer.a_getInputTracker();
+	const Frame framesInLoop = std::max(document.sequencer.framesInLoop, 1);
+
+	if (document.mixer.inputRecMode == InputRecMode::RIGID)
+		return {position % framesInLoop, framesInLoop};
+
+	const Frame scale = std::min((position / framesInLoop + 1) * framesInLoop, RecBuffer::MAX_FRAMES);
+
+	return {position, scale};
 }
 
 /* -------------------------------------------------------------------------- */
@@ -262,10 +285,10 @@ Peak Mixer::makePeak(const mcl::AudioBuffer& b) const
 
 /* -------------------------------------------------------------------------- */
 
-int Mixer::lineInRec(const mcl::AudioBuffer& inBuf, mcl::AudioBuffer& recBuf, Frame inputTracker,
+int Mixer::lineInRec(const mcl::AudioBuffer& inBuf, RecBuffer& recBuf, Frame inputTracker,
     int maxFrames, float inVol, bool allowsOverdub) const
 {
-	assert(maxFrames > 0 && maxFrames <= recBuf.countFrames());
+	assert(maxFrames > 0 && maxFrames <= RecBuffer::MAX_FRAMES);
 	assert(onEndOfRecording != nullptr);
 
 	if (inputTracker >= maxFrames && !allowsOverdub && !m_endOfRecCbFired)
@@ -275,11 +298,16 @@ int Mixer::lineInRec(const mcl::AudioBuffer& inBuf, mcl::AudioBuffer& recBuf, Fr
 		return 0;
 	}
 
-	const int   framesToCopy = -1; // copy everything
-	const Frame srcOffset    = 0;
-	const Frame destOffset   = inputTracker % maxFrames; // loop over at maxFrames
+	/* Loop over at maxFrames. The block is split in two if it crosses the end:
+	the tail goes back to the beginning of the buffer. */
+
+	const Frame destOffset = inputTracker % maxFrames;
+	const int   head       = std::min(inBuf.countFrames(), maxFrames - destOffset);
+	const int   tail       = inBuf.countFrames() - head;
 
-	recBuf.sum(inBuf, framesToCopy, srcOffset, destOffset, inVol);
+	recBuf.sum(inBuf, head, /*srcOffset=*/0, destOffset, inVol);
+	if (tail > 0 && allowsOverdub)
+		recBuf.sum(inBuf, tail, /*srcOffset=*/head, /*dstOffset=*/0, inVol);
 
 	return inputTracker + inBuf.countFrames();
 }
@@ -51,6 +51,7 @@ namespace giada::m
 {
 struct Action;
 class Channel;
+class RecBuffer;
 class Mixer
 {
 public:
@@ -74,7 +75,8 @@ public:
 	bool getInToOut() const;
 
 	/* getRecordInfo
-	Returns information on the ongoing input recording. */
+	Returns information on the ongoing input recording. 'maxLength' is the loop
+	length in RIGID mode, or a rolling scale of whole loops in FREE mode. */
 
 	RecordInfo getRecordInfo() const;
 
@@ -93,7 +95,7 @@ public:
 	Brings everything back to the initial state. Must be called only when mixer
 	is disabled.*/
 
-	void reset(int framesInLoop, int framesInBuffer);
+	void reset(int framesInBuffer);
 
 	/* enable, disable
 	Toggles master callback processing. Useful to suspend the rendering. */
@@ -101,13 +103,15 @@ public:
 	void enable();
 	void disable();
 
-	/* allocRecBuffer
-	Allocates new memory for the virtual input channel. */
+	/* refillRecBuffer
+	Allocates new memory for the virtual input channel, ahead of the recording
+	position. To be called periodically by a non-realtime thread. */
 
-	void allocRecBuffer(int frames);
+	void refillRecBuffer();
 
 	/* clearRecBuffer
-	Clears internal virtual channel. */
+	Clears internal virtual channel and releases the memory used by the last
+	take. */
 
 	void clearRecBuffer();
 
@@ -115,11 +119,12 @@ public:
 	Returns a read-only reference to the internal virtual channel. Use this to
 	merge data into channel after an input recording session. */
 
-	const mcl::AudioBuffer& getRecBuffer();
+	const RecBuffer& getRecBuffer();
 
 	/* startInputRec, stopInputRec
 	Starts/stops input recording on frame 'from'. The latter returns the frame
-	where the recording ended. */
+	where the recording ended. Both reach the realtime thread right away, even
+	within a Transaction. */
 
 	void  startInputRec(Frame from);
 	Frame stopInputRec();
@@ -176,7 +181,7 @@ private:
 	before the internal tracker loops over. The value changes whether you are
 	recording in RIGID or FREE mode. Returns the number of recorded frames. */
 
-	int lineInRec(const mcl::AudioBuffer& inBuf, mcl::AudioBuffer& recBuf,
+	int lineInRec(const mcl::AudioBuffer& inBuf, RecBuffer& recBuf,
 	    Frame inputTracker, int maxFrames, float inVol, bool allowsOverdub) const;
 
 	/* processLineIn
@@ -29,21 +29,81 @@
 #include "utils/log.h"
 #include <algorithm>
 #include <cassert>
+#include <iterator>
 #include <memory>
+#include <unordered_set>
 #ifdef G_DEBUG_MODE
 #include <fmt/core.h>
 #endif
 
 namespace giada::m::model
 {
+namespace
+{
+/* ActionKey_
+What makes two actions duplicates of each other. Plug-in parameter actions
+differ by target parameter too. */
+
+struct ActionKey_
+{
+	ID       channelId;
+	Tick     tick;
+	uint32_t event;
+	ID       pluginId;
+	int      pluginParam;
+
+	bool operator==(const ActionKey_&) const = default;
+};
+
+struct ActionKeyHash_
+{
+	std::size_t operator()(const ActionKey_& k) const
+	{
+		const uint64_t h = (static_cast<uint64_t>(static_cast<uint32_t>(k.channelId)) << 32) | static_cast<uint32_t>(k.tick);
+		const uint64_t p = (static_cast<uint64_t>(static_cast<uint32_t>(k.pluginId)) << 32) | static_cast<uint32_t>(k.pluginParam);
+		return std::hash<uint64_t>{}(h) ^ (std::hash<uint32_t>{}(k.event) * 31) ^ (std::hash<uint64_t>{}(p) * 17);
+	}
+};
+
+ActionKey_ makeKey_(const Action& a)
+{
+	return {a.channelId, a.tick, a.event.getRaw(), a.pluginId, a.pluginParam};
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Actions::Actions(const Actions& o)
+: m_actions(o.m_actions)
+{
+	rebuildIndex();
+}
+
+/* -------------------------------------------------------------------------- */
+
+Actions& Actions::operator=(const Actions& o)
+{
+	if (this == &o)
+		return *this;
+	m_actions = o.m_actions;
+	rebuildIndex();
+	return *this;
+}
+
+/* -------------------------------------------------------------------------- */
+
 void Actions::set(model::Actions::Map&& actions)
 {
 	m_actions = std::move(actions);
+	rebuildIndex();
 }
 
 void Actions::clearAll()
 {
 	m_actions.clear();
+	rebuildIndex();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -66,40 +126,32 @@ void Actions::clearActions(ID channelId, int type)
 
 /* -------------------------------------------------------------------------- */
 
-void Actions::deleteAction(ID id)
+void Actions::clearVolumeEnvelope(ID channelId)
 {
 	removeIf([=](const Action& a)
-	{ return a.id == id; });
+	{ return a.channelId == channelId && a.isVolumeEnvelope(); });
 }
 
-void Actions::deleteAction(ID currId, ID nextId)
+/* -------------------------------------------------------------------------- */
+
+void Actions::clearPluginActions(ID channelId, ID pluginId)
 {
 	removeIf([=](const Action& a)
-	{ return a.id == currId || a.id == nextId; });
+	{ return a.channelId == channelId && a.pluginId == pluginId; });
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Actions::updateKeyFrames(std::function<Frame(Frame old)> f)
+void Actions::deleteAction(ID id)
 {
-	Map temp;
-
-	/* Copy all existing actions in local map by cloning them, with just a
-	difference: they have a new frame value. */
-
-	for (const auto& [oldFrame, actions] : m_actions)
-	{
-		Frame newFrame = f(oldFrame);
-		for (const Action& a : actions)
-		{
-			Action copy = a;
-			copy.frame  = newFrame;
-			temp[newFrame].push_back(copy);
-		}
-		G_DEBUG("{} -> {}", oldFrame, newFrame);
-	}
+	removeIf([=](const Action& a)
+	{ return a.id == id; });
+}
 
-	m_actions = std::move(temp);
+void Actions::deleteAction(ID currId, ID nextId)
+{
+	removeIf([=](const Action& a)
+	{ return a.id == currId || a.id == nextId; });
 }
 
 /* -------------------------------------------------------------------------- */
@@ -109,6 +161,7 @@ void Actions::updateEvent(ID id, MidiEvent e)
 	Action* a = findAction(m_actions, id);
 	assert(a != nullptr);
 	a->event = e;
+	rebuildIndex();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -130,13 +183,14 @@ void Actions::updateSiblings(ID id, ID prevId, ID nextId)
 	{
 		pnext->prevId = pcurr->id;
 	}
+	rebuildIndex();
 }
 
 /* -------------------------------------------------------------------------- */
 
 bool Actions::hasActions(ID channelId, int type) const
 {
-	for (const auto& [frame, actions] : m_actions)
+	for (const auto& [tick, actions] : m_actions)
 		for (const Action& a : actions)
 			if (a.channelId == channelId && (type == 0 || type == a.event.getStatus()))
 				return true;
@@ -159,12 +213,12 @@ void Actions::debug() const
 {
 	puts("model::actions");
 
-	for (const auto& [frame, actions] : m_actions)
+	for (const auto& [tick, actions] : m_actions)
 	{
-		fmt::print("\tframe: {}\n", frame);
+		fmt::print("\ttick: {}\n", tick);
 		for (const Action& a : actions)
-			fmt::print("\t\t({}) - ID={}, frame={}, channel={}, value=0x{}, prevId={}, nextId={}\n",
-			    (void*)&a, a.id, a.frame, a.channelId, a.event.getRaw(), a.prevId, a.nextId);
+			fmt::print("\t\t({}) - ID={}, tick={}, channel={}, value=0x{}, prevId={}, nextId={}\n",
+			    (void*)&a, a.id, a.tick, a.channelId, a.event.getRaw(), a.prevId, a.nextId);
 	}
 }
 
@@ -172,19 +226,20 @@ void Actions::debug() const
 
 /* -------------------------------------------------------------------------- */
 
-Action Actions::rec(ID channelId, Frame frame, MidiEvent event)
+Action Actions::rec(ID channelId, Tick tick, MidiEvent event)
 {
 	/* Skip duplicates. */
 
-	if (exists(channelId, frame, event))
+	if (exists(channelId, tick, event))
 		return {};
 
-	Action a = actionFactory::makeAction(0, channelId, frame, event);
+	Action a = actionFactory::makeAction(0, channelId, tick, event);
 
-	/* If key frame doesn't exist yet, the [] operator in std::map is smart
+	/* If key tick doesn't exist yet, the [] operator in std::map is smart
 	enough to insert a new item first. No plug-in data for now. */
 
-	m_actions[frame].push_back(a);
+	m_actions[tick].push_back(a);
+	rebuildIndex();
 
 	return a;
 }
@@ -196,43 +251,76 @@ void Actions::rec(std::vector<Action>& actions)
 	if (actions.size() == 0)
 		return;
 
+	/* Hash what's already there once, instead of scanning the whole map for
+	each new action. New actions are added to the set too, so that duplicates
+	within 'actions' are skipped as well. */
+
+	std::unordered_set<ActionKey_, ActionKeyHash_> keys;
+	forEachAction([&keys](const Action& a)
+	{ keys.insert(makeKey_(a)); });
+
+	/* Sorting by tick (stable, to keep the recording order within the same
+	tick) lets consecutive actions reuse the same map node. */
+
+	std::stable_sort(actions.begin(), actions.end(), [](const Action& a, const Action& b)
+	{ return a.tick < b.tick; });
+
+	auto node = m_actions.end();
 	for (const Action& a : actions)
-		if (!exists(a.channelId, a.frame, a.event, m_actions))
-			m_actions[a.frame].push_back(a);
+	{
+		if (!keys.insert(makeKey_(a)).second)
+			continue;
+		if (node == m_actions.end() || node->first != a.tick)
+			node = m_actions.try_emplace(a.tick).first;
+		node->second.push_back(a);
+	}
+	rebuildIndex();
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Actions::rec(ID channelId, Frame f1, Frame f2, MidiEvent e1, MidiEvent e2)
+void Actions::rec(ID channelId, Tick t1, Tick t2, MidiEvent e1, MidiEvent e2)
 {
-	m_actions[f1].push_back(actionFactory::makeAction(0, channelId, f1, e1));
-	m_actions[f2].push_back(actionFactory::makeAction(0, channelId, f2, e2));
+	m_actions[t1].push_back(actionFactory::makeAction(0, channelId, t1, e1));
+	m_actions[t2].push_back(actionFactory::makeAction(0, channelId, t2, e2));
 
-	Action* a1 = findAction(m_actions, m_actions[f1].back().id);
-	Action* a2 = findAction(m_actions, m_actions[f2].back().id);
+	Action* a1 = findAction(m_actions, m_actions[t1].back().id);
+	Action* a2 = findAction(m_actions, m_actions[t2].back().id);
 	a1->nextId = a2->id;
 	a2->prevId = a1->id;
+	rebuildIndex();
 }
 
 /* -------------------------------------------------------------------------- */
 
-const std::vector<Action>* Actions::getActionsOnFrame(Frame frame) const
+const Actions::ChannelMap& Actions::getChannelActions() const { return m_channelActions; }
+
+/* -------------------------------------------------------------------------- */
+
+const Actions::ChannelIndex* Actions::findChannelActions(ID channelId) const
 {
-	if (m_actions.count(frame) == 0)
-		return nullptr;
-	return &m_actions.at(frame);
+	const auto it = m_channelActions.find(channelId);
+	return it != m_channelActions.end() ? &it->second : nullptr;
+}
+
+/* -------------------------------------------------------------------------- */
+
+const Actions::Envelope* Actions::getVolumeEnvelope(ID channelId) const
+{
+	const auto it = m_volumeEnvelopes.find(channelId);
+	return it != m_volumeEnvelopes.end() ? &it->second : nullptr;
 }
 
 /* -------------------------------------------------------------------------- */
 
-Action Actions::getClosestAction(ID channelId, Frame f, int type) const
+Action Actions::getClosestAction(ID channelId, Tick t, int type) const
 {
 	Action out = {};
 	forEachAction([&](const Action& a)
 	{
-		if (a.event.getStatus() != type || a.channelId != channelId)
+		if (a.event.getStatus() != type || a.channelId != channelId || a.pluginId != -1)
 			return;
-		if (!out.isValid() || (a.frame <= f && a.frame > out.frame))
+		if (!out.isValid() || (a.tick <= t && a.tick > out.tick))
 			out = a;
 	});
 	return out;
@@ -266,7 +354,7 @@ const Action* Actions::findAction(const Map& src, ID id) const
 {
 	if (id == 0)
 		return nullptr;
-	for (const auto& [frame, actions] : src)
+	for (const auto& [tick, actions] : src)
 		for (const Action& a : actions)
 			if (a.id == id)
 				return &a;
@@ -290,26 +378,68 @@ void Actions::optimize(Map& map)
 
 void Actions::removeIf(std::function<bool(const Action&)> f)
 {
-	for (auto& [frame, actions] : m_actions)
+	for (auto& [tick, actions] : m_actions)
 		actions.erase(std::remove_if(actions.begin(), actions.end(), f), actions.end());
 	optimize(m_actions);
+	rebuildIndex();
 }
 
 /* -------------------------------------------------------------------------- */
 
-bool Actions::exists(ID channelId, Frame frame, const MidiEvent& event, const Map& target) const
+void Actions::rebuildIndex()
 {
-	for (const auto& [_, actions] : target)
+	m_channelActions.clear();
+	m_volumeEnvelopes.clear();
+	for (const auto& [tick, actions] : m_actions)
+	{
 		for (const Action& a : actions)
-			if (a.channelId == channelId && a.frame == frame && a.event.getRaw() == event.getRaw())
-				return true;
+		{
+			m_channelActions[a.channelId].push_back(&a);
+			if (a.isVolumeEnvelope())
+				m_volumeEnvelopes[a.channelId].push_back({tick, a.event.getVelocityFloat()});
+		}
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Actions::exists(ID channelId, Tick tick, const MidiEvent& event, const Map& target) const
+{
+	const auto it = target.find(tick);
+	if (it == target.end())
+		return false;
+	for (const Action& a : it->second)
+		if (a.channelId == channelId && a.event.getRaw() == event.getRaw())
+			return true;
 	return false;
 }
 
 /* -------------------------------------------------------------------------- */
 
-bool Actions::exists(ID channelId, Frame frame, const MidiEvent& event) const
+bool Actions::exists(ID channelId, Tick tick, const MidiEvent& event) const
 {
-	return exists(channelId, frame, event, m_actions);
+	return exists(channelId, tick, event, m_actions);
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+float getEnvelopeValue(const Actions::Envelope& envelope, Tick t)
+{
+	assert(!envelope.empty());
+
+	const auto next = std::upper_bound(envelope.begin(), envelope.end(), t,
+	    [](Tick t, const Actions::EnvelopePoint& p)
+	{ return t < p.tick; });
+
+	if (next == envelope.begin())
+		return next->value;
+	if (next == envelope.end())
+		return envelope.back().value;
+
+	const auto  prev = std::prev(next);
+	const float pos  = static_cast<float>(t - prev->tick) / (next->tick - prev->tick);
+	return prev->value + (next->value - prev->value) * pos;
 }
 } // namespace giada::m::model
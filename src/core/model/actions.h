@@ -33,14 +33,43 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace giada::m::model
 {
+/* Actions
+The recorded actions, keyed by their position in musical ticks (see G_PPQ), so
+that tempo and sample rate changes don't touch them. Convert ticks to frames
+with model::Sequencer::tickToFrame. Actions are also indexed by channel: the
+index is rebuilt each time the actions change, so that the realtime thread can
+walk the actions of a single channel without filtering the others out. The
+index points into the actions map instead of holding copies: copying Actions
+rebuilds it, so that each copy points to its own actions. */
+
 class Actions
 {
 public:
-	using Map = std::map<Frame, std::vector<Action>>;
+	/* EnvelopePoint
+	A point of a volume envelope, taken from a volume envelope action. */
+
+	struct EnvelopePoint
+	{
+		Tick  tick;
+		float value;
+	};
+
+	using Map          = std::map<Tick, std::vector<Action>>;
+	using ChannelIndex = std::vector<const Action*>; // Sorted by tick
+	using ChannelMap   = std::map<ID, ChannelIndex>;
+	using Envelope     = std::vector<EnvelopePoint>; // Sorted by tick
+	using EnvelopeMap  = std::map<ID, Envelope>;
+
+	Actions() = default;
+	Actions(const Actions&);
+	Actions(Actions&&) = default;
+	Actions& operator=(const Actions&);
+	Actions& operator=(Actions&&) = default;
 
 	/* forEachAction
 	Applies a read-only callback on each action recorded. NEVER do anything
@@ -54,15 +83,28 @@ public:
 	std::vector<Action> getActionsOnChannel(ID channelId) const;
 
 	/* getClosestAction
-	Given a frame 'f' returns the closest action. */
+	Given a tick 't' returns the closest action. */
+
+	Action getClosestAction(ID channelId, Tick t, int type) const;
+
+	/* getChannelActions
+	Returns the actions grouped by channel ID. Channels without actions are not
+	in there. Doesn't allocate, safe to call from the realtime thread. */
+
+	const ChannelMap& getChannelActions() const;
 
-	Action getClosestAction(ID channelId, Frame f, int type) const;
+	/* findChannelActions
+	Returns the actions of a channel, sorted by tick, or nullptr if the channel
+	has none. Doesn't allocate, safe to call from the realtime thread. */
 
-	/* getActionsOnFrame
-	Returns a pointer to a vector of actions recorded on frame 'f', or nullptr
-	if the frame has no actions. */
+	const ChannelIndex* findChannelActions(ID channelId) const;
 
-	const std::vector<Action>* getActionsOnFrame(Frame f) const;
+	/* getVolumeEnvelope
+	Returns the volume envelope of a channel, or nullptr if the channel has
+	none. Rebuilt together with the channel index: doesn't allocate, safe to
+	call from the realtime thread. */
+
+	const Envelope* getVolumeEnvelope(ID channelId) const;
 
 	/* hasActions
 	Checks if the channel has at least one action recorded. */
@@ -103,6 +145,17 @@ public:
 
 	void clearActions(ID channelId, int type);
 
+	/* clearVolumeEnvelope
+	Clears the volume envelope actions from a channel, leaving any other
+	CHANNEL_CC action (e.g. plug-in automation) untouched. */
+
+	void clearVolumeEnvelope(ID channelId);
+
+	/* clearPluginActions
+	Clears the automation actions of a plug-in from a channel. */
+
+	void clearPluginActions(ID channelId, ID pluginId);
+
 	/* deleteAction (1)
 	Deletes a specific action. */
 
@@ -113,12 +166,6 @@ public:
 
 	void deleteAction(ID currId, ID nextId);
 
-	/* updateKeyFrames
-	Update all the key frames in the internal map of actions, according to a
-	lambda function 'f'. */
-
-	void updateKeyFrames(std::function<Frame(Frame old)> f);
-
 	/* updateEvent
 	Changes the event in action 'a'. */
 
@@ -133,11 +180,12 @@ public:
 	/* rec (1)
 	Records an action and returns it. Used by the Action Editor. */
 
-	Action rec(ID channelId, Frame frame, MidiEvent e);
+	Action rec(ID channelId, Tick tick, MidiEvent e);
 
 	/* rec (2)
-	Transfer a vector of actions into the current ActionMap. This is called by
-	recordHandler when a live session is over and consolidation is required. */
+	Transfer a vector of actions into the current ActionMap, skipping duplicates.
+	This is called by ActionRecorder when a live session is over and
+	consolidation is required. The vector gets sorted by tick. */
 
 	void rec(std::vector<Action>& actions);
 
@@ -145,24 +193,38 @@ public:
 	Records two actions on channel 'channel'. Useful when recording composite
 	actions in the Action Editor. */
 
-	void rec(ID channelId, Frame f1, Frame f2, MidiEvent e1, MidiEvent e2);
+	void rec(ID channelId, Tick t1, Tick t2, MidiEvent e1, MidiEvent e2);
 
 private:
-	bool exists(ID channelId, Frame frame, const MidiEvent& event, const Map& target) const;
-	bool exists(ID channelId, Frame frame, const MidiEvent& event) const;
+	bool exists(ID channelId, Tick tick, const MidiEvent& event, const Map& target) const;
+	bool exists(ID channelId, Tick tick, const MidiEvent& event) const;
 
 	Action*       findAction(Map& src, ID id);
 	const Action* findAction(const Map& src, ID id) const;
 
 	/* optimize
-	Removes frames without actions. */
+	Removes ticks without actions. */
 
 	void optimize(Map& map);
 
 	void removeIf(std::function<bool(const Action&)> f);
 
-	Actions::Map m_actions;
+	/* rebuildIndex
+	Regenerates m_channelActions and m_volumeEnvelopes from m_actions. Call this
+	after any change. */
+
+	void rebuildIndex();
+
+	Actions::Map         m_actions;
+	Actions::ChannelMap  m_channelActions;
+	Actions::EnvelopeMap m_volumeEnvelopes;
 };
+
+/* getEnvelopeValue
+Returns the value of a non-empty envelope at tick 't', linearly interpolated
+between the surrounding points. Realtime-safe. */
+
+float getEnvelopeValue(const Actions::Envelope&, Tick t);
 } // namespace giada::m::model
 
 #endif
@@ -29,6 +29,9 @@
 #include "core/channels/channelFactory.h"
 #include "core/conf.h"
 #include "core/model/shared.h"
+#include "core/plugins/plugin.h"
+#include "core/wave.h"
+#include "utils/time.h"
 #include "utils/vector.h"
 
 namespace giada::m::model
@@ -52,9 +55,23 @@ void Document::load(const Patch& patch, Shared& shared, float sampleRateRatio)
 			Channel channel = channelFactory::deserializeChannel(pchannel, *channelShared, sampleRateRatio, wave, plugins);
 			track.addChannel(std::move(channel));
 		}
+
+		/* A frozen track keeps its plug-ins suspended: they are restored only
+		when the track is unfrozen. */
+
+		track.frozenWave = shared.findWave(ptrack.frozenWaveId);
+		if (track.isFrozen())
+			for (const Channel& c : track.getChannels().getAll())
+				for (Plugin* p : c.plugins)
+					p->setSuspended(true);
 	}
 
-	actions.set(actionFactory::deserializeActions(patch.actions));
+	tracks.updateReturns();
+
+	/* Patch actions are in frames, at the patch's own tempo and sample rate. */
+
+	const int patchFramesInBeat = u::time::beatToFrame(1, patch.samplerate, patch.bpm);
+	actions.set(actionFactory::deserializeActions(patch.actions, patchFramesInBeat));
 
 	sequencer.status    = SeqStatus::STOPPED;
 	sequencer.bars      = patch.bars;
@@ -78,8 +95,10 @@ void Document::load(const Conf& conf)
 	kernelAudio.samplerate              = conf.samplerate;
 	kernelAudio.buffersize              = conf.buffersize;
 	kernelAudio.limitOutput             = conf.limitOutput;
+	kernelAudio.renderAhead             = conf.renderAhead;
 	kernelAudio.rsmpQuality             = conf.rsmpQuality;
 	kernelAudio.recTriggerLevel         = conf.recTriggerLevel;
+	kernelAudio.virtualDevice           = {conf.virtualAudioInput, conf.virtualAudioOutput, conf.virtualAudioFreewheel};
 
 	kernelMidi.api         = conf.midiSystem;
 	kernelMidi.portOut     = conf.midiPortOut;
@@ -117,11 +136,12 @@ void Document::store(Patch& patch) const
 	patch.bpm       = sequencer.bpm;
 	patch.quantize  = sequencer.quantize;
 	patch.metronome = sequencer.metronome;
-	patch.actions   = actionFactory::serializeActions(actions.getAll());
+	patch.actions   = actionFactory::serializeActions(actions.getAll(), sequencer.framesInBeat);
 
 	for (const Track& track : tracks.getAll())
 	{
-		patch.tracks.push_back({track.width, track.isInternal(), track.getChannels().getAllIDs()});
+		const ID frozenWaveId = track.isFrozen() ? track.frozenWave->id : 0;
+		patch.tracks.push_back({track.width, track.isInternal(), track.getChannels().getAllIDs(), frozenWaveId});
 		for (const Channel& c : track.getChannels().getAll())
 			patch.channels.push_back(channelFactory::serializeChannel(c));
 	}
@@ -141,9 +161,14 @@ void Document::store(Conf& conf) const
 	conf.samplerate       = kernelAudio.samplerate;
 	conf.buffersize       = kernelAudio.buffersize;
 	conf.limitOutput      = kernelAudio.limitOutput;
+	conf.renderAhead      = kernelAudio.renderAhead;
 	conf.rsmpQuality      = kernelAudio.rsmpQuality;
 	conf.recTriggerLevel  = kernelAudio.recTriggerLevel;
 
+	conf.virtualAudioInput     = kernelAudio.virtualDevice.inputPath;
+	conf.virtualAudioOutput    = kernelAudio.virtualDevice.outputPath;
+	conf.virtualAudioFreewheel = kernelAudio.virtualDevice.freewheel;
+
 	conf.midiSystem  = kernelMidi.api;
 	conf.midiPortOut = kernelMidi.portOut;
 	conf.midiPortIn  = kernelMidi.portIn;
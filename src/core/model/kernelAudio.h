@@ -30,6 +30,7 @@
 #include "core/resampler.h"
 #include "core/types.h"
 #include "deps/rtaudio/RtAudio.h"
+#include <string>
 
 namespace giada::m::model
 {
@@ -42,14 +43,23 @@ struct KernelAudio
 		int channelsStart = 0;
 	};
 
+	struct VirtualDevice
+	{
+		std::string inputPath  = "";
+		std::string outputPath = "";
+		bool        freewheel  = false;
+	};
+
 	RtAudio::Api       api             = G_DEFAULT_SOUNDSYS;
 	Device             deviceOut       = {G_DEFAULT_SOUNDDEV_OUT, G_MAX_IO_CHANS, 0};
 	Device             deviceIn        = {G_DEFAULT_SOUNDDEV_IN, 1, 0};
 	unsigned int       samplerate      = G_DEFAULT_SAMPLERATE;
 	unsigned int       buffersize      = G_DEFAULT_BUFSIZE;
 	bool               limitOutput     = false;
+	bool               renderAhead     = false;
 	Resampler::Quality rsmpQuality     = Resampler::Quality::LINEAR;
 	float              recTriggerLevel = 0.0f;
+	VirtualDevice      virtualDevice   = {};
 };
 } // namespace giada::m::model
 
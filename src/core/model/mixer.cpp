@@ -100,7 +100,7 @@ void Mixer::a_setPeakIn(Peak p) const
 
 /* -------------------------------------------------------------------------- */
 
-mcl::AudioBuffer& Mixer::getRecBuffer() const { return shared->recBuffer; }
+RecBuffer&        Mixer::getRecBuffer() const { return shared->recBuffer; }
 mcl::AudioBuffer& Mixer::getInBuffer() const { return shared->inBuffer; }
 
 /* -------------------------------------------------------------------------- */
@@ -28,6 +28,7 @@
 #define G_MODEL_MIXER_H
 
 #include "core/const.h"
+#include "core/recBuffer.h"
 #include "core/types.h"
 #include "core/weakAtomic.h"
 #include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
@@ -51,7 +52,7 @@ public:
 	void a_setPeakOut(Peak) const;
 	void a_setPeakIn(Peak) const;
 
-	mcl::AudioBuffer& getRecBuffer() const;
+	RecBuffer&        getRecBuffer() const;
 	mcl::AudioBuffer& getInBuffer() const;
 
 #ifdef G_DEBUG_MODE
@@ -79,9 +80,9 @@ private:
 		WeakAtomic<Frame> inputTracker = 0;
 
 		/* recBuffer
-		Working buffer for audio recording. */
+		Working buffer for audio recording. Grows with the take. */
 
-		mcl::AudioBuffer recBuffer;
+		RecBuffer recBuffer;
 
 		/* inBuffer
 		Working buffer for input channel. Used for the in->out bridge. */
@@ -33,6 +33,7 @@
 #include "core/waveFactory.h"
 #include "utils/log.h"
 #include "utils/string.h"
+#include "utils/trace.h"
 #include <cassert>
 #include <memory>
 #ifdef G_DEBUG_MODE
@@ -46,6 +47,7 @@ namespace giada::m::model
 {
 Model::Model()
 : onSwap(nullptr)
+, m_transactionDepth(0)
 {
 }
 
@@ -53,7 +55,10 @@ Model::Model()
 
 void Model::init()
 {
-	m_shared.init();
+	{
+		const std::scoped_lock lock(m_sharedMutex);
+		m_shared.init();
+	}
 
 	Document& document        = get();
 	document                  = {};
@@ -67,7 +72,10 @@ void Model::init()
 
 void Model::reset()
 {
-	m_shared.init();
+	{
+		const std::scoped_lock lock(m_sharedMutex);
+		m_shared.init();
+	}
 
 	Document& document        = get();
 	document.sequencer        = {};
@@ -89,7 +97,8 @@ void Model::load(const Conf& conf)
 
 /* -------------------------------------------------------------------------- */
 
-LoadState Model::load(const Patch& patch, PluginManager& pluginManager, int sampleRate, int bufferSize, Resampler::Quality rsmpQuality)
+LoadState Model::load(const Patch& patch, PluginManager& pluginManager, int sampleRate, int bufferSize,
+    Resampler::Quality rsmpQuality, const std::function<void(float)>& progress)
 {
 	const float sampleRateRatio = sampleRate / static_cast<float>(patch.samplerate);
 
@@ -97,7 +106,7 @@ LoadState Model::load(const Patch& patch, PluginManager& pluginManager, int samp
 	goes out of scope. */
 
 	const SharedLock lock  = lockShared(SwapType::NONE);
-	const LoadState  state = m_shared.load(patch, pluginManager, get().sequencer, sampleRate, bufferSize, rsmpQuality);
+	const LoadState  state = m_shared.load(patch, pluginManager, get().sequencer, sampleRate, bufferSize, rsmpQuality, progress);
 	get().load(patch, m_shared, sampleRateRatio);
 
 	return state;
@@ -144,6 +153,35 @@ DocumentLock    Model::get_RT() const { return DocumentLock(m_swapper); }
 
 void Model::swap(SwapType t)
 {
+	const std::scoped_lock lock(m_transactionMutex);
+
+	if (m_transactionDepth > 0)
+	{
+		/* HARD is the strongest SwapType, NONE the weakest. */
+
+		if (!m_pendingSwap.has_value() || static_cast<int>(t) < static_cast<int>(*m_pendingSwap))
+			m_pendingSwap = t;
+		return;
+	}
+	swap_(t);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Model::swapNow(SwapType t)
+{
+	const std::scoped_lock lock(m_transactionMutex);
+
+	if (m_transactionDepth > 0)
+		swap_(SwapType::NONE);
+	swap(t);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Model::swap_(SwapType t)
+{
+	u::trace::instant("model swap");
 	m_swapper.swap();
 	if (onSwap != nullptr)
 		onSwap(t);
@@ -158,6 +196,37 @@ SharedLock Model::lockShared(SwapType t)
 
 /* -------------------------------------------------------------------------- */
 
+Transaction Model::beginTransaction()
+{
+	return Transaction(*this);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Model::beginTransaction_()
+{
+	m_transactionMutex.lock();
+	m_transactionDepth++;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Model::endTransaction_()
+{
+	assert(m_transactionDepth > 0);
+
+	if (--m_transactionDepth == 0 && m_pendingSwap.has_value())
+	{
+		const SwapType pending = *m_pendingSwap;
+		m_pendingSwap.reset();
+		swap_(pending);
+	}
+
+	m_transactionMutex.unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+
 bool Model::isRtLocked() const
 {
 	return m_swapper.isRtLocked();
@@ -171,6 +240,18 @@ std::vector<std::unique_ptr<ChannelShared>>& Model::getAllChannelsShared() { ret
 
 /* -------------------------------------------------------------------------- */
 
+bool Model::visitChannelsShared(const std::function<void(ChannelShared&)>& f)
+{
+	const std::unique_lock lock(m_sharedMutex, std::try_to_lock);
+	if (!lock.owns_lock())
+		return false;
+	for (const std::unique_ptr<ChannelShared>& shared : m_shared.getAllChannels())
+		f(*shared);
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
 Plugin* Model::findPlugin(ID id) { return m_shared.findPlugin(id); }
 Wave*   Model::findWave(ID id) { return m_shared.findWave(id); }
 
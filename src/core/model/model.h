@@ -41,13 +41,17 @@
 #include "core/model/sequencer.h"
 #include "core/model/shared.h"
 #include "core/model/sharedLock.h"
+#include "core/model/transaction.h"
 #include "core/model/types.h"
 #include "core/plugins/plugin.h"
 #include "core/wave.h"
 #include "deps/mcl-atomic-swapper/src/atomic-swapper.hpp"
 #include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
 #include "utils/vector.h"
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 
 namespace giada::m::model
 {
@@ -69,6 +73,16 @@ public:
 
 	[[nodiscard]] SharedLock lockShared(SwapType t = SwapType::HARD);
 
+	/* beginTransaction
+	Returns a scoped Transaction object. All swaps requested by the calling
+	thread while the Transaction is alive are deferred and coalesced into a
+	single swap, performed with the strongest SwapType requested when the
+	outermost Transaction goes out of scope. Other threads that begin a
+	Transaction, swap or take a SharedLock in the meantime wait for it to end,
+	so that they never publish a half-built Document. */
+
+	[[nodiscard]] Transaction beginTransaction();
+
 	/* init
 	Initializes the internal Document. All values go back to default. */
 
@@ -86,9 +100,11 @@ public:
 	void load(const Conf&);
 
 	/* load (2)
-	Loads data from a Patch object. */
+	Loads data from a Patch object. The callback reports the plug-in loading
+	progress. */
 
-	LoadState load(const Patch&, PluginManager&, int sampleRate, int bufferSize, Resampler::Quality);
+	LoadState load(const Patch&, PluginManager&, int sampleRate, int bufferSize, Resampler::Quality,
+	    const std::function<void(float)>& progress);
 
 	/* store
 	Stores data into a Conf object. */
@@ -115,16 +131,31 @@ public:
 	const Document& get() const;
 
 	/* swap
-	Swap non-rt Document with the rt one. See 'SwapType' notes above. */
+	Swap non-rt Document with the rt one. See 'SwapType' notes above. The swap
+	is deferred if a Transaction is active on the calling thread. */
 
 	void swap(SwapType t);
 
+	/* swapNow
+	Like swap(), but the realtime thread sees the Document right away, even
+	within a Transaction: only the SwapType is deferred. Use this for changes
+	the realtime thread can't wait for, e.g. input recording on/off. */
+
+	void swapNow(SwapType t);
+
 	/* getAll[*] */
 
 	std::vector<std::unique_ptr<Wave>>&          getAllWaves();
 	std::vector<std::unique_ptr<Plugin>>&        getAllPlugins();
 	std::vector<std::unique_ptr<ChannelShared>>& getAllChannelsShared();
 
+	/* visitChannelsShared
+	Safe access to ChannelShared objects from a non-realtime thread other than
+	the main one. Calls 'f' on each of them, unless the shared data is being
+	modified right now: returns false without calling 'f' in that case. */
+
+	bool visitChannelsShared(const std::function<void(ChannelShared&)>& f);
+
 	/* find[*]
 	Finds something in the shared data given an ID. Returns nullptr if the
 	object is not found. */
@@ -158,8 +189,39 @@ public:
 	std::function<void(SwapType)> onSwap;
 
 private:
+	friend class SharedLock;
+	friend class Transaction;
+
+	/* swap_
+	Performs the actual swap, regardless of any active Transaction. */
+
+	void swap_(SwapType t);
+
+	/* [begin|end]Transaction_
+	Used by the Transaction object. beginTransaction_() waits until any
+	Transaction owned by another thread has ended. */
+
+	void beginTransaction_();
+	void endTransaction_();
+
 	AtomicSwapper m_swapper;
 	Shared        m_shared;
+
+	/* m_sharedMutex
+	Held by the main thread while it modifies the shared data (i.e. for as long
+	as a SharedLock is alive). Keeps visitChannelsShared() readers out. Never
+	taken by the realtime thread. Recursive: SharedLocks can be nested. */
+
+	std::recursive_mutex m_sharedMutex;
+
+	/* m_transactionMutex
+	Held by the thread that owns the current Transaction, for as long as the
+	outermost Transaction is alive, and briefly by any swap. Always taken before
+	m_sharedMutex. m_transactionDepth and m_pendingSwap are guarded by it. */
+
+	std::recursive_mutex    m_transactionMutex;
+	int                     m_transactionDepth;
+	std::optional<SwapType> m_pendingSwap;
 };
 } // namespace giada::m::model
 
@@ -95,6 +95,11 @@ int Sequencer::getMaxFramesInLoop(int sampleRate) const
 
 /* -------------------------------------------------------------------------- */
 
+Frame Sequencer::tickToFrame(Tick t) const { return u::time::tickToFrame(t, framesInBeat); }
+Tick  Sequencer::frameToTick(Frame f) const { return u::time::frameToTick(f, framesInBeat); }
+
+/* -------------------------------------------------------------------------- */
+
 void Sequencer::a_setCurrentFrame(Frame f, int sampleRate) const
 {
 	shared->currentFrame.store(f);
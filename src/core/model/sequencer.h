@@ -73,6 +73,12 @@ public:
 	void a_setCurrentFrame(Frame f, int sampleRate) const;
 	void a_setCurrentBeat(int b, int sampleRate) const;
 
+	/* tickToFrame, frameToTick
+	Convert between musical ticks and frames at the current tempo. */
+
+	Frame tickToFrame(Tick) const;
+	Tick  frameToTick(Frame) const;
+
 	SeqStatus status       = SeqStatus::STOPPED;
 	int       framesInLoop = 0;
 	int       framesInBar  = 0;
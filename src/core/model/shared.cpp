@@ -29,6 +29,8 @@
 #include "core/plugins/pluginFactory.h"
 #include "core/plugins/pluginManager.h"
 #include "core/waveFactory.h"
+#include "utils/fs.h"
+#include "utils/log.h"
 #include "utils/vector.h"
 #ifdef G_DEBUG_MODE
 #include <fmt/core.h>
@@ -89,19 +91,20 @@ void Shared::init()
 
 /* -------------------------------------------------------------------------- */
 
-LoadState Shared::load(const Patch& patch, PluginManager& pluginManager, const Sequencer& sequencer, int sampleRate, int bufferSize, Resampler::Quality rsmpQuality)
+LoadState Shared::load(const Patch& patch, PluginManager& pluginManager, const Sequencer& sequencer, int sampleRate,
+    int bufferSize, Resampler::Quality rsmpQuality, const std::function<void(float)>& progress)
 {
 	init();
 
 	LoadState state{patch};
 
-	for (const Patch::Plugin& pplugin : patch.plugins)
+	std::vector<std::unique_ptr<Plugin>> plugins = pluginManager.loadPlugins(patch.plugins, sequencer, sampleRate, bufferSize, progress);
+
+	for (std::size_t i = 0; i < plugins.size(); i++)
 	{
-		std::unique_ptr<juce::AudioPluginInstance> pi = pluginManager.makeJucePlugin(pplugin.path, sampleRate, bufferSize);
-		std::unique_ptr<Plugin>                    p  = pluginFactory::deserializePlugin(pplugin, std::move(pi), sequencer, sampleRate, bufferSize);
-		if (!p->valid)
-			state.missingPlugins.push_back(pplugin.path);
-		getAllPlugins().push_back(std::move(p));
+		if (!plugins[i]->valid)
+			state.missingPlugins.push_back(patch.plugins[i].path);
+		getAllPlugins().push_back(std::move(plugins[i]));
 	}
 
 	for (const Patch::Wave& pwave : patch.waves)
@@ -128,7 +131,26 @@ LoadState Shared::load(const Patch& patch, PluginManager& pluginManager, const S
 void Shared::store(Patch& patch, const std::string& projectPath)
 {
 	for (const auto& p : getAllPlugins())
-		patch.plugins.push_back(pluginFactory::serializePlugin(*p));
+	{
+		/* Invalid (i.e. missing) plug-ins have no state to write: keep the one
+		already in the project folder, if any. */
+
+		Patch::Plugin pplugin = pluginFactory::serializePlugin(*p);
+		if (p->valid)
+		{
+			/* Can't write the sidecar file: embed the state in the patch instead,
+			so that it doesn't point to a missing or stale file. */
+
+			const PluginState state = p->getState();
+			if (!state.save(u::fs::join(projectPath, pplugin.statePath)))
+			{
+				u::log::print("[Shared::store] unable to write state of plug-in {}, storing it in the patch\n", p->id);
+				pplugin.state     = state.asBase64();
+				pplugin.statePath = "";
+			}
+		}
+		patch.plugins.push_back(pplugin);
+	}
 
 	for (auto& w : getAllWaves())
 	{
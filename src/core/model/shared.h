@@ -33,6 +33,7 @@
 #include "core/model/sequencer.h"
 #include "core/plugins/plugin.h"
 #include "core/wave.h"
+#include <functional>
 
 namespace giada::m
 {
@@ -52,9 +53,11 @@ public:
 	void init();
 
 	/* load
-	Loads shared data from a Patch object. */
+	Loads shared data from a Patch object. The callback reports the plug-in
+	loading progress. */
 
-	LoadState load(const Patch&, PluginManager&, const Sequencer&, int sampleRate, int bufferSize, Resampler::Quality);
+	LoadState load(const Patch&, PluginManager&, const Sequencer&, int sampleRate, int bufferSize, Resampler::Quality,
+	    const std::function<void(float)>& progress);
 
 	/* store
 	Stores shared data into a Patch object. */
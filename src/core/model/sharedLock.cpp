@@ -32,14 +32,22 @@ namespace giada::m::model
 SharedLock::SharedLock(Model& m, SwapType t)
 : m_model(m)
 , m_swapType(t)
+, m_transactionLock(m.m_transactionMutex)
+, m_mutexLock(m.m_sharedMutex)
 {
+	/* The lock must reach the realtime thread immediately, even within a
+	Transaction. This also publishes any pending change made so far. */
+
 	m_model.get().locked = true;
-	m_model.swap(SwapType::NONE);
+	m_model.swap_(SwapType::NONE);
 }
 
 SharedLock::~SharedLock()
 {
+	/* Same for the unlock: the realtime thread must not stay locked out until
+	the Transaction ends. */
+
 	m_model.get().locked = false;
-	m_model.swap(m_swapType);
+	m_model.swapNow(m_swapType);
 }
 } // namespace giada::m::model
@@ -28,6 +28,7 @@
 #define G_MODEL_SHAREDLOCK_H
 
 #include "core/model/types.h"
+#include <mutex>
 
 namespace giada::m::model
 {
@@ -41,6 +42,12 @@ public:
 private:
 	Model&   m_model;
 	SwapType m_swapType;
+
+	/* m_transactionLock
+	Taken before m_mutexLock, to keep the same lock order as Transactions. */
+
+	std::unique_lock<std::recursive_mutex> m_transactionLock;
+	std::unique_lock<std::recursive_mutex> m_mutexLock;
 };
 } // namespace giada::m::model
 
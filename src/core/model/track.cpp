@@ -35,8 +35,10 @@ namespace giada::m::model
 {
 Track::Track(std::size_t index, int width, bool internal)
 : width(width)
+, frozenWave(nullptr)
 , m_index(index)
 , m_internal(internal)
+, m_return(false)
 {
 }
 
@@ -75,11 +77,35 @@ bool Track::isInternal() const
 
 /* -------------------------------------------------------------------------- */
 
+bool Track::isFrozen() const
+{
+	return frozenWave != nullptr;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Track::hasSends() const
+{
+	for (const Channel& ch : m_channels.getAll())
+		if (!ch.sends.empty())
+			return true;
+	return false;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Track::isReturn() const
+{
+	return m_return;
+}
+
+/* -------------------------------------------------------------------------- */
+
 #ifdef G_DEBUG_MODE
 
 void Track::debug() const
 {
-	fmt::print("model::track - index={} internal={}\n", m_index, m_internal);
+	fmt::print("model::track - index={} internal={} frozen={}\n", m_index, m_internal, isFrozen());
 	m_channels.debug();
 }
 
@@ -114,6 +140,15 @@ Channel& Track::getGroupChannel()
 
 /* -------------------------------------------------------------------------- */
 
+std::span<const Channel> Track::getMemberChannels() const
+{
+	assert(!m_internal);
+
+	return std::span<const Channel>(m_channels.getAll()).subspan(1);
+}
+
+/* -------------------------------------------------------------------------- */
+
 std::size_t Track::getNumChannels() const
 {
 	return m_channels.getAll().size();
@@ -28,6 +28,12 @@
 #define G_MODEL_TRACK_H
 
 #include "core/model/channels.h"
+#include <span>
+
+namespace giada::m
+{
+class Wave;
+}
 
 namespace giada::m::model
 {
@@ -47,6 +53,12 @@ public:
 	const Channel&  getGroupChannel() const;
 	std::size_t     getNumChannels() const;
 
+	/* getMemberChannels
+	Returns the channels summed by the Group Channel, i.e. all of them but the
+	Group Channel itself. Non-internal tracks only. */
+
+	std::span<const Channel> getMemberChannels() const;
+
 	/* getIndex
 	Returns this Track index. */
 
@@ -63,6 +75,24 @@ public:
 
 	bool isInternal() const;
 
+	/* isFrozen
+	True if the track has been rendered to a Wave: its channels and plug-ins are
+	not processed anymore, the frozen Wave is played instead. */
+
+	bool isFrozen() const;
+
+	/* hasSends
+	True if any channel in the track, Group Channel included, sends to a return
+	bus. */
+
+	bool hasSends() const;
+
+	/* isReturn
+	True if the track acts as a return bus, i.e. any channel sends to its Group
+	Channel. Kept up to date by Tracks::updateReturns(). */
+
+	bool isReturn() const;
+
 #ifdef G_DEBUG_MODE
 	void debug() const;
 #endif
@@ -77,10 +107,17 @@ public:
 
 	int width;
 
+	/* frozenWave
+	Rendered output of the whole track, one loop long. Null if the track is not
+	frozen. */
+
+	Wave* frozenWave;
+
 private:
 	Channels    m_channels;
 	std::size_t m_index;
 	bool        m_internal;
+	bool        m_return;
 };
 } // namespace giada::m::model
 
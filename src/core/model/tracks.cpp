@@ -59,6 +59,8 @@ void Tracks::remove(std::size_t index)
 
 	for (std::size_t index = 0; Track & track : m_tracks)
 		track.m_index = index++;
+
+	updateReturns();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -92,6 +94,16 @@ Channel& Tracks::getChannel(ID channelId)
 
 /* -------------------------------------------------------------------------- */
 
+const Channel* Tracks::findChannel(ID channelId) const
+{
+	for (const Track& track : m_tracks)
+		if (const Channel* ch = track.findChannel(channelId); ch != nullptr)
+			return ch;
+	return nullptr;
+}
+
+/* -------------------------------------------------------------------------- */
+
 void Tracks::forEachChannel(std::function<bool(Channel&)> f)
 {
 	for (Track& track : m_tracks)
@@ -115,6 +127,17 @@ std::vector<Channel*> Tracks::getChannelsIf(std::function<bool(const Channel&)>
 
 /* -------------------------------------------------------------------------- */
 
+void Tracks::removeSendsTo(ID returnId)
+{
+	for (Track& track : m_tracks)
+		for (Channel& channel : track.getChannels().getAll())
+			std::erase_if(channel.sends, [returnId](const Send& send)
+			{ return send.returnId == returnId; });
+	updateReturns();
+}
+
+/* -------------------------------------------------------------------------- */
+
 bool Tracks::anyChannelOf(std::function<bool(const Channel&)> f) const
 {
 	for (const Track& track : m_tracks)
@@ -125,6 +148,21 @@ bool Tracks::anyChannelOf(std::function<bool(const Channel&)> f) const
 
 /* -------------------------------------------------------------------------- */
 
+void Tracks::updateReturns()
+{
+	for (Track& track : m_tracks)
+		track.m_return = false;
+
+	for (const Track& track : m_tracks)
+		for (const Channel& channel : track.getChannels().getAll())
+			for (const Send& send : channel.sends)
+				for (Track& target : m_tracks)
+					if (!target.isInternal() && target.getGroupChannel().id == send.returnId)
+						target.m_return = true;
+}
+
+/* -------------------------------------------------------------------------- */
+
 std::vector<const Channel*> Tracks::getChannels() const
 {
 	std::vector<const Channel*> out;
@@ -166,6 +204,7 @@ void Tracks::addChannel(Channel&& channel, std::size_t trackIndex)
 	assert(trackIndex <= m_tracks.size());
 
 	m_tracks[trackIndex].addChannel(std::move(channel));
+	updateReturns();
 }
 
 void Tracks::addChannel(Channel&& channel, std::size_t trackIndex, std::size_t position)
@@ -174,6 +213,7 @@ void Tracks::addChannel(Channel&& channel, std::size_t trackIndex, std::size_t p
 	assert(trackIndex <= m_tracks.size());
 
 	m_tracks[trackIndex].addChannel(std::move(channel), position);
+	updateReturns();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -181,6 +221,7 @@ void Tracks::addChannel(Channel&& channel, std::size_t trackIndex, std::size_t p
 void Tracks::removeChannel(ID channelId)
 {
 	getByChannel(channelId).removeChannel(channelId);
+	updateReturns();
 }
 
 /* -------------------------------------------------------------------------- */
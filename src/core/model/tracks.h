@@ -41,6 +41,7 @@ class Tracks
 public:
 	const std::vector<Track>&   getAll() const;
 	const Channel&              getChannel(ID) const;
+	const Channel*              findChannel(ID) const;
 	bool                        anyChannelOf(std::function<bool(const Channel&)> f) const;
 	std::vector<const Channel*> getChannels() const;
 
@@ -69,6 +70,17 @@ public:
 	void                  forEachChannel(std::function<bool(Channel&)>);
 	std::vector<Channel*> getChannelsIf(std::function<bool(const Channel&)>);
 
+	/* removeSendsTo
+	Removes all sends pointing to the given return bus. */
+
+	void removeSendsTo(ID returnId);
+
+	/* updateReturns
+	Recomputes the return bus flag of each track. Must be called whenever sends,
+	channels or tracks change outside of the methods above, which already do it. */
+
+	void updateReturns();
+
 private:
 	std::vector<Track> m_tracks;
 };
@@ -0,0 +1,51 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/model/transaction.h"
+#include "core/model/model.h"
+#include <utility>
+
+namespace giada::m::model
+{
+Transaction::Transaction(Model& m)
+: m_model(m)
+, m_active(true)
+{
+	m_model.beginTransaction_();
+}
+
+Transaction::Transaction(Transaction&& o) noexcept
+: m_model(o.m_model)
+, m_active(std::exchange(o.m_active, false))
+{
+}
+
+Transaction::~Transaction()
+{
+	if (m_active)
+		m_model.endTransaction_();
+}
+} // namespace giada::m::model
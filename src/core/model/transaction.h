@@ -0,0 +1,55 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_MODEL_TRANSACTION_H
+#define G_MODEL_TRANSACTION_H
+
+#include "core/model/types.h"
+
+namespace giada::m::model
+{
+class Model;
+class Transaction
+{
+public:
+	Transaction(Model&);
+	~Transaction();
+
+	/* A Transaction ends exactly once: no copies. A moved-from Transaction
+	doesn't end anything. */
+
+	Transaction(const Transaction&) = delete;
+	Transaction(Transaction&&) noexcept;
+	Transaction& operator=(const Transaction&) = delete;
+	Transaction& operator=(Transaction&&)      = delete;
+
+private:
+	Model& m_model;
+	bool   m_active;
+};
+} // namespace giada::m::model
+
+#endif
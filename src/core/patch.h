@@ -30,6 +30,7 @@
 #include "core/const.h"
 #include "core/types.h"
 #include <cstdint>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -52,6 +53,7 @@ struct Patch
 		int             width;
 		bool            internal;
 		std::vector<ID> channels;
+		ID              frozenWaveId = 0;
 	};
 
 	struct Channel
@@ -94,19 +96,23 @@ struct Patch
 		uint32_t         midiInReadActions;
 		uint32_t         midiInPitch;
 		// midi channel
-		bool            midiOut;
-		int             midiOutChan;
-		std::vector<ID> pluginIds;
+		bool              midiOut;
+		int               midiOutChan;
+		std::vector<ID>   pluginIds;
+		std::vector<Send> sends;
 	};
 
 	struct Action
 	{
-		ID       id;
-		ID       channelId;
-		Frame    frame;
-		uint32_t event;
-		ID       prevId;
-		ID       nextId;
+		ID                   id;
+		ID                   channelId;
+		Frame                frame;
+		uint32_t             event;
+		ID                   prevId;
+		ID                   nextId;
+		ID                   pluginId    = -1;
+		int                  pluginParam = -1;
+		std::optional<float> value       = {}; // Plug-in parameter or volume envelope value
 	};
 
 	struct Wave
@@ -121,7 +127,8 @@ struct Patch
 		std::string           path;
 		bool                  bypass;
 		std::vector<float>    params; // TODO - to be removed in 0.18.0
-		std::string           state;
+		std::string           state;     // Base64, up to 1.2.0 or if 'statePath' couldn't be written
+		std::string           statePath; // Binary sidecar file
 		std::vector<uint32_t> midiInParams;
 	};
 
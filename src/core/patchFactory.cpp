@@ -57,8 +57,9 @@ void readTracks_(Patch& patch, const nlohmann::json& j)
 	for (const auto& jtrack : j[PATCH_KEY_TRACKS])
 	{
 		Patch::Track track;
-		track.width    = jtrack.value(PATCH_KEY_TRACK_WIDTH, G_DEFAULT_TRACK_WIDTH);
-		track.internal = jtrack.value(PATCH_KEY_TRACK_INTERNAL, false);
+		track.width        = jtrack.value(PATCH_KEY_TRACK_WIDTH, G_DEFAULT_TRACK_WIDTH);
+		track.internal     = jtrack.value(PATCH_KEY_TRACK_INTERNAL, false);
+		track.frozenWaveId = jtrack.value(PATCH_KEY_TRACK_FROZEN_WAVE, 0);
 		if (jtrack.contains(PATCH_KEY_TRACK_CHANNELS))
 			for (const auto& jplugin : jtrack[PATCH_KEY_TRACK_CHANNELS])
 				track.channels.push_back(jplugin);
@@ -69,7 +70,7 @@ void readTracks_(Patch& patch, const nlohmann::json& j)
 
 /* -------------------------------------------------------------------------- */
 
-void readPlugins_(Patch& patch, const nlohmann::json& j)
+void readPlugins_(Patch& patch, const nlohmann::json& j, const std::string& basePath)
 {
 	if (!j.contains(PATCH_KEY_PLUGINS))
 		return;
@@ -88,6 +89,9 @@ void readPlugins_(Patch& patch, const nlohmann::json& j)
 		else
 			p.state = jplugin.value(PATCH_KEY_PLUGIN_STATE, "");
 
+		if (jplugin.contains(PATCH_KEY_PLUGIN_STATE_PATH))
+			p.statePath = u::fs::join(basePath, jplugin.value(PATCH_KEY_PLUGIN_STATE_PATH, ""));
+
 		for (const auto& jmidiParam : jplugin[PATCH_KEY_PLUGIN_MIDI_IN_PARAMS])
 			p.midiInParams.push_back(jmidiParam);
 
@@ -123,12 +127,16 @@ void readActions_(Patch& patch, const nlohmann::json& j)
 	for (const auto& jaction : j[PATCH_KEY_ACTIONS])
 	{
 		Patch::Action a;
-		a.id        = jaction.value(G_PATCH_KEY_ACTION_ID, ++id);
-		a.channelId = jaction.value(G_PATCH_KEY_ACTION_CHANNEL, 0);
-		a.frame     = jaction.value(G_PATCH_KEY_ACTION_FRAME, 0);
-		a.event     = jaction.value(G_PATCH_KEY_ACTION_EVENT, 0);
-		a.prevId    = jaction.value(G_PATCH_KEY_ACTION_PREV, 0);
-		a.nextId    = jaction.value(G_PATCH_KEY_ACTION_NEXT, 0);
+		a.id          = jaction.value(G_PATCH_KEY_ACTION_ID, ++id);
+		a.channelId   = jaction.value(G_PATCH_KEY_ACTION_CHANNEL, 0);
+		a.frame       = jaction.value(G_PATCH_KEY_ACTION_FRAME, 0);
+		a.event       = jaction.value(G_PATCH_KEY_ACTION_EVENT, 0);
+		a.prevId      = jaction.value(G_PATCH_KEY_ACTION_PREV, 0);
+		a.nextId      = jaction.value(G_PATCH_KEY_ACTION_NEXT, 0);
+		a.pluginId    = jaction.value(G_PATCH_KEY_ACTION_PLUGIN, -1);
+		a.pluginParam = jaction.value(G_PATCH_KEY_ACTION_PLUGIN_PARAM, -1);
+		if (jaction.contains(G_PATCH_KEY_ACTION_VALUE))
+			a.value = jaction[G_PATCH_KEY_ACTION_VALUE].get<float>();
 		patch.actions.push_back(a);
 	}
 }
@@ -188,6 +196,11 @@ void readChannels_(Patch& patch, const nlohmann::json& j)
 			for (const auto& jplugin : jchannel[PATCH_KEY_CHANNEL_PLUGINS])
 				c.pluginIds.push_back(jplugin);
 
+		if (jchannel.contains(PATCH_KEY_CHANNEL_SENDS))
+			for (const auto& jsend : jchannel[PATCH_KEY_CHANNEL_SENDS])
+				c.sends.push_back({jsend.value(PATCH_KEY_CHANNEL_SEND_RETURN_ID, 0),
+				    jsend.value(PATCH_KEY_CHANNEL_SEND_LEVEL, 0.0f)});
+
 		patch.channels.push_back(c);
 	}
 }
@@ -205,7 +218,11 @@ void writePlugins_(const Patch& patch, nlohmann::json& j)
 		jplugin[PATCH_KEY_PLUGIN_ID]     = p.id;
 		jplugin[PATCH_KEY_PLUGIN_PATH]   = p.path;
 		jplugin[PATCH_KEY_PLUGIN_BYPASS] = p.bypass;
-		jplugin[PATCH_KEY_PLUGIN_STATE]  = p.state;
+
+		if (p.statePath.empty())
+			jplugin[PATCH_KEY_PLUGIN_STATE] = p.state;
+		else
+			jplugin[PATCH_KEY_PLUGIN_STATE_PATH] = p.statePath;
 
 		jplugin[PATCH_KEY_PLUGIN_MIDI_IN_PARAMS] = nlohmann::json::array();
 		for (uint32_t param : p.midiInParams)
@@ -224,9 +241,10 @@ void writeTracks_(const Patch& patch, nlohmann::json& j)
 	for (const Patch::Track& track : patch.tracks)
 	{
 		nlohmann::json jtrack;
-		jtrack[PATCH_KEY_TRACK_WIDTH]    = track.width;
-		jtrack[PATCH_KEY_TRACK_INTERNAL] = track.internal;
-		jtrack[PATCH_KEY_TRACK_CHANNELS] = nlohmann::json::array();
+		jtrack[PATCH_KEY_TRACK_WIDTH]       = track.width;
+		jtrack[PATCH_KEY_TRACK_INTERNAL]    = track.internal;
+		jtrack[PATCH_KEY_TRACK_FROZEN_WAVE] = track.frozenWaveId;
+		jtrack[PATCH_KEY_TRACK_CHANNELS]    = nlohmann::json::array();
 		for (ID channelId : track.channels)
 			jtrack[PATCH_KEY_TRACK_CHANNELS].push_back(channelId);
 
@@ -249,6 +267,13 @@ void writeActions_(const Patch& patch, nlohmann::json& j)
 		jaction[G_PATCH_KEY_ACTION_EVENT]   = a.event;
 		jaction[G_PATCH_KEY_ACTION_PREV]    = a.prevId;
 		jaction[G_PATCH_KEY_ACTION_NEXT]    = a.nextId;
+		if (a.pluginId != -1)
+		{
+			jaction[G_PATCH_KEY_ACTION_PLUGIN]       = a.pluginId;
+			jaction[G_PATCH_KEY_ACTION_PLUGIN_PARAM] = a.pluginParam;
+		}
+		if (a.value.has_value())
+			jaction[G_PATCH_KEY_ACTION_VALUE] = *a.value;
 		j[PATCH_KEY_ACTIONS].push_back(jaction);
 	}
 }
@@ -339,6 +364,15 @@ void writeChannels_(const Patch& patch, nlohmann::json& j)
 		for (ID pid : c.pluginIds)
 			jchannel[PATCH_KEY_CHANNEL_PLUGINS].push_back(pid);
 
+		jchannel[PATCH_KEY_CHANNEL_SENDS] = nlohmann::json::array();
+		for (const Send& send : c.sends)
+		{
+			nlohmann::json jsend;
+			jsend[PATCH_KEY_CHANNEL_SEND_RETURN_ID] = send.returnId;
+			jsend[PATCH_KEY_CHANNEL_SEND_LEVEL]     = send.level;
+			jchannel[PATCH_KEY_CHANNEL_SENDS].push_back(jsend);
+		}
+
 		j[PATCH_KEY_CHANNELS].push_back(jchannel);
 	}
 }
@@ -452,7 +486,7 @@ Patch deserialize(const std::string& filePath)
 
 		readCommons_(patch, j);
 		readTracks_(patch, j);
-		readPlugins_(patch, j);
+		readPlugins_(patch, j, u::fs::dirname(filePath));
 		readWaves_(patch, j, u::fs::dirname(filePath));
 		readActions_(patch, j);
 		readChannels_(patch, j);
@@ -26,9 +26,11 @@
 
 #include "core/plugins/plugin.h"
 #include "core/const.h"
+#include "utils/alloc.h"
 #include "utils/log.h"
 #include "utils/time.h"
 #include <FL/Fl.H>
+#include <algorithm>
 #include <cassert>
 #include <memory>
 
@@ -64,6 +66,7 @@ Plugin::Plugin(ID id, std::unique_ptr<juce::AudioPluginInstance> plugin,
 		midiInParams.emplace_back(0x0, i);
 
 	m_buffer.setSize(G_MAX_IO_CHANS, buffersize);
+	m_midiBuffer.ensureSize(G_MIDI_BUFFER_BYTES);
 
 	/* Try to set the main bus to the current number of channels. In the future
 	this setup will be performed manually through a proper channel matrix. */
@@ -187,6 +190,22 @@ bool Plugin::isSuspended() const
 	return m_plugin->isSuspended();
 }
 
+void Plugin::setSuspended(bool b)
+{
+	if (!valid)
+		return;
+	m_plugin->suspendProcessing(b);
+}
+
+/* -------------------------------------------------------------------------- */
+
+int Plugin::getLatency() const
+{
+	if (!valid)
+		return 0;
+	return std::max(0, m_plugin->getLatencySamples());
+}
+
 /* -------------------------------------------------------------------------- */
 
 bool Plugin::isInstrument() const
@@ -214,15 +233,38 @@ void Plugin::setBypass(bool b) { m_bypass.store(b); }
 
 /* -------------------------------------------------------------------------- */
 
-const Plugin::Buffer& Plugin::process(const Plugin::Buffer& out, juce::MidiBuffer m)
+void Plugin::process(Plugin::Buffer& out, const juce::MidiBuffer& m)
 {
-	/* Copy the incoming buffer data into the temporary one. This way FXes will
-	process	existing audio data on the private buffer. This is needed later on
-	when merging it back into the incoming buffer. */
+	const int numSamples     = out.getNumSamples();
+	const int numOutChannels = std::max(1, countMainOutChannels());
+
+	/* Copying raw data into a buffer with enough room doesn't allocate. */
+
+	m_midiBuffer.clear();
+	m_midiBuffer.addEvents(m, 0, -1, 0);
+
+	/* What happens inside the plug-in is out of our control. */
+
+	G_ALLOC_ALLOW();
+
+	if (!isInstrument())
+	{
+		m_plugin->processBlock(out, m_midiBuffer);
+
+		/* Plug-ins with fewer output channels than the buffer (e.g. mono FX)
+		leave the remaining channels untouched: fill them with the last one
+		produced. */
+
+		for (int i = numOutChannels; i < out.getNumChannels(); i++)
+			out.copyFrom(i, 0, out, numOutChannels - 1, 0, numSamples);
+		return;
+	}
+
+	m_buffer.makeCopyOf(out, /*avoidReallocating=*/true);
+	m_plugin->processBlock(m_buffer, m_midiBuffer);
 
-	m_buffer = out;
-	m_plugin->processBlock(m_buffer, m);
-	return m_buffer;
+	for (int i = 0; i < out.getNumChannels(); i++)
+		out.addFrom(i, 0, m_buffer, std::min(i, numOutChannels - 1), 0, numSamples);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -88,18 +88,32 @@ public:
 
 	int countMainOutChannels() const;
 
+	/* getLatency
+	Returns the processing delay introduced by the plug-in, in frames. Cheap,
+	safe to call from the realtime thread. */
+
+	int getLatency() const;
+
 	/* process
-	Process the plug-in with audio and MIDI data. The audio buffer is a
-	reference, while the MIDI buffer must be passed by copy: each plug-in must
-	receive its own copy of the event set, so that any attempt to change/clear
-	the MIDI buffer will only modify the local copy. Returns a reference of the
-	local buffer filled with processed data. */
+	Process the plug-in with audio and MIDI data. Each plug-in receives its own
+	copy of the MIDI events, made into a preallocated buffer, so that any
+	attempt to change/clear the MIDI buffer will only modify the local copy.
+	FX plug-ins process the
+	audio buffer in place. Instruments render into a local buffer instead, which
+	is then summed to the audio buffer: this allows multiple instruments to play
+	simultaneously on a given set of MIDI events. */
 
-	const Buffer& process(const Buffer& b, juce::MidiBuffer m);
+	void process(Buffer& b, const juce::MidiBuffer& m);
 
 	void setState(PluginState p);
 	void setBypass(bool b);
 
+	/* setSuspended
+	Suspends or resumes processing. A suspended plug-in is skipped by the
+	PluginHost and reports no latency, e.g. while its track is frozen. */
+
+	void setSuspended(bool b);
+
 	/* id
 	Unique identifier. */
 
@@ -140,6 +154,7 @@ private:
 	std::unique_ptr<juce::AudioPluginInstance> m_plugin;
 	std::unique_ptr<PluginHost::Info>          m_playHead;
 	Buffer                                     m_buffer;
+	juce::MidiBuffer                           m_midiBuffer;
 
 	std::atomic<bool> m_bypass;
 
@@ -28,12 +28,28 @@
 #include "core/idManager.h"
 #include "core/plugins/plugin.h"
 #include "core/plugins/pluginHost.h"
+#include <fmt/core.h>
+#include <mutex>
 
 namespace giada::m::pluginFactory
 {
 namespace
 {
 IdManager pluginId_;
+
+/* pluginIdMutex_
+Plug-ins can be created concurrently while loading a patch: see
+PluginManager::loadPlugins. */
+
+std::mutex pluginIdMutex_;
+
+/* -------------------------------------------------------------------------- */
+
+ID generateId_(ID id)
+{
+	const std::scoped_lock lock(pluginIdMutex_);
+	return pluginId_.generate(id);
+}
 } // namespace
 
 /* -------------------------------------------------------------------------- */
@@ -42,6 +58,7 @@ IdManager pluginId_;
 
 void reset()
 {
+	const std::scoped_lock lock(pluginIdMutex_);
 	pluginId_ = IdManager();
 }
 
@@ -49,7 +66,7 @@ void reset()
 
 std::unique_ptr<Plugin> createInvalid(ID id, const std::string& pid)
 {
-	return std::make_unique<Plugin>(pluginId_.generate(id), pid);
+	return std::make_unique<Plugin>(generateId_(id), pid);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -65,7 +82,7 @@ std::unique_ptr<Plugin> create(ID id, const std::string& pid, std::unique_ptr<ju
 		return pluginFactory::createInvalid(id, pid);
 
 	return std::make_unique<Plugin>(
-	    pluginId_.generate(id),
+	    generateId_(id),
 	    std::move(pi),
 	    std::make_unique<PluginHost::Info>(sequencer, sampleRate),
 	    sampleRate, bufferSize);
@@ -86,7 +103,7 @@ std::unique_ptr<Plugin> deserializePlugin(const Patch::Plugin& pplugin, std::uni
 	std::unique_ptr<Plugin> plugin = create(pplugin.id, pplugin.path, std::move(pi), sequencer, sampleRate, bufferSize);
 
 	plugin->setBypass(pplugin.bypass);
-	plugin->setState(PluginState(pplugin.state));
+	plugin->setState(pplugin.statePath.empty() ? PluginState(pplugin.state) : PluginState::fromFile(pplugin.statePath));
 
 	/* Fill plug-in MidiIn parameters. Don't fill Plugin::midiInParam if
 	Patch::midiInParams are zero: it would wipe out the current default 0x0
@@ -108,10 +125,10 @@ std::unique_ptr<Plugin> deserializePlugin(const Patch::Plugin& pplugin, std::uni
 Patch::Plugin serializePlugin(const Plugin& p)
 {
 	Patch::Plugin pp;
-	pp.id     = p.id;
-	pp.path   = p.getUniqueId();
-	pp.bypass = p.isBypassed();
-	pp.state  = p.getState().asBase64();
+	pp.id        = p.id;
+	pp.path      = p.getUniqueId();
+	pp.bypass    = p.isBypassed();
+	pp.statePath = fmt::format("plugin_{}.state", p.id);
 
 	for (const MidiLearnParam& param : p.midiInParams)
 		pp.midiInParams.push_back(param.getValue());
@@ -57,6 +57,12 @@ std::unique_ptr<Plugin> create(ID id, const std::string& pid, std::unique_ptr<ju
 std::unique_ptr<Plugin> deserializePlugin(const Patch::Plugin&, std::unique_ptr<juce::AudioPluginInstance>,
     const model::Sequencer&, int sampleRate, int bufferSize);
 
+/* serializePlugin
+Plug-in state is not part of the returned Patch::Plugin: it must be saved
+separately with Plugin::getState().save(), into the project folder, to the
+file name in Patch::Plugin::statePath. If that fails, store the state in
+Patch::Plugin::state and clear statePath. */
+
 Patch::Plugin serializePlugin(const Plugin&);
 } // namespace giada::m::pluginFactory
 
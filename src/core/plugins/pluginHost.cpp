@@ -30,15 +30,54 @@
 #include "core/model/model.h"
 #include "core/plugins/plugin.h"
 #include "core/plugins/pluginManager.h"
+#include "core/profiler.h"
 #include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
 #include "utils/log.h"
 #include "utils/vector.h"
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <memory>
 
 namespace giada::m
 {
+namespace
+{
+bool isActive_(const Plugin* p)
+{
+	return p->valid && !p->isSuspended() && !p->isBypassed();
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* applyParamChange_
+Sets a parameter value, skipping indexes that are out of range (e.g. actions
+recorded with a different version of the plug-in). */
+
+void applyParamChange_(const Plugin& p, const PluginParamChange& change)
+{
+	if (change.paramIndex >= 0 && change.paramIndex < p.getNumParameters())
+		p.setParameter(change.paramIndex, change.value);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* applyParamChanges_
+Applies all changes for the given plug-in at once. Used for plug-ins that are
+not processed, so that they are up to date once they come back. */
+
+void applyParamChanges_(const Plugin& p, std::span<const PluginParamChange> changes)
+{
+	for (const PluginParamChange& change : changes)
+		if (change.pluginId == p.id)
+			applyParamChange_(p, change);
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
 PluginHost::Info::Info(const model::Sequencer& s, int sampleRate)
 : m_sequencer(s)
 , m_sampleRate(sampleRate)
@@ -70,9 +109,12 @@ bool PluginHost::Info::canControlTransport()
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
-PluginHost::PluginHost(model::Model& m)
+PluginHost::PluginHost(model::Model& m, Profiler& p)
 : m_model(m)
+, m_profiler(p)
+, m_outputLatency(0)
 {
+	m_segmentEvents.ensureSize(G_MIDI_BUFFER_BYTES);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -93,26 +135,43 @@ void PluginHost::setBufferSize(int bufferSize)
 /* -------------------------------------------------------------------------- */
 
 void PluginHost::processStack(mcl::AudioBuffer& outBuf, const std::vector<Plugin*>& plugins,
-    const juce::MidiBuffer* events)
+    const juce::MidiBuffer& events, std::span<const PluginParamChange> changes)
 {
 	assert(outBuf.countFrames() == m_audioBuffer.getNumSamples());
 
-	if (plugins.empty())
-		return;
-
-	giadaToJuceTempBuf(outBuf);
+	/* Nothing would touch the audio: spare the round trip through the planar
+	buffer. */
 
-	if (events == nullptr)
+	if (std::none_of(plugins.begin(), plugins.end(), isActive_))
 	{
-		juce::MidiBuffer dummyEvents; // empty
-		processPlugins(plugins, dummyEvents);
+		for (const Plugin* p : plugins)
+			if (p->valid)
+				applyParamChanges_(*p, changes);
+		return;
 	}
-	else
-		processPlugins(plugins, *events);
 
+	giadaToJuceTempBuf(outBuf);
+	processPlugins(plugins, events, changes);
 	juceToGiadaOutBuf(outBuf);
 }
 
+void PluginHost::processStack(mcl::AudioBuffer& outBuf, const std::vector<Plugin*>& plugins,
+    const juce::MidiBuffer& events)
+{
+	processStack(outBuf, plugins, events, {});
+}
+
+void PluginHost::processStack(mcl::AudioBuffer& outBuf, const std::vector<Plugin*>& plugins,
+    std::span<const PluginParamChange> changes)
+{
+	processStack(outBuf, plugins, m_noEvents, changes);
+}
+
+void PluginHost::processStack(mcl::AudioBuffer& outBuf, const std::vector<Plugin*>& plugins)
+{
+	processStack(outBuf, plugins, m_noEvents, {});
+}
+
 /* -------------------------------------------------------------------------- */
 
 const Plugin& PluginHost::addPlugin(std::unique_ptr<Plugin> p)
@@ -133,13 +192,19 @@ void PluginHost::swapPlugin(const m::Plugin& p1, const m::Plugin& p2, std::vecto
 
 void PluginHost::freePlugin(const m::Plugin& plugin)
 {
+	const ID pluginId = plugin.id;
 	m_model.removePlugin(plugin);
+	m_profiler.releasePlugin(pluginId);
 }
 
 void PluginHost::freePlugins(const std::vector<Plugin*>& plugins)
 {
 	for (const Plugin* p : plugins)
+	{
+		const ID pluginId = p->id;
 		m_model.removePlugin(*p);
+		m_profiler.releasePlugin(pluginId);
+	}
 }
 
 /* -------------------------------------------------------------------------- */
@@ -147,6 +212,30 @@ void PluginHost::freePlugins(const std::vector<Plugin*>& plugins)
 void PluginHost::freeAllPlugins()
 {
 	m_model.clearPlugins();
+	m_profiler.releaseAllPlugins();
+}
+
+/* -------------------------------------------------------------------------- */
+
+Frame PluginHost::getLatency(const std::vector<Plugin*>& plugins) const
+{
+	Frame latency = 0;
+	for (const Plugin* p : plugins)
+		if (isActive_(p))
+			latency += p->getLatency();
+	return latency;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Frame PluginHost::getOutputLatency() const
+{
+	return m_outputLatency.load(std::memory_order_relaxed);
+}
+
+void PluginHost::setOutputLatency(Frame latency)
+{
+	m_outputLatency.store(latency, std::memory_order_relaxed);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -201,40 +290,69 @@ void PluginHost::juceToGiadaOutBuf(mcl::AudioBuffer& outBuf) const
 
 /* -------------------------------------------------------------------------- */
 
-void PluginHost::processPlugins(const std::vector<Plugin*>& plugins, const juce::MidiBuffer& events)
+void PluginHost::processPlugins(const std::vector<Plugin*>& plugins, const juce::MidiBuffer& events,
+    std::span<const PluginParamChange> changes)
 {
 	for (Plugin* p : plugins)
 	{
-		if (!p->valid || p->isSuspended() || p->isBypassed())
-			continue;
-		processPlugin(p, events);
+		if (isActive_(p))
+			processPlugin(p, events, changes);
+		else if (p->valid)
+			applyParamChanges_(*p, changes);
 	}
 }
 
 /* -------------------------------------------------------------------------- */
 
-void PluginHost::processPlugin(Plugin* p, const juce::MidiBuffer& events)
+void PluginHost::processPlugin(Plugin* p, const juce::MidiBuffer& events, std::span<const PluginParamChange> changes)
 {
-	const Plugin::Buffer& pluginBuffer = p->process(m_audioBuffer, events);
-	const bool            isInstrument = p->isInstrument();
+	const auto t0        = Profiler::now();
+	const int  numFrames = m_audioBuffer.getNumSamples();
+
+	/* Apply the changes due before the end of the minimum segment length, then
+	render up to the next change. With no changes the whole block is rendered in
+	one go, as usual. */
+
+	auto change = changes.begin();
+	for (int start = 0; start < numFrames;)
+	{
+		int end = numFrames;
+		for (; change != changes.end(); ++change)
+		{
+			if (change->pluginId != p->id)
+				continue;
+			if (change->frame >= start + G_MIN_PARAM_SEGMENT)
+			{
+				end = std::min(change->frame, numFrames);
+				break;
+			}
+			applyParamChange_(*p, *change);
+		}
+		processSegment(*p, events, start, end - start);
+		start = end;
+	}
+
+	m_profiler.recordPlugin(p->id, Profiler::now() - t0);
+}
 
-	/* Merge the plugin buffer back into the local one. Special care is needed
-	if audio channels mismatch. */
+/* -------------------------------------------------------------------------- */
 
-	for (int i = 0, j = 0; i < m_audioBuffer.getNumChannels(); i++)
+void PluginHost::processSegment(Plugin& p, const juce::MidiBuffer& events, int start, int length)
+{
+	if (length == m_audioBuffer.getNumSamples())
 	{
-		/* If instrument (i.e. a plug-in that accepts MIDI and produces audio
-		out of it), SUM the local working buffer to the main one. This allows
-		multiple plug-in instruments to play simultaneously on a given set of
-		MIDI events. If it's a normal FX instead (!isInstrument), the local
-		working buffer is simply copied over the main one. */
-
-		if (isInstrument)
-			m_audioBuffer.addFrom(i, 0, pluginBuffer, j, 0, pluginBuffer.getNumSamples());
-		else
-			m_audioBuffer.copyFrom(i, 0, pluginBuffer, j, 0, pluginBuffer.getNumSamples());
-		if (i < p->countMainOutChannels() - 1)
-			j++;
+		p.process(m_audioBuffer, events);
+		return;
 	}
+
+	/* A buffer referring to the private one doesn't allocate, nor does copying
+	raw data into a buffer with enough room. */
+
+	Plugin::Buffer segment(m_audioBuffer.getArrayOfWritePointers(), m_audioBuffer.getNumChannels(), start, length);
+
+	m_segmentEvents.clear();
+	m_segmentEvents.addEvents(events, start, length, -start);
+
+	p.process(segment, m_segmentEvents);
 }
-} // namespace giada::m
\ No newline at end of file
+} // namespace giada::m
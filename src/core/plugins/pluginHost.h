@@ -29,6 +29,7 @@
 
 #include "core/const.h"
 #include "core/types.h"
+#include <atomic>
 #include <functional>
 /* windows.h, included somewhere, defines 'small' as a macro and it clashes with
 some enum defined in the JUCE GUI module. */
@@ -38,6 +39,7 @@ some enum defined in the JUCE GUI module. */
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <memory>
+#include <span>
 
 namespace mcl
 {
@@ -47,7 +49,8 @@ class AudioBuffer;
 namespace giada::m
 {
 class Plugin;
-}
+class Profiler;
+} // namespace giada::m
 
 namespace giada::m::model
 {
@@ -73,7 +76,7 @@ public:
 		int                     m_sampleRate;
 	};
 
-	PluginHost(model::Model&);
+	PluginHost(model::Model&, Profiler&);
 
 	/* reset
 	Brings everything back to the initial state. */
@@ -92,11 +95,34 @@ public:
 
 	const Plugin& addPlugin(std::unique_ptr<Plugin> p);
 
-	/* processStack
-	Applies the fx list to the buffer. */
+	/* processStack (1)
+	Applies the fx list to the buffer, together with MIDI events and parameter
+	changes (sorted by frame). Each plug-in processes the block in segments, split
+	at the frames where its own parameters change, so that automation is
+	sample-accurate. Changes closer than G_MIN_PARAM_SEGMENT frames are applied
+	together, to avoid tiny segments. 'outBuf' is interleaved, like every other
+	channel and track buffer: it is converted to the private planar buffer once
+	before the stack and back once after it, only if some plug-in is active. */
+
+	void processStack(mcl::AudioBuffer& outBuf, const std::vector<Plugin*>& plugins,
+	    const juce::MidiBuffer& events, std::span<const PluginParamChange> changes);
+
+	/* processStack (2)
+	Applies the fx list to the buffer, together with MIDI events. */
 
 	void processStack(mcl::AudioBuffer& outBuf, const std::vector<Plugin*>& plugins,
-	    const juce::MidiBuffer* events = nullptr);
+	    const juce::MidiBuffer& events);
+
+	/* processStack (3)
+	Applies the fx list to the buffer, together with parameter changes. */
+
+	void processStack(mcl::AudioBuffer& outBuf, const std::vector<Plugin*>& plugins,
+	    std::span<const PluginParamChange> changes);
+
+	/* processStack (4)
+	Applies the fx list to the buffer, with no MIDI events. */
+
+	void processStack(mcl::AudioBuffer& outBuf, const std::vector<Plugin*>& plugins);
 
 	/* swapPlugin
 	Swaps plug-in 1 with plug-in 2 in the plug-in vector. */
@@ -118,29 +144,63 @@ public:
 
 	void freeAllPlugins();
 
+	/* getLatency
+	Returns the overall latency of the plug-in stack, in frames. Bypassed,
+	suspended or invalid plug-ins don't count. Realtime-safe. */
+
+	Frame getLatency(const std::vector<Plugin*>& plugins) const;
+
+	/* [get|set]OutputLatency
+	Latency added by plug-ins to the final output, i.e. the one of the slowest
+	track plus the master out stack. Set by the Renderer on each block. */
+
+	Frame getOutputLatency() const;
+	void  setOutputLatency(Frame);
+
 	void setPluginParameter(ID pluginId, int paramIndex, float value);
 	void setPluginProgram(ID pluginId, int programIndex);
 	void toggleBypass(ID pluginId);
 
 private:
 	/* giadaToJuceTempBuf
-	Copies the Giada buffer 'outBuf' to the private JUCE buffer for local
-	processing. */
+	Deinterleaves the Giada buffer 'outBuf' into the private JUCE buffer, where
+	the whole stack processes in place. */
 
 	void giadaToJuceTempBuf(const mcl::AudioBuffer& outBuf);
 
 	/* juceToGiadaOutBuf
-	Copies the private JUCE buffer to Giada buffer 'outBuf'. */
+	Interleaves the private JUCE buffer back into the Giada buffer 'outBuf'. */
 
 	void juceToGiadaOutBuf(mcl::AudioBuffer& outBuf) const;
 
-	void processPlugins(const std::vector<Plugin*>&, const juce::MidiBuffer& events);
+	void processPlugins(const std::vector<Plugin*>&, const juce::MidiBuffer& events,
+	    std::span<const PluginParamChange> changes);
+
+	void processPlugin(Plugin*, const juce::MidiBuffer& events, std::span<const PluginParamChange> changes);
+
+	/* processSegment
+	Processes 'length' frames of the private JUCE buffer, starting from 'start',
+	with the MIDI events falling in there. */
 
-	void processPlugin(Plugin*, const juce::MidiBuffer& events);
+	void processSegment(Plugin&, const juce::MidiBuffer& events, int start, int length);
 
 	model::Model& m_model;
+	Profiler&     m_profiler;
 
 	juce::AudioBuffer<float> m_audioBuffer;
+
+	/* m_noEvents
+	Empty MIDI buffer shared by all stacks that don't receive MIDI events. */
+
+	const juce::MidiBuffer m_noEvents;
+
+	/* m_segmentEvents
+	MIDI events of the segment being processed, shifted to its start.
+	Preallocated, see G_MIDI_BUFFER_BYTES. */
+
+	juce::MidiBuffer m_segmentEvents;
+
+	std::atomic<Frame> m_outputLatency;
 };
 } // namespace giada::m
 
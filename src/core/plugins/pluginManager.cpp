@@ -32,28 +32,38 @@
 #include "core/plugins/pluginFactory.h"
 #include "utils/fs.h"
 #include "utils/log.h"
-#include "utils/string.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstddef>
 #include <memory>
+#include <thread>
 
 namespace giada::m
 {
 namespace
 {
-juce::FileSearchPath toJuceFileSearchPath_(const std::string& dirs)
-{
-	juce::FileSearchPath searchPath;
-	for (const std::string& dir : u::string::split(dirs, ";"))
-		searchPath.add(juce::File(dir));
-	return searchPath;
-}
+/* MESSAGE_THREAD_FORMATS
+Plug-in formats whose instances must be created on the message thread. */
+
+constexpr std::array MESSAGE_THREAD_FORMATS = {"VST3", "AudioUnit"};
+
+constexpr int PROGRESS_RATE_MS = 50;
 } // namespace
 
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
+PluginManager::PluginManager()
+: m_scanner(m_formatManager, m_knownPluginList)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
 void PluginManager::reset()
 {
 	pluginFactory::reset();
@@ -69,42 +79,17 @@ void PluginManager::reset()
 
 int PluginManager::scanDirs(const std::string& dirs, std::function<bool(float)> progressCb)
 {
-	u::log::print("[pluginManager::scanDir] requested directories: '{}'\n", dirs);
-	u::log::print("[pluginManager::scanDir] currently known plug-ins: {}\n", m_knownPluginList.getNumTypes());
-
-	m_knownPluginList.clear(); // clear up previous plugins
-
-	const juce::FileSearchPath searchPath    = toJuceFileSearchPath_(dirs);
-	const float                numFormats    = m_formatManager.getNumFormats();
-	bool                       shouldRun     = true;
-	float                      totalProgress = 1.0f;
-
-	for (juce::AudioPluginFormat* format : m_formatManager.getFormats())
-	{
-		if (!shouldRun)
-			break;
-
-		juce::PluginDirectoryScanner scanner(m_knownPluginList, *format, searchPath, /*recursive=*/true, juce::File());
-
-		juce::String name;
-		while (scanner.scanNextFile(false, name) && shouldRun)
-		{
-			u::log::print("[pluginManager::scanDir]   scanning '{}'\n", name.toRawUTF8());
-			shouldRun = progressCb((totalProgress + scanner.getProgress()) / numFormats);
-		}
-
-		totalProgress += 1.0f;
-	}
-
-	u::log::print("[pluginManager::scanDir] {} plugin(s) found\n", m_knownPluginList.getNumTypes());
-	return m_knownPluginList.getNumTypes();
+	return m_scanner.scan(dirs, progressCb);
 }
 
 /* -------------------------------------------------------------------------- */
 
 bool PluginManager::saveList(const std::string& filepath) const
 {
-	bool out = m_knownPluginList.createXml()->writeTo(juce::File(filepath));
+	const std::unique_ptr<juce::XmlElement> xml = m_knownPluginList.createXml();
+	m_scanner.writeXml(*xml);
+
+	bool out = xml->writeTo(juce::File(filepath));
 	if (!out)
 		u::log::print("[pluginManager::saveList] unable to save plugin list to {}\n", filepath);
 	return out;
@@ -118,6 +103,7 @@ bool PluginManager::loadList(const std::string& filepath)
 	if (elem == nullptr)
 		return false;
 	m_knownPluginList.recreateFromXml(*elem);
+	m_scanner.readXml(*elem);
 	return true;
 }
 
@@ -249,6 +235,7 @@ std::unique_ptr<juce::AudioPluginInstance> PluginManager::makeJucePlugin(const s
 	if (pd == nullptr)
 	{
 		u::log::print("[pluginManager::makeJucePlugin] no plugin found with pid={}!\n", pid);
+		const std::scoped_lock lock(m_unknownPluginListMutex);
 		m_unknownPluginList.push_back(pid);
 		return nullptr;
 	}
@@ -259,6 +246,7 @@ std::unique_ptr<juce::AudioPluginInstance> PluginManager::makeJucePlugin(const s
 	{
 		u::log::print("[pluginManager::makeJucePlugin] unable to create instance with pid={}! Error: {}\n",
 		    pid, error.toStdString());
+		const std::scoped_lock lock(m_unknownPluginListMutex);
 		m_unknownPluginList.push_back(pid);
 		return nullptr;
 	}
@@ -267,4 +255,76 @@ std::unique_ptr<juce::AudioPluginInstance> PluginManager::makeJucePlugin(const s
 
 	return pi;
 }
-} // namespace giada::m
\ No newline at end of file
+
+/* -------------------------------------------------------------------------- */
+
+std::vector<std::unique_ptr<Plugin>> PluginManager::loadPlugins(const std::vector<Patch::Plugin>& pplugins,
+    const model::Sequencer& sequencer, int sampleRate, int bufferSize, const std::function<void(float)>& progress)
+{
+	const std::size_t numPlugins = pplugins.size();
+
+	std::vector<std::unique_ptr<Plugin>> out(numPlugins);
+	std::vector<std::size_t>             poolJobs;
+	std::vector<std::size_t>             mainJobs;
+
+	for (std::size_t i = 0; i < numPlugins; i++)
+		(needsMessageThread(pplugins[i].path) ? mainJobs : poolJobs).push_back(i);
+
+	u::log::print("[pluginManager::loadPlugins] loading {} plug-in(s), {} on the message thread\n",
+	    numPlugins, mainJobs.size());
+
+	std::atomic<std::size_t> next = 0;
+	std::atomic<std::size_t> done = 0;
+
+	/* Instantiation, prepareToPlay() (in the Plugin constructor) and state
+	restore: the expensive part. */
+
+	const auto load = [&](std::size_t i)
+	{
+		std::unique_ptr<juce::AudioPluginInstance> pi = makeJucePlugin(pplugins[i].path, sampleRate, bufferSize);
+		out[i]                                        = pluginFactory::deserializePlugin(pplugins[i], std::move(pi), sequencer, sampleRate, bufferSize);
+		done++;
+	};
+
+	const std::size_t numThreads = std::min<std::size_t>(poolJobs.size(), std::max(1u, std::thread::hardware_concurrency()));
+
+	std::vector<std::thread> threads;
+	for (std::size_t t = 0; t < numThreads; t++)
+	{
+		threads.emplace_back([&poolJobs, &next, &load]()
+		{
+			for (std::size_t j = next++; j < poolJobs.size(); j = next++)
+				load(poolJobs[j]);
+		});
+	}
+
+	for (std::size_t i : mainJobs)
+	{
+		load(i);
+		progress(done / static_cast<float>(numPlugins));
+	}
+
+	while (done < numPlugins)
+	{
+		progress(done / static_cast<float>(numPlugins));
+		std::this_thread::sleep_for(std::chrono::milliseconds(PROGRESS_RATE_MS));
+	}
+
+	for (std::thread& t : threads)
+		t.join();
+
+	progress(1.0f);
+	return out;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool PluginManager::needsMessageThread(const std::string& pid) const
+{
+	const std::unique_ptr<juce::PluginDescription> pd = m_knownPluginList.getTypeForIdentifierString(pid);
+	if (pd == nullptr)
+		return false;
+	return std::any_of(MESSAGE_THREAD_FORMATS.begin(), MESSAGE_THREAD_FORMATS.end(), [&pd](const char* format)
+	{ return pd->pluginFormatName == format; });
+}
+} // namespace giada::m
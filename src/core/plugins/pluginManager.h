@@ -28,8 +28,11 @@
 #define G_PLUGIN_MANAGER_H
 
 #include "core/patch.h"
+#include "core/plugins/pluginScanner.h"
 #include "plugin.h"
+#include <functional>
 #include <memory>
+#include <mutex>
 
 namespace giada::m::patch
 {
@@ -101,16 +104,20 @@ public:
 
 	void reset();
 
+	PluginManager();
+
 	/* scanDirs
 	Parses plugin directories (semicolon-separated) and store list in
-	knownPluginList. The callback is called on each plugin found. Used to update
-	the main window from the GUI thread. Return false from the progress callback
-	to stop	the scanning process. */
+	knownPluginList. Only new or changed plug-in files are probed, out of
+	process: see PluginScanner. The callback is called periodically with the
+	current progress. Used to update the main window from the GUI thread.
+	Return false from the progress callback to stop the scanning process. */
 
 	int scanDirs(const std::string& paths, std::function<bool(float)> progressCb);
 
 	/* (save|load)List
-	(Save|Load) knownPluginList (in|from) an XML file. */
+	(Save|Load) knownPluginList, together with the scanner cache, (in|from) an
+	XML file. */
 
 	bool saveList(const std::string& path) const;
 	bool loadList(const std::string& path);
@@ -121,6 +128,17 @@ public:
 
 	std::unique_ptr<juce::AudioPluginInstance> makeJucePlugin(const std::string& pid, int sampleRate, int bufferSize);
 
+	/* loadPlugins
+	Creates the plug-ins of a patch, restoring their state. Plug-ins are loaded
+	concurrently on a pool of threads, except for those whose format must be
+	instantiated on the message thread: these ones are loaded on the calling
+	thread in the meantime, which must be the message thread. The callback is
+	called periodically on the calling thread with the current progress. Returns
+	plug-ins in the same order of the input vector; missing ones are invalid. */
+
+	std::vector<std::unique_ptr<Plugin>> loadPlugins(const std::vector<Patch::Plugin>&, const model::Sequencer&,
+	    int sampleRate, int bufferSize, const std::function<void(float)>& progress);
+
 	/* clonePlugins
 	Clones all plugins in the Plugin vector passed in as a parameter. Returns a
 	new vector containing the new clones. */
@@ -131,6 +149,12 @@ public:
 	void sortPlugins(SortMode);
 
 private:
+	/* needsMessageThread
+	True if the plug-in 'pid' belongs to a format whose instances must be
+	created on the message thread. */
+
+	bool needsMessageThread(const std::string& pid) const;
+
 	/* formatManager
 	Plugin format manager. */
 
@@ -141,10 +165,17 @@ private:
 
 	juce::KnownPluginList m_knownPluginList;
 
+	/* scanner
+	Out-of-process plug-in scanner that fills knownPluginList. */
+
+	PluginScanner m_scanner;
+
 	/* unknownPluginList
-	List of unrecognized plugins found in a patch. */
+	List of unrecognized plugins found in a patch. Guarded by a mutex, as plug-ins
+	can be loaded concurrently. */
 
 	std::vector<std::string> m_unknownPluginList;
+	std::mutex               m_unknownPluginListMutex;
 };
 } // namespace giada::m
 
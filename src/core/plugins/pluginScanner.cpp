@@ -0,0 +1,360 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/plugins/pluginScanner.h"
+#include "core/const.h"
+#include "utils/log.h"
+#include "utils/string.h"
+#include <algorithm>
+#include <chrono>
+#include <set>
+#include <thread>
+
+namespace giada::m
+{
+namespace
+{
+constexpr auto CACHE_TAG      = "GIADA_SCAN_CACHE";
+constexpr auto CACHE_ENTRY    = "FILE";
+constexpr auto RESULT_TAG     = "GIADA_SCAN_RESULT";
+constexpr int  POLL_RATE_MS   = 50;
+constexpr int  EXIT_OK        = 0;
+constexpr int  EXIT_NO_FORMAT = 1;
+constexpr int  EXIT_NO_WRITE  = 2;
+
+/* -------------------------------------------------------------------------- */
+
+juce::FileSearchPath toJuceFileSearchPath_(const std::string& dirs)
+{
+	juce::FileSearchPath searchPath;
+	for (const std::string& dir : u::string::split(dirs, ";"))
+		searchPath.add(juce::File(dir));
+	return searchPath;
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+PluginScanner::PluginScanner(juce::AudioPluginFormatManager& fm, juce::KnownPluginList& kpl)
+: m_formatManager(fm)
+, m_knownPluginList(kpl)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+int PluginScanner::scan(const std::string& dirs, const std::function<bool(float)>& progressCb)
+{
+	u::log::print("[PluginScanner::scan] requested directories: '{}'\n", dirs);
+	u::log::print("[PluginScanner::scan] currently known plug-ins: {}\n", m_knownPluginList.getNumTypes());
+
+	const juce::FileSearchPath searchPath = toJuceFileSearchPath_(dirs);
+
+	/* Group the currently known plug-ins by file. */
+
+	std::map<Key, std::vector<juce::PluginDescription>> known;
+	for (const juce::PluginDescription& pd : m_knownPluginList.getTypes())
+		known[makeKey(pd)].push_back(pd);
+
+	/* Collect all plug-in files: only new or changed ones need to be probed. */
+
+	std::vector<Key>       found;
+	std::vector<Key>       jobs;
+	std::vector<Signature> signatures;
+
+	for (juce::AudioPluginFormat* format : m_formatManager.getFormats())
+	{
+		for (const juce::String& file : format->searchPathsForPlugins(searchPath, /*recursive=*/true))
+		{
+			const Key       key       = {format->getName().toStdString(), file.toStdString()};
+			const Signature signature = makeSignature(key.second);
+
+			found.push_back(key);
+			if (isUpToDate(key, signature, known[key], *format))
+				continue;
+			jobs.push_back(key);
+			signatures.push_back(signature);
+		}
+	}
+
+	u::log::print("[PluginScanner::scan] {} file(s) found, {} to probe\n", found.size(), jobs.size());
+
+	/* Probe files in parallel, one helper process per file. The calling thread
+	keeps reporting the progress in the meantime. */
+
+	std::vector<Result>      results(jobs.size());
+	std::atomic<std::size_t> next = 0;
+	std::atomic<std::size_t> done = 0;
+	std::atomic<bool>        stop = false;
+
+	const std::size_t numThreads = std::min<std::size_t>(jobs.size(), std::max(1u, std::thread::hardware_concurrency()));
+
+	std::vector<std::thread> threads;
+	for (std::size_t i = 0; i < numThreads; i++)
+	{
+		threads.emplace_back([this, &jobs, &results, &next, &done, &stop]()
+		{
+			for (std::size_t j = next++; j < jobs.size() && !stop; j = next++)
+			{
+				results[j] = probe(jobs[j], stop);
+				done++;
+			}
+		});
+	}
+
+	while (done < jobs.size() && !stop)
+	{
+		if (!progressCb(done / static_cast<float>(jobs.size())))
+			stop = true;
+		std::this_thread::sleep_for(std::chrono::milliseconds(POLL_RATE_MS));
+	}
+
+	for (std::thread& t : threads)
+		t.join();
+
+	/* Merge results. Files not probed because of a stop request keep their old
+	cache entry, if any. */
+
+	for (std::size_t i = 0; i < jobs.size(); i++)
+	{
+		const Key&    key    = jobs[i];
+		const Result& result = results[i];
+
+		if (result.status == Result::Status::SKIPPED)
+			continue;
+
+		for (const juce::PluginDescription& pd : known[key])
+			m_knownPluginList.removeType(pd);
+
+		const bool blocked = result.status == Result::Status::FAILED;
+		m_cache[key]       = {signatures[i], blocked};
+
+		if (blocked)
+		{
+			u::log::print("[PluginScanner::scan]   '{}' blocklisted\n", key.second);
+			continue;
+		}
+
+		for (const juce::PluginDescription& pd : result.descriptions)
+			m_knownPluginList.addType(pd);
+	}
+
+	prune(found);
+
+	u::log::print("[PluginScanner::scan] {} plugin(s) found\n", m_knownPluginList.getNumTypes());
+	return m_knownPluginList.getNumTypes();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void PluginScanner::clear()
+{
+	m_cache.clear();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void PluginScanner::writeXml(juce::XmlElement& parent) const
+{
+	juce::XmlElement* cache = parent.createNewChildElement(CACHE_TAG);
+
+	for (const auto& [key, entry] : m_cache)
+	{
+		juce::XmlElement* e = cache->createNewChildElement(CACHE_ENTRY);
+		e->setAttribute("format", juce::String(key.first));
+		e->setAttribute("path", juce::String(key.second));
+		e->setAttribute("size", juce::String(entry.signature.size));
+		e->setAttribute("mtime", juce::String(entry.signature.mtime));
+		e->setAttribute("blocked", entry.blocked);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void PluginScanner::readXml(const juce::XmlElement& parent)
+{
+	clear();
+
+	const juce::XmlElement* cache = parent.getChildByName(CACHE_TAG);
+	if (cache == nullptr)
+		return;
+
+	for (const juce::XmlElement* e : cache->getChildIterator())
+	{
+		if (!e->hasTagName(CACHE_ENTRY))
+			continue;
+
+		const Key key = {
+		    e->getStringAttribute("format").toStdString(),
+		    e->getStringAttribute("path").toStdString()};
+
+		m_cache[key] = {
+		    {e->getStringAttribute("size").getLargeIntValue(), e->getStringAttribute("mtime").getLargeIntValue()},
+		    e->getBoolAttribute("blocked")};
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+int PluginScanner::runHelper(const std::string& formatName, const std::string& file,
+    const std::string& outPath)
+{
+	const juce::ScopedJuceInitialiser_GUI juceInit;
+
+	juce::AudioPluginFormatManager formatManager;
+	formatManager.addDefaultFormats();
+
+	for (juce::AudioPluginFormat* format : formatManager.getFormats())
+	{
+		if (format->getName().toStdString() != formatName)
+			continue;
+
+		juce::OwnedArray<juce::PluginDescription> descriptions;
+		format->findAllTypesForFile(descriptions, juce::String(file));
+
+		/* The output file is written only if probing went through: a missing
+		file tells the parent process that the helper has crashed. */
+
+		juce::XmlElement xml(RESULT_TAG);
+		for (const juce::PluginDescription* pd : descriptions)
+			xml.addChildElement(pd->createXml().release());
+
+		return xml.writeTo(juce::File(outPath)) ? EXIT_OK : EXIT_NO_WRITE;
+	}
+
+	return EXIT_NO_FORMAT;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool PluginScanner::isUpToDate(const Key& key, const Signature& signature,
+    const std::vector<juce::PluginDescription>& known, juce::AudioPluginFormat& format) const
+{
+	const auto it = m_cache.find(key);
+	if (it == m_cache.end() || it->second.signature != signature)
+		return false;
+
+	/* Identifiers that are not files (e.g. AudioUnits) have an empty signature:
+	let the format tell if they have changed. */
+
+	if (signature != Signature{})
+		return true;
+	return std::none_of(known.begin(), known.end(), [&format](const juce::PluginDescription& pd)
+	{ return format.pluginNeedsRescanning(pd); });
+}
+
+/* -------------------------------------------------------------------------- */
+
+PluginScanner::Result PluginScanner::probe(const Key& key, const std::atomic<bool>& stop) const
+{
+	const juce::File output = juce::File::createTempFile(".xml");
+	const juce::File self   = juce::File::getSpecialLocation(juce::File::currentExecutableFile);
+
+	const juce::StringArray args = {
+	    self.getFullPathName(), HELPER_ARG, juce::String(key.first), juce::String(key.second), output.getFullPathName()};
+
+	juce::ChildProcess process;
+	if (!process.start(args, /*streamFlags=*/0))
+	{
+		u::log::print("[PluginScanner::probe] unable to start scanner helper for '{}'\n", key.second);
+		return {Result::Status::SKIPPED};
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+	while (!process.waitForProcessToFinish(POLL_RATE_MS))
+	{
+		if (stop)
+		{
+			process.kill();
+			return {Result::Status::SKIPPED};
+		}
+		if (std::chrono::steady_clock::now() - start > std::chrono::milliseconds(G_PLUGIN_SCAN_TIMEOUT_MS))
+		{
+			u::log::print("[PluginScanner::probe] '{}' timed out\n", key.second);
+			process.kill();
+			return {Result::Status::FAILED};
+		}
+	}
+
+	const std::unique_ptr<juce::XmlElement> xml = juce::XmlDocument::parse(output);
+	output.deleteFile();
+
+	if (process.getExitCode() != EXIT_OK || xml == nullptr || !xml->hasTagName(RESULT_TAG))
+	{
+		u::log::print("[PluginScanner::probe] '{}' crashed the scanner helper\n", key.second);
+		return {Result::Status::FAILED};
+	}
+
+	Result result = {Result::Status::OK};
+	for (const juce::XmlElement* e : xml->getChildIterator())
+	{
+		juce::PluginDescription pd;
+		if (pd.loadFromXml(*e))
+			result.descriptions.push_back(pd);
+	}
+	return result;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void PluginScanner::prune(const std::vector<Key>& found)
+{
+	const std::set<Key> foundSet(found.begin(), found.end());
+
+	std::erase_if(m_cache, [&foundSet](const auto& pair)
+	{ return !foundSet.contains(pair.first); });
+
+	for (const juce::PluginDescription& pd : m_knownPluginList.getTypes())
+	{
+		const auto it = m_cache.find(makeKey(pd));
+		if (it == m_cache.end() || it->second.blocked)
+			m_knownPluginList.removeType(pd);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+PluginScanner::Key PluginScanner::makeKey(const juce::PluginDescription& pd)
+{
+	return {pd.pluginFormatName.toStdString(), pd.fileOrIdentifier.toStdString()};
+}
+
+/* -------------------------------------------------------------------------- */
+
+PluginScanner::Signature PluginScanner::makeSignature(const std::string& fileOrIdentifier)
+{
+	if (!juce::File::isAbsolutePath(fileOrIdentifier))
+		return {};
+
+	const juce::File file(fileOrIdentifier);
+	if (!file.exists())
+		return {};
+
+	return {file.getSize(), file.getLastModificationTime().toMilliseconds()};
+}
+} // namespace giada::m
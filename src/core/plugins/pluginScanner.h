@@ -0,0 +1,146 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_PLUGIN_SCANNER_H
+#define G_PLUGIN_SCANNER_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace giada::m
+{
+/* PluginScanner
+Fills a juce::KnownPluginList by probing plug-in files in separate helper
+processes (Giada itself, launched with the HELPER_ARG argument), several at a
+time. A plug-in that crashes or hangs only takes its own helper down. Probed
+files are cached by format, path, size and modification time: later scans only
+probe new or changed files. Files whose helper crashed or timed out are
+blocklisted until they change. */
+
+class PluginScanner final
+{
+public:
+	/* HELPER_ARG
+	Command line argument that turns Giada into a scanner helper process. */
+
+	static constexpr auto HELPER_ARG = "--scan-plugin";
+
+	PluginScanner(juce::AudioPluginFormatManager&, juce::KnownPluginList&);
+
+	/* scan
+	Probes new or changed plug-in files found in 'dirs' (semicolon-separated)
+	and updates the known plug-in list accordingly. The callback is called
+	periodically with the current progress; return false from it to stop the
+	scanning process. Returns the number of known plug-ins. */
+
+	int scan(const std::string& dirs, const std::function<bool(float)>& progressCb);
+
+	/* clear
+	Empties the cache and the blocklist. */
+
+	void clear();
+
+	/* (write|read)Xml
+	(Writes|Reads) the cache (to|from) a child element of 'parent'. */
+
+	void writeXml(juce::XmlElement& parent) const;
+	void readXml(const juce::XmlElement& parent);
+
+	/* runHelper
+	Entry point of the scanner helper process. Probes 'file' with the plug-in
+	format 'formatName' and writes the plug-in descriptions found to 'outPath'.
+	Returns the process exit code. */
+
+	static int runHelper(const std::string& formatName, const std::string& file,
+	    const std::string& outPath);
+
+private:
+	/* Key
+	Format name and file path (or identifier) of a probed plug-in file. */
+
+	using Key = std::pair<std::string, std::string>;
+
+	struct Signature
+	{
+		int64_t size  = 0;
+		int64_t mtime = 0;
+
+		bool operator==(const Signature&) const = default;
+	};
+
+	struct Entry
+	{
+		Signature signature = {};
+		bool      blocked   = false;
+	};
+
+	struct Result
+	{
+		enum class Status
+		{
+			OK,     // Probed successfully
+			FAILED, // Helper crashed or timed out: blocklist the file
+			SKIPPED // Not probed, e.g. on stop request
+		};
+
+		Status                               status       = Status::SKIPPED;
+		std::vector<juce::PluginDescription> descriptions = {};
+	};
+
+	/* isUpToDate
+	True if the file pointed to by 'key' has been probed already and hasn't
+	changed since. */
+
+	bool isUpToDate(const Key&, const Signature&, const std::vector<juce::PluginDescription>& known,
+	    juce::AudioPluginFormat&) const;
+
+	/* probe
+	Runs a scanner helper process on a single file. Thread-safe. */
+
+	Result probe(const Key&, const std::atomic<bool>& stop) const;
+
+	/* prune
+	Removes from the known plug-in list all descriptions without a valid
+	cache entry, and the cache entries of files no longer found. */
+
+	void prune(const std::vector<Key>& found);
+
+	static Key       makeKey(const juce::PluginDescription&);
+	static Signature makeSignature(const std::string& fileOrIdentifier);
+
+	juce::AudioPluginFormatManager& m_formatManager;
+	juce::KnownPluginList&          m_knownPluginList;
+	std::map<Key, Entry>            m_cache;
+};
+} // namespace giada::m
+
+#endif
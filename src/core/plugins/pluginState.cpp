@@ -47,6 +47,26 @@ PluginState::PluginState(const std::string& base64)
 
 /* -------------------------------------------------------------------------- */
 
+PluginState PluginState::fromFile(const std::string& path)
+{
+	juce::MemoryBlock data;
+	if (!juce::File(path).loadFileAsData(data))
+	{
+		u::log::print("[PluginState::fromFile] unable to read plug-in state from {}\n", path);
+		return {};
+	}
+	return PluginState(std::move(data));
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool PluginState::save(const std::string& path) const
+{
+	return juce::File(path).replaceWithData(m_data.getData(), m_data.getSize());
+}
+
+/* -------------------------------------------------------------------------- */
+
 std::string PluginState::asBase64() const
 {
 	return m_data.toBase64Encoding().toStdString();
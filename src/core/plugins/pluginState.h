@@ -40,6 +40,17 @@ public:
 	PluginState(juce::MemoryBlock&& data);
 	PluginState(const std::string& base64);
 
+	/* fromFile
+	Reads a raw binary state previously written by save(). Returns an invalid
+	state on failure. */
+
+	static PluginState fromFile(const std::string& path);
+
+	/* save
+	Writes the raw binary state to a file. */
+
+	bool save(const std::string& path) const;
+
 	std::string asBase64() const;
 	const void* getData() const;
 	size_t      getSize() const;
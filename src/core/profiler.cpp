@@ -0,0 +1,431 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/profiler.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <fmt/core.h>
+#include <fmt/ostream.h>
+#include <fstream>
+#include <utility>
+
+namespace giada::m
+{
+namespace
+{
+/* LOAD_SMOOTHING
+Weight of the newest sample in the exponential moving average of loads. */
+
+constexpr float LOAD_SMOOTHING = 0.1f;
+
+/* FREE_SLOT_, RELEASED_SLOT_
+Special plugin IDs of an empty slot and of a slot whose plugin has been
+removed (a tombstone). */
+
+constexpr ID FREE_SLOT_     = 0;
+constexpr ID RELEASED_SLOT_ = -1;
+
+/* -------------------------------------------------------------------------- */
+
+void updateMax_(std::atomic<uint64_t>& max, uint64_t value)
+{
+	uint64_t prev = max.load(std::memory_order_relaxed);
+	while (prev < value && !max.compare_exchange_weak(prev, value, std::memory_order_relaxed))
+		;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void smooth_(std::atomic<float>& avg, float value)
+{
+	const float prev = avg.load(std::memory_order_relaxed);
+	avg.store(prev + LOAD_SMOOTHING * (value - prev), std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void writeStats_(std::ofstream& out, const std::string& name, const Profiler::Histogram::Stats& s)
+{
+	fmt::print(out, "{:<16} count={} mean={:.1f}us max={:.1f}us p99<{:.0f}us\n",
+	    name, s.count, s.meanUs, s.maxUs, s.p99Us);
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+void Profiler::Histogram::record(Duration d)
+{
+	const uint64_t ns = std::max<int64_t>(d.count(), 0);
+	const uint64_t us = ns / 1000;
+	const int      b  = std::min<int>(std::bit_width(us), NUM_BUCKETS - 1);
+
+	m_buckets[b].fetch_add(1, std::memory_order_relaxed);
+	m_count.fetch_add(1, std::memory_order_relaxed);
+	m_totalNs.fetch_add(ns, std::memory_order_relaxed);
+	updateMax_(m_maxNs, ns);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Profiler::Histogram::clear()
+{
+	for (std::atomic<uint64_t>& b : m_buckets)
+		b.store(0, std::memory_order_relaxed);
+	m_count.store(0, std::memory_order_relaxed);
+	m_totalNs.store(0, std::memory_order_relaxed);
+	m_maxNs.store(0, std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+Profiler::Histogram::Stats Profiler::Histogram::getStats() const
+{
+	Stats s;
+	s.count = m_count.load(std::memory_order_relaxed);
+	if (s.count == 0)
+		return s;
+
+	s.meanUs = m_totalNs.load(std::memory_order_relaxed) / 1000.0 / s.count;
+	s.maxUs  = m_maxNs.load(std::memory_order_relaxed) / 1000.0;
+
+	uint64_t total = 0;
+	for (int i = 0; i < NUM_BUCKETS; i++)
+	{
+		s.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+		total += s.buckets[i];
+	}
+
+	/* Counters are read while the audio thread is writing: use the sum of
+	buckets as reference, so that the percentile is consistent with them. */
+
+	const uint64_t threshold = total - total / 100;
+	uint64_t       partial   = 0;
+	for (int i = 0; i < NUM_BUCKETS; i++)
+	{
+		partial += s.buckets[i];
+		if (partial >= threshold)
+		{
+			s.p99Us = static_cast<double>(uint64_t{1} << i);
+			break;
+		}
+	}
+	return s;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Profiler::Profiler()
+: m_blockPeriodNs(0)
+, m_dspLoad(0.0f)
+, m_dspLoadPeak(0.0f)
+, m_underflows(0)
+, m_overflows(0)
+, m_droppedEvents(0)
+, m_renderAheadUnderruns(0)
+, m_numTracks(0)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+Profiler::Clock::time_point Profiler::now()
+{
+	return Clock::now();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Profiler::setBlockPeriod(int bufferSize, int sampleRate)
+{
+	if (sampleRate <= 0) // Audio device not ready: loads can't be computed
+		m_blockPeriodNs.store(0);
+	else
+		m_blockPeriodNs.store(static_cast<int64_t>(bufferSize) * 1'000'000'000 / sampleRate);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Profiler::recordRender(Duration d)
+{
+	m_render.record(d);
+
+	const float load = toLoad(d);
+	smooth_(m_dspLoad, load);
+	if (load > m_dspLoadPeak.load(std::memory_order_relaxed))
+		m_dspLoadPeak.store(load, std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Profiler::recordSequencer(Duration d)
+{
+	m_sequencer.record(d);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Profiler::recordTrack(std::size_t trackIndex, Duration d)
+{
+	if (trackIndex >= MAX_TRACKS)
+		return;
+	m_tracks[trackIndex].record(d);
+	if (trackIndex >= m_numTracks.load(std::memory_order_relaxed))
+		m_numTracks.store(trackIndex + 1, std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Profiler::recordPlugin(ID pluginId, Duration d)
+{
+	PluginSlot* slot = getPluginSlot(pluginId);
+	if (slot == nullptr)
+		return;
+	slot->histogram.record(d);
+	smooth_(slot->load, toLoad(d));
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Profiler::recordXrun(bool underflow, bool overflow)
+{
+	if (underflow)
+		m_underflows.fetch_add(1, std::memory_order_relaxed);
+	if (overflow)
+		m_overflows.fetch_add(1, std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Profiler::recordDroppedEvents(std::size_t count)
+{
+	m_droppedEvents.fetch_add(count, std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Profiler::recordRenderAheadUnderrun()
+{
+	m_renderAheadUnderruns.fetch_add(1, std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+float Profiler::getDspLoad() const
+{
+	return m_dspLoad.load(std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+float Profiler::getPluginLoad(ID pluginId) const
+{
+	const PluginSlot* slot = findPluginSlot(pluginId);
+	return slot != nullptr ? slot->load.load(std::memory_order_relaxed) : 0.0f;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Profiler::Report Profiler::getReport() const
+{
+	Report r;
+	r.dspLoad              = m_dspLoad.load(std::memory_order_relaxed);
+	r.dspLoadPeak          = m_dspLoadPeak.load(std::memory_order_relaxed);
+	r.underflows           = m_underflows.load(std::memory_order_relaxed);
+	r.overflows            = m_overflows.load(std::memory_order_relaxed);
+	r.droppedEvents        = m_droppedEvents.load(std::memory_order_relaxed);
+	r.renderAheadUnderruns = m_renderAheadUnderruns.load(std::memory_order_relaxed);
+	r.render               = m_render.getStats();
+	r.sequencer            = m_sequencer.getStats();
+
+	const std::size_t numTracks = m_numTracks.load(std::memory_order_relaxed);
+	for (std::size_t i = 0; i < numTracks; i++)
+		r.tracks.push_back(m_tracks[i].getStats());
+
+	for (const PluginSlot& slot : m_plugins)
+	{
+		const ID pluginId = slot.pluginId.load(std::memory_order_acquire);
+		if (pluginId == FREE_SLOT_ || pluginId == RELEASED_SLOT_)
+			continue;
+		r.plugins.push_back({pluginId, slot.load.load(std::memory_order_relaxed), slot.histogram.getStats()});
+	}
+	return r;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Profiler::reset()
+{
+	m_dspLoad.store(0.0f);
+	m_dspLoadPeak.store(0.0f);
+	m_underflows.store(0);
+	m_overflows.store(0);
+	m_droppedEvents.store(0);
+	m_renderAheadUnderruns.store(0);
+	m_render.clear();
+	m_sequencer.clear();
+	for (Histogram& h : m_tracks)
+		h.clear();
+	m_numTracks.store(0);
+
+	/* Plug-in slots are kept claimed: the audio thread might be writing into
+	them right now. Only their data is cleared. */
+
+	for (PluginSlot& slot : m_plugins)
+	{
+		slot.load.store(0.0f);
+		slot.histogram.clear();
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Profiler::releasePlugin(ID pluginId)
+{
+	PluginSlot* slot = findPluginSlot(pluginId);
+	if (slot == nullptr)
+		return;
+	slot->load.store(0.0f);
+	slot->histogram.clear();
+	slot->pluginId.store(RELEASED_SLOT_, std::memory_order_release);
+}
+
+void Profiler::releaseAllPlugins()
+{
+	for (PluginSlot& slot : m_plugins)
+	{
+		slot.load.store(0.0f);
+		slot.histogram.clear();
+		slot.pluginId.store(FREE_SLOT_, std::memory_order_release);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Profiler::dump(const std::string& path) const
+{
+	std::ofstream out(path);
+	if (!out.is_open())
+		return false;
+
+	const Report r = getReport();
+
+	fmt::print(out, "DSP load: {:.1f}% (peak {:.1f}%)\n", r.dspLoad * 100, r.dspLoadPeak * 100);
+	fmt::print(out, "Xruns: {} underflows, {} overflows\n", r.underflows, r.overflows);
+	fmt::print(out, "Dropped sequencer events: {}\n", r.droppedEvents);
+	fmt::print(out, "Render-ahead underruns: {}\n\n", r.renderAheadUnderruns);
+
+	writeStats_(out, "render", r.render);
+	writeStats_(out, "sequencer", r.sequencer);
+	for (std::size_t i = 0; i < r.tracks.size(); i++)
+		writeStats_(out, fmt::format("track {}", i), r.tracks[i]);
+	for (const PluginReport& p : r.plugins)
+		writeStats_(out, fmt::format("plugin {} ({:.1f}%)", p.pluginId, p.load * 100), p.stats);
+
+	fmt::print(out, "\nRender histogram (us):\n");
+	for (int i = 0; i < Histogram::NUM_BUCKETS; i++)
+		if (r.render.buckets[i] > 0)
+			fmt::print(out, "  < {:>8}: {}\n", uint64_t{1} << i, r.render.buckets[i]);
+
+	return out.good();
+}
+
+/* -------------------------------------------------------------------------- */
+
+Profiler::PluginSlot* Profiler::getPluginSlot(ID pluginId)
+{
+	assert(pluginId != FREE_SLOT_ && pluginId != RELEASED_SLOT_);
+
+	/* Open addressing with linear probing. Released slots become tombstones, so
+	a lookup can still stop at the first empty slot. A new plugin claims the
+	first empty or released slot along its probe sequence. */
+
+	const std::size_t start    = std::hash<ID>{}(pluginId) % MAX_PLUGINS;
+	PluginSlot*       reusable = nullptr;
+	for (std::size_t i = 0; i < MAX_PLUGINS; i++)
+	{
+		PluginSlot& slot = m_plugins[(start + i) % MAX_PLUGINS];
+		const ID    id   = slot.pluginId.load(std::memory_order_acquire);
+		if (id == pluginId)
+			return &slot;
+		if (id == RELEASED_SLOT_ && reusable == nullptr)
+			reusable = &slot;
+		if (id == FREE_SLOT_)
+		{
+			if (reusable == nullptr)
+				reusable = &slot;
+			break;
+		}
+	}
+
+	if (reusable == nullptr)
+		return nullptr;
+
+	/* Another thread might have claimed the slot in the meantime: give up on
+	this measurement, the next one will probe again. */
+
+	ID expected = reusable->pluginId.load(std::memory_order_acquire);
+	if (expected != FREE_SLOT_ && expected != RELEASED_SLOT_)
+		return expected == pluginId ? reusable : nullptr;
+	if (reusable->pluginId.compare_exchange_strong(expected, pluginId, std::memory_order_acq_rel))
+		return reusable;
+	return expected == pluginId ? reusable : nullptr;
+}
+
+/* -------------------------------------------------------------------------- */
+
+const Profiler::PluginSlot* Profiler::findPluginSlot(ID pluginId) const
+{
+	const std::size_t start = std::hash<ID>{}(pluginId) % MAX_PLUGINS;
+	for (std::size_t i = 0; i < MAX_PLUGINS; i++)
+	{
+		const PluginSlot& slot = m_plugins[(start + i) % MAX_PLUGINS];
+		const ID          id   = slot.pluginId.load(std::memory_order_acquire);
+		if (id == pluginId)
+			return &slot;
+		if (id == FREE_SLOT_)
+			return nullptr;
+	}
+	return nullptr;
+}
+
+Profiler::PluginSlot* Profiler::findPluginSlot(ID pluginId)
+{
+	return const_cast<PluginSlot*>(std::as_const(*this).findPluginSlot(pluginId));
+}
+
+/* -------------------------------------------------------------------------- */
+
+float Profiler::toLoad(Duration d) const
+{
+	const int64_t period = m_blockPeriodNs.load(std::memory_order_relaxed);
+	return period > 0 ? static_cast<float>(d.count()) / period : 0.0f;
+}
+} // namespace giada::m
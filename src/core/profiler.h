@@ -0,0 +1,210 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_PROFILER_H
+#define G_PROFILER_H
+
+#include "core/types.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace giada::m
+{
+/* Profiler
+Audio thread instrumentation. Records durations of the rendering stages into
+lock-free histograms, together with DSP load and xrun counters. All the
+record*() methods are realtime-safe: they never lock nor allocate. Reports are
+assembled on demand by non-realtime threads. */
+
+class Profiler
+{
+public:
+	using Clock    = std::chrono::steady_clock;
+	using Duration = std::chrono::nanoseconds;
+
+	static constexpr int MAX_TRACKS  = 64;  // Tracks beyond this index are not profiled
+	static constexpr int MAX_PLUGINS = 256; // Live plugins beyond this number are not profiled
+
+	/* Histogram
+	Lock-free histogram of durations. Bucket 0 collects durations below 1 us,
+	bucket N durations in [2^(N-1), 2^N) us. */
+
+	class Histogram
+	{
+	public:
+		static constexpr int NUM_BUCKETS = 24;
+
+		struct Stats
+		{
+			uint64_t                            count  = 0;
+			double                              meanUs = 0.0;
+			double                              maxUs  = 0.0;
+			double                              p99Us  = 0.0; // Upper bound of the 99th percentile bucket
+			std::array<uint64_t, NUM_BUCKETS> buckets = {};
+		};
+
+		void  record(Duration);
+		void  clear();
+		Stats getStats() const;
+
+	private:
+		std::array<std::atomic<uint64_t>, NUM_BUCKETS> m_buckets = {};
+		std::atomic<uint64_t>                          m_count   = 0;
+		std::atomic<uint64_t>                          m_totalNs = 0;
+		std::atomic<uint64_t>                          m_maxNs   = 0;
+	};
+
+	struct PluginReport
+	{
+		ID               pluginId;
+		float            load; // Average fraction of the block period
+		Histogram::Stats stats;
+	};
+
+	struct Report
+	{
+		float                     dspLoad;
+		float                     dspLoadPeak;
+		uint64_t                  underflows;
+		uint64_t                  overflows;
+		uint64_t                  droppedEvents;
+		uint64_t                  renderAheadUnderruns;
+		Histogram::Stats          render;
+		Histogram::Stats          sequencer;
+		std::vector<Histogram::Stats> tracks; // By track index
+		std::vector<PluginReport> plugins;
+	};
+
+	Profiler();
+
+	static Clock::time_point now();
+
+	/* setBlockPeriod
+	Tells the profiler the duration of an audio block, used to compute loads.
+	Call this whenever the stream is (re)opened. */
+
+	void setBlockPeriod(int bufferSize, int sampleRate);
+
+	/* record[Render|Sequencer|Track|Plugin]
+	Realtime-safe. Records the elapsed time of a rendering stage. Render time
+	also updates the DSP load. */
+
+	void recordRender(Duration);
+	void recordSequencer(Duration);
+	void recordTrack(std::size_t trackIndex, Duration);
+	void recordPlugin(ID pluginId, Duration);
+
+	/* recordXrun
+	Realtime-safe. Counts buffer underflows (output) and overflows (input). */
+
+	void recordXrun(bool underflow, bool overflow);
+
+	/* recordDroppedEvents
+	Realtime-safe. Counts sequencer events that didn't fit in the per-block
+	event buffers. */
+
+	void recordDroppedEvents(std::size_t);
+
+	/* recordRenderAheadUnderrun
+	Realtime-safe. Counts blocks of a track rendered ahead that weren't ready
+	in time, and have been replaced with silence. */
+
+	void recordRenderAheadUnderrun();
+
+	/* getDspLoad
+	Returns the smoothed fraction of the block period spent rendering. */
+
+	float getDspLoad() const;
+
+	/* getPluginLoad
+	Returns the smoothed fraction of the block period spent in the plugin, or 0
+	if the plugin has never been processed. */
+
+	float getPluginLoad(ID pluginId) const;
+
+	Report getReport() const;
+
+	/* reset
+	Clears all collected data. */
+
+	void reset();
+
+	/* releasePlugin
+	Frees the slot of a plugin that has been removed, so that it can be reused
+	by new plugins. Call it only when the plugin can't be processed anymore. */
+
+	void releasePlugin(ID pluginId);
+
+	/* releaseAllPlugins
+	Same as above, for all plugins. Call it only when no plugins are left in the
+	model. */
+
+	void releaseAllPlugins();
+
+	/* dump
+	Writes a human-readable report to file. Returns false on failure. */
+
+	bool dump(const std::string& path) const;
+
+private:
+	struct PluginSlot
+	{
+		std::atomic<ID>    pluginId = 0;
+		std::atomic<float> load     = 0.0f;
+		Histogram          histogram;
+	};
+
+	/* getPluginSlot
+	Finds the slot for the given plugin, or claims a free one. Returns nullptr
+	if the table is full. */
+
+	PluginSlot*       getPluginSlot(ID pluginId);
+	PluginSlot*       findPluginSlot(ID pluginId);
+	const PluginSlot* findPluginSlot(ID pluginId) const;
+
+	float toLoad(Duration) const;
+
+	std::atomic<int64_t>  m_blockPeriodNs;
+	std::atomic<float>    m_dspLoad;
+	std::atomic<float>    m_dspLoadPeak;
+	std::atomic<uint64_t> m_underflows;
+	std::atomic<uint64_t> m_overflows;
+	std::atomic<uint64_t> m_droppedEvents;
+	std::atomic<uint64_t> m_renderAheadUnderruns;
+
+	Histogram                             m_render;
+	Histogram                             m_sequencer;
+	std::array<Histogram, MAX_TRACKS>     m_tracks;
+	std::array<PluginSlot, MAX_PLUGINS>   m_plugins;
+	std::atomic<std::size_t>              m_numTracks;
+};
+} // namespace giada::m
+
+#endif
@@ -81,4 +81,18 @@ bool Quantizer::hasBeenTriggered() const
 {
 	return m_performId.load() != -1;
 }
-} // namespace giada::m
\ No newline at end of file
+
+/* -------------------------------------------------------------------------- */
+
+int Quantizer::getTriggered() const
+{
+	return m_performId.load();
+}
+
+void Quantizer::setTriggered(int id)
+{
+	assert(id == -1 || m_callbacks.count(id) > 0);
+
+	m_performId.store(id);
+}
+} // namespace giada::m
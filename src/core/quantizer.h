@@ -68,6 +68,13 @@ public:
 
 	bool hasBeenTriggered() const;
 
+	/* getTriggered, setTriggered
+	Slot of the function waiting for the next quantization step, or -1 if none.
+	Used to rewind a channel to a previous state. */
+
+	int  getTriggered() const;
+	void setTriggered(int id);
+
 private:
 	std::map<int, std::function<void(Frame)>> m_callbacks;
 	mutable WeakAtomic<int>                   m_performId = -1;
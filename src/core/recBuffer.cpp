@@ -0,0 +1,156 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "core/recBuffer.h"
+#include "core/const.h"
+#include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace giada::m
+{
+RecBuffer::RecBuffer()
+: m_chunks(MAX_CHUNKS)
+, m_numChunks(0)
+, m_frames(0)
+, m_dropped(0)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+template <typename F>
+void RecBuffer::forEachChunk(Frame frames, F&& f) const
+{
+	const std::scoped_lock lock(m_mutex);
+
+	const std::size_t numChunks = m_numChunks.load();
+
+	for (std::size_t i = 0; i < numChunks; i++)
+	{
+		const Frame offset = static_cast<Frame>(i) * CHUNK_FRAMES;
+		if (offset >= frames)
+			break;
+		f(*m_chunks[i], std::min(CHUNK_FRAMES, frames - offset), offset);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+Frame       RecBuffer::countFrames() const { return m_frames.load(); }
+std::size_t RecBuffer::countChunks() const { return m_numChunks.load(); }
+Frame       RecBuffer::getDroppedFrames() const { return m_dropped.load(); }
+
+/* -------------------------------------------------------------------------- */
+
+void RecBuffer::sum(const mcl::AudioBuffer& src, int framesToCopy, Frame srcOffset,
+    Frame dstOffset, float gain)
+{
+	assert(dstOffset >= 0 && dstOffset + framesToCopy <= MAX_FRAMES);
+
+	const std::size_t numChunks = m_numChunks.load(std::memory_order_acquire);
+
+	/* A block of input might straddle two chunks. */
+
+	while (framesToCopy > 0)
+	{
+		const std::size_t index       = dstOffset / CHUNK_FRAMES;
+		const Frame       chunkOffset = dstOffset % CHUNK_FRAMES;
+		const int         frames      = std::min(framesToCopy, CHUNK_FRAMES - chunkOffset);
+
+		if (index < numChunks)
+			m_chunks[index]->sum(src, frames, srcOffset, chunkOffset, gain);
+		else
+			m_dropped.fetch_add(frames, std::memory_order_relaxed);
+
+		framesToCopy -= frames;
+		srcOffset += frames;
+		dstOffset += frames;
+	}
+
+	if (dstOffset > m_frames.load(std::memory_order_relaxed))
+		m_frames.store(dstOffset, std::memory_order_release);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RecBuffer::refill()
+{
+	const std::scoped_lock lock(m_mutex);
+
+	const std::size_t recorded = (m_frames.load(std::memory_order_acquire) + CHUNK_FRAMES - 1) / CHUNK_FRAMES;
+	const std::size_t needed   = std::min(MAX_CHUNKS, recorded + CHUNKS_AHEAD);
+
+	for (std::size_t i = m_numChunks.load(std::memory_order_relaxed); i < needed; i++)
+	{
+		m_chunks[i] = std::make_unique<Chunk>(CHUNK_FRAMES, G_MAX_IO_CHANS);
+		m_numChunks.store(i + 1, std::memory_order_release);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RecBuffer::clear()
+{
+	const std::scoped_lock lock(m_mutex);
+
+	const std::size_t numChunks = m_numChunks.load();
+	const std::size_t keep      = std::min(numChunks, CHUNKS_AHEAD);
+	const Frame       frames    = m_frames.load();
+
+	m_numChunks.store(keep);
+
+	for (std::size_t i = 0; i < numChunks; i++)
+	{
+		if (i >= keep)
+			m_chunks[i].reset();
+		else if (static_cast<Frame>(i) * CHUNK_FRAMES < frames) // Untouched chunks are silent already
+			m_chunks[i]->clear();
+	}
+
+	m_frames.store(0);
+	m_dropped.store(0);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RecBuffer::copyTo(mcl::AudioBuffer& dst) const
+{
+	forEachChunk(dst.countFrames(), [&dst](const Chunk& chunk, int frames, Frame offset)
+	{
+		dst.set(chunk, frames, /*srcOffset=*/0, offset);
+	});
+}
+
+void RecBuffer::sumTo(mcl::AudioBuffer& dst) const
+{
+	forEachChunk(dst.countFrames(), [&dst](const Chunk& chunk, int frames, Frame offset)
+	{
+		dst.sum(chunk, frames, /*srcOffset=*/0, offset, /*gain=*/1.0f);
+	});
+}
+} // namespace giada::m
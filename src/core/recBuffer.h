@@ -0,0 +1,139 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_REC_BUFFER_H
+#define G_REC_BUFFER_H
+
+#include "core/types.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace mcl
+{
+class AudioBuffer;
+}
+
+namespace giada::m
+{
+/* RecBuffer
+Working buffer for input recording, made of fixed-size chunks allocated on
+demand. The audio thread writes into it without locks nor allocations, as long
+as a non-realtime thread calls refill() often enough to keep CHUNKS_AHEAD empty
+chunks past the last recorded frame. Memory grows with the take, up to
+MAX_FRAMES. Frames that fall into a chunk not allocated yet are dropped. */
+
+class RecBuffer final
+{
+public:
+	/* CHUNK_FRAMES, MAX_CHUNKS, CHUNKS_AHEAD
+	Size of each chunk, maximum number of chunks in a take and number of chunks
+	always ready for the audio thread past the recording position. */
+
+	static constexpr Frame       CHUNK_FRAMES = 32768;
+	static constexpr std::size_t MAX_CHUNKS   = 8192;
+	static constexpr std::size_t CHUNKS_AHEAD = 8;
+
+	/* MAX_FRAMES
+	Longest take that can be recorded, in frames. */
+
+	static constexpr Frame MAX_FRAMES = CHUNK_FRAMES * static_cast<Frame>(MAX_CHUNKS);
+
+	RecBuffer();
+
+	/* countFrames
+	Returns the length of the take so far, i.e. the last frame written + 1. */
+
+	Frame countFrames() const;
+
+	/* countChunks
+	Returns the number of chunks currently allocated. */
+
+	std::size_t countChunks() const;
+
+	/* getDroppedFrames
+	Returns the number of frames lost because no chunk was ready for them. */
+
+	Frame getDroppedFrames() const;
+
+	/* sum
+	Audio thread. Sums 'framesToCopy' frames of 'src', starting from 'srcOffset',
+	into the buffer at frame 'dstOffset'. */
+
+	void sum(const mcl::AudioBuffer& src, int framesToCopy, Frame srcOffset,
+	    Frame dstOffset, float gain);
+
+	/* refill
+	Non-realtime thread. Allocates new chunks, if needed, so that CHUNKS_AHEAD
+	of them are available past the last recorded frame. */
+
+	void refill();
+
+	/* clear
+	Non-realtime thread, while not recording. Silences the take and frees all
+	chunks but the first CHUNKS_AHEAD ones. */
+
+	void clear();
+
+	/* copyTo, sumTo
+	Non-realtime thread, while not recording. Copies or sums the take into 'dst',
+	up to its length. Parts of 'dst' past the allocated chunks are left as they
+	are. */
+
+	void copyTo(mcl::AudioBuffer& dst) const;
+	void sumTo(mcl::AudioBuffer& dst) const;
+
+private:
+	using Chunk = mcl::AudioBuffer;
+
+	/* forEachChunk
+	Calls 'f' on every allocated chunk that overlaps the first 'frames' frames of
+	the take, with the chunk, the frames to read and the offset of the chunk in
+	the take. */
+
+	template <typename F>
+	void forEachChunk(Frame frames, F&& f) const;
+
+	/* m_chunks
+	MAX_CHUNKS slots, never resized. Only the first m_numChunks are valid: new
+	chunks are published to the audio thread by bumping the counter. */
+
+	std::vector<std::unique_ptr<Chunk>> m_chunks;
+	std::atomic<std::size_t>            m_numChunks;
+	std::atomic<Frame>                  m_frames;
+	std::atomic<Frame>                  m_dropped;
+
+	/* m_mutex
+	Serializes non-realtime operations. Never taken by the audio thread. */
+
+	mutable std::mutex m_mutex;
+};
+} // namespace giada::m
+
+#endif
@@ -31,11 +31,11 @@
 
 namespace giada::m::rendering
 {
-void advanceMidiChannel(const Channel& ch, const Sequencer::Event& e, KernelMidi& kernelMidi)
+void advanceMidiChannel(const Channel& ch, const Sequencer::Event& e, KernelMidi* kernelMidi)
 {
 	if (e.type == Sequencer::EventType::FIRST_BEAT)
 		rewindMidiChannel(ch.shared->playStatus);
 	if (ch.isPlaying() && e.type == Sequencer::EventType::ACTIONS)
-		sendMidiFromActions(ch, *e.actions, e.delta, kernelMidi);
+		sendMidiFromActions(ch, e.actions, e.delta, kernelMidi);
 }
 } // namespace giada::m::rendering
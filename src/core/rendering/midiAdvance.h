@@ -38,7 +38,11 @@ class KernelMidi;
 
 namespace giada::m::rendering
 {
-void advanceMidiChannel(const Channel&, const Sequencer::Event&, KernelMidi&);
+/* advanceMidiChannel
+MIDI out is skipped if 'kernelMidi' is nullptr (e.g. offline rendering):
+plug-ins still get the events. */
+
+void advanceMidiChannel(const Channel&, const Sequencer::Event&, KernelMidi*);
 } // namespace giada::m::rendering
 
 #endif
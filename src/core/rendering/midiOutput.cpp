@@ -48,11 +48,15 @@ void sendMidiLightning_(ID channelId, uint32_t learnt, const MidiMap::Message& m
 
 /* -------------------------------------------------------------------------- */
 
+/* sendMidiToPlugins_
+Doesn't allocate, so that it can be used on the realtime thread: relies on the
+memory preallocated by the MidiQueue and drops the event if the queue is full. */
+
 void sendMidiToPlugins_(ChannelShared::MidiQueue& midiQueue, const MidiEvent& e, Frame localFrame)
 {
 	MidiEvent eWithDelta(e);
 	eWithDelta.setDelta(localFrame);
-	midiQueue.enqueue(eWithDelta);
+	midiQueue.try_enqueue(eWithDelta);
 }
 } // namespace
 
@@ -67,15 +71,17 @@ void registerOnSendMidiCb(std::function<void(ID)> f)
 
 /* -------------------------------------------------------------------------- */
 
-void sendMidiFromActions(const Channel& ch, const std::vector<Action>& actions, Frame delta, KernelMidi& kernelMidi)
+void sendMidiFromActions(const Channel& ch, std::span<const Action* const> actions, Frame delta, KernelMidi* kernelMidi)
 {
-	for (const Action& action : actions)
+	for (const Action* pa : actions)
 	{
-		if (action.channelId != ch.id)
+		const Action& action = *pa;
+		assert(action.channelId == ch.id);
+		if (action.pluginId != -1) // Plug-in automation, see queuePluginParamChanges()
 			continue;
 		sendMidiToPlugins_(ch.shared->midiQueue, action.event, delta);
-		if (ch.canSendMidi())
-			sendMidiToOut(ch.id, action.event, ch.midiChannel->outputFilter, kernelMidi);
+		if (kernelMidi != nullptr && ch.canSendMidi())
+			sendMidiToOut(ch.id, action.event, ch.midiChannel->outputFilter, *kernelMidi);
 	}
 }
 
@@ -96,11 +102,12 @@ void sendMidiEventToPlugins(ChannelShared::MidiQueue& midiQueue, const MidiEvent
 {
 	/* Now all messages are turned into Channel-0 messages. Giada doesn't care
 	about holding MIDI channel information. Moreover, having all internal
-	messages on channel 0 is way easier. Then send it to plug-ins. */
+	messages on channel 0 is way easier. Then send it to plug-ins, keeping the
+	frame offset computed on reception. */
 
 	MidiEvent flat(e);
 	flat.setChannel(0);
-	sendMidiToPlugins_(midiQueue, flat, /*delta=*/0);
+	midiQueue.enqueue(flat);
 }
 
 /* -------------------------------------------------------------------------- */
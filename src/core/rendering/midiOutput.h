@@ -30,6 +30,7 @@
 #include "core/channels/channelShared.h"
 #include "core/midiEvent.h"
 #include "core/midiMapper.h"
+#include <span>
 
 namespace giada::m
 {
@@ -46,9 +47,11 @@ Callback fired when a MIDI signal has been sent. */
 void registerOnSendMidiCb(std::function<void(ID channelId)>);
 
 /* sendMidiFromActions
-Sends a corresponding MIDI event for each action in the action vector. */
+Sends a corresponding MIDI event for each action in 'actions'. All
+actions must belong to the channel. Events go to plug-ins only if 'kernelMidi'
+is nullptr. */
 
-void sendMidiFromActions(const Channel&, const std::vector<Action>&, Frame delta, KernelMidi&);
+void sendMidiFromActions(const Channel&, std::span<const Action* const>, Frame delta, KernelMidi*);
 
 /* sendMidiAllNotesOff
 Sends a G_MIDI_ALL_NOTES_OFF event to the outside world and plug-ins. */
@@ -57,7 +60,7 @@ void sendMidiAllNotesOff(const Channel&, KernelMidi&);
 
 /* sendMidiEventToPlugins
 Enqueue MIDI event to to the MIDI queue, so that it will be processed later
-on by the PluginHost. */
+on by the PluginHost at the event's delta frame. */
 
 void sendMidiEventToPlugins(ChannelShared::MidiQueue&, const MidiEvent&);
 
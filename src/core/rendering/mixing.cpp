@@ -0,0 +1,99 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "core/rendering/mixing.h"
+#include "core/channels/channelShared.h"
+#include <algorithm>
+
+namespace giada::m::rendering
+{
+mcl::AudioBuffer::Pan calcPanning(float pan)
+{
+	/* TODO - precompute the AudioBuffer::Pan when pan value changes instead of
+	building it on the fly. */
+
+	/* Center pan (0.5f)? Pass-through. */
+
+	if (pan == 0.5f)
+		return {1.0f, 1.0f};
+	return {1.0f - pan, pan};
+}
+
+/* -------------------------------------------------------------------------- */
+
+void sumRamped(mcl::AudioBuffer& dst, const mcl::AudioBuffer& src, ChannelShared& shared,
+    float volume, float pan)
+{
+	/* Effective left and right gains, consistent with calcPanning() where
+	center pan is a pass-through. */
+
+	const float gainL = pan == 0.5f ? volume : volume * (1.0f - pan);
+	const float gainR = pan == 0.5f ? volume : volume * pan;
+	const float fromL = shared.lastGainL < 0.0f ? gainL : shared.lastGainL;
+	const float fromR = shared.lastGainR < 0.0f ? gainR : shared.lastGainR;
+
+	shared.lastGainL = gainL;
+	shared.lastGainR = gainR;
+
+	/* Fast path: nothing has changed since the last block. */
+
+	if (fromL == gainL && fromR == gainR)
+	{
+		dst.sum(src, volume, calcPanning(pan));
+		return;
+	}
+
+	const int   frames      = std::min(dst.countFrames(), src.countFrames());
+	const int   srcChannels = src.countChannels();
+	const float stepL       = (gainL - fromL) / frames;
+	const float stepR       = (gainR - fromR) / frames;
+
+	/* Stereo to stereo is by far the most common case (and the one of volume
+	envelopes, ramping on every block): keep the loop free of branches and
+	indirections, so that the compiler can vectorise it. */
+
+	if (dst.countChannels() == 2 && srcChannels == 2)
+	{
+		float*       d = dst[0];
+		const float* s = src[0];
+		for (int i = 0; i < frames; i++)
+		{
+			d[i * 2]     += s[i * 2] * (fromL + stepL * i);
+			d[i * 2 + 1] += s[i * 2 + 1] * (fromR + stepR * i);
+		}
+		return;
+	}
+
+	for (int i = 0; i < frames; i++)
+	{
+		const float gL = fromL + stepL * i;
+		const float gR = fromR + stepR * i;
+		for (int j = 0; j < dst.countChannels(); j++)
+			dst[i][j] += src[i][std::min(j, srcChannels - 1)] * (j == 0 ? gL : gR);
+	}
+}
+} // namespace giada::m::rendering
@@ -0,0 +1,55 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_RENDERING_MIXING_H
+#define G_RENDERING_MIXING_H
+
+#include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
+
+namespace giada::m
+{
+class ChannelShared;
+}
+
+namespace giada::m::rendering
+{
+/* calcPanning
+Returns the left and right gains for the given pan value. Center pan (0.5) is
+a pass-through. */
+
+mcl::AudioBuffer::Pan calcPanning(float pan);
+
+/* sumRamped
+Sums 'src' into 'dst' with the given volume and pan, read from the channel's
+parameter lanes. If the resulting gains differ from the ones used in the
+previous block, they are linearly ramped across the current block to avoid
+zipper noise. */
+
+void sumRamped(mcl::AudioBuffer& dst, const mcl::AudioBuffer& src, ChannelShared&, float volume, float pan);
+} // namespace giada::m::rendering
+
+#endif
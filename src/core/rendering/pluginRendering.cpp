@@ -27,6 +27,7 @@
 #include "core/rendering/pluginRendering.h"
 #include "core/channels/channel.h"
 #include "core/plugins/pluginHost.h"
+#include <span>
 
 namespace giada::m::rendering
 {
@@ -34,14 +35,16 @@ namespace
 {
 /* prepareMidiBuffer_
 Fills the JUCE MIDI buffer with events previously enqueued in the MidiQueue.
-Returns a reference to the JUCE MIDI buffer for convenience. */
+Returns a reference to the JUCE MIDI buffer for convenience. The buffer is
+preallocated for G_MAX_MIDI_EVENTS: events in excess are left in the queue for
+the next block. */
 
 const juce::MidiBuffer& prepareMidiBuffer_(ChannelShared& shared)
 {
 	shared.midiBuffer.clear();
 
 	MidiEvent e;
-	while (shared.midiQueue.try_dequeue(e))
+	for (int i = 0; i < G_MAX_MIDI_EVENTS && shared.midiQueue.try_dequeue(e); i++)
 	{
 		juce::MidiMessage message = juce::MidiMessage(
 		    e.getStatus(),
@@ -52,6 +55,13 @@ const juce::MidiBuffer& prepareMidiBuffer_(ChannelShared& shared)
 
 	return shared.midiBuffer;
 }
+
+/* -------------------------------------------------------------------------- */
+
+std::span<const PluginParamChange> getParamChanges_(const ChannelShared& shared)
+{
+	return {shared.paramChanges.begin(), shared.paramChanges.end()};
+}
 } // namespace
 
 /* -------------------------------------------------------------------------- */
@@ -60,14 +70,36 @@ const juce::MidiBuffer& prepareMidiBuffer_(ChannelShared& shared)
 
 void renderAudioAndMidiPlugins(const Channel& ch, PluginHost& pluginHost)
 {
-	pluginHost.processStack(ch.shared->audioBuffer, ch.plugins, &prepareMidiBuffer_(*ch.shared));
+	pluginHost.processStack(ch.shared->audioBuffer, ch.plugins, prepareMidiBuffer_(*ch.shared), getParamChanges_(*ch.shared));
 	ch.shared->midiBuffer.clear();
+	ch.shared->paramChanges.clear();
 }
 
 /* -------------------------------------------------------------------------- */
 
 void renderAudioPlugins(const Channel& ch, PluginHost& pluginHost)
 {
-	pluginHost.processStack(ch.shared->audioBuffer, ch.plugins, nullptr);
+	pluginHost.processStack(ch.shared->audioBuffer, ch.plugins, getParamChanges_(*ch.shared));
+	ch.shared->paramChanges.clear();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void renderGroupPlugins(const Channel& group, mcl::AudioBuffer& out, PluginHost& pluginHost)
+{
+	pluginHost.processStack(out, group.plugins, getParamChanges_(*group.shared));
+	group.shared->paramChanges.clear();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void queuePluginParamChanges(const Channel& ch, std::span<const Action* const> actions, Frame delta)
+{
+	for (const Action* a : actions)
+	{
+		if (a->pluginId == -1 || a->event.getStatus() != MidiEvent::CHANNEL_CC)
+			continue;
+		ch.shared->paramChanges.push_back({a->pluginId, a->pluginParam, a->event.getVelocityFloat(), delta});
+	}
 }
 } // namespace giada::m::rendering
@@ -27,7 +27,10 @@
 #ifndef G_RENDERING_PLUGIN_RENDERING_H
 #define G_RENDERING_PLUGIN_RENDERING_H
 
+#include "core/actions/action.h"
 #include "core/channels/channelShared.h"
+#include <span>
+#include <vector>
 
 namespace giada::m
 {
@@ -46,6 +49,18 @@ void renderAudioAndMidiPlugins(const Channel&, PluginHost&);
 Renders audio-only plug-ins. */
 
 void renderAudioPlugins(const Channel&, PluginHost&);
+
+/* renderGroupPlugins
+Renders the plug-ins of a Group Channel on the given track buffer. */
+
+void renderGroupPlugins(const Channel& group, mcl::AudioBuffer& out, PluginHost&);
+
+/* queuePluginParamChanges
+Queues the plug-in parameter changes found in the given actions, to be applied
+at frame 'delta' when the channel's plug-ins are rendered. Changes in excess of
+G_MAX_PARAM_CHANGES per block are dropped. */
+
+void queuePluginParamChanges(const Channel&, std::span<const Action* const>, Frame delta);
 } // namespace giada::m::rendering
 
 #endif
@@ -33,129 +33,80 @@
 
 namespace giada::m::rendering
 {
-Reactor::Reactor(model::Model& model, MidiMapper<KernelMidi>& m, ActionRecorder& a, KernelMidi& km)
+Reactor::Reactor(model::Model& model, MidiMapper<KernelMidi>& m, ActionRecorder& a, KernelMidi& km, TriggerQueue& q)
 : m_model(model)
 , m_kernelMidi(km)
 , m_actionRecorder(a)
 , m_midiMapper(m)
+, m_triggerQueue(q)
 {
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Reactor::keyPress(ID channelId, float velocity, bool canRecordActions, bool canQuantize, Frame currentFrameQuantized)
+void Reactor::keyPress(ID channelId, float velocity, bool canRecordActions, bool canQuantize, Frame currentFrameQuantized, Frame localFrame)
 {
 	Channel& ch = m_model.get().tracks.getChannel(channelId);
 
-	if (ch.type == ChannelType::MIDI)
-	{
-		playMidiChannel(ch.shared->playStatus);
-	}
-	else if (ch.type == ChannelType::SAMPLE && ch.hasWave())
-	{
-		const bool             isAnyLoopMode = ch.sampleChannel->isAnyLoopMode();
-		const bool             velocityAsVol = ch.sampleChannel->velocityAsVol;
-		const SamplePlayerMode mode          = ch.sampleChannel->mode;
-
-		if (canRecordActions && !isAnyLoopMode)
-		{
-			recordSampleKeyPress(channelId, *ch.shared, currentFrameQuantized, mode, m_actionRecorder);
-			ch.hasActions = true;
-		}
+	bool hasRecorded = false;
 
-		pressSampleChannel(channelId, *ch.shared, mode, velocity, canQuantize, isAnyLoopMode, velocityAsVol);
-	}
-	else if (ch.type == ChannelType::PREVIEW)
-	{
-		pressSampleChannel(channelId, *ch.shared, SamplePlayerMode::SINGLE_BASIC_PAUSE,
-		    /*velocity=*/0.0f, /*canQuantize=*/false, /*isAnyLoopMode=*/false,
-		    /*velocityAsVol=*/false);
-	}
-	else if (ch.type == ChannelType::GROUP)
+	if (ch.type == ChannelType::GROUP)
 	{
-		for (const Channel& child : m_model.get().tracks.getByChannel(ch.id).getChannels().getAll())
+		for (Channel& child : m_model.get().tracks.getByChannel(ch.id).getChannels().getAll())
 			if (child.type != ChannelType::GROUP)
-				keyPress(child.id, velocity, canRecordActions, canQuantize, currentFrameQuantized);
+				hasRecorded |= pressChannel(child, velocity, canRecordActions, canQuantize, currentFrameQuantized, localFrame);
 	}
+	else
+		hasRecorded = pressChannel(ch, velocity, canRecordActions, canQuantize, currentFrameQuantized, localFrame);
 
-	m_model.swap(model::SwapType::SOFT);
+	/* The Document needs to be swapped only if new actions have been recorded.
+	Play status changes are performed by the real-time thread on the channel's
+	shared state. */
+
+	if (hasRecorded)
+		m_model.swap(model::SwapType::SOFT);
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Reactor::keyRelease(ID channelId, bool canRecordActions, Frame currentFrameQuantized)
+void Reactor::keyRelease(ID channelId, bool canRecordActions, Frame currentFrameQuantized, Frame localFrame)
 {
 	Channel& ch = m_model.get().tracks.getChannel(channelId);
 
-	if (ch.type == ChannelType::MIDI)
-		return;
-
-	if (ch.type == ChannelType::SAMPLE && ch.hasWave())
-	{
-		const SamplePlayerMode mode = ch.sampleChannel->mode;
-
-		if (canRecordActions && mode == SamplePlayerMode::SINGLE_PRESS)
-		{
-			/* Record a stop event only if channel is SINGLE_PRESS. For any other
-		mode the key release event is meaningless. */
-
-			recordSampleKeyRelease(channelId, currentFrameQuantized, m_actionRecorder);
-			ch.hasActions = true;
-		}
+	bool hasRecorded = false;
 
-		releaseSampleChannel(*ch.shared, mode);
-	}
-	else if (ch.type == ChannelType::PREVIEW)
-	{
-		releaseSampleChannel(*ch.shared, SamplePlayerMode::SINGLE_BASIC_PAUSE);
-	}
-	else if (ch.type == ChannelType::GROUP)
+	if (ch.type == ChannelType::GROUP)
 	{
-		for (const Channel& child : m_model.get().tracks.getByChannel(ch.id).getChannels().getAll())
+		for (Channel& child : m_model.get().tracks.getByChannel(ch.id).getChannels().getAll())
 			if (child.type != ChannelType::GROUP)
-				keyRelease(child.id, canRecordActions, currentFrameQuantized);
+				hasRecorded |= releaseChannel(child, canRecordActions, currentFrameQuantized, localFrame);
 	}
+	else
+		hasRecorded = releaseChannel(ch, canRecordActions, currentFrameQuantized, localFrame);
 
-	m_model.swap(model::SwapType::SOFT);
+	if (hasRecorded)
+		m_model.swap(model::SwapType::SOFT);
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Reactor::keyKill(ID channelId, bool canRecordActions, Frame currentFrameQuantized)
+void Reactor::keyKill(ID channelId, bool canRecordActions, Frame currentFrameQuantized, Frame localFrame)
 {
 	Channel& ch = m_model.get().tracks.getChannel(channelId);
 
-	if (ch.type == ChannelType::MIDI)
-	{
-		if (ch.isPlaying())
-		{
-			stopMidiChannel(ch.shared->playStatus);
-			sendMidiAllNotesOff(ch, m_kernelMidi);
-		}
-	}
-	else if (ch.type == ChannelType::SAMPLE)
-	{
-		const SamplePlayerMode mode = ch.sampleChannel->mode;
-
-		if (ch.hasWave() && canRecordActions && mode == SamplePlayerMode::SINGLE_PRESS)
-		{
-			/* Record a stop event only if channel is SINGLE_PRESS. For any other
-			mode the key release event is meaningless. */
+	bool hasRecorded = false;
 
-			recordSampleKeyKill(channelId, currentFrameQuantized, m_actionRecorder);
-			ch.hasActions = true;
-		}
-
-		killSampleChannel(*ch.shared, mode);
-	}
-	else if (ch.type == ChannelType::GROUP)
+	if (ch.type == ChannelType::GROUP)
 	{
-		for (const Channel& child : m_model.get().tracks.getByChannel(ch.id).getChannels().getAll())
+		for (Channel& child : m_model.get().tracks.getByChannel(ch.id).getChannels().getAll())
 			if (child.type != ChannelType::GROUP)
-				keyKill(child.id, canRecordActions, currentFrameQuantized);
+				hasRecorded |= killChannel(child, canRecordActions, currentFrameQuantized, localFrame);
 	}
+	else
+		hasRecorded = killChannel(ch, canRecordActions, currentFrameQuantized, localFrame);
 
-	m_model.swap(model::SwapType::SOFT);
+	if (hasRecorded)
+		m_model.swap(model::SwapType::SOFT);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -299,4 +250,80 @@ void Reactor::rewindAll()
 				rewindMidiChannel(ch.shared->playStatus);
 	m_model.swap(model::SwapType::SOFT);
 }
+
+/* -------------------------------------------------------------------------- */
+
+bool Reactor::pressChannel(Channel& ch, float velocity, bool canRecordActions, bool canQuantize, Frame currentFrameQuantized, Frame localFrame)
+{
+	bool hasRecorded = false;
+
+	if (ch.type == ChannelType::SAMPLE && ch.hasWave())
+	{
+		const SamplePlayerMode mode = ch.sampleChannel->mode;
+
+		if (canRecordActions && !ch.sampleChannel->isAnyLoopMode())
+		{
+			recordSampleKeyPress(ch.id, *ch.shared, currentFrameQuantized, mode, m_actionRecorder);
+			ch.hasActions = true;
+			hasRecorded   = true;
+		}
+	}
+
+	m_triggerQueue.enqueue({Trigger::Type::PRESS, ch.id, velocity, canQuantize, localFrame});
+
+	return hasRecorded;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Reactor::releaseChannel(Channel& ch, bool canRecordActions, Frame currentFrameQuantized, Frame localFrame)
+{
+	if (ch.type == ChannelType::MIDI)
+		return false;
+
+	bool hasRecorded = false;
+
+	/* Record a stop event only if channel is SINGLE_PRESS. For any other mode
+	the key release event is meaningless. */
+
+	if (ch.type == ChannelType::SAMPLE && ch.hasWave() && canRecordActions &&
+	    ch.sampleChannel->mode == SamplePlayerMode::SINGLE_PRESS)
+	{
+		recordSampleKeyRelease(ch.id, currentFrameQuantized, m_actionRecorder);
+		ch.hasActions = true;
+		hasRecorded   = true;
+	}
+
+	m_triggerQueue.enqueue({Trigger::Type::RELEASE, ch.id, 0.0f, false, localFrame});
+
+	return hasRecorded;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Reactor::killChannel(Channel& ch, bool canRecordActions, Frame currentFrameQuantized, Frame localFrame)
+{
+	bool hasRecorded = false;
+
+	/* Record a stop event only if channel is SINGLE_PRESS. For any other mode
+	the key kill event is meaningless. */
+
+	if (ch.type == ChannelType::SAMPLE && ch.hasWave() && canRecordActions &&
+	    ch.sampleChannel->mode == SamplePlayerMode::SINGLE_PRESS)
+	{
+		recordSampleKeyKill(ch.id, currentFrameQuantized, m_actionRecorder);
+		ch.hasActions = true;
+		hasRecorded   = true;
+	}
+
+	m_triggerQueue.enqueue({Trigger::Type::KILL, ch.id, 0.0f, false, localFrame});
+
+	/* Silence MIDI channels from here, as stopAll() does: the audio thread only
+	changes the play status when processing the trigger. */
+
+	if (ch.type == ChannelType::MIDI && ch.isPlaying())
+		sendMidiAllNotesOff(ch, m_kernelMidi);
+
+	return hasRecorded;
+}
 } // namespace giada::m::rendering
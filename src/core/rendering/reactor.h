@@ -28,10 +28,12 @@
 #define G_RENDERING_REACTOR_H
 
 #include "core/midiMapper.h"
+#include "core/rendering/trigger.h"
 #include "core/types.h"
 
 namespace giada::m
 {
+class Channel;
 class MidiEvent;
 class ActionRecorder;
 class KernelMidi;
@@ -47,11 +49,17 @@ namespace giada::m::rendering
 class Reactor
 {
 public:
-	Reactor(model::Model&, MidiMapper<KernelMidi>&, ActionRecorder&, KernelMidi&);
+	Reactor(model::Model&, MidiMapper<KernelMidi>&, ActionRecorder&, KernelMidi&, TriggerQueue&);
 
-	void keyPress(ID channelId, float velocity, bool canRecordActions, bool canQuantize, Frame currentFrameQuantized);
-	void keyRelease(ID channelId, bool canRecordActions, Frame currentFrameQuantized);
-	void keyKill(ID channelId, bool canRecordActions, Frame currentFrameQuantized);
+	/* key[Press|Release|Kill]
+	Manual triggers. 'localFrame' is the offset in the next audio block where
+	the trigger takes place. Actions are recorded here, while the actual play
+	status change is delegated to the real-time thread through the trigger
+	queue. */
+
+	void keyPress(ID channelId, float velocity, bool canRecordActions, bool canQuantize, Frame currentFrameQuantized, Frame localFrame);
+	void keyRelease(ID channelId, bool canRecordActions, Frame currentFrameQuantized, Frame localFrame);
+	void keyKill(ID channelId, bool canRecordActions, Frame currentFrameQuantized, Frame localFrame);
 	void processMidiEvent(ID channelId, const MidiEvent&, bool canRecordActions, Frame currentFrameQuantized);
 	void toggleReadActions(ID channelId, bool seqIsRunning);
 	void killReadActions(ID channelId);
@@ -61,10 +69,19 @@ public:
 	void rewindAll();
 
 private:
+	/* [press|release|kill]Channel
+	Records actions (if any) and pushes a new trigger for a single non-group
+	channel. Returns whether the Document has been modified. */
+
+	bool pressChannel(Channel&, float velocity, bool canRecordActions, bool canQuantize, Frame currentFrameQuantized, Frame localFrame);
+	bool releaseChannel(Channel&, bool canRecordActions, Frame currentFrameQuantized, Frame localFrame);
+	bool killChannel(Channel&, bool canRecordActions, Frame currentFrameQuantized, Frame localFrame);
+
 	model::Model&           m_model;
 	KernelMidi&             m_kernelMidi;
 	ActionRecorder&         m_actionRecorder;
 	MidiMapper<KernelMidi>& m_midiMapper;
+	TriggerQueue&           m_triggerQueue;
 };
 } // namespace giada::m::rendering
 
@@ -0,0 +1,280 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/rendering/renderAheadQueue.h"
+#include "core/const.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace giada::m::rendering
+{
+RenderAheadQueue::Slot::Slot()
+: m_depth(1)
+, m_read(0)
+, m_write(0)
+, m_state(State::FREE)
+, m_trackId(0)
+, m_flush(false)
+, m_hold(0)
+, m_nextFrame(0)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+RenderAheadQueue::State RenderAheadQueue::Slot::getState() const { return m_state.load(); }
+ID                      RenderAheadQueue::Slot::getTrackId() const { return m_trackId.load(); }
+
+/* -------------------------------------------------------------------------- */
+
+bool RenderAheadQueue::Slot::bind(ID trackId)
+{
+	if (m_state.load() != State::FREE)
+		return false;
+
+	/* Only the worker moves a slot out of FREE: no need for a CAS here. */
+
+	m_trackId.store(trackId);
+	m_flush.store(false);
+	m_hold.store(0);
+	m_state.store(State::IDLE);
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool RenderAheadQueue::Slot::unbind()
+{
+	State state = m_state.load();
+	if (state == State::FREE || state == State::BUSY)
+		return state == State::FREE;
+	if (!m_state.compare_exchange_strong(state, State::FREE))
+		return false;
+	clear();
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool RenderAheadQueue::Slot::request()
+{
+	if (m_hold.load() > 0 || m_flush.load())
+		return false;
+	State expected = State::IDLE;
+	return m_state.compare_exchange_strong(expected, State::REQUESTED);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RenderAheadQueue::Slot::accept(Frame nextFrame)
+{
+	assert(m_state.load() == State::REQUESTED);
+
+	m_nextFrame = nextFrame;
+	m_state.store(State::AHEAD, std::memory_order_release);
+}
+
+void RenderAheadQueue::Slot::reject()
+{
+	assert(m_state.load() == State::REQUESTED);
+
+	m_flush.store(false);
+	m_hold.store(HOLD_BLOCKS);
+	m_state.store(State::IDLE);
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool RenderAheadQueue::Slot::acquire()
+{
+	State expected = State::AHEAD;
+	return m_state.compare_exchange_strong(expected, State::BUSY, std::memory_order_acquire);
+}
+
+void RenderAheadQueue::Slot::release()
+{
+	assert(m_state.load() == State::BUSY);
+
+	m_state.store(State::AHEAD, std::memory_order_release);
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool RenderAheadQueue::Slot::reclaim()
+{
+	State expected = State::AHEAD;
+	if (!m_state.compare_exchange_strong(expected, State::IDLE, std::memory_order_acquire))
+		return false;
+	m_flush.store(false);
+	m_hold.store(HOLD_BLOCKS);
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RenderAheadQueue::Slot::tick()
+{
+	/* A flush on a track already owned by the audio thread just restarts the
+	hold period. */
+
+	if (m_flush.exchange(false))
+		m_hold.store(HOLD_BLOCKS);
+	else if (m_hold.load() > 0)
+		m_hold.fetch_sub(1);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RenderAheadQueue::Slot::requestFlush() { m_flush.store(true); }
+bool RenderAheadQueue::Slot::isFlushRequested() const { return m_flush.load(); }
+
+/* -------------------------------------------------------------------------- */
+
+RenderAheadQueue::Block* RenderAheadQueue::Slot::getWriteBlock()
+{
+	const std::size_t w = m_write.load(std::memory_order_relaxed);
+	if (w - m_read.load(std::memory_order_acquire) >= m_depth)
+		return nullptr;
+	return &m_blocks[w % m_depth];
+}
+
+void RenderAheadQueue::Slot::push()
+{
+	m_write.store(m_write.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+Frame RenderAheadQueue::Slot::getNextFrame() const { return m_nextFrame; }
+void  RenderAheadQueue::Slot::setNextFrame(Frame f) { m_nextFrame = f; }
+
+/* -------------------------------------------------------------------------- */
+
+const RenderAheadQueue::Block* RenderAheadQueue::Slot::front() const
+{
+	const std::size_t r = m_read.load(std::memory_order_relaxed);
+	if (r == m_write.load(std::memory_order_acquire))
+		return nullptr;
+	return &m_blocks[r % m_depth];
+}
+
+void RenderAheadQueue::Slot::pop()
+{
+	assert(size() > 0);
+
+	m_read.store(m_read.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void RenderAheadQueue::Slot::clear()
+{
+	m_read.store(m_write.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::size_t RenderAheadQueue::Slot::size() const
+{
+	return m_write.load(std::memory_order_acquire) - m_read.load(std::memory_order_acquire);
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+int RenderAheadQueue::computeDepth(int bufferSize, int sampleRate)
+{
+	const double frames = sampleRate * G_RENDER_AHEAD_MS / 1000.0;
+	return std::clamp(static_cast<int>(std::ceil(frames / bufferSize)), 1, MAX_BLOCKS);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RenderAheadQueue::reset(int bufferSize, int depth)
+{
+	assert(depth > 0 && depth <= MAX_BLOCKS);
+
+	for (Slot& slot : m_slots)
+	{
+		slot.m_state.store(State::FREE);
+		slot.m_trackId.store(0);
+		slot.m_flush.store(false);
+		slot.m_hold.store(0);
+		slot.m_read.store(0);
+		slot.m_write.store(0);
+		slot.m_depth = depth;
+		for (int i = 0; i < MAX_BLOCKS; i++)
+		{
+			if (i < depth)
+				slot.m_blocks[i].audio.alloc(bufferSize, G_MAX_IO_CHANS);
+			else
+				slot.m_blocks[i].audio = mcl::AudioBuffer();
+		}
+	}
+	m_deferred.clear();
+}
+
+/* -------------------------------------------------------------------------- */
+
+RenderAheadQueue::Slots&       RenderAheadQueue::getSlots() { return m_slots; }
+const RenderAheadQueue::Slots& RenderAheadQueue::getSlots() const { return m_slots; }
+
+/* -------------------------------------------------------------------------- */
+
+RenderAheadQueue::Slot* RenderAheadQueue::find(ID trackId)
+{
+	for (Slot& slot : m_slots)
+		if (slot.getState() != State::FREE && slot.getTrackId() == trackId)
+			return &slot;
+	return nullptr;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RenderAheadQueue::requestFlush()
+{
+	for (Slot& slot : m_slots)
+		if (slot.getState() != State::FREE)
+			slot.requestFlush();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RenderAheadQueue::setSuspended(bool v) { m_suspended.store(v); }
+bool RenderAheadQueue::isSuspended() const { return m_suspended.load(); }
+
+/* -------------------------------------------------------------------------- */
+
+bool RenderAheadQueue::deferTrigger(const Trigger& t)
+{
+	return m_deferred.push_back(t);
+}
+
+RenderAheadQueue::DeferredTriggers RenderAheadQueue::takeDeferredTriggers()
+{
+	DeferredTriggers out = m_deferred;
+	m_deferred.clear();
+	return out;
+}
+} // namespace giada::m::rendering
@@ -0,0 +1,256 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_RENDERING_RENDER_AHEAD_QUEUE_H
+#define G_RENDERING_RENDER_AHEAD_QUEUE_H
+
+#include "core/const.h"
+#include "core/rendering/trigger.h"
+#include "core/ringBuffer.h"
+#include "core/types.h"
+#include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace giada::m::rendering
+{
+/* RenderAheadQueue
+Per-track FIFOs of audio blocks rendered ahead of time by a non-realtime worker
+thread, for tracks whose output doesn't depend on any live input. Each slot is
+bound to a track (i.e. to its Group Channel) and, at any time, either the audio
+thread or the worker owns the track's channels, according to the slot state:
+    State::FREE - not bound to any track;
+    State::IDLE - bound, the track is rendered by the audio thread as usual;
+    State::REQUESTED - the worker wants to take the track over. The audio thread
+        accepts (-> AHEAD) or rejects (-> IDLE) the request after its next block;
+    State::AHEAD - the track is rendered by the worker: the audio thread only
+        reads blocks from the FIFO;
+    State::BUSY - same as AHEAD, while the worker is rendering a block.
+The audio thread takes the track back (AHEAD -> IDLE) whenever a flush is
+requested, e.g. on live interaction. */
+
+class RenderAheadQueue final
+{
+public:
+	/* MAX_TRACKS, MAX_CHANNELS
+	Maximum number of tracks that can be rendered ahead, and maximum number of
+	channels (Group Channel included) of each one of them. */
+
+	static constexpr std::size_t MAX_TRACKS   = 16;
+	static constexpr std::size_t MAX_CHANNELS = 32;
+
+	/* MAX_BLOCKS
+	Maximum depth of each FIFO, in audio blocks. */
+
+	static constexpr int MAX_BLOCKS = 16;
+
+	/* HOLD_BLOCKS
+	Number of audio blocks a track stays with the audio thread after a flush or
+	a rejected request, before the worker may ask for it again. */
+
+	static constexpr int HOLD_BLOCKS = 64;
+
+	/* MAX_DEFERRED_TRIGGERS
+	Maximum number of triggers waiting for a track to be taken back. */
+
+	static constexpr std::size_t MAX_DEFERRED_TRIGGERS = 32;
+
+	enum class State
+	{
+		FREE,
+		IDLE,
+		REQUESTED,
+		AHEAD,
+		BUSY
+	};
+
+	/* ChannelState
+	Playback and rendering state of a channel, as it was before rendering a
+	block. Used to rewind the channel when the track is taken back by the audio
+	thread. The resampler and the delay line can't be saved: they are reset
+	instead. */
+
+	struct ChannelState
+	{
+		ID            channelId    = 0;
+		Frame         tracker      = 0;
+		ChannelStatus playStatus   = ChannelStatus::OFF;
+		int           quantizerId  = -1;
+		float         lastGainL    = -1.0f;
+		float         lastGainR    = -1.0f;
+		float         envelopeGain = G_DEFAULT_VOL;
+	};
+
+	struct Block
+	{
+		mcl::AudioBuffer                       audio;
+		Frame                                  frame       = 0; // Sequencer frame the block starts at
+		std::array<ChannelState, MAX_CHANNELS> channels    = {};
+		std::size_t                            numChannels = 0;
+	};
+
+	class Slot final
+	{
+	public:
+		Slot();
+
+		State getState() const;
+		ID    getTrackId() const;
+
+		/* bind
+		Worker thread. Binds a free slot to a track, given its Group Channel ID.
+		Returns false if the slot is taken. */
+
+		bool bind(ID trackId);
+
+		/* unbind
+		Audio thread. Frees the slot. Returns false if the worker is rendering a
+		block: try again later. */
+
+		bool unbind();
+
+		/* request
+		Worker thread. Asks the audio thread to hand the track over. Returns
+		false if the track has been taken back recently or a flush is pending. */
+
+		bool request();
+
+		/* accept, reject
+		Audio thread. Answers a request. On accept, 'nextFrame' is the sequencer
+		frame the worker starts rendering from. */
+
+		void accept(Frame nextFrame);
+		void reject();
+
+		/* acquire, release
+		Worker thread. Marks the slot as busy while rendering a block. acquire()
+		returns false if the track is not rendered ahead. */
+
+		bool acquire();
+		void release();
+
+		/* reclaim
+		Audio thread. Takes the track back. Returns false if the worker is
+		rendering a block: the track stays with the worker for now. The FIFO is
+		left untouched. */
+
+		bool reclaim();
+
+		/* tick
+		Audio thread. Counts down the hold period, once per block. */
+
+		void tick();
+
+		/* requestFlush, isFlushRequested
+		Any thread. Asks the audio thread to take the track back as soon as
+		possible. */
+
+		void requestFlush();
+		bool isFlushRequested() const;
+
+		/* getWriteBlock, push, getNextFrame, setNextFrame
+		Worker thread, while the slot is busy. getWriteBlock() returns nullptr if
+		the FIFO is full. */
+
+		Block* getWriteBlock();
+		void   push();
+		Frame  getNextFrame() const;
+		void   setNextFrame(Frame);
+
+		/* front, pop, clear
+		Audio thread. front() returns nullptr if the FIFO is empty. */
+
+		const Block* front() const;
+		void         pop();
+		void         clear();
+
+		std::size_t size() const;
+
+	private:
+		friend class RenderAheadQueue;
+
+		std::array<Block, MAX_BLOCKS> m_blocks;
+		std::size_t                   m_depth;
+		std::atomic<std::size_t>      m_read;
+		std::atomic<std::size_t>      m_write;
+		std::atomic<State>            m_state;
+		std::atomic<ID>               m_trackId;
+		std::atomic<bool>             m_flush;
+		std::atomic<int>              m_hold;
+		Frame                         m_nextFrame;
+	};
+
+	using Slots            = std::array<Slot, MAX_TRACKS>;
+	using DeferredTriggers = RingBuffer<Trigger, MAX_DEFERRED_TRIGGERS>;
+
+	/* computeDepth
+	Returns how many blocks to render ahead for the given audio settings, so
+	that the FIFOs hold roughly G_RENDER_AHEAD_MS of audio. */
+
+	static int computeDepth(int bufferSize, int sampleRate);
+
+	/* reset
+	Frees all slots and sets a new block size and FIFO depth. Must be called
+	only when the audio thread and the worker are both stopped. */
+
+	void reset(int bufferSize, int depth);
+
+	Slots&       getSlots();
+	const Slots& getSlots() const;
+
+	/* find
+	Returns the slot bound to the given track, or nullptr if none. */
+
+	Slot* find(ID trackId);
+
+	/* requestFlush
+	Any thread. Requests a flush on all bound slots. */
+
+	void requestFlush();
+
+	/* setSuspended, isSuspended
+	A suspended queue doesn't hand any track over to the worker. */
+
+	void setSuspended(bool);
+	bool isSuspended() const;
+
+	/* deferTrigger, takeDeferredTriggers
+	Audio thread. Triggers for a track still owned by the worker are kept here
+	until the track is taken back. deferTrigger() returns false if full: the
+	trigger is dropped. */
+
+	bool             deferTrigger(const Trigger&);
+	DeferredTriggers takeDeferredTriggers();
+
+private:
+	Slots             m_slots;
+	DeferredTriggers  m_deferred;
+	std::atomic<bool> m_suspended = false;
+};
+} // namespace giada::m::rendering
+
+#endif
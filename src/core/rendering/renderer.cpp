@@ -27,44 +27,125 @@
 #include "core/rendering/renderer.h"
 #include "core/mixer.h"
 #include "core/model/model.h"
+#include "core/profiler.h"
+#include "core/recBuffer.h"
 #include "core/rendering/midiAdvance.h"
-#include "core/rendering/midiOutput.h"
 #include "core/rendering/midiReactions.h"
+#include "core/rendering/mixing.h"
 #include "core/rendering/pluginRendering.h"
 #include "core/rendering/sampleAdvance.h"
+#include "core/rendering/sampleReactions.h"
 #include "core/rendering/sampleRendering.h"
+#include "core/wave.h"
+#include "utils/alloc.h"
 #ifdef WITH_AUDIO_JACK
 #include "core/jackSynchronizer.h"
 #include "core/jackTransport.h"
 #endif
+#include <algorithm>
+#include <thread>
 
 namespace giada::m::rendering
 {
-mcl::AudioBuffer::Pan calcPanning_(float pan)
+namespace
 {
-	/* TODO - precompute the AudioBuffer::Pan when pan value changes instead of
-	building it on the fly. */
+/* findTrack_
+Returns the track with the given Group Channel ID, or nullptr if not found. */
 
-	/* Center pan (0.5f)? Pass-through. */
+const model::Track* findTrack_(const model::Tracks& tracks, ID groupChannelId)
+{
+	for (const model::Track& track : tracks.getAll())
+		if (track.getGroupChannel().id == groupChannelId)
+			return &track;
+	return nullptr;
+}
+
+/* -------------------------------------------------------------------------- */
 
-	if (pan == 0.5f)
-		return {1.0f, 1.0f};
-	return {1.0f - pan, pan};
+/* findTrackOf_
+Returns the track the given channel belongs to, or nullptr if not found. */
+
+const model::Track* findTrackOf_(const model::Tracks& tracks, ID channelId)
+{
+	for (const model::Track& track : tracks.getAll())
+		if (track.getChannels().find(channelId) != nullptr)
+			return &track;
+	return nullptr;
 }
 
+/* -------------------------------------------------------------------------- */
+
+/* isRenderedAhead_
+True if the slot's track is currently owned by the render-ahead worker. */
+
+bool isRenderedAhead_(const RenderAheadQueue::Slot* slot)
+{
+	if (slot == nullptr)
+		return false;
+	const RenderAheadQueue::State state = slot->getState();
+	return state == RenderAheadQueue::State::AHEAD || state == RenderAheadQueue::State::BUSY;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* hasPendingMidi_
+True if any MIDI channel in the track has events waiting in its queue, e.g.
+live MIDI input sent to its plug-ins. */
+
+bool hasPendingMidi_(const model::Track& track)
+{
+	for (const Channel& c : track.getChannels().getAll())
+		if (c.type == ChannelType::MIDI && c.shared->midiQueue.size_approx() > 0)
+			return true;
+	return false;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* advanceVolumeEnvelope_
+Reads the channel's volume envelope at the end of the block 'block'. Only the
+end gain is needed: the one at the start of the block is the end gain of the
+previous block, and sumRamped() ramps between the two. Sample Channels follow
+their envelope only while reading actions. */
+
+void advanceVolumeEnvelope_(const Channel& ch, const model::Actions& actions, const model::Sequencer& sequencer,
+    geompp::Range<Frame> block)
+{
+	const model::Actions::Envelope* envelope = actions.getVolumeEnvelope(ch.id);
+
+	if (envelope == nullptr || (ch.type == ChannelType::SAMPLE && !ch.shared->isReadingActions()))
+	{
+		ch.shared->envelopeGain = G_DEFAULT_VOL;
+		return;
+	}
+
+	Frame end = block.b;
+	if (end > sequencer.framesInLoop && sequencer.framesInLoop > 0) // Block crossing the end of the loop
+		end %= sequencer.framesInLoop;
+
+	ch.shared->envelopeGain = model::getEnvelopeValue(*envelope, sequencer.frameToTick(end));
+}
+} // namespace
+
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
 #ifdef WITH_AUDIO_JACK
-Renderer::Renderer(Sequencer& s, Mixer& m, PluginHost& ph, JackSynchronizer& js, JackTransport& jt, KernelMidi& km)
+Renderer::Renderer(Sequencer& s, Mixer& m, PluginHost& ph, JackSynchronizer& js, JackTransport& jt, KernelMidi& km, TriggerQueue& q,
+    RenderAheadQueue& raq, PluginHost& aph, Profiler& p)
 #else
-Renderer::Renderer(Sequencer& s, Mixer& m, PluginHost& ph, KernelMidi& km)
+Renderer::Renderer(Sequencer& s, Mixer& m, PluginHost& ph, KernelMidi& km, TriggerQueue& q, RenderAheadQueue& raq,
+    PluginHost& aph, Profiler& p)
 #endif
 : m_sequencer(s)
 , m_mixer(m)
 , m_pluginHost(ph)
 , m_kernelMidi(km)
+, m_triggerQueue(q)
+, m_renderAheadQueue(raq)
+, m_profiler(p)
+, m_aheadPluginHost(aph)
 #ifdef WITH_AUDIO_JACK
 , m_jackSynchronizer(js)
 , m_jackTransport(jt)
@@ -76,6 +157,8 @@ Renderer::Renderer(Sequencer& s, Mixer& m, PluginHost& ph, KernelMidi& km)
 
 void Renderer::render(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const model::Model& model) const
 {
+	G_ALLOC_TRAP();
+
 	/* Clean up output buffer before any rendering. Do this even if mixer is
 	disabled to avoid audio leftovers during a temporary suspension (e.g. when
 	loading a new patch). */
@@ -104,6 +187,21 @@ void Renderer::render(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const m
 		m_jackSynchronizer.recvJackSync(m_jackTransport.getState());
 #endif
 
+	const Frame currentFrame = sequencer.a_getCurrentFrame(); // Before advancing
+
+	/* Apply manual triggers first, so that quantized ones are seen by the
+	quantizer in the advance step below. Triggers are left in the queue while
+	the document is locked: they will be processed as soon as it is released.
+	Tracks rendered ahead that got a trigger are taken back from the worker
+	in between. */
+
+	if (!document_RT.locked)
+	{
+		processTriggers(tracks);
+		prepareRenderAhead(tracks, currentFrame, sequencer.isRunning());
+		processDeferredTriggers(tracks);
+	}
+
 	/* If the m_sequencer is running, advance it first (i.e. parse it for events).
 	Also advance channels (i.e. let them react to m_sequencer events), only if the
 	document is not locked: another thread might altering channel's data in the
@@ -111,20 +209,23 @@ void Renderer::render(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const m
 
 	if (sequencer.isRunning())
 	{
-		const Frame                currentFrame  = sequencer.a_getCurrentFrame();
 		const int                  bufferSize    = out.countFrames();
 		const int                  quantizerStep = m_sequencer.getQuantizerStep();            // TODO pass this to m_sequencer.advance - or better, Advancer class
 		const geompp::Range<Frame> renderRange   = {currentFrame, currentFrame + bufferSize}; // TODO pass this to m_sequencer.advance - or better, Advancer class
 
-		const Sequencer::EventBuffer& events = m_sequencer.advance(sequencer, bufferSize, kernelAudio.samplerate, actions);
+		const auto                    t0     = Profiler::now();
+		const Sequencer::Events& events = m_sequencer.advance(sequencer, bufferSize, kernelAudio.samplerate, actions);
+		if (events.dropped > 0)
+			m_profiler.recordDroppedEvents(events.dropped);
 		m_sequencer.render(out, document_RT);
 		if (!document_RT.locked)
-			advanceTracks(events, tracks, renderRange, quantizerStep);
+			advanceTracks(events, tracks, actions, sequencer, renderRange, quantizerStep);
+		m_profiler.recordSequencer(Profiler::now() - t0);
 	}
 
 	/* Then render Mixer, channels and finalize output. */
 
-	const int      maxFramesToRec = mixer.inputRecMode == InputRecMode::FREE ? sequencer.getMaxFramesInLoop(kernelAudio.samplerate) : sequencer.framesInLoop;
+	const int      maxFramesToRec = mixer.inputRecMode == InputRecMode::FREE ? RecBuffer::MAX_FRAMES : sequencer.framesInLoop;
 	const bool     hasSolos       = mixer.hasSolos;
 	const bool     hasInput       = in.isAllocd();
 	const Channel& masterOutCh    = tracks.getChannel(Mixer::MASTER_OUT_CHANNEL_ID);
@@ -137,7 +238,7 @@ void Renderer::render(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const m
 		renderMasterIn(masterInCh, mixer.getInBuffer());
 
 	if (!document_RT.locked)
-		renderTracks(tracks, out, mixer.getInBuffer(), hasSolos, sequencer.isRunning());
+		renderTracks(tracks, out, mixer.getInBuffer(), hasSolos, sequencer.isRunning(), currentFrame, sequencer.a_getCurrentFrame());
 
 	renderMasterOut(masterOutCh, out);
 	if (mixer.renderPreview)
@@ -145,85 +246,655 @@ void Renderer::render(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const m
 
 	/* Post processing. */
 
-	m_mixer.finalizeOutput(mixer, out, mixer.inToOut, kernelAudio.limitOutput, masterOutCh.volume);
+	m_mixer.finalizeOutput(mixer, out, mixer.inToOut, kernelAudio.limitOutput, masterOutCh.shared->volume.load());
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Renderer::processTriggers(const model::Tracks& tracks) const
+{
+	Trigger trigger;
+	while (m_triggerQueue.try_dequeue(trigger))
+		processTriggerOrDefer(trigger, tracks);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Renderer::processTriggerOrDefer(const Trigger& trigger, const model::Tracks& tracks) const
+{
+	/* The channel might have been deleted in the meantime. */
+
+	const Channel* ch = tracks.findChannel(trigger.channelId);
+	if (ch == nullptr)
+		return;
+
+	/* Live interaction: the track, if rendered ahead, must go back to the audio
+	thread. */
+
+	const model::Track* track = findTrackOf_(tracks, trigger.channelId);
+	if (track != nullptr)
+	{
+		RenderAheadQueue::Slot* slot = m_renderAheadQueue.find(track->getGroupChannel().id);
+		if (slot != nullptr)
+			slot->requestFlush();
+		if (isRenderedAhead_(slot))
+		{
+			if (!m_renderAheadQueue.deferTrigger(trigger))
+				m_profiler.recordDroppedEvents(1);
+			return;
+		}
+	}
+
+	processTrigger(trigger, *ch);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Renderer::processDeferredTriggers(const model::Tracks& tracks) const
+{
+	for (const Trigger& trigger : m_renderAheadQueue.takeDeferredTriggers())
+		processTriggerOrDefer(trigger, tracks);
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Renderer::advanceTracks(const Sequencer::EventBuffer& events, const model::Tracks& tracks,
-    geompp::Range<Frame> block, int quantizerStep) const
+void Renderer::processTrigger(const Trigger& trigger, const Channel& ch) const
+{
+	ChannelShared& shared = *ch.shared;
+
+	if (ch.type == ChannelType::MIDI)
+	{
+		if (trigger.type == Trigger::Type::PRESS)
+			playMidiChannel(shared.playStatus);
+		else if (trigger.type == Trigger::Type::KILL && ch.isPlaying())
+			stopMidiChannel(shared.playStatus); // All notes off already sent by the Reactor
+	}
+	else if (ch.type == ChannelType::SAMPLE)
+	{
+		const SamplePlayerMode mode = ch.sampleChannel->mode;
+
+		switch (trigger.type)
+		{
+		case Trigger::Type::PRESS:
+			if (ch.hasWave())
+				pressSampleChannel(ch.id, shared, mode, trigger.velocity, trigger.canQuantize,
+				    ch.sampleChannel->isAnyLoopMode(), ch.sampleChannel->velocityAsVol, trigger.localFrame);
+			break;
+		case Trigger::Type::RELEASE:
+			if (ch.hasWave())
+				releaseSampleChannel(shared, mode, trigger.localFrame);
+			break;
+		case Trigger::Type::KILL:
+			killSampleChannel(shared, mode, trigger.localFrame);
+			break;
+		}
+	}
+	else if (ch.type == ChannelType::PREVIEW)
+	{
+		if (trigger.type == Trigger::Type::PRESS)
+			pressSampleChannel(ch.id, shared, SamplePlayerMode::SINGLE_BASIC_PAUSE,
+			    /*velocity=*/0.0f, /*canQuantize=*/false, /*isAnyLoopMode=*/false,
+			    /*velocityAsVol=*/false, /*localFrame=*/0);
+		else if (trigger.type == Trigger::Type::RELEASE)
+			releaseSampleChannel(shared, SamplePlayerMode::SINGLE_BASIC_PAUSE, /*localFrame=*/0);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Renderer::advanceTracks(const Sequencer::Events& events, const model::Tracks& tracks,
+    const model::Actions& actions, const model::Sequencer& sequencer, geompp::Range<Frame> block,
+    int quantizerStep) const
 {
 	for (const model::Track& track : tracks.getAll())
+	{
+		if (track.isFrozen()) // Channels of a frozen track are not rendered
+			continue;
+		if (isRenderedAhead_(m_renderAheadQueue.find(track.getGroupChannel().id))) // Advanced by the worker
+			continue;
 		for (const Channel& c : track.getChannels().getAll())
-			if (!c.isInternal())
-				advanceChannel(c, events, block, quantizerStep);
+		{
+			if (c.isInternal())
+				continue;
+			advanceChannel(c, events, block, quantizerStep, &m_kernelMidi);
+			advanceVolumeEnvelope_(c, actions, sequencer, block);
+		}
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Renderer::prepareRenderAhead(const model::Tracks& tracks, Frame currentFrame, bool seqIsRunning) const
+{
+	using State = RenderAheadQueue::State;
+
+	for (RenderAheadQueue::Slot& slot : m_renderAheadQueue.getSlots())
+	{
+		const State state = slot.getState();
+		if (state == State::FREE)
+			continue;
+
+		if (findTrack_(tracks, slot.getTrackId()) == nullptr) // Track deleted
+		{
+			slot.unbind();
+			continue;
+		}
+
+		if (state == State::IDLE)
+			slot.tick();
+		if (state != State::AHEAD && state != State::BUSY)
+			continue;
+
+		/* Keep on reading from the FIFO only if it holds the block for the
+		current frame and nothing happened in the meantime. The worker might be
+		rendering right now: if so, try again on the next block. */
+
+		const RenderAheadQueue::Block* front = slot.front();
+		const bool inSync = front != nullptr && front->frame == currentFrame;
+
+		if (seqIsRunning && inSync && !slot.isFlushRequested() && !m_renderAheadQueue.isSuspended())
+			continue;
+		if (slot.reclaim())
+			reclaimTrack(slot, tracks);
+		else
+			slot.requestFlush();
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Renderer::reclaimTrack(RenderAheadQueue::Slot& slot, const model::Tracks& tracks) const
+{
+	/* Channels have been advanced past the blocks still in the FIFO, which
+	will never be played: rewind them. An empty FIFO means the channels are
+	already where the worker stopped. */
+
+	if (const RenderAheadQueue::Block* front = slot.front(); front != nullptr)
+	{
+		for (std::size_t i = 0; i < front->numChannels; i++)
+		{
+			const RenderAheadQueue::ChannelState& state = front->channels[i];
+			const Channel*                        ch    = tracks.findChannel(state.channelId);
+			if (ch == nullptr)
+				continue;
+			ch->shared->resetRenderState();
+			ch->shared->tracker.store(state.tracker);
+			ch->shared->playStatus.store(state.playStatus);
+			ch->shared->lastGainL    = state.lastGainL;
+			ch->shared->lastGainR    = state.lastGainR;
+			ch->shared->envelopeGain = state.envelopeGain;
+			if (ch->shared->quantizer)
+				ch->shared->quantizer->setTriggered(state.quantizerId);
+		}
+	}
+	slot.clear();
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Renderer::advanceChannel(const Channel& ch, const Sequencer::EventBuffer& events,
-    geompp::Range<Frame> block, Frame quantizerStep) const
+void Renderer::advanceChannel(const Channel& ch, const Sequencer::Events& events,
+    geompp::Range<Frame> block, Frame quantizerStep, KernelMidi* midiOut) const
 {
 	if (ch.shared->quantizer)
 		ch.shared->quantizer->advance(block, quantizerStep);
 
-	for (const Sequencer::Event& e : events)
+	/* Leftovers from a block whose plug-ins haven't been rendered (e.g. frozen
+	tracks) must not pile up. */
+
+	ch.shared->paramChanges.clear();
+
+	/* Merge timeline events with the channel's actions. Timeline events come
+	first on the same frame. REWIND is pushed by the quantizer once the whole
+	block has been parsed, so all actions precede it. */
+
+	Sequencer::ChannelActions actions = events.getActions(ch.id);
+
+	for (const Sequencer::Event& e : events.timeline)
+	{
+		for (; !actions.done() && (actions.get().delta < e.delta || e.type == Sequencer::EventType::REWIND); actions.next())
+			advanceChannel(ch, actions.get(), midiOut);
+		advanceChannel(ch, e, midiOut);
+	}
+	for (; !actions.done(); actions.next())
+		advanceChannel(ch, actions.get(), midiOut);
+}
+
+void Renderer::advanceChannel(const Channel& ch, const Sequencer::Event& e, KernelMidi* midiOut) const
+{
+	if (e.type == Sequencer::EventType::ACTIONS)
+		rendering::queuePluginParamChanges(ch, e.actions, e.delta);
+
+	if (ch.type == ChannelType::MIDI)
+		rendering::advanceMidiChannel(ch, e, midiOut);
+	else if (ch.type == ChannelType::SAMPLE)
+		rendering::advanceSampleChannel(ch, e);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Renderer::renderTracks(const model::Tracks& tracks, mcl::AudioBuffer& out, const mcl::AudioBuffer& in,
+    bool hasSolos, bool seqIsRunning, Frame currentFrame, Frame nextFrame) const
+{
+	const std::vector<model::Track>& all = tracks.getAll();
+
+	/* Plug-in delay compensation. Latencies are read on each block, so that
+	plug-ins being added, removed, bypassed or changing their own latency are
+	picked up right away: delay lines crossfade to the new values. Each channel
+	is delayed to match the slowest channel in its track, then each track to
+	match the slowest track. */
+
+	Frame maxLatency = 0;
+	for (const model::Track& track : all)
+		if (!track.isInternal())
+			maxLatency = std::max(maxLatency, getTrackLatency(track));
+
+	const Frame masterOutLatency = m_pluginHost.getLatency(tracks.getChannel(Mixer::MASTER_OUT_CHANNEL_ID).plugins);
+	m_pluginHost.setOutputLatency(maxLatency + masterOutLatency);
+
+	/* Return buses collect the sends of all other tracks: empty them first, then
+	render them last. */
+
+	for (const model::Track& track : all)
+		if (!track.isInternal())
+			track.getGroupChannel().shared->returnBuffer.clear();
+
+	for (const bool returns : {false, true})
 	{
-		if (ch.type == ChannelType::MIDI)
-			rendering::advanceMidiChannel(ch, e, m_kernelMidi);
-		else if (ch.type == ChannelType::SAMPLE)
-			rendering::advanceSampleChannel(ch, e);
+		for (std::size_t trackIndex = 0; trackIndex < all.size(); trackIndex++)
+		{
+			const model::Track& track = all[trackIndex];
+			if (track.isInternal() || track.isReturn() != returns)
+				continue;
+
+			const auto              t0      = Profiler::now();
+			const Channel&          group   = track.getGroupChannel();
+			RenderAheadQueue::Slot* slot    = m_renderAheadQueue.find(group.id);
+			const bool              live    = !track.isFrozen() && !isRenderedAhead_(slot);
+			const mcl::AudioBuffer* sendsIn = returns ? &group.shared->returnBuffer : nullptr;
+
+			if (track.isFrozen())
+				renderFrozenTrack(track, currentFrame, seqIsRunning);
+			else if (!live)
+				renderAheadTrack(track, *slot, currentFrame);
+			else
+				renderTrack(track, group.shared->audioBuffer, in, hasSolos, seqIsRunning, m_pluginHost, sendsIn);
+
+			/* The worker asked for this track: hand it over, starting from the next
+			block, if nothing prevents it. */
+
+			if (slot != nullptr && slot->getState() == RenderAheadQueue::State::REQUESTED)
+			{
+				if (seqIsRunning && !slot->isFlushRequested() && !m_renderAheadQueue.isSuspended())
+					slot->accept(nextFrame);
+				else
+					slot->reject();
+			}
+
+			group.shared->delayLine.process(group.shared->audioBuffer, maxLatency - getTrackLatency(track));
+
+			/* Channels' own buffers are valid only if the track has just been
+			rendered here: frozen tracks and tracks rendered ahead send from their
+			Group Channel only. */
+
+			if (!returns)
+				renderSends(track, tracks, hasSolos, /*groupOnly=*/!live);
+
+			if (group.isAudible(hasSolos))
+				sumRamped(out, group.shared->audioBuffer, *group.shared, group.shared->volume.load(), group.shared->pan.load());
+
+			m_profiler.recordTrack(trackIndex, Profiler::now() - t0);
+		}
 	}
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Renderer::renderTracks(const model::Tracks& tracks, mcl::AudioBuffer& out,
-    const mcl::AudioBuffer& in, bool hasSolos, bool seqIsRunning) const
+void Renderer::renderTrack(const model::Track& track, mcl::AudioBuffer& out, const mcl::AudioBuffer& in,
+    bool hasSolos, bool seqIsRunning, PluginHost& pluginHost, const mcl::AudioBuffer* sendsIn) const
 {
+	const Channel& group           = track.getGroupChannel();
+	const Frame    channelsLatency = getChannelsLatency(track);
+
+	out.clear();
+
+	for (const Channel& c : track.getMemberChannels())
+	{
+		const Frame delay = channelsLatency - pluginHost.getLatency(c.plugins);
+		renderNormalChannel(c, out, in, hasSolos, seqIsRunning, delay, pluginHost);
+	}
+
+	if (sendsIn != nullptr)
+		out.sum(*sendsIn, /*gain=*/1.0f);
+
+	rendering::renderGroupPlugins(group, out, pluginHost);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Renderer::renderSends(const model::Track& track, const model::Tracks& tracks, bool hasSolos,
+    bool groupOnly) const
+{
+	for (const Channel& c : track.getChannels().getAll())
+	{
+		if (c.sends.empty() || (groupOnly && c.type != ChannelType::GROUP) || !c.isAudible(hasSolos))
+			continue;
+
+		/* Sends are post-fader: the volume envelope applies too. */
+
+		const float                 volume = c.shared->volume.load() * c.shared->volumeInternal.load() * c.shared->envelopeGain;
+		const mcl::AudioBuffer::Pan pan    = calcPanning(c.shared->pan.load());
+
+		for (const Send& send : c.sends)
+		{
+			/* The return bus might have been deleted in the meantime. */
+
+			const Channel* ret = tracks.findChannel(send.returnId);
+			if (ret == nullptr || ret->type != ChannelType::GROUP)
+				continue;
+			ret->shared->returnBuffer.sum(c.shared->audioBuffer, volume * send.level, pan);
+		}
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Renderer::renderAheadTrack(const model::Track& track, RenderAheadQueue::Slot& slot, Frame currentFrame) const
+{
+	mcl::AudioBuffer&              out   = track.getGroupChannel().shared->audioBuffer;
+	const RenderAheadQueue::Block* block = slot.front();
+
+	if (block == nullptr || block->frame != currentFrame)
+	{
+		out.clear();
+		m_profiler.recordRenderAheadUnderrun();
+		return;
+	}
+
+	out.set(block->audio, /*gain=*/1.0f);
+	slot.pop();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Renderer::renderFrozenTrack(const model::Track& track, Frame currentFrame, bool seqIsRunning) const
+{
+	assert(track.isFrozen());
+
+	mcl::AudioBuffer&       out  = track.getGroupChannel().shared->audioBuffer;
+	const mcl::AudioBuffer& wave = track.frozenWave->getBuffer();
+
+	out.clear();
+
+	if (!seqIsRunning || wave.countFrames() == 0)
+		return;
+
+	/* The frozen Wave is one loop long: wrap around it, should the loop have
+	been changed in the meantime. */
+
+	const int channels = std::min(out.countChannels(), wave.countChannels());
+	for (int i = 0; i < out.countFrames(); i++)
+	{
+		const Frame frame = (currentFrame + i) % wave.countFrames();
+		for (int j = 0; j < channels; j++)
+			out[i][j] = wave[frame][j];
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Renderer::renderTrackOffline(mcl::AudioBuffer& out, const model::Document& document,
+    std::size_t trackIndex, Frame start) const
+{
+	const model::Sequencer&    sequencer  = document.sequencer;
+	const model::Track&        track      = document.tracks.getAll()[trackIndex];
+	const int                  bufferSize = out.countFrames();
+	const geompp::Range<Frame> range      = {start, start + bufferSize};
+
+	/* Peek instead of advancing: the sequencer's current frame, the quantizer
+	and the metronome must not move while freezing. The render-ahead worker is
+	suspended, so m_peekEvents is free to use. */
+
+	const Sequencer::Events& events = m_sequencer.peek(sequencer, start, bufferSize, document.actions);
+	for (const Channel& c : track.getMemberChannels())
+	{
+		advanceChannel(c, events, range, m_sequencer.getQuantizerStep(), /*midiOut=*/nullptr);
+		advanceVolumeEnvelope_(c, document.actions, sequencer, range);
+	}
+
+	/* No live input while freezing: channels armed for recording get silence. */
+
+	mcl::AudioBuffer in(bufferSize, out.countChannels());
+	in.clear();
+
+	renderTrack(track, out, in, /*hasSolos=*/false, /*seqIsRunning=*/true, m_pluginHost, /*sendsIn=*/nullptr);
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Renderer::renderAhead(const model::Model& model) const
+{
+	using State = RenderAheadQueue::State;
+
+	if (m_renderAheadQueue.isSuspended())
+		return false;
+
+	/* The worker reads the realtime Document like the audio thread does, so
+	that shared data can't be altered while rendering. */
+
+	const model::DocumentLock documentLock = model.get_RT();
+	const model::Document&    document     = documentLock.get();
+	const model::Tracks&      tracks       = document.tracks;
+
+	if (document.locked || !document.mixer.a_isActive())
+		return false;
+
+	/* Bind new tracks to free slots first. */
+
 	for (const model::Track& track : tracks.getAll())
 	{
-		if (track.isInternal())
+		const ID groupId = track.getGroupChannel().id;
+		if (!canRenderAhead(track, document) || m_renderAheadQueue.find(groupId) != nullptr)
 			continue;
+		for (RenderAheadQueue::Slot& slot : m_renderAheadQueue.getSlots())
+			if (slot.bind(groupId))
+				break;
+	}
 
-		const Channel& group = track.getGroupChannel();
-		group.shared->audioBuffer.clear();
+	bool rendered = false;
+	for (RenderAheadQueue::Slot& slot : m_renderAheadQueue.getSlots())
+	{
+		if (m_renderAheadQueue.isSuspended())
+			break;
 
-		for (const Channel& c : track.getChannels().getAll())
-			renderNormalChannel(c, group.shared->audioBuffer, in, hasSolos, seqIsRunning);
+		const State         state = slot.getState();
+		const model::Track* track = state != State::FREE ? findTrack_(tracks, slot.getTrackId()) : nullptr;
+		if (track == nullptr) // Free slot, or track deleted: the audio thread will unbind it
+			continue;
+
+		const bool canRender = canRenderAhead(*track, document);
+
+		if (state == State::IDLE && canRender)
+			slot.request();
+		if (!slot.acquire())
+			continue;
+
+		if (!canRender || hasPendingMidi_(*track))
+			slot.requestFlush();
+		else if (!slot.isFlushRequested())
+		{
+			rendered = renderTrackAhead(*track, slot, document) || rendered;
+
+			/* MIDI input might have shown up while rendering: it must be played
+			live. */
+
+			if (hasPendingMidi_(*track))
+				slot.requestFlush();
+		}
+
+		slot.release();
+	}
+	return rendered;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Renderer::renderTrackAhead(const model::Track& track, RenderAheadQueue::Slot& slot,
+    const model::Document& document) const
+{
+	RenderAheadQueue::Block* block = slot.getWriteBlock();
+	if (block == nullptr) // FIFO full
+		return false;
+
+	const model::Sequencer&    sequencer  = document.sequencer;
+	const Frame                start      = slot.getNextFrame();
+	const int                  bufferSize = block->audio.countFrames();
+	const geompp::Range<Frame> range      = {start, start + bufferSize};
+
+	/* Save channels' state first: the audio thread puts it back if this block
+	will never be played. */
+
+	block->frame       = start;
+	block->numChannels = 0;
+	for (const Channel& c : track.getChannels().getAll())
+	{
+		const ChannelShared& shared      = *c.shared;
+		const int            quantizerId = shared.quantizer ? shared.quantizer->getTriggered() : -1;
+
+		block->channels[block->numChannels++] = {c.id, shared.tracker.load(), shared.playStatus.load(),
+		    quantizerId, shared.lastGainL, shared.lastGainR, shared.envelopeGain};
+	}
+
+	const Sequencer::Events& events = m_sequencer.peek(sequencer, start, bufferSize, document.actions);
+	for (const Channel& c : track.getMemberChannels())
+	{
+		advanceChannel(c, events, range, m_sequencer.getQuantizerStep(), &m_kernelMidi);
+		advanceVolumeEnvelope_(c, document.actions, sequencer, range);
+	}
+
+	/* Tracks rendered ahead never read the input (see canRenderAhead()): the
+	mixer's input buffer is passed only to fill the gap. */
+
+	renderTrack(track, block->audio, document.mixer.getInBuffer(), document.mixer.hasSolos,
+	    /*seqIsRunning=*/true, m_aheadPluginHost, /*sendsIn=*/nullptr);
+
+	slot.setNextFrame((start + bufferSize) % sequencer.framesInLoop);
+	slot.push();
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Renderer::canRenderAhead(const model::Track& track, const model::Document& document) const
+{
+	if (!document.sequencer.isRunning() || track.isInternal() || track.isFrozen())
+		return false;
+
+	/* Return buses depend on other tracks. */
 
-		rendering::renderAudioPlugins(group, m_pluginHost);
+	if (track.isReturn())
+		return false;
 
-		if (group.isAudible(hasSolos))
-			out.sum(group.shared->audioBuffer, group.volume, calcPanning_(group.pan));
+	const std::vector<Channel>& channels = track.getChannels().getAll();
+	if (channels.size() > RenderAheadQueue::MAX_CHANNELS)
+		return false;
+
+	/* Rendering ahead pays off only with some plug-ins to process. */
+
+	bool hasPlugins = false;
+	for (const Channel& c : channels)
+	{
+		if (c.armed || c.canSendMidi())
+			return false;
+		if (c.type != ChannelType::GROUP && !c.sends.empty()) // Sends are summed by the audio thread
+			return false;
+		hasPlugins = hasPlugins || !c.plugins.empty();
+	}
+	return hasPlugins;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Renderer::suspendRenderAhead(const model::Tracks& tracks) const
+{
+	using State = RenderAheadQueue::State;
+
+	m_renderAheadQueue.setSuspended(true);
+
+	/* The worker might still be in the middle of a block: wait for it. */
+
+	for (RenderAheadQueue::Slot& slot : m_renderAheadQueue.getSlots())
+	{
+		while (true)
+		{
+			const State state = slot.getState();
+			if (state == State::BUSY)
+				std::this_thread::yield();
+			else if (state == State::REQUESTED)
+				slot.reject();
+			else if (state != State::AHEAD)
+				break;
+			else if (slot.reclaim())
+				reclaimTrack(slot, tracks);
+		}
 	}
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Renderer::renderNormalChannel(const Channel& ch, mcl::AudioBuffer& out,
-    const mcl::AudioBuffer& in, bool mixerHasSolos, bool seqIsRunning) const
+void Renderer::resumeRenderAhead() const
+{
+	m_renderAheadQueue.setSuspended(false);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Renderer::renderNormalChannel(const Channel& ch, mcl::AudioBuffer& out, const mcl::AudioBuffer& in,
+    bool mixerHasSolos, bool seqIsRunning, Frame delay, PluginHost& pluginHost) const
 {
 	ch.shared->audioBuffer.clear();
 
 	if (ch.type == ChannelType::SAMPLE)
 	{
-		renderSampleChannel(ch, in, seqIsRunning);
+		renderSampleChannel(ch, in, seqIsRunning, pluginHost);
 	}
 	else if (ch.type == ChannelType::MIDI)
 	{
-		renderMidiChannel(ch);
+		renderMidiChannel(ch, pluginHost);
 	}
 
+	ch.shared->delayLine.process(ch.shared->audioBuffer, delay);
+
 	if (ch.isAudible(mixerHasSolos))
-		out.sum(ch.shared->audioBuffer, ch.volume * ch.shared->volumeInternal.load(), calcPanning_(ch.pan));
+	{
+		const float volume = ch.shared->volume.load() * ch.shared->volumeInternal.load() * ch.shared->envelopeGain;
+		sumRamped(out, ch.shared->audioBuffer, *ch.shared, volume, ch.shared->pan.load());
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+Frame Renderer::getChannelsLatency(const model::Track& track) const
+{
+	Frame latency = 0;
+	for (const Channel& c : track.getMemberChannels())
+		latency = std::max(latency, m_pluginHost.getLatency(c.plugins));
+	return latency;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Frame Renderer::getTrackLatency(const model::Track& track) const
+{
+	if (track.isFrozen()) // Latency already removed from the frozen Wave
+		return 0;
+	return getChannelsLatency(track) + m_pluginHost.getLatency(track.getGroupChannel().plugins);
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Renderer::renderMasterIn(const Channel& ch, mcl::AudioBuffer& in) const
 {
-	m_pluginHost.processStack(in, ch.plugins, nullptr);
+	m_pluginHost.processStack(in, ch.plugins);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -231,8 +902,9 @@ void Renderer::renderMasterIn(const Channel& ch, mcl::AudioBuffer& in) const
 void Renderer::renderMasterOut(const Channel& ch, mcl::AudioBuffer& out) const
 {
 	ch.shared->audioBuffer.set(out, /*gain=*/1.0f);
-	m_pluginHost.processStack(ch.shared->audioBuffer, ch.plugins, nullptr);
-	out.set(ch.shared->audioBuffer, ch.volume);
+	m_pluginHost.processStack(ch.shared->audioBuffer, ch.plugins);
+	out.clear();
+	sumRamped(out, ch.shared->audioBuffer, *ch.shared, ch.shared->volume.load(), G_DEFAULT_PAN);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -244,12 +916,13 @@ void Renderer::renderPreview(const Channel& ch, mcl::AudioBuffer& out) const
 	if (ch.isPlaying())
 		rendering::renderSampleChannel(ch, /*seqIsRunning=*/false); // Sequencer status is irrelevant here
 
-	out.sum(ch.shared->audioBuffer, ch.volume, calcPanning_(ch.pan));
+	sumRamped(out, ch.shared->audioBuffer, *ch.shared, ch.shared->volume.load(), ch.shared->pan.load());
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Renderer::renderSampleChannel(const Channel& ch, const mcl::AudioBuffer& in, bool seqIsRunning) const
+void Renderer::renderSampleChannel(const Channel& ch, const mcl::AudioBuffer& in, bool seqIsRunning,
+    PluginHost& pluginHost) const
 {
 	assert(ch.type == ChannelType::SAMPLE);
 
@@ -259,15 +932,15 @@ void Renderer::renderSampleChannel(const Channel& ch, const mcl::AudioBuffer& in
 	if (ch.canReceiveAudio())
 		rendering::renderSampleChannelInput(ch, in); // record "clean" audio first	(i.e. not plugin-processed)
 
-	rendering::renderAudioPlugins(ch, m_pluginHost);
+	rendering::renderAudioPlugins(ch, pluginHost);
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Renderer::renderMidiChannel(const Channel& ch) const
+void Renderer::renderMidiChannel(const Channel& ch, PluginHost& pluginHost) const
 {
 	assert(ch.type == ChannelType::MIDI);
 
-	rendering::renderAudioAndMidiPlugins(ch, m_pluginHost);
+	rendering::renderAudioAndMidiPlugins(ch, pluginHost);
 }
 } // namespace giada::m::rendering
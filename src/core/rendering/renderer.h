@@ -27,6 +27,8 @@
 #ifndef G_RENDERER_H
 #define G_RENDERER_H
 
+#include "core/rendering/renderAheadQueue.h"
+#include "core/rendering/trigger.h"
 #include "core/sequencer.h"
 #include <vector>
 
@@ -43,6 +45,7 @@ class Mixer;
 class Channel;
 class PluginHost;
 class KernelMidi;
+class Profiler;
 #ifdef WITH_AUDIO_JACK
 class JackSynchronizer;
 class JackTransport;
@@ -52,8 +55,12 @@ class JackTransport;
 namespace giada::m::model
 {
 class Model;
+class Document;
 class Channels;
+class Track;
 class Tracks;
+class Actions;
+class Sequencer;
 } // namespace giada::m::model
 
 namespace giada::m::rendering
@@ -62,37 +69,163 @@ class Renderer
 {
 public:
 #ifdef WITH_AUDIO_JACK
-	Renderer(Sequencer&, Mixer&, PluginHost&, JackSynchronizer&, JackTransport&, KernelMidi&);
+	Renderer(Sequencer&, Mixer&, PluginHost&, JackSynchronizer&, JackTransport&, KernelMidi&, TriggerQueue&,
+	    RenderAheadQueue&, PluginHost& aheadPluginHost, Profiler&);
 #else
-	Renderer(Sequencer&, Mixer&, PluginHost&, KernelMidi&);
+	Renderer(Sequencer&, Mixer&, PluginHost&, KernelMidi&, TriggerQueue&, RenderAheadQueue&,
+	    PluginHost& aheadPluginHost, Profiler&);
 #endif
 
 	void render(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const model::Model&) const;
 
+	/* renderAhead
+	Worker thread. Renders one block ahead for each track handed over by the
+	audio thread, if its FIFO is not full yet, and asks for new tracks that can
+	be rendered ahead. Returns true if at least one block has been rendered. */
+
+	bool renderAhead(const model::Model&) const;
+
+	/* suspendRenderAhead, resumeRenderAhead
+	Takes all tracks back from the render-ahead worker, and prevents it from
+	getting new ones until resumed. Call suspendRenderAhead() only when the
+	audio thread is stopped or the mixer is disabled. */
+
+	void suspendRenderAhead(const model::Tracks&) const;
+	void resumeRenderAhead() const;
+
+	/* renderTrackOffline
+	Renders one block of a single track into 'out', starting from frame 'start',
+	as if the sequencer were running: advances the track's channels, then
+	processes channels and plug-ins. The sequencer itself is left untouched and
+	no MIDI is sent out. The output is not delay-compensated against other
+	tracks. Used to freeze a track: the audio stream and the render-ahead worker
+	must be stopped. */
+
+	void renderTrackOffline(mcl::AudioBuffer& out, const model::Document&, std::size_t trackIndex,
+	    Frame start) const;
+
+	/* getTrackLatency
+	Returns the plug-in latency of a track, i.e. its slowest channel plus its
+	Group Channel. */
+
+	Frame getTrackLatency(const model::Track&) const;
+
 private:
+	/* processTriggers
+	Consumes all manual triggers pushed by the Reactor since the last audio
+	block and applies them to the channels' shared state. */
+
+	void processTriggers(const model::Tracks&) const;
+	void processTrigger(const Trigger&, const Channel&) const;
+
+	/* processTriggerOrDefer
+	Processes a trigger, unless its channel belongs to a track still rendered
+	ahead: the track is flushed and the trigger is deferred to a later block. */
+
+	void processTriggerOrDefer(const Trigger&, const model::Tracks&) const;
+	void processDeferredTriggers(const model::Tracks&) const;
+
+	/* prepareRenderAhead
+	Takes back the tracks rendered ahead that must be flushed or whose FIFO is
+	out of sync with the sequencer, and frees slots of deleted tracks. */
+
+	void prepareRenderAhead(const model::Tracks&, Frame currentFrame, bool seqIsRunning) const;
+
+	/* reclaimTrack
+	Brings the channels of a track taken back from the render-ahead worker to
+	the state they had before rendering the oldest block still in the FIFO,
+	then empties the FIFO. */
+
+	void reclaimTrack(RenderAheadQueue::Slot&, const model::Tracks&) const;
+
+	/* canRenderAhead
+	Tells whether a track can be rendered ahead, i.e. its output depends only
+	on the sequencer: no input recording or monitoring, no MIDI output, no
+	return bus, no sends from channels other than the Group Channel. */
+
+	bool canRenderAhead(const model::Track&, const model::Document&) const;
+
+	/* renderTrackAhead
+	Worker thread. Renders the next block of a track into the slot's FIFO. */
+
+	bool renderTrackAhead(const model::Track&, RenderAheadQueue::Slot&, const model::Document&) const;
+
 	/* advanceTracks
 	Processes Channels' static events (e.g. pre-recorded actions or sequencer
 	events) in the current audio block. Called when the sequencer is running. */
 
-	void advanceTracks(const Sequencer::EventBuffer&, const model::Tracks&,
-	    geompp::Range<Frame>, int quantizerStep) const;
+	void advanceTracks(const Sequencer::Events&, const model::Tracks&, const model::Actions&,
+	    const model::Sequencer&, geompp::Range<Frame>, int quantizerStep) const;
+
+	/* advanceChannel
+	Feeds the channel with the timeline events and its own ACTIONS events,
+	merged in frame order. MIDI out is skipped if 'midiOut' is nullptr. */
+
+	void advanceChannel(const Channel&, const Sequencer::Events&, geompp::Range<Frame>, Frame quantizerStep,
+	    KernelMidi* midiOut) const;
+	void advanceChannel(const Channel&, const Sequencer::Event&, KernelMidi* midiOut) const;
+
+	void renderTracks(const model::Tracks&, mcl::AudioBuffer& out, const mcl::AudioBuffer& in,
+	    bool hasSolos, bool seqIsRunning, Frame currentFrame, Frame nextFrame) const;
+
+	/* renderTrack
+	Renders the channels of a track into 'out', lined up with the slowest
+	channel, then processes the Group Channel's plug-ins. If the track is a
+	return bus, 'sendsIn' holds the sends to be mixed in before the plug-ins. */
+
+	void renderTrack(const model::Track&, mcl::AudioBuffer& out, const mcl::AudioBuffer& in,
+	    bool hasSolos, bool seqIsRunning, PluginHost&, const mcl::AudioBuffer* sendsIn) const;
+
+	/* renderSends
+	Sums the post-fader output of the track's channels into the return buses
+	they send to. If 'groupOnly', only the Group Channel's sends are processed. */
 
-	void advanceChannel(const Channel&, const Sequencer::EventBuffer&, geompp::Range<Frame>, Frame quantizerStep) const;
+	void renderSends(const model::Track&, const model::Tracks&, bool hasSolos, bool groupOnly) const;
 
-	void renderTracks(const model::Tracks&, mcl::AudioBuffer& out,
-	    const mcl::AudioBuffer& in, bool hasSolos, bool seqIsRunning) const;
-	void renderNormalChannel(const Channel& ch, mcl::AudioBuffer& out,
-	    const mcl::AudioBuffer& in, bool mixerHasSolos, bool seqIsRunning) const;
+	/* renderAheadTrack
+	Copies the block rendered ahead for 'currentFrame' into the Group Channel's
+	buffer. Silence if not ready in time. */
+
+	void renderAheadTrack(const model::Track&, RenderAheadQueue::Slot&, Frame currentFrame) const;
+
+	/* renderFrozenTrack
+	Copies the frozen Wave of a track into its Group Channel's buffer, in sync
+	with the sequencer position 'currentFrame'. Silence if the sequencer is
+	stopped. */
+
+	void renderFrozenTrack(const model::Track&, Frame currentFrame, bool seqIsRunning) const;
+
+	/* renderNormalChannel
+	Renders the channel and sums it into 'out', after delaying it by 'delay'
+	frames for plug-in delay compensation. */
+
+	void renderNormalChannel(const Channel& ch, mcl::AudioBuffer& out, const mcl::AudioBuffer& in,
+	    bool mixerHasSolos, bool seqIsRunning, Frame delay, PluginHost&) const;
 	void renderMasterIn(const Channel&, mcl::AudioBuffer& in) const;
 	void renderMasterOut(const Channel&, mcl::AudioBuffer& out) const;
 	void renderPreview(const Channel&, mcl::AudioBuffer& out) const;
-	void renderSampleChannel(const Channel&, const mcl::AudioBuffer& in, bool seqIsRunning) const;
-	void renderMidiChannel(const Channel&) const;
+	void renderSampleChannel(const Channel&, const mcl::AudioBuffer& in, bool seqIsRunning, PluginHost&) const;
+	void renderMidiChannel(const Channel&, PluginHost&) const;
+
+	/* getChannelsLatency
+	Returns the plug-in latency of the slowest channel in the track, Group
+	Channel excluded. */
+
+	Frame getChannelsLatency(const model::Track&) const;
 
 	Sequencer&  m_sequencer;
 	Mixer&      m_mixer;
 	PluginHost& m_pluginHost;
 	KernelMidi& m_kernelMidi;
+	TriggerQueue& m_triggerQueue;
+	RenderAheadQueue& m_renderAheadQueue;
+	Profiler&     m_profiler;
+
+	/* m_aheadPluginHost
+	Plug-in host used by the render-ahead worker thread: PluginHost is not meant
+	to be shared across threads. */
+
+	PluginHost& m_aheadPluginHost;
 #ifdef WITH_AUDIO_JACK
 	JackSynchronizer& m_jackSynchronizer;
 	JackTransport&    m_jackTransport;
@@ -114,18 +114,15 @@ void onNoteOn_(ChannelShared& shared, Frame localFrame, SamplePlayerMode mode, f
 
 /* -------------------------------------------------------------------------- */
 
-void parseActions_(ID channelId, ChannelShared& shared, const std::vector<Action>& as,
+void parseActions_(ChannelShared& shared, std::span<const Action* const> as,
     Frame localFrame, SamplePlayerMode mode)
 {
-	for (const Action& a : as)
+	for (const Action* a : as)
 	{
-		if (a.channelId != channelId)
-			continue;
-
-		switch (a.event.getStatus())
+		switch (a->event.getStatus())
 		{
 		case MidiEvent::CHANNEL_NOTE_ON:
-			onNoteOn_(shared, localFrame, mode, a.event.getVelocityFloat());
+			onNoteOn_(shared, localFrame, mode, a->event.getVelocityFloat());
 			break;
 
 		case MidiEvent::CHANNEL_NOTE_OFF:
@@ -167,7 +164,7 @@ void advanceSampleChannel(const Channel& ch, const Sequencer::Event& e)
 
 	case Sequencer::EventType::ACTIONS:
 		if (!isLoop && ch.shared->isReadingActions())
-			parseActions_(ch.id, *ch.shared, *e.actions, e.delta, mode);
+			parseActions_(*ch.shared, e.actions, e.delta, mode);
 		break;
 
 	default:
@@ -80,7 +80,7 @@ void stopReadActions_(ChannelShared& shared, ChannelStatus curRecStatus,
 /* -------------------------------------------------------------------------- */
 
 ChannelStatus pressWhileOff_(ID channelId, ChannelShared& shared, float velocity,
-    bool canQuantize, bool velocityAsVol)
+    bool canQuantize, bool velocityAsVol, Frame localFrame)
 {
 	/* Reset internal volume to default (1.0) if no velocity as volume. This is
 	important in case the channel has actions and some of them have velocity
@@ -94,14 +94,20 @@ ChannelStatus pressWhileOff_(ID channelId, ChannelShared& shared, float velocity
 		shared.quantizer->trigger(Q_ACTION_PLAY + channelId);
 		return ChannelStatus::OFF;
 	}
-	else
-		return ChannelStatus::PLAY;
+
+	/* Start rendering at 'localFrame' in the next block. Not needed when
+	starting right at the beginning of it: a channel in PLAY status is rendered
+	from frame 0 by default. */
+
+	if (localFrame > 0)
+		shared.renderQueue->enqueue({RenderInfo::Mode::NORMAL, localFrame});
+	return ChannelStatus::PLAY;
 }
 
 /* -------------------------------------------------------------------------- */
 
 ChannelStatus pressWhilePlay_(ID channelId, ChannelShared& shared, SamplePlayerMode mode,
-    bool canQuantize)
+    bool canQuantize, Frame localFrame)
 {
 	switch (mode)
 	{
@@ -109,14 +115,14 @@ ChannelStatus pressWhilePlay_(ID channelId, ChannelShared& shared, SamplePlayerM
 		if (canQuantize)
 			shared.quantizer->trigger(Q_ACTION_REWIND + channelId);
 		else
-			rewindSampleChannel(shared, /*localFrame=*/0);
+			rewindSampleChannel(shared, localFrame);
 		return ChannelStatus::PLAY;
 
 	case SamplePlayerMode::SINGLE_ENDLESS:
 		return ChannelStatus::ENDING;
 
 	case SamplePlayerMode::SINGLE_BASIC:
-		stopSampleChannel(shared, 0);
+		stopSampleChannel(shared, localFrame);
 		return ChannelStatus::PLAY; // Let SamplePlayer stop it once done
 
 	default:
@@ -218,7 +224,7 @@ void stopSampleChannel(ChannelShared& shared, Frame localFrame)
 
 /* -------------------------------------------------------------------------- */
 
-void pressSampleChannel(ID channelId, ChannelShared& shared, SamplePlayerMode mode, float velocity, bool canQuantize, bool isLoop, bool velocityAsVol)
+void pressSampleChannel(ID channelId, ChannelShared& shared, SamplePlayerMode mode, float velocity, bool canQuantize, bool isLoop, bool velocityAsVol, Frame localFrame)
 {
 	ChannelStatus playStatus = shared.playStatus.load();
 
@@ -228,14 +234,14 @@ void pressSampleChannel(ID channelId, ChannelShared& shared, SamplePlayerMode mo
 		if (isLoop)
 			playStatus = ChannelStatus::WAIT;
 		else
-			playStatus = pressWhileOff_(channelId, shared, velocity, canQuantize, velocityAsVol);
+			playStatus = pressWhileOff_(channelId, shared, velocity, canQuantize, velocityAsVol, localFrame);
 		break;
 
 	case ChannelStatus::PLAY:
 		if (isLoop)
 			playStatus = ChannelStatus::ENDING;
 		else
-			playStatus = pressWhilePlay_(channelId, shared, mode, canQuantize);
+			playStatus = pressWhilePlay_(channelId, shared, mode, canQuantize, localFrame);
 		break;
 
 	case ChannelStatus::WAIT:
@@ -255,7 +261,7 @@ void pressSampleChannel(ID channelId, ChannelShared& shared, SamplePlayerMode mo
 
 /* -------------------------------------------------------------------------- */
 
-void releaseSampleChannel(ChannelShared& shared, SamplePlayerMode mode)
+void releaseSampleChannel(ChannelShared& shared, SamplePlayerMode mode, Frame localFrame)
 {
 	/* Key release is meaningful only for SINGLE_PRESS modes. */
 
@@ -267,18 +273,18 @@ void releaseSampleChannel(ChannelShared& shared, SamplePlayerMode mode)
 	disable it. */
 
 	if (shared.playStatus.load() == ChannelStatus::PLAY)
-		stopSampleChannel(shared, 0); // Let SamplePlayer stop it once done
+		stopSampleChannel(shared, localFrame); // Let SamplePlayer stop it once done
 	else if (shared.quantizer->hasBeenTriggered())
 		shared.quantizer->clear();
 }
 
 /* -------------------------------------------------------------------------- */
 
-void killSampleChannel(ChannelShared& shared, SamplePlayerMode mode)
+void killSampleChannel(ChannelShared& shared, SamplePlayerMode mode, Frame localFrame)
 {
 	const ChannelStatus playStatus = shared.playStatus.load();
 	if (playStatus == ChannelStatus::PLAY || playStatus == ChannelStatus::ENDING)
-		stopSampleChannel(shared, 0);
+		stopSampleChannel(shared, localFrame);
 	if (mode == SamplePlayerMode::SINGLE_BASIC_PAUSE)
 		shared.tracker.store(0); // Hard rewind
 }
@@ -44,13 +44,14 @@ void killSampleReadActions(ChannelShared&);
 void toggleSampleReadActions(ChannelShared&, bool treatRecsAsLoops, bool seqIsRunning);
 
 /* [...]SampleChannel
-Actions manually performed on a Sample channel. */
+Actions manually performed on a Sample channel. 'localFrame' is the offset in
+the next audio block where the action takes place. */
 
 void stopSampleChannelBySeq(ChannelShared&, bool chansStopOnSeqHalt, bool isLoop);
 void stopSampleChannel(ChannelShared&, Frame localFrame);
-void pressSampleChannel(ID channelId, ChannelShared&, SamplePlayerMode, float velocity, bool canQuantize, bool isLoop, bool velocityAsVol);
-void releaseSampleChannel(ChannelShared&, SamplePlayerMode);
-void killSampleChannel(ChannelShared&, SamplePlayerMode);
+void pressSampleChannel(ID channelId, ChannelShared&, SamplePlayerMode, float velocity, bool canQuantize, bool isLoop, bool velocityAsVol, Frame localFrame);
+void releaseSampleChannel(ChannelShared&, SamplePlayerMode, Frame localFrame);
+void killSampleChannel(ChannelShared&, SamplePlayerMode, Frame localFrame);
 void rewindSampleChannel(ChannelShared&, Frame localFrame);
 void playSampleChannel(ChannelShared&, Frame localFrame);
 
@@ -123,7 +123,7 @@ Frame render_(const Channel& ch, mcl::AudioBuffer& buf, Frame tracker, Frame off
 {
 	const Frame      begin     = ch.sampleChannel->begin;
 	const Frame      end       = ch.sampleChannel->end;
-	const float      pitch     = ch.sampleChannel->pitch;
+	const float      pitch     = ch.shared->pitch.load();
 	const Wave&      wave      = *ch.sampleChannel->getWave();
 	const Resampler& resampler = ch.shared->resampler.value();
 
@@ -0,0 +1,64 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_RENDERING_TRIGGER_H
+#define G_RENDERING_TRIGGER_H
+
+#include "core/types.h"
+#include "deps/concurrentqueue/concurrentqueue.h"
+
+namespace giada::m::rendering
+{
+/* Trigger
+A compact command that tells the real-time thread to press, release or kill a
+channel. Triggers are produced by the Reactor on non-realtime threads and
+consumed by the Renderer at the beginning of each audio block, which updates
+the channel's shared state directly without any Document swap.
+    Type::PRESS - key press, with velocity and quantization flag;
+    Type::RELEASE - key release;
+    Type::KILL - hard stop.
+'localFrame' is the offset in the audio block where the trigger takes place. */
+
+struct Trigger
+{
+	enum class Type
+	{
+		PRESS,
+		RELEASE,
+		KILL
+	};
+
+	Type  type        = Type::PRESS;
+	ID    channelId   = 0;
+	float velocity    = 0.0f;
+	bool  canQuantize = false;
+	Frame localFrame  = 0;
+};
+
+using TriggerQueue = moodycamel::ConcurrentQueue<Trigger>;
+} // namespace giada::m::rendering
+
+#endif
@@ -149,4 +149,12 @@ void Resampler::last() const
 {
 	src_reset(m_state);
 }
+
+/* -------------------------------------------------------------------------- */
+
+void Resampler::reset() const
+{
+	assert(m_state != nullptr);
+	src_reset(m_state);
+}
 } // namespace giada::m
@@ -73,6 +73,11 @@ public:
 
 	void last() const;
 
+	/* reset
+	Clears the internal state, as if no audio had been processed yet. */
+
+	void reset() const;
+
 private:
 	static long callback(void* self, float** audio);
 	long        callback(float** audio);
@@ -33,8 +33,8 @@
 namespace giada
 {
 /* RingBuffer
-A non-thread-safe, fixed-size ring buffer implementation. It grows from 0 to S,
-then items are overwritten starting from position 0. */
+A non-thread-safe, fixed-size buffer implementation. It grows from 0 to S: once
+full, new items are rejected rather than overwriting the existing ones. */
 
 template <typename T, std::size_t S>
 class RingBuffer
@@ -52,16 +52,18 @@ public:
 
 	void clear()
 	{
-		m_data.fill({});
-		m_index = 0;
-		m_end   = 0;
+		m_end = 0;
 	}
 
-	void push_back(T t)
+	/* push_back
+	Appends an item. Returns false if the buffer is full: the item is dropped. */
+
+	bool push_back(T t)
 	{
-		m_data[m_index] = t;
-		m_index         = (m_index + 1) % m_data.size(); // Wraps around at m_data.size()
-		m_end           = std::max(m_index, m_end);      // Points to the greater index
+		if (full())
+			return false;
+		m_data[m_end++] = t;
+		return true;
 	}
 
 	std::size_t size() const noexcept
@@ -69,10 +71,14 @@ public:
 		return m_end;
 	}
 
+	bool full() const noexcept
+	{
+		return m_end == S;
+	}
+
 private:
 	std::array<T, S> m_data;
-	std::size_t      m_index = 0;
-	std::size_t      m_end   = 0;
+	std::size_t      m_end = 0;
 };
 } // namespace giada
 
@@ -35,6 +35,8 @@
 #include "utils/log.h"
 #include "utils/math.h"
 #include "utils/time.h"
+#include <algorithm>
+#include <cassert>
 
 namespace giada::m
 {
@@ -102,13 +104,15 @@ Frame Sequencer::quantize(Frame f) const
 
 void Sequencer::reset(int sampleRate)
 {
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	model::Sequencer& s = m_model.get().sequencer;
 
 	s.bars     = G_DEFAULT_BARS;
 	s.beats    = G_DEFAULT_BEATS;
 	s.bpm      = G_DEFAULT_BPM;
 	s.quantize = G_DEFAULT_QUANTIZE;
-	recomputeFrames(sampleRate); // Model swap is done here, no need to call it twice
+	recomputeFrames(sampleRate);
 	rewind();
 }
 
@@ -121,19 +125,52 @@ void Sequencer::setSampleRate(int sampleRate)
 
 /* -------------------------------------------------------------------------- */
 
-const Sequencer::EventBuffer& Sequencer::advance(const model::Sequencer& sequencer,
+const Sequencer::Events& Sequencer::advance(const model::Sequencer& sequencer,
     Frame bufferSize, int sampleRate, const model::Actions& actions) const
 {
-	m_eventBuffer.clear();
+	/* The loop might have shrunk since the last block (e.g. after a bpm change):
+	wrap the current frame so that it always falls within the loop. */
+
+	const Frame start = sequencer.a_getCurrentFrame() % sequencer.framesInLoop;
+	const Frame end   = start + bufferSize;
+
+	parse(m_events, sequencer, start, bufferSize, actions, /*triggerMetronome=*/true);
+
+	/* Advance this and quantizer after the event parsing. */
+
+	sequencer.a_setCurrentFrame(end % sequencer.framesInLoop, sampleRate);
+	m_quantizer.advance(geompp::Range<Frame>(start, end), getQuantizerStep());
+
+	return m_events;
+}
+
+/* -------------------------------------------------------------------------- */
+
+const Sequencer::Events& Sequencer::peek(const model::Sequencer& sequencer, Frame start,
+    Frame bufferSize, const model::Actions& actions) const
+{
+	parse(m_peekEvents, sequencer, start, bufferSize, actions, /*triggerMetronome=*/false);
+	return m_peekEvents;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Sequencer::parse(Events& events, const model::Sequencer& sequencer, Frame blockStart,
+    Frame bufferSize, const model::Actions& actions, bool triggerMetronome) const
+{
+	events.timeline.clear();
+	events.segments.clear();
+	events.actions   = &actions;
+	events.sequencer = &sequencer;
+	events.dropped   = 0;
 
-	const Frame start        = sequencer.a_getCurrentFrame();
-	const Frame end          = start + bufferSize;
 	const Frame framesInLoop = sequencer.framesInLoop;
+	const Frame start        = blockStart % framesInLoop;
+	const Frame end          = start + bufferSize;
 	const Frame framesInBar  = sequencer.framesInBar;
 	const Frame framesInBeat = sequencer.framesInBeat;
-	const Frame nextFrame    = end % framesInLoop;
 
-	/* Process events in the current block. */
+	/* Process timeline events in the current block. */
 
 	for (Frame i = start, local = 0; i < end; i++, local++)
 	{
@@ -142,30 +179,127 @@ const Sequencer::EventBuffer& Sequencer::advance(const model::Sequencer& sequenc
 
 		if (global == 0)
 		{
-			m_eventBuffer.push_back({EventType::FIRST_BEAT, global, local});
-			m_metronome.trigger(Metronome::Click::BEAT, local);
+			pushEvent(events, events.timeline, {EventType::FIRST_BEAT, global, local});
+			if (triggerMetronome)
+				m_metronome.trigger(Metronome::Click::BEAT, local);
 		}
 		else if (global % framesInBar == 0)
 		{
-			m_eventBuffer.push_back({EventType::BAR, global, local});
-			m_metronome.trigger(Metronome::Click::BAR, local);
+			pushEvent(events, events.timeline, {EventType::BAR, global, local});
+			if (triggerMetronome)
+				m_metronome.trigger(Metronome::Click::BAR, local);
 		}
 		else if (global % framesInBeat == 0)
 		{
-			m_metronome.trigger(Metronome::Click::BEAT, local);
+			if (triggerMetronome)
+				m_metronome.trigger(Metronome::Click::BEAT, local);
 		}
+	}
+
+	/* Then split the block into segments that don't cross the end of the loop.
+	Actions are stored in ticks: each segment becomes a tick range at the
+	current tempo, read later by each channel with Events::getActions(). */
+
+	for (Frame segStart = start, local = 0; local < bufferSize; segStart = 0)
+	{
+		const Frame segEnd = std::min(framesInLoop, segStart + bufferSize - local);
+		if (segEnd <= segStart)
+			break;
 
-		const std::vector<Action>* as = actions.getActionsOnFrame(global);
-		if (as != nullptr)
-			m_eventBuffer.push_back({EventType::ACTIONS, global, local, as});
+		if (!events.segments.push_back({segStart, local, sequencer.frameToTick(segStart), sequencer.frameToTick(segEnd)}))
+			events.dropped++;
+
+		local += segEnd - segStart;
 	}
+}
 
-	/* Advance this and quantizer after the event parsing. */
+/* -------------------------------------------------------------------------- */
 
-	sequencer.a_setCurrentFrame(nextFrame, sampleRate);
-	m_quantizer.advance(geompp::Range<Frame>(start, end), getQuantizerStep());
+void Sequencer::pushEvent(Events& events, EventBuffer& buffer, const Event& e) const
+{
+	if (!buffer.push_back(e))
+		events.dropped++;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Sequencer::ChannelActions Sequencer::Events::getActions(ID channelId) const
+{
+	return ChannelActions(*this, actions != nullptr ? actions->findChannelActions(channelId) : nullptr);
+}
+
+/* -------------------------------------------------------------------------- */
 
-	return m_eventBuffer;
+Sequencer::ChannelActions::ChannelActions(const Events& events, const model::Actions::ChannelIndex* index)
+: m_events(events)
+, m_index(index)
+, m_segment(0)
+{
+	if (m_index == nullptr)
+		m_segment = m_events.segments.size();
+	else
+		seek(0);
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Sequencer::ChannelActions::done() const
+{
+	return m_segment >= m_events.segments.size();
+}
+
+/* -------------------------------------------------------------------------- */
+
+const Sequencer::Event& Sequencer::ChannelActions::get() const
+{
+	assert(!done());
+	return m_event;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Sequencer::ChannelActions::next()
+{
+	m_it = m_next;
+	if (m_it != m_end)
+		load();
+	else
+		seek(m_segment + 1);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Sequencer::ChannelActions::seek(std::size_t segment)
+{
+	const auto byTick = [](const Action* a, Tick t)
+	{ return a->tick < t; };
+
+	for (m_segment = segment; m_segment < m_events.segments.size(); m_segment++)
+	{
+		const Segment& s = *(m_events.segments.begin() + m_segment);
+
+		m_it  = std::lower_bound(m_index->begin(), m_index->end(), s.firstTick, byTick);
+		m_end = std::lower_bound(m_it, m_index->end(), s.lastTick, byTick);
+		if (m_it != m_end)
+		{
+			load();
+			return;
+		}
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Sequencer::ChannelActions::load()
+{
+	const Segment& s    = *(m_events.segments.begin() + m_segment);
+	const Tick     tick = (*m_it)->tick;
+
+	m_next = std::find_if(m_it, m_end, [tick](const Action* a)
+	{ return a->tick != tick; });
+
+	const Frame global = m_events.sequencer->tickToFrame(tick);
+	m_event            = {EventType::ACTIONS, global, s.local + global - s.start, {m_it, m_next}};
 }
 
 /* -------------------------------------------------------------------------- */
@@ -214,7 +348,7 @@ void Sequencer::rawStop()
 void Sequencer::rawRewind(Frame delta)
 {
 	rewindForced();
-	m_eventBuffer.push_back({EventType::REWIND, 0, delta});
+	pushEvent(m_events, m_events.timeline, {EventType::REWIND, 0, delta});
 }
 
 /* -------------------------------------------------------------------------- */
@@ -294,9 +428,12 @@ void Sequencer::setBpm(float b, int sampleRate)
 
 void Sequencer::rawSetBpm(float v, int sampleRate)
 {
-	assert(onBpmChange != nullptr);
+	/* Bpm and frames are updated in a single swap, so that the realtime thread
+	never sees a half-applied tempo change. Actions are stored in ticks and
+	don't need any update. */
+
+	const model::Transaction transaction = m_model.beginTransaction();
 
-	const float oldVal = m_model.get().sequencer.bpm;
 	const float newVal = std::clamp(v, G_MIN_BPM, G_MAX_BPM);
 
 	m_model.get().sequencer.bpm = newVal;
@@ -304,8 +441,6 @@ void Sequencer::rawSetBpm(float v, int sampleRate)
 
 	recomputeFrames(sampleRate);
 
-	onBpmChange(oldVal, newVal, m_quantizerStep);
-
 	u::log::print("[sequencer::rawSetBpm] Bpm changed to {}\n", newVal);
 }
 
@@ -316,6 +451,8 @@ void Sequencer::setBeats(int newBeats, int newBars, int sampleRate)
 	newBeats = std::clamp(newBeats, 1, G_MAX_BEATS);
 	newBars  = std::clamp(newBars, 1, newBeats); // Bars cannot be greater than beats
 
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	m_model.get().sequencer.beats = newBeats;
 	m_model.get().sequencer.bars  = newBars;
 	m_model.swap(model::SwapType::HARD);
@@ -335,6 +472,8 @@ void Sequencer::rawGoToBeat(int beat, int sampleRate)
 
 void Sequencer::setQuantize(int q, int sampleRate)
 {
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	m_model.get().sequencer.quantize = q;
 	m_model.swap(model::SwapType::HARD);
 
@@ -345,6 +484,8 @@ void Sequencer::setQuantize(int q, int sampleRate)
 
 void Sequencer::setStatus(SeqStatus s)
 {
+	const model::Transaction transaction = m_model.beginTransaction();
+
 	m_model.get().sequencer.status = s;
 	m_model.swap(model::SwapType::SOFT);
 
@@ -30,8 +30,10 @@
 #include "core/actions/action.h"
 #include "core/eventDispatcher.h"
 #include "core/metronome.h"
+#include "core/model/actions.h"
 #include "core/quantizer.h"
 #include "core/ringBuffer.h"
+#include <span>
 #include <vector>
 
 namespace mcl
@@ -43,7 +45,6 @@ namespace giada::m::model
 {
 class Model;
 class Sequencer;
-class Actions;
 struct Document;
 } // namespace giada::m::model
 
@@ -66,14 +67,98 @@ public:
 
 	struct Event
 	{
-		EventType                  type    = EventType::NONE;
-		Frame                      global  = 0;
-		Frame                      delta   = 0;
-		const std::vector<Action>* actions = nullptr;
+		EventType type   = EventType::NONE;
+		Frame     global = 0;
+		Frame     delta  = 0;
+
+		/* actions
+		ACTIONS events only: the channel's actions recorded on this tick. */
+
+		std::span<const Action* const> actions;
 	};
 
 	using EventBuffer = RingBuffer<Event, G_MAX_SEQUENCER_EVENTS>;
 
+	/* Segment
+	Part of a block that doesn't cross the end of the loop: frames [start, end)
+	of the loop, i.e. ticks [firstTick, lastTick), rendered from frame 'local' of
+	the block on. A block has one segment, or more if it wraps around the loop. */
+
+	struct Segment
+	{
+		Frame start     = 0;
+		Frame local     = 0;
+		Tick  firstTick = 0;
+		Tick  lastTick  = 0;
+	};
+
+	class Events;
+
+	/* ChannelActions
+	Walks the ACTIONS events of a single channel in a block, one per tick, in
+	frame order. Reads the channel index of model::Actions directly: nothing is
+	copied, so nothing can be dropped however many channels play on the same
+	tick. */
+
+	class ChannelActions
+	{
+	public:
+		ChannelActions(const Events&, const model::Actions::ChannelIndex*);
+
+		bool         done() const;
+		const Event& get() const;
+		void         next();
+
+	private:
+		using Iterator = model::Actions::ChannelIndex::const_iterator;
+
+		/* seek
+		Moves to the first action of segment 'segment', or of the first non-empty
+		segment past it. */
+
+		void seek(std::size_t segment);
+
+		/* load
+		Fills m_event with the actions on the tick of m_it. */
+
+		void load();
+
+		const Events&                       m_events;
+		const model::Actions::ChannelIndex* m_index;
+		std::size_t                         m_segment;
+		Iterator                            m_it;
+		Iterator                            m_next;
+		Iterator                            m_end;
+		Event                               m_event;
+	};
+
+	/* Events
+	Events found in a block. Timeline events (FIRST_BEAT, BAR, REWIND) are
+	shared by all channels and stored here. ACTIONS events are read on demand,
+	one channel at a time, with getActions(). */
+
+	class Events
+	{
+	public:
+		static constexpr std::size_t MAX_SEGMENTS = 8;
+
+		/* getActions
+		Returns the ACTIONS events of channel 'channelId'. */
+
+		ChannelActions getActions(ID channelId) const;
+
+		EventBuffer                       timeline;
+		RingBuffer<Segment, MAX_SEGMENTS> segments;
+		const model::Actions*             actions   = nullptr;
+		const model::Sequencer*           sequencer = nullptr;
+
+		/* dropped
+		Number of events (or segments, for very short loops) that didn't fit in
+		the buffers. */
+
+		std::size_t dropped = 0;
+	};
+
 	Sequencer(model::Model&, MidiSynchronizer&, JackTransport&);
 
 	/* canQuantize
@@ -137,10 +222,19 @@ public:
 
 	/* advance
 	Parses sequencer events that might occur in a block and advances the internal
-	quantizer. Returns a reference to the internal EventBuffer filled with events
-	(if any). Call this on each new audio block. */
+	quantizer. Returns a reference to the internal Events filled with events (if
+	any). Call this on each new audio block. */
 
-	const EventBuffer& advance(const model::Sequencer&, Frame bufferSize, int sampleRate,
+	const Events& advance(const model::Sequencer&, Frame bufferSize, int sampleRate,
+	    const model::Actions&) const;
+
+	/* peek
+	Like advance(), but parses events in the block starting at 'start' without
+	touching the current frame, the quantizer or the metronome. Returns a
+	reference to a second internal Events: only one thread besides the audio
+	one (the render-ahead worker) may call this. */
+
+	const Events& peek(const model::Sequencer&, Frame start, Frame bufferSize,
 	    const model::Actions&) const;
 
 	/* render
@@ -172,9 +266,8 @@ public:
 
 	void recomputeFrames(int sampleRate);
 
-	std::function<void(SeqStatus)>         onAboutStart;
-	std::function<void()>                  onAboutStop;
-	std::function<void(float, float, int)> onBpmChange;
+	std::function<void(SeqStatus)> onAboutStart;
+	std::function<void()>          onAboutStop;
 
 private:
 	/* raw[*]
@@ -192,11 +285,29 @@ private:
 	MidiSynchronizer& m_midiSynchronizer;
 	JackTransport&    m_jackTransport;
 
-	/* m_eventBuffer
-	Buffer of events found in each block sent to channels for event parsing.
-	This is filled during react(). */
+	/* parse
+	Fills 'events' with the events found in the block [start, start + bufferSize).
+	'start' is wrapped around the loop first, in case the loop has shrunk.
+	Triggers the metronome clicks too, if 'triggerMetronome' is set. */
+
+	void parse(Events&, const model::Sequencer&, Frame start, Frame bufferSize,
+	    const model::Actions&, bool triggerMetronome) const;
+
+	/* pushEvent
+	Appends an event to 'buffer', counting it as dropped in 'events' if full. */
+
+	void pushEvent(Events& events, EventBuffer& buffer, const Event&) const;
+
+	/* m_events
+	Events found in each block sent to channels for event parsing. This is
+	filled during advance(). */
+
+	mutable Events m_events;
+
+	/* m_peekEvents
+	Same as above, filled during peek(). */
 
-	mutable EventBuffer m_eventBuffer;
+	mutable Events m_peekEvents;
 
 	Metronome m_metronome;
 	Quantizer m_quantizer;
@@ -0,0 +1,69 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/stateObserver.h"
+#include "core/channels/channelShared.h"
+#include "core/dirtyFlags.h"
+#include "core/model/model.h"
+
+namespace giada::m
+{
+StateObserver::StateObserver(model::Model& m)
+: onChannelPlayStatusChanged(nullptr)
+, m_model(m)
+, m_lastSequence(0)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+void StateObserver::poll()
+{
+	/* Nothing has been published since the last visit: skip the scan. Read the
+	sequence number before consuming the bits, so that any change happening
+	during the scan will be caught on the next poll. */
+
+	const uint64_t sequence = DirtyFlags::getSequence();
+	if (sequence == m_lastSequence)
+		return;
+
+	/* The main thread might be adding or removing channels right now: try
+	again on the next poll. */
+
+	const bool visited = m_model.visitChannelsShared([this](ChannelShared& shared)
+	{
+		const DirtyFlags::Mask mask = shared.dirty.consume();
+		if (mask == 0)
+			return;
+
+		if (mask & ChannelShared::DIRTY_PLAY_STATUS && onChannelPlayStatusChanged != nullptr)
+			onChannelPlayStatusChanged(shared.id, shared.playStatus.load());
+	});
+
+	if (visited)
+		m_lastSequence = sequence;
+}
+} // namespace giada::m
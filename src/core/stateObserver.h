@@ -0,0 +1,70 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_STATE_OBSERVER_H
+#define G_STATE_OBSERVER_H
+
+#include "core/types.h"
+#include <cstdint>
+#include <functional>
+
+namespace giada::m::model
+{
+class Model;
+}
+
+namespace giada::m
+{
+/* StateObserver
+Non-realtime observer of the channels' shared state. The realtime thread only
+marks dirty bits (see DirtyFlags) when something changes; the observer collects
+them periodically and fans out notifications through its callbacks. */
+
+class StateObserver
+{
+public:
+	StateObserver(model::Model&);
+
+	/* poll
+	Checks for changes since the last call and fires the corresponding
+	callbacks. Must be called from a non-realtime thread. */
+
+	void poll();
+
+	/* onChannelPlayStatusChanged
+	Fired when the play status of a channel has changed. A status changed
+	multiple times between two polls is notified once, with the most recent
+	value. */
+
+	std::function<void(ID, ChannelStatus)> onChannelPlayStatusChanged;
+
+private:
+	model::Model& m_model;
+	uint64_t      m_lastSequence;
+};
+} // namespace giada::m
+
+#endif
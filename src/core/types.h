@@ -32,13 +32,15 @@ namespace giada
 using ID    = int;
 using Pixel = int;
 using Frame = int;
+using Tick  = int;
 
 enum class Thread
 {
 	MAIN,
 	MIDI,
 	AUDIO,
-	EVENTS
+	EVENTS,
+	RENDER_AHEAD
 };
 
 /* Windows fix */
@@ -109,6 +111,28 @@ struct Peak
 	float left;
 	float right;
 };
+
+/* Send
+Post-fader aux send from a channel to a return bus, i.e. the Group Channel of
+another track. */
+
+struct Send
+{
+	ID    returnId;
+	float level;
+};
+
+/* PluginParamChange
+A new value for a plug-in parameter, due at a given frame within the current
+audio block. */
+
+struct PluginParamChange
+{
+	ID    pluginId;
+	int   paramIndex;
+	float value;
+	Frame frame;
+};
 } // namespace giada
 
 #endif
@@ -0,0 +1,234 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/virtualAudioDevice.h"
+#include "core/wave.h"
+#include "core/waveFactory.h"
+#include "utils/log.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+
+namespace giada::m
+{
+VirtualAudioDevice::VirtualAudioDevice()
+: onAudioCallback(nullptr)
+, onXrun(nullptr)
+, m_inputPosition(0)
+, m_outputFile(nullptr)
+, m_running(false)
+, m_open(false)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+VirtualAudioDevice::~VirtualAudioDevice()
+{
+	close();
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool VirtualAudioDevice::open(const Config& config, Resampler::Quality quality)
+{
+	close();
+
+	if (config.sampleRate == 0 || config.bufferSize == 0)
+		return false;
+
+	m_config        = config;
+	m_inputPosition = 0;
+
+	if (m_config.channelsOutCount > 0)
+		m_out.alloc(m_config.bufferSize, m_config.channelsOutCount);
+	if (m_config.channelsInCount > 0)
+		m_in.alloc(m_config.bufferSize, m_config.channelsInCount);
+
+	if (m_config.channelsInCount > 0 && !m_config.inputPath.empty())
+	{
+		waveFactory::Result res = waveFactory::createFromFile(m_config.inputPath, /*id=*/0, m_config.sampleRate, quality);
+		if (res.status != G_RES_OK)
+		{
+			u::log::print("[VirtualAudioDevice::open] unable to read input file {}\n", m_config.inputPath);
+			return false;
+		}
+		m_inputWave = std::move(res.wave);
+	}
+
+	if (!m_config.outputPath.empty() && m_config.channelsOutCount > 0)
+	{
+		SF_INFO header;
+		header.samplerate = m_config.sampleRate;
+		header.channels   = m_config.channelsOutCount;
+		header.format     = SF_FORMAT_WAV | SF_FORMAT_FLOAT;
+
+		m_outputFile = sf_open(m_config.outputPath.c_str(), SFM_WRITE, &header);
+		if (m_outputFile == nullptr)
+		{
+			u::log::print("[VirtualAudioDevice::open] unable to open output file {}: {}\n",
+			    m_config.outputPath, sf_strerror(nullptr));
+			m_inputWave.reset();
+			return false;
+		}
+	}
+
+	m_open = true;
+
+	u::log::print("[VirtualAudioDevice::open] sampleRate={} bufferSize={} outs={} ins={} freewheel={}\n",
+	    m_config.sampleRate, m_config.bufferSize, m_config.channelsOutCount, m_config.channelsInCount,
+	    m_config.freewheel);
+
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool VirtualAudioDevice::start()
+{
+	assert(onAudioCallback != nullptr);
+
+	if (!m_open)
+		return false;
+	if (m_running.load())
+		return true;
+
+	m_running.store(true);
+	m_thread = std::thread([this]()
+	{ run(); });
+
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void VirtualAudioDevice::stop()
+{
+	m_running.store(false);
+	if (m_thread.joinable())
+		m_thread.join();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void VirtualAudioDevice::close()
+{
+	stop();
+
+	if (m_outputFile != nullptr)
+	{
+		sf_close(m_outputFile);
+		m_outputFile = nullptr;
+	}
+
+	m_inputWave.reset();
+	m_out = mcl::AudioBuffer();
+	m_in  = mcl::AudioBuffer();
+	m_open = false;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool VirtualAudioDevice::isOpen() const { return m_open; }
+bool VirtualAudioDevice::isRunning() const { return m_running.load(); }
+
+const VirtualAudioDevice::Config& VirtualAudioDevice::getConfig() const { return m_config; }
+
+/* -------------------------------------------------------------------------- */
+
+void VirtualAudioDevice::run()
+{
+	using Clock = std::chrono::steady_clock;
+
+	const auto period = std::chrono::duration_cast<Clock::duration>(
+	    std::chrono::duration<double>(m_config.bufferSize / static_cast<double>(m_config.sampleRate)));
+
+	Clock::time_point deadline = Clock::now();
+
+	while (m_running.load())
+	{
+		readInput();
+		m_out.clear();
+		onAudioCallback(m_out, m_in);
+		writeOutput();
+
+		if (m_config.freewheel)
+			continue;
+
+		/* Pace the next block on an absolute timeline, so that small scheduling
+		jitters don't accumulate. If the deadline has already been missed by a
+		whole period, report it and restart the timeline from now instead of
+		bursting blocks to catch up, just like a real device would drop them. */
+
+		deadline += period;
+		const Clock::time_point now = Clock::now();
+		if (now > deadline + period)
+		{
+			if (onXrun != nullptr)
+				onXrun();
+			deadline = now;
+		}
+		std::this_thread::sleep_until(deadline);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void VirtualAudioDevice::readInput()
+{
+	if (!m_in.isAllocd())
+		return;
+
+	m_in.clear();
+
+	if (m_inputWave == nullptr)
+		return;
+
+	/* Input file is played once, then the device keeps feeding silence. The
+	input Wave is always stereo (see waveFactory::createFromFile): extra device
+	channels, if any, get the last Wave channel. */
+
+	const mcl::AudioBuffer& src    = m_inputWave->getBuffer();
+	const Frame             frames = std::min(m_in.countFrames(), src.countFrames() - m_inputPosition);
+
+	for (Frame i = 0; i < frames; i++)
+		for (int j = 0; j < m_in.countChannels(); j++)
+			m_in[i][j] = src[m_inputPosition + i][std::min(j, src.countChannels() - 1)];
+
+	m_inputPosition += std::max(0, frames);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void VirtualAudioDevice::writeOutput()
+{
+	if (m_outputFile == nullptr)
+		return;
+
+	if (sf_writef_float(m_outputFile, m_out[0], m_out.countFrames()) != m_out.countFrames())
+		u::log::print("[VirtualAudioDevice::writeOutput] warning: incomplete write!\n");
+}
+} // namespace giada::m
@@ -0,0 +1,119 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_VIRTUAL_AUDIO_DEVICE_H
+#define G_VIRTUAL_AUDIO_DEVICE_H
+
+#include "core/const.h"
+#include "core/resampler.h"
+#include "core/types.h"
+#include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <sndfile.h>
+#include <string>
+#include <thread>
+
+namespace giada::m
+{
+class Wave;
+
+/* VirtualAudioDevice
+A device-free audio backend. A private thread invokes 'onAudioCallback' once per
+block, either paced at the configured sample rate and buffer size, or as fast as
+possible (freewheel mode). Input, if any, is read from an audio file; output can
+optionally be written to a WAV file. Used by KernelAudio when the audio API is
+RTAUDIO_DUMMY, so that the engine can run headless with no sound server. */
+
+class VirtualAudioDevice final
+{
+public:
+	struct Config
+	{
+		unsigned int sampleRate       = G_DEFAULT_SAMPLERATE;
+		unsigned int bufferSize       = G_DEFAULT_BUFSIZE;
+		int          channelsOutCount = G_MAX_IO_CHANS;
+		int          channelsInCount  = 0;
+		std::string  inputPath        = "";
+		std::string  outputPath       = "";
+		bool         freewheel        = false;
+	};
+
+	VirtualAudioDevice();
+	~VirtualAudioDevice();
+
+	/* open
+	Prepares buffers, loads the input file (resampled to Config::sampleRate if
+	needed) and opens the output file. Returns false on failure. */
+
+	bool open(const Config&, Resampler::Quality);
+
+	/* start, stop
+	Starts or stops the processing thread. */
+
+	bool start();
+	void stop();
+
+	/* close
+	Stops the processing thread (if running), finalizes the output file and
+	frees all resources. */
+
+	void close();
+
+	bool          isOpen() const;
+	bool          isRunning() const;
+	const Config& getConfig() const;
+
+	/* onAudioCallback
+	Invoked on each audio block from the processing thread. */
+
+	std::function<int(mcl::AudioBuffer& out, const mcl::AudioBuffer& in)> onAudioCallback;
+
+	/* onXrun
+	Invoked from the processing thread when a block has been delivered later
+	than its deadline. Never fired in freewheel mode. */
+
+	std::function<void()> onXrun;
+
+private:
+	void run();
+	void readInput();
+	void writeOutput();
+
+	Config                m_config;
+	std::unique_ptr<Wave> m_inputWave;
+	Frame                 m_inputPosition;
+	SNDFILE*              m_outputFile;
+	mcl::AudioBuffer      m_out;
+	mcl::AudioBuffer      m_in;
+	std::thread           m_thread;
+	std::atomic<bool>     m_running;
+	bool                  m_open;
+};
+} // namespace giada::m
+
+#endif
@@ -27,8 +27,8 @@
 #ifndef G_WEAK_ATOMIC_H
 #define G_WEAK_ATOMIC_H
 
+#include "core/dirtyFlags.h"
 #include <atomic>
-#include <functional>
 
 namespace giada
 {
@@ -45,9 +45,10 @@ public:
 	}
 
 	WeakAtomic(const WeakAtomic& o)
-	: onChange(o.onChange)
-	, m_atomic(o.load())
+	: m_atomic(o.load())
 	, m_value(o.m_value)
+	, m_dirtyFlags(o.m_dirtyFlags)
+	, m_dirtyMask(o.m_dirtyMask)
 	{
 	}
 
@@ -60,7 +61,8 @@ public:
 	{
 		if (this == &o)
 			return *this;
-		onChange = o.onChange;
+		m_dirtyFlags = o.m_dirtyFlags;
+		m_dirtyMask  = o.m_dirtyMask;
 		store(o.load());
 		m_value = o.m_value;
 		return *this;
@@ -82,16 +84,26 @@ public:
 	void store(T t)
 	{
 		m_atomic.store(t, std::memory_order_relaxed);
-		if (onChange != nullptr && t != m_value)
-			onChange(t);
+		if (m_dirtyFlags != nullptr && t != m_value)
+			m_dirtyFlags->set(m_dirtyMask);
 		m_value = t;
 	}
 
-	std::function<void(T)> onChange = nullptr;
+	/* publishTo
+	Marks the given bits in a DirtyFlags object whenever the value changes.
+	Realtime-safe: no callbacks are invoked on store. */
+
+	void publishTo(DirtyFlags& flags, DirtyFlags::Mask mask)
+	{
+		m_dirtyFlags = &flags;
+		m_dirtyMask  = mask;
+	}
 
 private:
-	std::atomic<T> m_atomic;
-	T              m_value;
+	std::atomic<T>   m_atomic;
+	T                m_value;
+	DirtyFlags*      m_dirtyFlags = nullptr;
+	DirtyFlags::Mask m_dirtyMask  = 0;
 };
 } // namespace giada
 
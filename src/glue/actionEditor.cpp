@@ -83,7 +83,7 @@ Data getData(ID channelId)
 
 /* -------------------------------------------------------------------------- */
 
-const m::Action* findAction(ID id)
+m::Action findAction(ID id)
 {
 	return g_engine->getActionEditorApi().findAction(id);
 }
@@ -133,9 +133,7 @@ void deleteSampleAction(ID channelId, const m::Action& a)
 
 /* -------------------------------------------------------------------------- */
 
-#if 0
-
-void recordEnvelopeAction(ID channelId, Frame f, int value)
+void recordEnvelopeAction(ID channelId, Frame f, float value)
 {
 	g_engine->getActionEditorApi().recordEnvelopeAction(channelId, f, value);
 }
@@ -149,13 +147,11 @@ void deleteEnvelopeAction(ID channelId, const m::Action& a)
 
 /* -------------------------------------------------------------------------- */
 
-void updateEnvelopeAction(ID channelId, const m::Action& a, Frame f, int value)
+void updateEnvelopeAction(ID channelId, const m::Action& a, Frame f, float value)
 {
 	g_engine->getActionEditorApi().updateEnvelopeAction(channelId, a, f, value);
 }
 
-#endif
-
 /* -------------------------------------------------------------------------- */
 
 void updateVelocity(const m::Action& a, float value)
@@ -73,7 +73,7 @@ struct Data
 
 Data getData(ID channelId);
 
-const m::Action* findAction(ID);
+m::Action findAction(ID);
 
 /* MIDI actions.  */
 
@@ -91,13 +91,11 @@ void deleteSampleAction(ID channelId, const m::Action& a);
 void updateSampleAction(ID channelId, const m::Action& a, int type,
     Frame f1, Frame f2 = 0);
 
-/* Envelope actions (only volume for now). */
+/* Envelope actions (only volume for now). Values are gains in [0.0, 1.0]. */
 
-#if 0
-void recordEnvelopeAction(ID channelId, Frame f, int value);
+void recordEnvelopeAction(ID channelId, Frame f, float value);
 void deleteEnvelopeAction(ID channelId, const m::Action& a);
-void updateEnvelopeAction(ID channelId, const m::Action& a, Frame f, int value);
-#endif
+void updateEnvelopeAction(ID channelId, const m::Action& a, Frame f, float value);
 } // namespace giada::c::actionEditor
 
 #endif
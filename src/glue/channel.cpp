@@ -289,6 +289,29 @@ bool canRemoveTrack(std::size_t trackIndex)
 
 /* -------------------------------------------------------------------------- */
 
+void freezeTrack(std::size_t trackIndex)
+{
+	/* The column is rendered offline on this thread, with the audio stream
+	stopped: warn the user first. */
+
+	if (!v::gdConfirmWin(g_ui->getI18Text(v::LangMap::COMMON_WARNING), g_ui->getI18Text(v::LangMap::MESSAGE_CHANNEL_FREEZE)))
+		return;
+	auto progress = g_ui->mainWindow->getScopedProgress(g_ui->getI18Text(v::LangMap::MESSAGE_CHANNEL_FREEZINGTRACK));
+	g_engine->getChannelsApi().freezeTrack(trackIndex);
+}
+
+void unfreezeTrack(std::size_t trackIndex)
+{
+	g_engine->getChannelsApi().unfreezeTrack(trackIndex);
+}
+
+bool isTrackFrozen(std::size_t trackIndex)
+{
+	return g_engine->getChannelsApi().getTracks().get(trackIndex).isFrozen();
+}
+
+/* -------------------------------------------------------------------------- */
+
 void setSamplePlayerMode(ID channelId, SamplePlayerMode mode)
 {
 	g_engine->getChannelsApi().setSamplePlayerMode(channelId, mode);
@@ -311,6 +334,40 @@ void setName(ID channelId, const std::string& name)
 
 /* -------------------------------------------------------------------------- */
 
+void setSend(ID channelId, ID returnId, float level)
+{
+	g_engine->getChannelsApi().setSend(channelId, returnId, level);
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::vector<SendData> getSends(ID channelId)
+{
+	m::ChannelsApi&   api     = g_engine->getChannelsApi();
+	const m::Channel& channel = api.get(channelId);
+
+	std::vector<SendData> out;
+	for (const m::model::Track& track : api.getTracks().getAll())
+	{
+		if (track.isInternal())
+			continue;
+
+		const m::Channel& group = track.getGroupChannel();
+		if (!api.canSend(channelId, group.id))
+			continue;
+
+		float level = 0.0f;
+		for (const m::Send& send : channel.sends)
+			if (send.returnId == group.id)
+				level = send.level;
+
+		out.push_back({group.id, track.getIndex(), group.name, level});
+	}
+	return out;
+}
+
+/* -------------------------------------------------------------------------- */
+
 void clearAllActions(ID channelId)
 {
 	if (!v::gdConfirmWin(g_ui->getI18Text(v::LangMap::COMMON_WARNING),
@@ -323,21 +380,21 @@ void clearAllActions(ID channelId)
 
 /* -------------------------------------------------------------------------- */
 
-void pressChannel(ID channelId, float velocity, Thread t)
+void pressChannel(ID channelId, float velocity, Thread t, Frame localFrame)
 {
-	g_engine->getChannelsApi().press(channelId, velocity);
+	g_engine->getChannelsApi().press(channelId, velocity, localFrame);
 	notifyChannelForMidiIn(t, channelId);
 }
 
-void releaseChannel(ID channelId, Thread t)
+void releaseChannel(ID channelId, Thread t, Frame localFrame)
 {
-	g_engine->getChannelsApi().release(channelId);
+	g_engine->getChannelsApi().release(channelId, localFrame);
 	notifyChannelForMidiIn(t, channelId);
 }
 
-void killChannel(ID channelId, Thread t)
+void killChannel(ID channelId, Thread t, Frame localFrame)
 {
-	g_engine->getChannelsApi().kill(channelId);
+	g_engine->getChannelsApi().kill(channelId, localFrame);
 	notifyChannelForMidiIn(t, channelId);
 }
 
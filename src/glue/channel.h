@@ -121,6 +121,14 @@ struct Track
 	std::vector<Data> channels;
 };
 
+struct SendData
+{
+	ID          returnId;   // Group Channel of the return track
+	std::size_t trackIndex; // Index of the return track
+	std::string name;       // Name of the return track's Group Channel
+	float       level;      // 0.0f if not sending
+};
+
 /* getChannels
 Returns a single viewModel object filled with data from a channel. */
 
@@ -187,6 +195,19 @@ True if the track is removable (only one Group channel contained). */
 
 bool canRemoveTrack(std::size_t trackIndex);
 
+/* freezeTrack, unfreezeTrack
+Renders the track to a Wave to save CPU, or brings it back to live rendering. */
+
+void freezeTrack(std::size_t trackIndex);
+void unfreezeTrack(std::size_t trackIndex);
+bool isTrackFrozen(std::size_t trackIndex);
+
+/* getSends
+Returns the return buses the channel can send to, along with the current send
+levels. */
+
+std::vector<SendData> getSends(ID channelId);
+
 /* set*
 Sets several channel properties. */
 
@@ -194,6 +215,7 @@ void setInputMonitor(ID channelId, bool value);
 void setOverdubProtection(ID channelId, bool value);
 void setName(ID channelId, const std::string& name);
 void setHeight(ID channelId, Pixel p);
+void setSend(ID channelId, ID returnId, float level);
 
 /* clearAllActions
 Deletes all recorded actions on channel 'channelId'. */
@@ -202,9 +224,13 @@ void clearAllActions(ID channelId);
 
 void setSamplePlayerMode(ID channelId, SamplePlayerMode m);
 
-void  pressChannel(ID channelId, float velocity, Thread t);
-void  releaseChannel(ID channelId, Thread t);
-void  killChannel(ID channelId, Thread t);
+/* [press|release|kill]Channel
+Trigger functions. 'localFrame' is the frame offset in the next audio block
+where the trigger should take place (e.g. for sample-accurate MIDI input). */
+
+void  pressChannel(ID channelId, float velocity, Thread t, Frame localFrame = 0);
+void  releaseChannel(ID channelId, Thread t, Frame localFrame = 0);
+void  killChannel(ID channelId, Thread t, Frame localFrame = 0);
 float setChannelVolume(ID channelId, float v, Thread t, bool repaintMainUi = false);
 float setChannelPitch(ID channelId, float v, Thread t);
 float setChannelPan(ID channelId, float v);
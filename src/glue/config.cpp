@@ -111,7 +111,7 @@ AudioData getAudioData()
 {
 	AudioData audioData;
 
-	audioData.apis[RtAudio::Api::RTAUDIO_DUMMY] = "(Dummy)";
+	audioData.apis[RtAudio::Api::RTAUDIO_DUMMY] = "(Virtual device)";
 	if (g_engine->getConfigApi().audio_hasAPI(RtAudio::Api::LINUX_ALSA))
 		audioData.apis[RtAudio::Api::LINUX_ALSA] = "ALSA";
 	if (g_engine->getConfigApi().audio_hasAPI(RtAudio::Api::UNIX_JACK))
@@ -37,8 +37,11 @@
 #include "gui/elems/mainWindow/mainOutput.h"
 #include "gui/elems/mainWindow/mainTimer.h"
 #include "gui/ui.h"
+#include "utils/fs.h"
 #include "utils/gui.h"
 #include "utils/string.h"
+#include "utils/trace.h"
+#include <fmt/core.h>
 
 extern giada::v::Ui*     g_ui;
 extern giada::m::Engine* g_engine;
@@ -52,6 +55,7 @@ Timer::Timer()
 , quantize(g_engine->getMainApi().getQuantizerValue())
 , isUsingJack(g_engine->getConfigApi().audio_getAPI() == RtAudio::Api::UNIX_JACK)
 , isRecordingInput(g_engine->getMainApi().isRecordingInput())
+, dspLoad(g_engine->getMainApi().getDspLoad())
 {
 }
 
@@ -285,6 +289,83 @@ void toggleInputRecording() { g_engine->getMainApi().toggleInputRecording(); }
 
 /* -------------------------------------------------------------------------- */
 
+void savePerformanceReport()
+{
+	const std::string path = u::fs::join(u::fs::getConfigDirPath(), "performance.txt");
+
+	if (!g_engine->getMainApi().dumpProfilerReport(path))
+	{
+		v::gdAlert(g_ui->getI18Text(v::LangMap::MESSAGE_MAIN_PERFREPORTERROR));
+		return;
+	}
+	const std::string msg = fmt::format("{} {}", g_ui->getI18Text(v::LangMap::MESSAGE_MAIN_PERFREPORTSAVED), path);
+	v::gdAlert(msg.c_str());
+}
+
+/* -------------------------------------------------------------------------- */
+
+void toggleTimelineCapture()
+{
+	if (!u::trace::isEnabled())
+	{
+		u::trace::start();
+		return;
+	}
+
+	u::trace::stop();
+
+	const std::string path = u::fs::join(u::fs::getConfigDirPath(), "timeline.json");
+
+	if (!u::trace::save(path))
+	{
+		v::gdAlert(g_ui->getI18Text(v::LangMap::MESSAGE_MAIN_TIMELINEERROR));
+		return;
+	}
+	const std::string msg = fmt::format("{} {}", g_ui->getI18Text(v::LangMap::MESSAGE_MAIN_TIMELINESAVED), path);
+	v::gdAlert(msg.c_str());
+}
+
+/* -------------------------------------------------------------------------- */
+
+void toggleSessionCapture()
+{
+	m::MainApi&       mainApi = g_engine->getMainApi();
+	const std::string path    = u::fs::join(u::fs::getConfigDirPath(), "capture");
+
+	if (!mainApi.isCapturingSession())
+	{
+		if (!mainApi.startSessionCapture(path))
+			v::gdAlert(g_ui->getI18Text(v::LangMap::MESSAGE_MAIN_SESSIONERROR));
+		return;
+	}
+
+	if (!mainApi.stopSessionCapture())
+	{
+		v::gdAlert(g_ui->getI18Text(v::LangMap::MESSAGE_MAIN_SESSIONERROR));
+		return;
+	}
+	const std::string msg = fmt::format("{} {}", g_ui->getI18Text(v::LangMap::MESSAGE_MAIN_SESSIONSAVED), path);
+	v::gdAlert(msg.c_str());
+}
+
+/* -------------------------------------------------------------------------- */
+
+void replaySession()
+{
+	const std::string path       = u::fs::join(u::fs::getConfigDirPath(), "capture");
+	const std::string outputPath = u::fs::join(path, "replay.wav");
+
+	if (!g_engine->replaySession(path, outputPath))
+	{
+		v::gdAlert(g_ui->getI18Text(v::LangMap::MESSAGE_MAIN_SESSIONREPLAYERROR));
+		return;
+	}
+	const std::string msg = fmt::format("{} {}", g_ui->getI18Text(v::LangMap::MESSAGE_MAIN_SESSIONREPLAYED), outputPath);
+	v::gdAlert(msg.c_str());
+}
+
+/* -------------------------------------------------------------------------- */
+
 #ifdef G_DEBUG_MODE
 
 void printDebugInfo()
@@ -55,6 +55,7 @@ struct Timer
 	int   quantize;
 	bool  isUsingJack;
 	bool  isRecordingInput;
+	float dspLoad;
 };
 
 struct IO
@@ -141,6 +142,30 @@ void toggleActionRecording();
 void stopInputRecording();
 void toggleInputRecording();
 
+/* savePerformanceReport
+Writes the audio engine performance report to a file in the configuration
+directory and tells the user where it is. */
+
+void savePerformanceReport();
+
+/* toggleTimelineCapture
+Starts recording the engine threads timeline or, if already recording, stops
+and saves it to a Chrome trace file in the configuration directory. */
+
+void toggleTimelineCapture();
+
+/* toggleSessionCapture
+Starts journaling all external inputs and the audio input or, if already
+capturing, stops and saves them in the configuration directory. */
+
+void toggleSessionCapture();
+
+/* replaySession
+Renders offline the last session capture to a WAV file in the configuration
+directory and tells the user where it is. */
+
+void replaySession();
+
 #ifdef G_DEBUG_MODE
 void printDebugInfo();
 #endif
@@ -136,6 +136,13 @@ std::vector<m::PluginManager::PluginInfo> getPluginsInfo()
 
 /* -------------------------------------------------------------------------- */
 
+float getCpuLoad(ID pluginId)
+{
+	return g_engine->getPluginsApi().getCpuLoad(pluginId);
+}
+
+/* -------------------------------------------------------------------------- */
+
 void updateWindow(ID pluginId, Thread t)
 {
 	const m::Plugin* p = g_engine->getPluginsApi().get(pluginId);
@@ -192,7 +199,7 @@ void setProgram(ID pluginId, int programIndex)
 
 void setParameter(ID channelId, ID pluginId, int paramIndex, float value, Thread t)
 {
-	g_engine->getPluginsApi().setParameter(pluginId, paramIndex, value);
+	g_engine->getPluginsApi().setParameter(channelId, pluginId, paramIndex, value);
 	channel::notifyChannelForMidiIn(t, channelId);
 
 	g_ui->pumpEvent([pluginId, t]()
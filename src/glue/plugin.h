@@ -114,6 +114,11 @@ Param   getParam(int index, const m::Plugin& plugin, ID channelId);
 
 std::vector<m::PluginManager::PluginInfo> getPluginsInfo();
 
+/* getCpuLoad
+Returns the fraction of the audio block period spent processing the plug-in. */
+
+float getCpuLoad(ID pluginId);
+
 /* updateWindow
 Updates the editor-less plug-in window. This is useless if the plug-in has an
 editor. */
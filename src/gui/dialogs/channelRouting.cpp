@@ -30,16 +30,35 @@
 #include "gui/elems/basics/flex.h"
 #include "gui/elems/basics/textButton.h"
 #include "gui/elems/panTool.h"
+#include "gui/elems/sendTool.h"
 #include "gui/elems/volumeTool.h"
 #include "gui/ui.h"
 #include "utils/gui.h"
+#include <fmt/core.h>
 
 extern giada::v::Ui* g_ui;
 
 namespace giada::v
 {
-gdChannelRouting::gdChannelRouting(const c::channel::Data& d)
-: gdWindow(u::gui::getCenterWinBounds({-1, -1, 260, 90}), g_ui->getI18Text(LangMap::CHANNELROUTING_TITLE), WID_CHANNEL_ROUTING)
+namespace
+{
+/* getHeight_
+Returns the window height, given the number of send rows. */
+
+int getHeight_(std::size_t numSends)
+{
+	if (numSends == 0)
+		return 90;
+	return 90 + static_cast<int>(numSends + 1) * (G_GUI_UNIT + G_GUI_INNER_MARGIN); // +1: 'Sends' header
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+gdChannelRouting::gdChannelRouting(const c::channel::Data& d, const std::vector<c::channel::SendData>& sends)
+: gdWindow(u::gui::getCenterWinBounds({-1, -1, 260, getHeight_(sends.size())}), g_ui->getI18Text(LangMap::CHANNELROUTING_TITLE), WID_CHANNEL_ROUTING)
 {
 	constexpr int LABEL_WIDTH = 70;
 
@@ -51,6 +70,16 @@ gdChannelRouting::gdChannelRouting(const c::channel::Data& d)
 			m_pan    = new gePanTool(d.id, d.pan, LABEL_WIDTH);
 			body->addWidget(m_volume, G_GUI_UNIT);
 			body->addWidget(m_pan, G_GUI_UNIT);
+			if (!sends.empty())
+				body->addWidget(new geBox(g_ui->getI18Text(LangMap::CHANNELROUTING_SENDS), FL_ALIGN_LEFT), G_GUI_UNIT);
+			for (const c::channel::SendData& send : sends)
+			{
+				std::string name = send.name;
+				if (name.empty())
+					name = fmt::format(fmt::runtime(g_ui->getI18Text(LangMap::CHANNELROUTING_COLUMN)), send.trackIndex);
+				m_sends.push_back(new geSendTool(d.id, send.returnId, name, send.level, LABEL_WIDTH));
+				body->addWidget(m_sends.back(), G_GUI_UNIT);
+			}
 			body->end();
 		}
 
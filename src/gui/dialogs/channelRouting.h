@@ -28,26 +28,30 @@
 #define GD_CHANNEL_ROUTING_H
 
 #include "gui/dialogs/window.h"
+#include <vector>
 
 namespace giada::c::channel
 {
 struct Data;
-}
+struct SendData;
+} // namespace giada::c::channel
 
 namespace giada::v
 {
 class geVolumeTool;
 class gePanTool;
+class geSendTool;
 class geTextButton;
 class gdChannelRouting : public gdWindow
 {
 public:
-	gdChannelRouting(const c::channel::Data& d);
+	gdChannelRouting(const c::channel::Data& d, const std::vector<c::channel::SendData>& sends);
 
 private:
-	geVolumeTool* m_volume;
-	gePanTool*    m_pan;
-	geTextButton* m_close;
+	geVolumeTool*            m_volume;
+	gePanTool*               m_pan;
+	std::vector<geSendTool*> m_sends;
+	geTextButton*            m_close;
 };
 } // namespace giada::v
 
@@ -114,7 +114,7 @@ gdMainWindow::gdMainWindow(geompp::Rect<int> r, const char* title)
 
 				zone2->addWidget(mainTransport, 400);
 				zone2->addWidget(new geBox());
-				zone2->addWidget(zoneTimer, 237);
+				zone2->addWidget(zoneTimer, 301);
 				zone2->end();
 			}
 
@@ -242,12 +242,12 @@ void gePianoRoll::rebuild(c::actionEditor::Data& d)
 
 	for (const m::Action& a1 : m_data->actions)
 	{
-		if (a1.event.getStatus() == m::MidiEvent::CHANNEL_NOTE_OFF)
+		if (a1.event.getStatus() != m::MidiEvent::CHANNEL_NOTE_ON) // Plug-in automation is not shown here
 			continue;
 
 		assert(a1.isValid()); // a2 might be null if orphaned
 
-		const m::Action& a2 = a1.nextId != 0 ? *c::actionEditor::findAction(a1.nextId) : m::Action{};
+		const m::Action a2 = a1.nextId != 0 ? c::actionEditor::findAction(a1.nextId) : m::Action{};
 
 		Pixel px = x() + m_base->frameToPixel(a1.frame);
 		Pixel py = y() + noteToY(a1.event.getNote());
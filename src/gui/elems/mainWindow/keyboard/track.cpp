@@ -50,6 +50,8 @@ enum class Menu
 	ADD_MIDI_CHANNEL,
 	ADD_TRACK,
 	REMOVE_TRACK,
+	FREEZE_TRACK,
+	UNFREEZE_TRACK,
 };
 
 /* -------------------------------------------------------------------------- */
@@ -121,6 +123,10 @@ void geTrack::showMenu() const
 	menu.addItem((ID)Menu::ADD_MIDI_CHANNEL, g_ui->getI18Text(LangMap::MAIN_TRACK_BUTTON_ADDMIDICHANNEL));
 	menu.addItem((ID)Menu::ADD_TRACK, g_ui->getI18Text(LangMap::MAIN_TRACK_BUTTON_ADD_TRACK));
 	menu.addItem((ID)Menu::REMOVE_TRACK, g_ui->getI18Text(LangMap::MAIN_TRACK_BUTTON_REMOVE_TRACK));
+	if (c::channel::isTrackFrozen(index))
+		menu.addItem((ID)Menu::UNFREEZE_TRACK, g_ui->getI18Text(LangMap::MAIN_TRACK_BUTTON_UNFREEZE_TRACK));
+	else
+		menu.addItem((ID)Menu::FREEZE_TRACK, g_ui->getI18Text(LangMap::MAIN_TRACK_BUTTON_FREEZE_TRACK));
 
 	geKeyboard* keyboard = static_cast<geKeyboard*>(parent());
 
@@ -143,6 +149,12 @@ void geTrack::showMenu() const
 		case Menu::ADD_TRACK:
 			keyboard->addTrack();
 			break;
+		case Menu::FREEZE_TRACK:
+			c::channel::freezeTrack(index);
+			break;
+		case Menu::UNFREEZE_TRACK:
+			c::channel::unfreezeTrack(index);
+			break;
 		}
 	};
 
@@ -85,6 +85,14 @@ geMainMenu::geMainMenu()
 	{ c::layout::openBrowserForProjectSave(); }),
 	    makeMenuItem_(LangMap::MAIN_MENU_FILE_CLOSEPROJECT, [](Fl_Widget*, void*)
 	{ c::main::closeProject(); }),
+	    makeMenuItem_(LangMap::MAIN_MENU_FILE_PERFREPORT, [](Fl_Widget*, void*)
+	{ c::main::savePerformanceReport(); }),
+	    makeMenuItem_(LangMap::MAIN_MENU_FILE_TIMELINE, [](Fl_Widget*, void*)
+	{ c::main::toggleTimelineCapture(); }),
+	    makeMenuItem_(LangMap::MAIN_MENU_FILE_SESSIONCAPTURE, [](Fl_Widget*, void*)
+	{ c::main::toggleSessionCapture(); }),
+	    makeMenuItem_(LangMap::MAIN_MENU_FILE_SESSIONREPLAY, [](Fl_Widget*, void*)
+	{ c::main::replaySession(); }),
 #ifdef G_DEBUG_MODE
 	    makeMenuItem_(LangMap::MAIN_MENU_FILE_DEBUGSTATS, [](Fl_Widget*, void*)
 	{ c::main::printDebugInfo(); }),
@@ -28,6 +28,7 @@
 #include "core/const.h"
 #include "glue/layout.h"
 #include "glue/main.h"
+#include "gui/elems/basics/box.h"
 #include "gui/elems/basics/choice.h"
 #include "gui/elems/basics/imageButton.h"
 #include "gui/elems/basics/textButton.h"
@@ -48,6 +49,8 @@ geMainTimer::geMainTimer()
 	m_quantizer  = new geChoice();
 	m_multiplier = new geImageButton(graphics::multiplyOff, graphics::multiplyOn);
 	m_divider    = new geImageButton(graphics::divideOff, graphics::divideOn);
+	m_dspLoad    = new geBox("", FL_ALIGN_RIGHT | FL_ALIGN_INSIDE);
+	addWidget(m_dspLoad, 60);
 	addWidget(m_quantizer, 60);
 	addWidget(m_bpm, 60);
 	addWidget(m_meter, 60);
@@ -60,6 +63,7 @@ geMainTimer::geMainTimer()
 	m_quantizer->copy_tooltip(g_ui->getI18Text(LangMap::MAIN_TIMER_LABEL_QUANTIZER));
 	m_multiplier->copy_tooltip(g_ui->getI18Text(LangMap::MAIN_TIMER_LABEL_MULTIPLIER));
 	m_divider->copy_tooltip(g_ui->getI18Text(LangMap::MAIN_TIMER_LABEL_DIVIDER));
+	m_dspLoad->copy_tooltip(g_ui->getI18Text(LangMap::MAIN_TIMER_LABEL_DSPLOAD));
 
 	m_bpm->onClick = [&timer = m_timer]()
 	{ c::layout::openBpmWindow(timer.bpm); };
@@ -88,6 +92,8 @@ void geMainTimer::refresh()
 {
 	m_timer = c::main::getTimer();
 
+	m_dspLoad->copy_label(fmt::format("DSP {:.0f}%", m_timer.dspLoad * 100).c_str());
+
 	if (m_timer.isRecordingInput)
 	{
 		m_bpm->deactivate();
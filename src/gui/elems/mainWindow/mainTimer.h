@@ -34,6 +34,7 @@ namespace giada::v
 {
 class geImageButton;
 class geTextButton;
+class geBox;
 class geChoice;
 class geMainTimer : public geFlex
 {
@@ -61,6 +62,7 @@ private:
 	geChoice*      m_quantizer;
 	geImageButton* m_multiplier;
 	geImageButton* m_divider;
+	geBox*         m_dspLoad;
 };
 } // namespace giada::v
 
@@ -29,6 +29,7 @@
 #include "gui/dialogs/pluginList.h"
 #include "gui/dialogs/pluginWindow.h"
 #include "gui/dialogs/pluginWindowGUI.h"
+#include "gui/elems/basics/box.h"
 #include "gui/elems/basics/choice.h"
 #include "gui/elems/basics/imageButton.h"
 #include "gui/elems/basics/pack.h"
@@ -38,6 +39,7 @@
 #include "utils/gui.h"
 #include "utils/log.h"
 #include <cassert>
+#include <fmt/core.h>
 #include <string>
 
 extern giada::v::Ui* g_ui;
@@ -50,18 +52,22 @@ gePluginElement::gePluginElement(int x, int y, int w, int h, c::plugin::Plugin d
 {
 	button       = new geTextButton("");
 	program      = new geChoice();
+	cpuLoad      = new geBox("", FL_ALIGN_RIGHT | FL_ALIGN_INSIDE);
 	bypass       = new geTextButton("");
 	shiftUpBtn   = new geImageButton(graphics::upOff, graphics::upOn);
 	shiftDownBtn = new geImageButton(graphics::downOff, graphics::downOn);
 	remove       = new geImageButton(graphics::removeOff, graphics::removeOn);
 	addWidget(button);
 	addWidget(program);
+	addWidget(cpuLoad, 40);
 	addWidget(bypass, G_GUI_UNIT);
 	addWidget(shiftUpBtn, G_GUI_UNIT);
 	addWidget(shiftDownBtn, G_GUI_UNIT);
 	addWidget(remove, G_GUI_UNIT);
 	end();
 
+	cpuLoad->copy_tooltip(g_ui->getI18Text(LangMap::PLUGINLIST_CPULOAD));
+
 	remove->onClick = [this]()
 	{ removePlugin(); };
 
@@ -123,6 +129,15 @@ const m::Plugin& gePluginElement::getPluginRef() const
 
 /* -------------------------------------------------------------------------- */
 
+void gePluginElement::refresh()
+{
+	if (!m_plugin.valid)
+		return;
+	cpuLoad->copy_label(fmt::format("{:.1f}%", c::plugin::getCpuLoad(m_plugin.id) * 100).c_str());
+}
+
+/* -------------------------------------------------------------------------- */
+
 void gePluginElement::shiftUp()
 {
 	const gdPluginList* parent = static_cast<const gdPluginList*>(window());
@@ -33,6 +33,7 @@
 
 namespace giada::v
 {
+class geBox;
 class geChoice;
 class geTextButton;
 class geImageButton;
@@ -44,8 +45,14 @@ public:
 	ID               getPluginId() const;
 	const m::Plugin& getPluginRef() const;
 
+	/* refresh
+	Updates the CPU load indicator. */
+
+	void refresh();
+
 	geTextButton*  button;
 	geChoice*      program;
+	geBox*         cpuLoad;
 	geTextButton*  bypass;
 	geImageButton* shiftUpBtn;
 	geImageButton* shiftDownBtn;
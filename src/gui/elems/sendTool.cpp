@@ -0,0 +1,80 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "src/gui/elems/sendTool.h"
+#include "glue/channel.h"
+#include "gui/elems/basics/dial.h"
+#include "gui/elems/basics/input.h"
+#include "gui/elems/basics/textButton.h"
+#include "gui/ui.h"
+#include "utils/math.h"
+#include <fmt/core.h>
+
+extern giada::v::Ui* g_ui;
+
+namespace giada::v
+{
+geSendTool::geSendTool(ID channelId, ID returnId, const std::string& returnName, float level, int labelWidth)
+: geFlex(Direction::HORIZONTAL, G_GUI_INNER_MARGIN)
+, m_channelId(channelId)
+, m_returnId(returnId)
+{
+	m_input = new geInput(returnName.c_str(), labelWidth);
+	m_dial  = new geDial();
+	m_reset = new geTextButton(g_ui->getI18Text(LangMap::COMMON_RESET));
+	addWidget(m_input);
+	addWidget(m_dial, G_GUI_UNIT);
+	addWidget(m_reset, 70);
+	end();
+
+	m_dial->range(0.0f, 1.0f);
+	m_dial->onChange = [this](float val)
+	{
+		c::channel::setSend(m_channelId, m_returnId, val);
+		update(val);
+	};
+
+	m_input->setReadonly(true);
+	m_input->setCursorColor(FL_WHITE);
+
+	m_reset->onClick = [this]()
+	{
+		c::channel::setSend(m_channelId, m_returnId, 0.0f);
+		update(0.0f);
+	};
+
+	update(level);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void geSendTool::update(float level)
+{
+	const float dB = u::math::linearToDB(level);
+	m_dial->value(level);
+	m_input->setValue(dB > -INFINITY ? fmt::format("{:.2f}", dB) : "-inf");
+}
+} // namespace giada::v
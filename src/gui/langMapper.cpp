@@ -66,6 +66,14 @@ LangMap::LangMap()
 	m_data[MESSAGE_MAIN_CLEARALLVOLUMEACTIONS]    = "Clear all volume actions: are you sure?";
 	m_data[MESSAGE_MAIN_CLEARALLSTARTSTOPACTIONS] = "Clear all start/stop actions: are you sure?";
 	m_data[MESSAGE_MAIN_CLOSEPROJECT]             = "Close project: are you sure?";
+	m_data[MESSAGE_MAIN_PERFREPORTSAVED]          = "Performance report saved to";
+	m_data[MESSAGE_MAIN_PERFREPORTERROR]          = "Unable to save the performance report.";
+	m_data[MESSAGE_MAIN_TIMELINESAVED]            = "Timeline saved to";
+	m_data[MESSAGE_MAIN_TIMELINEERROR]            = "Unable to save the timeline.";
+	m_data[MESSAGE_MAIN_SESSIONSAVED]             = "Session capture saved to";
+	m_data[MESSAGE_MAIN_SESSIONERROR]             = "Unable to capture the session.";
+	m_data[MESSAGE_MAIN_SESSIONREPLAYED]          = "Session replay rendered to";
+	m_data[MESSAGE_MAIN_SESSIONREPLAYERROR]       = "Unable to replay the session. Make sure audio settings match the capture.";
 
 	m_data[MESSAGE_INIT_WRONGSYSTEM] = "Your soundcard isn't configured correctly!";
 	m_data[MESSAGE_INIT_QUITGIADA]   = "Quit Giada: are you sure?";
@@ -78,6 +86,8 @@ LangMap::LangMap()
 	m_data[MESSAGE_CHANNEL_LOADINGSAMPLESERROR]   = "Some files weren't loaded successfully.";
 	m_data[MESSAGE_CHANNEL_DELETE]                = "Delete channel: are you sure?";
 	m_data[MESSAGE_CHANNEL_FREE]                  = "Free channel: are you sure?";
+	m_data[MESSAGE_CHANNEL_FREEZE]                = "Freeze column: audio output stops while rendering. Continue?";
+	m_data[MESSAGE_CHANNEL_FREEZINGTRACK]         = "Freezing column...";
 
 	m_data[MESSAGE_STORAGE_PATCHUNREADABLE]     = "This patch is unreadable.";
 	m_data[MESSAGE_STORAGE_PATCHINVALID]        = "This patch is not valid.";
@@ -97,6 +107,10 @@ LangMap::LangMap()
 	m_data[MAIN_MENU_FILE_SAVEPROJECT]     = "Save project...";
 	m_data[MAIN_MENU_FILE_CLOSEPROJECT]    = "Close project";
 	m_data[MAIN_MENU_FILE_DEBUGSTATS]      = "Debug stats";
+	m_data[MAIN_MENU_FILE_PERFREPORT]      = "Save performance report";
+	m_data[MAIN_MENU_FILE_TIMELINE]        = "Start/stop timeline capture";
+	m_data[MAIN_MENU_FILE_SESSIONCAPTURE]  = "Start/stop session capture";
+	m_data[MAIN_MENU_FILE_SESSIONREPLAY]   = "Replay last session capture";
 	m_data[MAIN_MENU_FILE_QUIT]            = "Quit Giada";
 	m_data[MAIN_MENU_EDIT]                 = "Edit";
 	m_data[MAIN_MENU_EDIT_FREEALLSAMPLES]  = "Free all Sample channels";
@@ -122,6 +136,7 @@ LangMap::LangMap()
 	m_data[MAIN_TIMER_LABEL_QUANTIZER]  = "Live quantizer";
 	m_data[MAIN_TIMER_LABEL_MULTIPLIER] = "Beat multiplier";
 	m_data[MAIN_TIMER_LABEL_DIVIDER]    = "Beat divider";
+	m_data[MAIN_TIMER_LABEL_DSPLOAD]    = "Audio engine load";
 
 	m_data[MAIN_SEQUENCER_LABEL] = "Main sequencer";
 
@@ -141,6 +156,8 @@ LangMap::LangMap()
 	m_data[MAIN_TRACK_BUTTON_ADDMIDICHANNEL]   = "Add MIDI channel";
 	m_data[MAIN_TRACK_BUTTON_REMOVE_TRACK]     = "Remove column";
 	m_data[MAIN_TRACK_BUTTON_ADD_TRACK]        = "Add column";
+	m_data[MAIN_TRACK_BUTTON_FREEZE_TRACK]     = "Freeze column";
+	m_data[MAIN_TRACK_BUTTON_UNFREEZE_TRACK]   = "Unfreeze column";
 
 	m_data[MAIN_CHANNEL_NOSAMPLE]                  = "-- no sample --";
 	m_data[MAIN_CHANNEL_DEFAULTGROUPNAME]          = "-- group --";
@@ -195,6 +212,7 @@ LangMap::LangMap()
 	m_data[PLUGINLIST_TITLE_CHANNEL]   = "Channel Plug-ins";
 	m_data[PLUGINLIST_ADDPLUGIN]       = "-- add new plugin --";
 	m_data[PLUGINLIST_NOPROGRAMS]      = "-- no programs --";
+	m_data[PLUGINLIST_CPULOAD]         = "CPU load";
 
 	m_data[CHANNELNAME_TITLE] = "New channel name";
 
@@ -349,7 +367,9 @@ LangMap::LangMap()
 	m_data[CONFIG_PLUGINS_SCAN]        = "Scan ({} found)";
 	m_data[CONFIG_PLUGINS_INVALIDPATH] = "Invalid path.";
 
-	m_data[CHANNELROUTING_TITLE] = "Channel Routing";
+	m_data[CHANNELROUTING_TITLE]  = "Channel Routing";
+	m_data[CHANNELROUTING_SENDS]  = "Sends";
+	m_data[CHANNELROUTING_COLUMN] = "Column {}";
 }
 
 const char* LangMap::get(const std::string& key) const
@@ -71,6 +71,14 @@ public:
 	static constexpr auto MESSAGE_MAIN_CLEARALLVOLUMEACTIONS    = "message_main_clearAllVolumeActions";
 	static constexpr auto MESSAGE_MAIN_CLEARALLSTARTSTOPACTIONS = "message_main_clearAllStartStopActions";
 	static constexpr auto MESSAGE_MAIN_CLOSEPROJECT             = "message_main_closeProject";
+	static constexpr auto MESSAGE_MAIN_PERFREPORTSAVED          = "message_main_perfReportSaved";
+	static constexpr auto MESSAGE_MAIN_PERFREPORTERROR          = "message_main_perfReportError";
+	static constexpr auto MESSAGE_MAIN_TIMELINESAVED            = "message_main_timelineSaved";
+	static constexpr auto MESSAGE_MAIN_TIMELINEERROR            = "message_main_timelineError";
+	static constexpr auto MESSAGE_MAIN_SESSIONSAVED             = "message_main_sessionSaved";
+	static constexpr auto MESSAGE_MAIN_SESSIONERROR             = "message_main_sessionError";
+	static constexpr auto MESSAGE_MAIN_SESSIONREPLAYED          = "message_main_sessionReplayed";
+	static constexpr auto MESSAGE_MAIN_SESSIONREPLAYERROR       = "message_main_sessionReplayError";
 
 	static constexpr auto MESSAGE_INIT_WRONGSYSTEM = "message_init_wrongSystem";
 	static constexpr auto MESSAGE_INIT_QUITGIADA   = "message_init_quitGiada";
@@ -83,6 +91,8 @@ public:
 	static constexpr auto MESSAGE_CHANNEL_LOADINGSAMPLESERROR   = "message_channel_loadingSamplesError";
 	static constexpr auto MESSAGE_CHANNEL_DELETE                = "message_channel_delete";
 	static constexpr auto MESSAGE_CHANNEL_FREE                  = "message_channel_free";
+	static constexpr auto MESSAGE_CHANNEL_FREEZE                = "message_channel_freeze";
+	static constexpr auto MESSAGE_CHANNEL_FREEZINGTRACK         = "message_channel_freezingTrack";
 
 	static constexpr auto MESSAGE_STORAGE_PATCHUNREADABLE     = "message_storage_patchUnreadable";
 	static constexpr auto MESSAGE_STORAGE_PATCHINVALID        = "message_storage_patchInvalid";
@@ -102,6 +112,10 @@ public:
 	static constexpr auto MAIN_MENU_FILE_SAVEPROJECT     = "main_menu_file_saveProject";
 	static constexpr auto MAIN_MENU_FILE_CLOSEPROJECT    = "main_menu_file_closeProject";
 	static constexpr auto MAIN_MENU_FILE_DEBUGSTATS      = "main_menu_file_debugStats";
+	static constexpr auto MAIN_MENU_FILE_PERFREPORT      = "main_menu_file_perfReport";
+	static constexpr auto MAIN_MENU_FILE_TIMELINE        = "main_menu_file_timeline";
+	static constexpr auto MAIN_MENU_FILE_SESSIONCAPTURE  = "main_menu_file_sessionCapture";
+	static constexpr auto MAIN_MENU_FILE_SESSIONREPLAY   = "main_menu_file_sessionReplay";
 	static constexpr auto MAIN_MENU_FILE_QUIT            = "main_menu_file_quit";
 	static constexpr auto MAIN_MENU_EDIT                 = "main_menu_edit";
 	static constexpr auto MAIN_MENU_EDIT_FREEALLSAMPLES  = "main_menu_edit_freeAllSamples";
@@ -126,6 +140,7 @@ public:
 	static constexpr auto MAIN_TIMER_LABEL_QUANTIZER  = "main_mainTimer_label_quantizer";
 	static constexpr auto MAIN_TIMER_LABEL_MULTIPLIER = "main_mainTimer_label_multiplier";
 	static constexpr auto MAIN_TIMER_LABEL_DIVIDER    = "main_mainTimer_label_divider";
+	static constexpr auto MAIN_TIMER_LABEL_DSPLOAD    = "main_mainTimer_label_dspLoad";
 
 	static constexpr auto MAIN_SEQUENCER_LABEL = "main_sequencer_label";
 
@@ -143,6 +158,8 @@ public:
 	static constexpr auto MAIN_TRACK_BUTTON_ADDMIDICHANNEL   = "main_track_button_addMidiChannel";
 	static constexpr auto MAIN_TRACK_BUTTON_REMOVE_TRACK     = "main_track_button_removeTrack";
 	static constexpr auto MAIN_TRACK_BUTTON_ADD_TRACK        = "main_track_button_addTrack";
+	static constexpr auto MAIN_TRACK_BUTTON_FREEZE_TRACK     = "main_track_button_freezeTrack";
+	static constexpr auto MAIN_TRACK_BUTTON_UNFREEZE_TRACK   = "main_track_button_unfreezeTrack";
 
 	static constexpr auto MAIN_CHANNEL_NOSAMPLE                  = "main_channel_noSample";
 	static constexpr auto MAIN_CHANNEL_DEFAULTGROUPNAME          = "main_channel_defaultGroupName";
@@ -195,6 +212,7 @@ public:
 	static constexpr auto PLUGINLIST_TITLE_CHANNEL   = "pluginList_title_channel";
 	static constexpr auto PLUGINLIST_ADDPLUGIN       = "pluginList_addPlugin";
 	static constexpr auto PLUGINLIST_NOPROGRAMS      = "pluginList_noPrograms";
+	static constexpr auto PLUGINLIST_CPULOAD         = "pluginList_cpuLoad";
 
 	static constexpr auto CHANNELNAME_TITLE = "channelName_title";
 
@@ -343,7 +361,9 @@ public:
 	static constexpr auto CONFIG_PLUGINS_SCAN        = "config_plugins_scan";
 	static constexpr auto CONFIG_PLUGINS_INVALIDPATH = "config_plugins_invalidPath";
 
-	static constexpr auto CHANNELROUTING_TITLE = "channelRouting_title";
+	static constexpr auto CHANNELROUTING_TITLE  = "channelRouting_title";
+	static constexpr auto CHANNELROUTING_SENDS  = "channelRouting_sends";
+	static constexpr auto CHANNELROUTING_COLUMN = "channelRouting_column";
 
 	LangMap();
 
@@ -193,10 +193,12 @@ void Ui::refresh()
 
 	m_blinker = (m_blinker + 1) % BLINK_RATE;
 
-	/* Refresh Sample Editor and Action Editor for dynamic playhead. */
+	/* Refresh Sample Editor and Action Editor for dynamic playhead, plug-in
+	list for CPU load. */
 
 	refreshSubWindow(WID_SAMPLE_EDITOR);
 	refreshSubWindow(WID_ACTION_EDITOR);
+	refreshSubWindow(WID_FX_LIST);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -29,6 +29,7 @@
 #include "core/model/model.h"
 #include "gui/ui.h"
 #include "utils/gui.h"
+#include "utils/trace.h"
 
 namespace giada::v
 {
@@ -64,6 +65,8 @@ void Updater::update(void* p) { static_cast<Updater*>(p)->update(); }
 
 void Updater::update()
 {
+	G_TRACE("ui update");
+
 	m_ui.refresh();
 	Fl::add_timeout(G_GUI_REFRESH_RATE, update, this); // Repeat
 }
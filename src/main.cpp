@@ -36,6 +36,8 @@ int main(int argc, char** argv)
 
 	if (int ret = m::init::tests(argc, argv); ret != -1)
 		return ret;
+	if (int ret = m::init::pluginScanner(argc, argv); ret != -1)
+		return ret;
 
 	auto enginePtr = std::make_unique<m::Engine>();
 	auto uiPtr     = std::make_unique<v::Ui>();
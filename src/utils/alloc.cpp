@@ -0,0 +1,260 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "utils/alloc.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#ifdef G_OS_WINDOWS
+#include <malloc.h>
+#endif
+
+namespace giada::u::alloc
+{
+namespace
+{
+thread_local bool        armed_      = false;
+std::atomic<std::size_t> violations_ = 0;
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Trap::Trap(bool armed)
+: m_previous(armed_)
+{
+	armed_ = armed;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Trap::~Trap()
+{
+	armed_ = m_previous;
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::size_t getViolations()
+{
+	return violations_.load();
+}
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef G_DEBUG_MODE
+
+namespace detail
+{
+/* onAllocation
+Called by the global operator new replacements below. Set a breakpoint here to find out
+who is allocating. */
+
+void onAllocation()
+{
+	if (armed_)
+		violations_.fetch_add(1, std::memory_order_relaxed);
+}
+} // namespace detail
+
+#endif
+} // namespace giada::u::alloc
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+#ifdef G_DEBUG_MODE
+
+/* Replacements for the global allocation functions. Every form is replaced,
+aligned and nothrow ones included: the standard library is not required to
+implement them on top of the plain operator new, so leaving any of them out
+would let allocations slip past the trap. */
+
+namespace
+{
+void* allocate_(std::size_t size, std::size_t alignment)
+{
+	giada::u::alloc::detail::onAllocation();
+
+	if (size == 0)
+		size = 1;
+	while (true)
+	{
+		void* p = nullptr;
+		if (alignment <= alignof(std::max_align_t))
+			p = std::malloc(size);
+		else
+#ifdef G_OS_WINDOWS
+			p = _aligned_malloc(size, alignment);
+#else
+			/* std::aligned_alloc wants a size multiple of the alignment. */
+			p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+		if (p != nullptr)
+			return p;
+		std::new_handler handler = std::get_new_handler();
+		if (handler == nullptr)
+			throw std::bad_alloc();
+		handler();
+	}
+}
+
+void deallocate_(void* p, std::size_t alignment) noexcept
+{
+#ifdef G_OS_WINDOWS
+	if (alignment > alignof(std::max_align_t))
+	{
+		_aligned_free(p);
+		return;
+	}
+#else
+	(void)alignment;
+#endif
+	std::free(p);
+}
+
+template <typename F>
+void* allocateNoThrow_(F f) noexcept
+{
+	try
+	{
+		return f();
+	}
+	catch (const std::bad_alloc&)
+	{
+		return nullptr;
+	}
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+
+void* operator new(std::size_t size)
+{
+	return allocate_(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size)
+{
+	return allocate_(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t al)
+{
+	return allocate_(size, static_cast<std::size_t>(al));
+}
+
+void* operator new[](std::size_t size, std::align_val_t al)
+{
+	return allocate_(size, static_cast<std::size_t>(al));
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	return allocateNoThrow_([size] { return ::operator new(size); });
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+	return allocateNoThrow_([size] { return ::operator new[](size); });
+}
+
+void* operator new(std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept
+{
+	return allocateNoThrow_([size, al] { return ::operator new(size, al); });
+}
+
+void* operator new[](std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept
+{
+	return allocateNoThrow_([size, al] { return ::operator new[](size, al); });
+}
+
+/* -------------------------------------------------------------------------- */
+
+void operator delete(void* p) noexcept
+{
+	deallocate_(p, alignof(std::max_align_t));
+}
+
+void operator delete[](void* p) noexcept
+{
+	deallocate_(p, alignof(std::max_align_t));
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	deallocate_(p, alignof(std::max_align_t));
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+	deallocate_(p, alignof(std::max_align_t));
+}
+
+void operator delete(void* p, std::align_val_t al) noexcept
+{
+	deallocate_(p, static_cast<std::size_t>(al));
+}
+
+void operator delete[](void* p, std::align_val_t al) noexcept
+{
+	deallocate_(p, static_cast<std::size_t>(al));
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t al) noexcept
+{
+	deallocate_(p, static_cast<std::size_t>(al));
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t al) noexcept
+{
+	deallocate_(p, static_cast<std::size_t>(al));
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+	deallocate_(p, alignof(std::max_align_t));
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+	deallocate_(p, alignof(std::max_align_t));
+}
+
+void operator delete(void* p, std::align_val_t al, const std::nothrow_t&) noexcept
+{
+	deallocate_(p, static_cast<std::size_t>(al));
+}
+
+void operator delete[](void* p, std::align_val_t al, const std::nothrow_t&) noexcept
+{
+	deallocate_(p, static_cast<std::size_t>(al));
+}
+
+#endif
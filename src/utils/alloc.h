@@ -0,0 +1,85 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_UTILS_ALLOC_H
+#define G_UTILS_ALLOC_H
+
+#include "core/const.h"
+#include <cstddef>
+
+#define G_ALLOC_CONCAT_(a, b) a##b
+#define G_ALLOC_ID_(line) G_ALLOC_CONCAT_(allocScope_, line)
+
+/* G_ALLOC_TRAP
+Arms the allocation trap for the enclosing scope: any heap allocation made by
+the calling thread in the meantime is counted as a violation. Debug mode only,
+it compiles to nothing in release builds. */
+
+/* G_ALLOC_ALLOW
+Disarms the allocation trap for the enclosing scope. Use this around code that
+is known to allocate and can't be fixed, e.g. third-party plug-ins. */
+
+#ifdef G_DEBUG_MODE
+#define G_ALLOC_TRAP() const giada::u::alloc::Trap G_ALLOC_ID_(__LINE__)(/*armed=*/true)
+#define G_ALLOC_ALLOW() const giada::u::alloc::Trap G_ALLOC_ID_(__LINE__)(/*armed=*/false)
+#else
+#define G_ALLOC_TRAP() \
+	do                 \
+	{                  \
+	} while (0)
+#define G_ALLOC_ALLOW() \
+	do                  \
+	{                   \
+	} while (0)
+#endif
+
+namespace giada::u::alloc
+{
+/* Trap
+Arms (or disarms) the allocation trap on the calling thread for its own
+lifetime. Traps can be nested: the innermost one wins. */
+
+class Trap
+{
+public:
+	Trap(bool armed);
+	~Trap();
+
+	Trap(const Trap&)            = delete;
+	Trap& operator=(const Trap&) = delete;
+
+private:
+	bool m_previous;
+};
+
+/* getViolations
+Returns the number of allocations caught by the trap so far, across all
+threads. Always 0 in release builds. */
+
+std::size_t getViolations();
+} // namespace giada::u::alloc
+
+#endif
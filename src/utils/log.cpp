@@ -27,11 +27,150 @@
  * -------------------------------------------------------------------------- */
 
 #include "log.h"
+#include "deps/concurrentqueue/concurrentqueue.h"
+#include <atomic>
+#include <chrono>
 #include <cstdio>
+#include <fmt/args.h>
+#include <iostream>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 
 namespace giada::u::log
 {
+namespace
+{
+/* RING_SIZE
+Number of preallocated records in the realtime ring. */
+
+constexpr std::size_t RING_SIZE = 512;
+
+/* FLUSH_RATE
+How often the background thread drains the realtime ring. */
+
+constexpr auto FLUSH_RATE = std::chrono::milliseconds(20);
+
+moodycamel::ConcurrentQueue<detail::Record> ring_(RING_SIZE, /*max_explicit_producers=*/8, /*max_implicit_producers=*/0);
+std::atomic<uint64_t>                       dropped_ = 0;
+std::atomic<bool>                           running_ = false;
+std::thread                                 worker_;
+std::mutex                                  mutex_; // Guards the output
+thread_local bool                           isRealtime_ = false;
+
+/* token_
+Producer token of the calling thread, created when it is registered as
+realtime: pushing into the ring with a token never allocates. */
+
+thread_local std::unique_ptr<moodycamel::ProducerToken> token_;
+
+/* -------------------------------------------------------------------------- */
+
+void flush_()
+{
+	detail::Record r;
+	while (ring_.try_dequeue(r))
+	{
+		if (r.file != nullptr)
+			detail::writeDebug(r.file, r.func, detail::format(r));
+		else if (mode != LOG_MODE_MUTE)
+			detail::write(detail::format(r));
+	}
+
+	if (const uint64_t dropped = dropped_.exchange(0); dropped > 0)
+		detail::write(fmt::format("[log] {} realtime messages dropped\n", dropped));
+}
+
+/* -------------------------------------------------------------------------- */
+
+void startWorker_()
+{
+	running_.store(true);
+	worker_ = std::thread([]()
+	{
+		while (running_.load())
+		{
+			std::this_thread::sleep_for(FLUSH_RATE);
+			flush_();
+		}
+	});
+}
+
+/* -------------------------------------------------------------------------- */
+
+void stopWorker_()
+{
+	running_.store(false);
+	if (worker_.joinable())
+		worker_.join();
+	flush_();
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+namespace detail
+{
+std::string format(const Record& r)
+{
+	fmt::dynamic_format_arg_store<fmt::format_context> store;
+	for (std::size_t i = 0; i < r.numArgs; i++)
+	{
+		std::visit([&store](const auto& arg)
+		{
+			if constexpr (std::is_same_v<std::decay_t<decltype(arg)>, FixedString>)
+				store.push_back(std::string(arg.data()));
+			else
+				store.push_back(arg);
+		},
+		    r.args[i]);
+	}
+
+	try
+	{
+		return fmt::vformat(r.format, store);
+	}
+	catch (const fmt::format_error& e)
+	{
+		return fmt::format("[log] unable to format '{}': {}\n", r.format, e.what());
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void push(const Record& r)
+{
+	if (token_ == nullptr || !ring_.try_enqueue(*token_, r))
+		dropped_.fetch_add(1, std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void write(const std::string& s)
+{
+	std::scoped_lock lock(mutex_);
+	if (mode == LOG_MODE_FILE && file.is_open())
+		fmt::print(file, "{}", s);
+	else
+		fmt::print("{}", s);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void writeDebug(const char* file, const char* func, const std::string& s)
+{
+	std::scoped_lock lock(mutex_);
+	std::cerr << file << "::" << func << "() - " << s << "\n";
+}
+} // namespace detail
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
 bool init(int m)
 {
 	mode = m;
@@ -42,6 +181,7 @@ bool init(int m)
 		if (!file.is_open())
 			return false;
 	}
+	startWorker_();
 	return true;
 }
 
@@ -49,7 +189,22 @@ bool init(int m)
 
 void close()
 {
+	stopWorker_();
 	if (mode == LOG_MODE_FILE)
 		file.close();
 }
+
+/* -------------------------------------------------------------------------- */
+
+void registerThread(bool isRealtime)
+{
+	isRealtime_ = isRealtime;
+	if (isRealtime_ && token_ == nullptr)
+		token_ = std::make_unique<moodycamel::ProducerToken>(ring_);
+}
+
+bool isRealtimeThread()
+{
+	return isRealtime_;
+}
 } // namespace giada::u::log
@@ -31,16 +31,20 @@
 
 #include "core/const.h"
 #include "utils/fs.h"
+#include <array>
+#include <cstdint>
 #include <fmt/core.h>
 #include <fmt/ostream.h>
 #include <fstream>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <utility>
+#include <variant>
 
 #ifdef G_DEBUG_MODE
 #define G_DEBUG(f, ...) \
-	std::cerr << __FILE__ << "::" << __func__ << "() - " << fmt::format(f __VA_OPT__(, ) __VA_ARGS__) << "\n";
+	giada::u::log::debug(__FILE__, __func__, f __VA_OPT__(, ) __VA_ARGS__);
 #else
 #define G_DEBUG(f, ...) \
 	do                  \
@@ -53,23 +57,130 @@ namespace giada::u::log
 inline std::ofstream file;
 inline int           mode;
 
+namespace detail
+{
+/* Record
+A log message captured on a realtime thread: the format string (which acts as
+a format-id, since it always points to a string literal) plus a fixed number
+of arguments stored by value. Strings and types without a binary
+representation are copied into a small inline buffer, truncated if needed. */
+
+constexpr std::size_t MAX_ARGS        = 8;
+constexpr std::size_t MAX_STRING_SIZE = 32;
+
+using FixedString = std::array<char, MAX_STRING_SIZE>;
+using Arg         = std::variant<int64_t, uint64_t, double, bool, FixedString>;
+
+struct Record
+{
+	const char*                   format  = nullptr;
+	const char*                   file    = nullptr; // Only for G_DEBUG messages
+	const char*                   func    = nullptr; // Only for G_DEBUG messages
+	std::size_t                   numArgs = 0;
+	std::array<Arg, MAX_ARGS> args    = {};
+};
+
+template <typename T>
+Arg makeArg(const T& v)
+{
+	using Type = std::decay_t<T>;
+
+	if constexpr (std::is_same_v<Type, bool>)
+		return v;
+	else if constexpr (std::is_integral_v<Type> && !std::is_same_v<Type, char> && std::is_signed_v<Type>)
+		return static_cast<int64_t>(v);
+	else if constexpr (std::is_integral_v<Type> && !std::is_same_v<Type, char>)
+		return static_cast<uint64_t>(v);
+	else if constexpr (std::is_floating_point_v<Type>)
+		return static_cast<double>(v);
+	else
+	{
+		FixedString out = {};
+		if constexpr (std::is_same_v<Type, char>)
+			out[0] = v;
+		else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+			std::string_view(v).copy(out.data(), out.size() - 1);
+		else
+			fmt::format_to_n(out.data(), out.size() - 1, "{}", v);
+		return out;
+	}
+}
+
+template <typename... Args>
+Record makeRecord(const char* format, const char* file, const char* func, Args&&... args)
+{
+	static_assert(sizeof...(Args) <= MAX_ARGS, "Too many arguments for a realtime log message");
+
+	Record r;
+	r.format  = format;
+	r.file    = file;
+	r.func    = func;
+	r.numArgs = sizeof...(Args);
+
+	std::size_t i = 0;
+	((r.args[i++] = makeArg(args)), ...);
+
+	return r;
+}
+
+/* format
+Turns a Record into a string. Called by the background thread. */
+
+std::string format(const Record&);
+
+/* push
+Enqueues a Record into the realtime ring. Never blocks nor allocates: the
+message is dropped if the ring is full. */
+
+void push(const Record&);
+
+/* write, writeDebug
+Write a formatted message to the current output. Not realtime-safe. */
+
+void write(const std::string&);
+void writeDebug(const char* file, const char* func, const std::string&);
+} // namespace detail
+
 /* init
 Initializes logger. Mode defines where to write the output: LOG_MODE_STDOUT,
-LOG_MODE_FILE and LOG_MODE_MUTE. */
+LOG_MODE_FILE and LOG_MODE_MUTE. Also starts the background thread that
+flushes messages coming from realtime threads. */
 
 bool init(int mode);
 
 void close();
 
+/* registerThread
+Marks the calling thread as realtime or not. Messages printed from realtime
+threads don't touch the output directly: they are pushed into a lock-free
+ring and formatted later by the background thread. Not realtime-safe: call it
+before the thread starts its realtime work. */
+
+void registerThread(bool isRealtime);
+bool isRealtimeThread();
+
 template <typename... Args>
 static void print(const char* format, Args&&... args)
 {
 	if (mode == LOG_MODE_MUTE)
 		return;
-	if (mode == LOG_MODE_FILE && file.is_open())
-		fmt::print(file, fmt::runtime(format), args...);
+	if (isRealtimeThread())
+		detail::push(detail::makeRecord(format, nullptr, nullptr, args...));
+	else
+		detail::write(fmt::format(fmt::runtime(format), args...));
+}
+
+/* debug
+Backend for the G_DEBUG macro: same as print() but adds the source location
+and always writes to stderr. */
+
+template <typename... Args>
+static void debug(const char* file, const char* func, const char* format, Args&&... args)
+{
+	if (isRealtimeThread())
+		detail::push(detail::makeRecord(format, file, func, args...));
 	else
-		fmt::print(fmt::runtime(format), args...);
+		detail::writeDebug(file, func, fmt::format(fmt::runtime(format), args...));
 }
 } // namespace giada::u::log
 
@@ -96,6 +96,8 @@ std::string toString(Thread t)
 		return "AUDIO (rt)";
 	case Thread::EVENTS:
 		return "EVENTS";
+	case Thread::RENDER_AHEAD:
+		return "RENDER_AHEAD";
 	default:
 		return "(unknown)";
 	}
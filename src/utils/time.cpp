@@ -27,7 +27,9 @@
  * -------------------------------------------------------------------------- */
 
 #include "time.h"
+#include "core/const.h"
 #include <chrono>
+#include <cstdint>
 #include <thread>
 
 namespace giada::u::time
@@ -50,4 +52,26 @@ int frameToBeat(Frame frame, int sampleRate, float bpm)
 {
 	return static_cast<int>(frame / (sampleRate * (60.0f / bpm)));
 }
+
+/* -------------------------------------------------------------------------- */
+
+Frame tickToFrame(Tick tick, int framesInBeat)
+{
+	/* Rounds down, the opposite of frameToTick() below. */
+
+	return static_cast<Frame>((static_cast<int64_t>(tick) * framesInBeat) / G_PPQ);
+}
+
+/* -------------------------------------------------------------------------- */
+
+Tick frameToTick(Frame frame, int framesInBeat)
+{
+	if (framesInBeat <= 0)
+		return 0;
+
+	/* Rounds up: the first tick that falls on or after 'frame'. */
+
+	const int64_t ticks = static_cast<int64_t>(frame) * G_PPQ;
+	return static_cast<Tick>((ticks + framesInBeat - 1) / framesInBeat);
+}
 } // namespace giada::u::time
@@ -44,6 +44,14 @@ Frame beatToFrame(int beat, int sampleRate, float bpm);
 Returns the beat a frame corresponds to. */
 
 int frameToBeat(Frame frame, int sampleRate, float bpm);
+
+/* tickToFrame, frameToTick
+Convert between musical ticks (G_PPQ per beat) and frames, given the number of
+frames in a beat. As long as a beat has no more than G_PPQ frames, converting a
+frame to tick and back yields the same frame. */
+
+Frame tickToFrame(Tick tick, int framesInBeat);
+Tick  frameToTick(Frame frame, int framesInBeat);
 } // namespace giada::u::time
 
 #endif
\ No newline at end of file
@@ -0,0 +1,294 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "utils/trace.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fmt/core.h>
+#include <fmt/ostream.h>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace giada::u::trace
+{
+namespace
+{
+struct Event
+{
+	const char* name;
+	long long   start; // Microseconds since capture start
+	long long   duration; // Negative for instant events
+};
+
+/* Buffer
+Append-only list of events owned by a single writer thread. The write index
+is published with release semantics so that save() can read a consistent
+prefix while the capture is still running. The writer empties its own buffer
+when it finds out that a new capture has started: 'generation' tells which
+capture the events belong to. */
+
+struct Buffer
+{
+	Buffer()
+	: events(MAX_EVENTS)
+	{
+	}
+
+	std::vector<Event> events;
+	std::atomic<int>   count      = 0;
+	std::atomic<int>   generation = -1;
+};
+
+using ThreadName = std::array<char, 32>;
+
+/* Registered threads, one slot each. Buffers are allocated only once a capture
+has been started, and never freed: a late writer from a previous capture can't
+end up writing into released memory. Writers read 'buffers_' only, everything
+else is guarded by 'mutex_'. */
+
+std::array<ThreadName, MAX_THREADS>              threadNames_ = {};
+std::array<std::unique_ptr<Buffer>, MAX_THREADS> storage_;
+std::array<std::atomic<Buffer*>, MAX_THREADS>    buffers_     = {};
+int                                              numThreads_  = 0;
+bool                                             started_     = false;
+std::mutex                                       mutex_;
+
+std::atomic<int>                            generation_ = 0;
+std::atomic<bool>                           enabled_    = false;
+std::atomic<std::chrono::steady_clock::rep> epoch_      = 0; // Capture start
+
+/* Per-thread state: the name the thread has been registered with, and its
+slot. */
+
+thread_local std::string threadName_;
+thread_local int         threadIndex_ = -1;
+
+/* -------------------------------------------------------------------------- */
+
+long long now_()
+{
+	const auto now   = std::chrono::steady_clock::now().time_since_epoch();
+	const auto epoch = std::chrono::steady_clock::duration(epoch_.load(std::memory_order_relaxed));
+	return std::chrono::duration_cast<std::chrono::microseconds>(now - epoch).count();
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* allocate_
+Allocates the buffer of the given slot, if not done yet. Call it with 'mutex_'
+held. */
+
+void allocate_(int index)
+{
+	if (storage_[index] != nullptr)
+		return;
+	storage_[index] = std::make_unique<Buffer>();
+	buffers_[index].store(storage_[index].get(), std::memory_order_release);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* getBuffer_
+Returns the buffer of the calling thread for the current capture. Returns
+nullptr if the thread is not registered, or there's no buffer yet. */
+
+Buffer* getBuffer_()
+{
+	if (threadIndex_ < 0)
+		return nullptr;
+
+	Buffer* buffer = buffers_[threadIndex_].load(std::memory_order_acquire);
+	if (buffer == nullptr)
+		return nullptr;
+
+	const int generation = generation_.load(std::memory_order_acquire);
+	if (buffer->generation.load(std::memory_order_relaxed) != generation)
+	{
+		buffer->count.store(0, std::memory_order_relaxed);
+		buffer->generation.store(generation, std::memory_order_release);
+	}
+	return buffer;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void record_(const char* name, long long start, long long duration)
+{
+	Buffer* buffer = getBuffer_();
+	if (buffer == nullptr)
+		return;
+
+	const int i = buffer->count.load(std::memory_order_relaxed);
+	if (i >= MAX_EVENTS)
+		return;
+	buffer->events[i] = {name, start, duration};
+	buffer->count.store(i + 1, std::memory_order_release);
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Scope::Scope(const char* name)
+: m_name(name)
+, m_start(enabled_.load(std::memory_order_relaxed) ? now_() : -1)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+Scope::~Scope()
+{
+	if (m_start < 0 || !enabled_.load(std::memory_order_relaxed))
+		return;
+	record_(m_name, m_start, now_() - m_start);
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+void registerThread(const std::string& name)
+{
+	if (threadIndex_ != -1 && threadName_ == name)
+		return;
+
+	std::scoped_lock lock(mutex_);
+
+	threadName_  = name;
+	threadIndex_ = -1;
+
+	/* Threads re-created with the same name (e.g. the audio thread when the
+	audio device is reopened) take their old slot back. */
+
+	ThreadName threadName = {};
+	name.copy(threadName.data(), threadName.size() - 1);
+
+	for (int i = 0; i < numThreads_; i++)
+		if (threadNames_[i] == threadName)
+			threadIndex_ = i;
+
+	if (threadIndex_ == -1)
+	{
+		if (numThreads_ == MAX_THREADS)
+			return;
+		threadIndex_               = numThreads_++;
+		threadNames_[threadIndex_] = threadName;
+	}
+
+	if (started_)
+		allocate_(threadIndex_);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void instant(const char* name)
+{
+	if (!enabled_.load(std::memory_order_relaxed))
+		return;
+	record_(name, now_(), -1);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void start()
+{
+	std::scoped_lock lock(mutex_);
+
+	enabled_.store(false);
+
+	started_ = true;
+	for (int i = 0; i < numThreads_; i++)
+		allocate_(i);
+
+	epoch_.store(std::chrono::steady_clock::now().time_since_epoch().count());
+	generation_.fetch_add(1, std::memory_order_release);
+	enabled_.store(true);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void stop()
+{
+	std::scoped_lock lock(mutex_);
+	enabled_.store(false);
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool isEnabled()
+{
+	return enabled_.load();
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool save(const std::string& path)
+{
+	std::scoped_lock lock(mutex_);
+
+	std::ofstream out(path);
+	if (!out.is_open())
+		return false;
+
+	fmt::print(out, "{{\"traceEvents\":[\n");
+
+	const int generation = generation_.load(std::memory_order_acquire);
+	bool      first      = true;
+	for (int tid = 0; tid < numThreads_; tid++)
+	{
+		/* Skip buffers not written since the current capture started: they
+		hold events from a previous one. */
+
+		const Buffer* buffer = storage_[tid].get();
+		if (buffer == nullptr || buffer->generation.load(std::memory_order_acquire) != generation)
+			continue;
+		const int count = buffer->count.load(std::memory_order_acquire);
+
+		fmt::print(out, "{}{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"{}\"}}}}",
+		    first ? "" : ",\n", tid, threadNames_[tid].data());
+		first = false;
+
+		for (int i = 0; i < count; i++)
+		{
+			const Event& e = buffer->events[i];
+			if (e.duration < 0)
+				fmt::print(out, ",\n{{\"name\":\"{}\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":{},\"ts\":{}}}",
+				    e.name, tid, e.start);
+			else
+				fmt::print(out, ",\n{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{},\"dur\":{}}}",
+				    e.name, tid, e.start, e.duration);
+		}
+	}
+
+	fmt::print(out, "\n]}}\n");
+	return out.good();
+}
+} // namespace giada::u::trace
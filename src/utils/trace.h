@@ -0,0 +1,102 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_UTILS_TRACE_H
+#define G_UTILS_TRACE_H
+
+#include <string>
+
+#define G_TRACE_CONCAT_(a, b) a##b
+#define G_TRACE_ID_(line) G_TRACE_CONCAT_(traceScope_, line)
+
+/* G_TRACE
+Marks the enclosing scope as a slice in the timeline. 'name' must be a string
+literal. Costs a relaxed atomic load when tracing is disabled. */
+
+#define G_TRACE(name) const giada::u::trace::Scope G_TRACE_ID_(__LINE__)(name)
+
+namespace giada::u::trace
+{
+/* MAX_THREADS
+Maximum number of threads that can write into the timeline. */
+
+constexpr int MAX_THREADS = 16;
+
+/* MAX_EVENTS
+Capacity of each per-thread buffer. Events beyond this limit are dropped until
+the next capture starts. */
+
+constexpr int MAX_EVENTS = 1 << 17;
+
+/* Scope
+Records a complete event spanning its own lifetime. Realtime-safe: writes go
+into a preallocated per-thread buffer without locks. Only threads registered
+with registerThread() are recorded. */
+
+class Scope
+{
+public:
+	Scope(const char* name);
+	~Scope();
+
+	Scope(const Scope&)            = delete;
+	Scope& operator=(const Scope&) = delete;
+
+private:
+	const char* m_name;
+	long long   m_start;
+};
+
+/* registerThread
+Gives a name to the calling thread, used as track label in the exported
+timeline, and lets it write into the timeline. Threads with the same name share
+the same buffer: only one of them may be alive at any given time. Cheap to call
+repeatedly with the same name. Not realtime-safe otherwise. */
+
+void registerThread(const std::string& name);
+
+/* instant
+Records a zero-duration event. 'name' must be a string literal. */
+
+void instant(const char* name);
+
+/* start, stop
+Begin or end a capture. Starting a new capture discards the previous one.
+Buffers of registered threads are allocated on the first start(), so call
+these from a non-realtime thread. */
+
+void start();
+void stop();
+bool isEnabled();
+
+/* save
+Writes the current capture to file in Chrome trace format (JSON), readable by
+chrome://tracing and Perfetto. Returns false on failure. */
+
+bool save(const std::string& path);
+} // namespace giada::u::trace
+
+#endif
@@ -6,6 +6,7 @@
 #include "src/core/model/model.h"
 #include "src/core/types.h"
 #include <catch2/catch.hpp>
+#include <thread>
 
 TEST_CASE("ActionRecorder")
 {
@@ -23,6 +24,7 @@ TEST_CASE("ActionRecorder")
 	channelFactory::Data channel1 = channelFactory::create(channelID1, ChannelType::SAMPLE, 1024, Resampler::Quality::LINEAR, false);
 	channelFactory::Data channel2 = channelFactory::create(channelID2, ChannelType::SAMPLE, 1024, Resampler::Quality::LINEAR, false);
 
+	model.get().sequencer.framesInBeat = 22050; // 120 BPM at 44100 Hz
 	model.get().tracks.add(0, false);
 	model.get().tracks.get(0).getChannels().getAll() = {channel1.channel, channel2.channel};
 	model.addChannelShared(std::move(channel1.shared));
@@ -61,10 +63,19 @@ TEST_CASE("ActionRecorder")
 			ar.rec(channelID2, f1, e1);
 			ar.rec(channelID2, f2, e2);
 
+			const model::Actions::ChannelMap& index = model.get().actions.getChannelActions();
+
+			REQUIRE(index.size() == 2);
+			REQUIRE(index.at(channelID1).size() == 2);
+			REQUIRE(index.at(channelID2).size() == 2);
+			for (const Action* a : index.at(channelID2))
+				REQUIRE(a->channelId == channelID2);
+
 			ar.clearChannel(channelID1);
 
 			REQUIRE(ar.hasActions(channelID1) == false);
 			REQUIRE(ar.hasActions(channelID2) == true);
+			REQUIRE(index.count(channelID1) == 0);
 		}
 
 		SECTION("Test clear actions by type")
@@ -80,5 +91,192 @@ TEST_CASE("ActionRecorder")
 			ar.clearAllActions();
 			REQUIRE(ar.hasActions(channelID1) == false);
 		}
+
+		SECTION("Test channel index of copies")
+		{
+			/* The channel index points into the actions map: a copy must point
+			into its own one. */
+
+			const model::Actions copy = model.get().actions;
+
+			REQUIRE(copy.findChannelActions(channelID1) != nullptr);
+			REQUIRE(copy.findChannelActions(channelID1)->size() == 2);
+			for (const Action* a : *copy.findChannelActions(channelID1))
+			{
+				REQUIRE(a == copy.findAction(a->id));
+				REQUIRE(a != model.get().actions.findAction(a->id));
+			}
+			REQUIRE(copy.findChannelActions(channelID2) == nullptr);
+		}
+	}
+
+	SECTION("Test live recording")
+	{
+		const MidiEvent on  = MidiEvent::makeFrom3Bytes(MidiEvent::CHANNEL_NOTE_ON, 0x40, 0x7F, 0);
+		const MidiEvent off = MidiEvent::makeFrom3Bytes(MidiEvent::CHANNEL_NOTE_OFF, 0x40, 0x00, 0);
+
+		/* Two input threads record in sequence, the second one on a channel
+		whose notes are recorded twice. */
+
+		std::thread([&]()
+		{
+			ar.liveRec(channelID1, on, 100);
+			ar.liveRec(channelID1, off, 200);
+		}).join();
+		std::thread([&]()
+		{
+			ar.liveRec(channelID2, on, 300);
+			ar.liveRec(channelID2, off, 400);
+			ar.liveRec(channelID2, on, 300);
+		}).join();
+
+		const std::unordered_set<ID> channels = ar.consolidate();
+
+		REQUIRE(channels == std::unordered_set<ID>{channelID1, channelID2});
+		REQUIRE(ar.getActionsOnChannel(channelID1).size() == 2);
+		REQUIRE(ar.getActionsOnChannel(channelID2).size() == 2); // Duplicate skipped
+
+		const std::vector<Action> actions = ar.getActionsOnChannel(channelID1);
+		REQUIRE(actions[0].frame == 100);
+		REQUIRE(actions[0].nextId == actions[1].id);
+		REQUIRE(actions[1].frame == 200);
+		REQUIRE(actions[1].prevId == actions[0].id);
+
+		SECTION("Test consolidate again")
+		{
+			REQUIRE(ar.consolidate().empty());
+			REQUIRE(ar.getActionsOnChannel(channelID1).size() == 2);
+		}
+	}
+
+	SECTION("Test live recording from re-created threads")
+	{
+		/* A device reopened many times gets a new callback thread each time:
+		threads with a role share the same lane, so nothing is dropped. */
+
+		const std::size_t numThreads = LiveActionBuffer::MAX_LANES * 2;
+
+		for (std::size_t i = 0; i < numThreads; i++)
+		{
+			std::thread([&ar, i]()
+			{
+				LiveActionBuffer::registerThread(Thread::MIDI);
+				ar.liveRec(channelID1, MidiEvent::makeFrom3Bytes(MidiEvent::CHANNEL_NOTE_ON, 0x40, 0x7F, 0), static_cast<Frame>(i) * 100);
+			}).join();
+		}
+
+		ar.consolidate();
+
+		REQUIRE(ar.getActionsOnChannel(channelID1).size() == numThreads);
+	}
+
+	SECTION("Test live recording of plug-in parameters")
+	{
+		const ID pluginID = 10;
+
+		ar.liveRecPluginParam(channelID1, pluginID, /*paramIndex=*/0, 0.25f, 100);
+		ar.liveRecPluginParam(channelID1, pluginID, /*paramIndex=*/1, 0.25f, 100); // Same frame, other parameter
+		ar.liveRecPluginParam(channelID1, pluginID, /*paramIndex=*/0, 0.75f, 200);
+
+		REQUIRE(ar.consolidate() == std::unordered_set<ID>{channelID1});
+
+		const std::vector<Action> actions = ar.getActionsOnChannel(channelID1);
+
+		REQUIRE(actions.size() == 3);
+		for (const Action& a : actions)
+		{
+			REQUIRE(a.pluginId == pluginID);
+			REQUIRE(a.event.getStatus() == MidiEvent::CHANNEL_CC);
+			REQUIRE_FALSE(a.isVolumeEnvelope());
+		}
+		REQUIRE(actions[0].pluginParam == 0);
+		REQUIRE(actions[1].pluginParam == 1);
+		REQUIRE(actions[2].event.getVelocityFloat() == 0.75f);
+
+		SECTION("Test clone")
+		{
+			/* Automation follows the cloned plug-in. The other plug-in has not
+			been cloned: its automation is left behind. */
+
+			const ID clonedPluginID = 20;
+
+			ar.liveRecPluginParam(channelID1, /*pluginId=*/11, /*paramIndex=*/0, 0.5f, 300);
+			ar.consolidate();
+
+			REQUIRE(ar.cloneActions(channelID1, channelID2, {{pluginID, clonedPluginID}}));
+
+			const std::vector<Action> clones = ar.getActionsOnChannel(channelID2);
+
+			REQUIRE(clones.size() == 3);
+			for (const Action& a : clones)
+				REQUIRE(a.pluginId == clonedPluginID);
+			REQUIRE(ar.getActionsOnChannel(channelID1).size() == 4);
+		}
+
+		SECTION("Test clear plug-in actions")
+		{
+			ar.rec(channelID1, 300, MidiEvent::makeFrom3Bytes(MidiEvent::CHANNEL_NOTE_ON, 0x00, 0x00, 0));
+			ar.clearPluginActions(channelID1, pluginID);
+
+			REQUIRE(ar.getActionsOnChannel(channelID1).size() == 1);
+			REQUIRE(ar.getActionsOnChannel(channelID1)[0].pluginId == -1);
+			REQUIRE(ar.hasActions(channelID1) == true);
+		}
+	}
+
+	SECTION("Test volume envelope")
+	{
+		const Frame lastFrameInLoop = 88199; // Four beats
+
+		ar.recordEnvelopeAction(channelID1, 22050, 0.5f, lastFrameInLoop);
+
+		const model::Actions::Envelope* envelope = model.get().actions.getVolumeEnvelope(channelID1);
+
+		REQUIRE(envelope != nullptr);
+		REQUIRE(envelope->size() == 3); // Boundaries added
+		REQUIRE(model::getEnvelopeValue(*envelope, 0) == 1.0f);
+		REQUIRE(model::getEnvelopeValue(*envelope, G_PPQ / 2) == Approx(0.75f));
+		REQUIRE(model::getEnvelopeValue(*envelope, G_PPQ) == 0.5f);
+
+		ar.recordEnvelopeAction(channelID1, 44100, 0.0f, lastFrameInLoop);
+
+		REQUIRE(model.get().actions.getVolumeEnvelope(channelID1)->size() == 4);
+		REQUIRE(model::getEnvelopeValue(*model.get().actions.getVolumeEnvelope(channelID1), G_PPQ * 2) == 0.0f);
+
+		SECTION("Test delete point")
+		{
+			const std::vector<Action> actions = ar.getActionsOnChannel(channelID1);
+
+			ar.deleteEnvelopeAction(channelID1, actions[1]);
+
+			envelope = model.get().actions.getVolumeEnvelope(channelID1);
+			REQUIRE(envelope->size() == 3);
+			REQUIRE(model::getEnvelopeValue(*envelope, G_PPQ) == Approx(0.5f)); // Halfway to the 0.0 point
+		}
+
+		SECTION("Test delete boundary")
+		{
+			ar.deleteEnvelopeAction(channelID1, ar.getActionsOnChannel(channelID1)[0]);
+
+			REQUIRE(model.get().actions.getVolumeEnvelope(channelID1) == nullptr);
+			REQUIRE(ar.hasActions(channelID1) == false);
+		}
+	}
+
+	SECTION("Test tempo change")
+	{
+		const MidiEvent e = MidiEvent::makeFrom3Bytes(MidiEvent::CHANNEL_NOTE_ON, 0x00, 0x00, 0);
+		const Action    a = ar.rec(channelID1, 11025, e);
+
+		REQUIRE(a.tick == G_PPQ / 2);
+
+		/* Doubling the tempo halves the frames in a beat: the action stays on
+		the same musical position. */
+
+		model.get().sequencer.framesInBeat = 11025;
+		model.swap(model::SwapType::NONE);
+
+		REQUIRE(ar.findAction(a.id).tick == G_PPQ / 2);
+		REQUIRE(ar.findAction(a.id).frame == 5512);
 	}
 }
@@ -21,6 +21,8 @@ TEST_CASE("channelFactory")
 		REQUIRE(data.channel.id != 0); // If ID == 0, must be auto-generated
 		REQUIRE(data.channel.type == ChannelType::SAMPLE);
 
+		data.channel.sends.push_back({/*returnId=*/42, /*level=*/0.5f});
+
 		SECTION("test clone")
 		{
 			channelFactory::Data clone = channelFactory::create(data.channel, /*bufferSize=*/1024, Resampler::Quality::LINEAR);
@@ -34,6 +36,18 @@ TEST_CASE("channelFactory")
 			REQUIRE(clone.channel.hasActions == data.channel.hasActions);
 			REQUIRE(clone.channel.name == data.channel.name);
 			REQUIRE(clone.channel.height == data.channel.height);
+			REQUIRE(clone.channel.sends.size() == 1);
+			REQUIRE(clone.channel.sends[0].returnId == 42);
+			REQUIRE(clone.channel.sends[0].level == 0.5f);
+		}
+
+		SECTION("test serialization")
+		{
+			const Patch::Channel pch = channelFactory::serializeChannel(data.channel);
+
+			REQUIRE(pch.sends.size() == 1);
+			REQUIRE(pch.sends[0].returnId == 42);
+			REQUIRE(pch.sends[0].level == 0.5f);
 		}
 	}
 }
@@ -0,0 +1,111 @@
+#include "src/core/channels/channelManager.h"
+#include "src/core/actions/actionRecorder.h"
+#include "src/core/kernelMidi.h"
+#include "src/core/midiMapper.h"
+#include "src/core/model/model.h"
+#include "src/core/patch.h"
+#include "src/core/types.h"
+#include "src/core/waveFactory.h"
+#include <catch2/catch.hpp>
+
+TEST_CASE("ChannelManager")
+{
+	using namespace giada;
+	using namespace giada::m;
+
+	const int   bufferSize = 1024;
+	const Frame waveSize   = 4096;
+
+	model::Model model;
+
+	model.registerThread(Thread::MAIN, /*realtime=*/false);
+	model.reset();
+
+	KernelMidi             kernelMidi(model);
+	MidiMapper<KernelMidi> midiMapper(kernelMidi);
+	ActionRecorder         actionRecorder(model);
+	ChannelManager         channelManager(model, midiMapper, actionRecorder, kernelMidi);
+
+	channelManager.onChannelsAltered = []() {};
+	channelManager.reset(bufferSize);
+
+	/* Track 0 is the internal one: work on the first visible track. */
+
+	const std::size_t trackIndex = 1;
+
+	const ID channelId = channelManager.addChannel(ChannelType::SAMPLE, trackIndex, bufferSize).id;
+
+	SECTION("Test freeze and unfreeze")
+	{
+		std::unique_ptr<Wave> wave   = waveFactory::createEmpty(waveSize, G_MAX_IO_CHANS, 44100, "FROZEN");
+		const ID              waveId = wave->id;
+
+		channelManager.freezeTrack(trackIndex, std::move(wave));
+
+		const model::Track& frozen = model.get().tracks.get(trackIndex);
+
+		REQUIRE(frozen.isFrozen());
+		REQUIRE(frozen.frozenWave == model.findWave(waveId));
+		REQUIRE(frozen.frozenWave->getBuffer().countFrames() == waveSize);
+
+		/* The frozen Wave goes into the patch with its track. */
+
+		Patch patch;
+		model.get().store(patch);
+
+		REQUIRE(patch.tracks[trackIndex].frozenWaveId == waveId);
+		REQUIRE(patch.tracks[trackIndex + 1].frozenWaveId == 0);
+
+		channelManager.unfreezeTrack(trackIndex);
+
+		REQUIRE(model.get().tracks.get(trackIndex).isFrozen() == false);
+		REQUIRE(model.findWave(waveId) == nullptr);
+	}
+
+	SECTION("Test sends")
+	{
+		const auto groupId = [&model](std::size_t index)
+		{ return model.get().tracks.get(index).getGroupChannel().id; };
+
+		const ID returnA = groupId(trackIndex + 1);
+		const ID returnB = groupId(trackIndex + 2);
+
+		/* A channel can't send to its own track. */
+
+		REQUIRE(channelManager.canSend(channelId, groupId(trackIndex)) == false);
+		REQUIRE(channelManager.canSend(channelId, returnA) == true);
+
+		channelManager.setSend(channelId, returnA, 0.5f);
+
+		REQUIRE(model.get().tracks.getChannel(channelId).sends.size() == 1);
+		REQUIRE(model.get().tracks.getChannel(channelId).sends[0].level == 0.5f);
+		REQUIRE(model.get().tracks.get(trackIndex + 1).isReturn() == true);
+		REQUIRE(model.get().tracks.get(trackIndex).isReturn() == false);
+
+		/* No chains: a return bus can't send, and a track with sends can't be a
+		return bus. */
+
+		REQUIRE(channelManager.canSend(returnA, returnB) == false);
+		REQUIRE(channelManager.canSend(returnB, groupId(trackIndex)) == false);
+
+		channelManager.setSend(returnA, returnB, 0.5f);
+
+		REQUIRE(model.get().tracks.getChannel(returnA).sends.empty());
+		REQUIRE(model.get().tracks.get(trackIndex + 2).isReturn() == false);
+
+		/* A zero level removes the send, and the return bus with it. */
+
+		channelManager.setSend(channelId, returnA, 0.0f);
+
+		REQUIRE(model.get().tracks.getChannel(channelId).sends.empty());
+		REQUIRE(model.get().tracks.get(trackIndex + 1).isReturn() == false);
+		REQUIRE(channelManager.canSend(returnA, returnB) == true);
+
+		/* Removing the return track drops the sends pointing to it. */
+
+		channelManager.setSend(channelId, returnB, 1.0f);
+		channelManager.removeTrack(trackIndex + 2);
+
+		REQUIRE(model.get().tracks.getChannel(channelId).sends.empty());
+	}
+}
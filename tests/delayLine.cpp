@@ -0,0 +1,96 @@
+#include "../src/core/delayLine.h"
+#include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <catch2/catch.hpp>
+#include <cmath>
+
+TEST_CASE("DelayLine")
+{
+	using namespace giada;
+	using namespace giada::m;
+
+	constexpr int BUFFER_SIZE  = 64;
+	constexpr int NUM_CHANNELS = 2;
+	constexpr int MAX_DELAY    = 100;
+
+	DelayLine        delayLine(MAX_DELAY, NUM_CHANNELS);
+	mcl::AudioBuffer buffer(BUFFER_SIZE, NUM_CHANNELS);
+
+	/* Feeds a ramp [1..BUFFER_SIZE] into the buffer. */
+
+	const auto fill = [&buffer]()
+	{
+		for (int i = 0; i < BUFFER_SIZE; i++)
+			for (int j = 0; j < NUM_CHANNELS; j++)
+				buffer[i][j] = static_cast<float>(i + 1);
+	};
+
+	SECTION("Test no delay")
+	{
+		fill();
+		delayLine.process(buffer, 0);
+
+		REQUIRE(delayLine.getDelay() == 0);
+		for (int i = 0; i < BUFFER_SIZE; i++)
+			REQUIRE(buffer[i][0] == static_cast<float>(i + 1));
+	}
+
+	SECTION("Test constant delay")
+	{
+		constexpr int DELAY = 10;
+
+		/* First block: the delay is crossfaded in from no delay. Second block
+		onwards: the signal is simply shifted. */
+
+		fill();
+		delayLine.process(buffer, DELAY);
+		fill();
+		delayLine.process(buffer, DELAY);
+
+		REQUIRE(delayLine.getDelay() == DELAY);
+		for (int i = 0; i < BUFFER_SIZE; i++)
+		{
+			const float expected = static_cast<float>(i < DELAY ? BUFFER_SIZE - DELAY + i + 1 : i - DELAY + 1);
+			REQUIRE(buffer[i][0] == expected);
+			REQUIRE(buffer[i][1] == expected);
+		}
+	}
+
+	SECTION("Test clear")
+	{
+		constexpr int DELAY = 10;
+
+		fill();
+		delayLine.process(buffer, DELAY);
+		delayLine.clear();
+		fill();
+		delayLine.process(buffer, DELAY);
+
+		/* The delay is kept, but nothing from before the clear comes out. */
+
+		REQUIRE(delayLine.getDelay() == DELAY);
+		for (int i = 0; i < BUFFER_SIZE; i++)
+			REQUIRE(buffer[i][0] == static_cast<float>(i < DELAY ? 0 : i - DELAY + 1));
+	}
+
+	SECTION("Test delay clamped to max")
+	{
+		fill();
+		delayLine.process(buffer, MAX_DELAY * 2);
+
+		REQUIRE(delayLine.getDelay() == MAX_DELAY);
+	}
+
+	SECTION("Test delay change is smooth")
+	{
+		fill();
+		delayLine.process(buffer, 0);
+		fill();
+		delayLine.process(buffer, 32);
+
+		/* Crossfade from the dry signal to silence (nothing has been delayed
+		yet): no jumps larger than the input itself. */
+
+		for (int i = 1; i < BUFFER_SIZE; i++)
+			REQUIRE(std::abs(buffer[i][0] - buffer[i - 1][0]) <= 2.0f);
+	}
+}
@@ -0,0 +1,39 @@
+#include "../src/core/dirtyFlags.h"
+#include "../src/core/weakAtomic.h"
+#include <catch2/catch.hpp>
+
+TEST_CASE("DirtyFlags")
+{
+	using namespace giada;
+
+	constexpr DirtyFlags::Mask BIT_A = 1 << 0;
+	constexpr DirtyFlags::Mask BIT_B = 1 << 1;
+
+	DirtyFlags flags;
+
+	SECTION("Test set and consume")
+	{
+		const uint64_t sequence = DirtyFlags::getSequence();
+
+		flags.set(BIT_A);
+		flags.set(BIT_B);
+
+		REQUIRE(DirtyFlags::getSequence() == sequence + 2);
+		REQUIRE(flags.consume() == (BIT_A | BIT_B));
+		REQUIRE(flags.consume() == 0);
+	}
+
+	SECTION("Test WeakAtomic publication")
+	{
+		WeakAtomic<int> value = 0;
+		value.publishTo(flags, BIT_B);
+
+		value.store(0);
+
+		REQUIRE(flags.consume() == 0); // Same value: nothing changed
+
+		value.store(1);
+
+		REQUIRE(flags.consume() == BIT_B);
+	}
+}
@@ -0,0 +1,110 @@
+#include "../src/core/journal.h"
+#include "../src/core/midiEvent.h"
+#include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+
+using namespace giada;
+using namespace giada::m;
+
+TEST_CASE("Journal")
+{
+	const std::string path = (std::filesystem::temp_directory_path() / "giada-journal").string();
+
+	Journal journal;
+
+	Journal::Header header;
+	header.sampleRate = 44100;
+	header.bufferSize = 64;
+	header.channelsIn = 2;
+	header.bpm        = 90.0f;
+
+	mcl::AudioBuffer in;
+	in.alloc(64, 2);
+
+	SECTION("Test events are ignored when not capturing")
+	{
+		const Journal::Scope scope = journal.record({Journal::EventType::SEQUENCER_START});
+
+		REQUIRE(journal.isCapturing() == false);
+		REQUIRE(journal.stopCapture() == false);
+	}
+
+	SECTION("Test capture and load")
+	{
+		REQUIRE(journal.startCapture(path, header));
+		REQUIRE(journal.isCapturing());
+
+		{
+			const Journal::Scope scope = journal.record({Journal::EventType::CHANNEL_PRESS, 7, 0.5f, 16});
+		}
+
+		journal.onAudioBlock(in, 64);
+		journal.onAudioBlock(in, 64);
+
+		{
+			const MidiEvent      e     = MidiEvent::makeFrom3Bytes(0x90, 60, 100);
+			const Journal::Scope scope = journal.record(Journal::makeMidiEvent(Journal::EventType::MIDI_IN, 0, e));
+
+			/* Nested inputs (e.g. triggered by the MIDI event above) are not
+			recorded. */
+
+			const Journal::Scope nested = journal.record({Journal::EventType::SEQUENCER_START});
+		}
+
+		journal.onAudioBlock(in, 64);
+
+		REQUIRE(journal.stopCapture());
+		REQUIRE(journal.isCapturing() == false);
+
+		const Journal::Data data = Journal::load(path);
+
+		REQUIRE(data.valid);
+		REQUIRE(data.header.sampleRate == 44100);
+		REQUIRE(data.header.bufferSize == 64);
+		REQUIRE(data.header.bpm == 90.0f);
+		REQUIRE(data.header.frames == 64 * 3);
+		REQUIRE(std::filesystem::exists(data.header.inputPath));
+		REQUIRE(data.events.size() == 2);
+
+		REQUIRE(data.events[0].type == Journal::EventType::CHANNEL_PRESS);
+		REQUIRE(data.events[0].frame == 0);
+		REQUIRE(data.events[0].channelId == 7);
+		REQUIRE(data.events[0].value == 0.5f);
+		REQUIRE(data.events[0].arg1 == 16);
+
+		REQUIRE(data.events[1].type == Journal::EventType::MIDI_IN);
+		REQUIRE(data.events[1].frame == 128);
+		REQUIRE(Journal::toMidiEvent(data.events[1]).getNote() == 60);
+		REQUIRE(Journal::toMidiEvent(data.events[1]).getVelocity() == 100);
+
+		std::filesystem::remove_all(path);
+	}
+
+	SECTION("Test missing journal")
+	{
+		REQUIRE(Journal::load("/path/to/nowhere").valid == false);
+	}
+
+	SECTION("Test malformed events")
+	{
+		/* Each event must be an array of 7 numbers. */
+
+		const auto loadEvents = [&path](const std::string& events)
+		{
+			std::filesystem::create_directories(path);
+			std::ofstream(std::filesystem::path(path) / "journal.json") << "{\"events\": " << events << "}";
+			return Journal::load(path).valid;
+		};
+
+		REQUIRE(loadEvents("[[0, 1, 2, 0.5, 0, 0, 0]]") == true);
+		REQUIRE(loadEvents("[[0, 1, 2, 0.5, 0, 0]]") == false);
+		REQUIRE(loadEvents("[[0, 1, 2, 0.5, 0, 0, 0, 0]]") == false);
+		REQUIRE(loadEvents("[[0, 1, 2, \"a\", 0, 0, 0]]") == false);
+		REQUIRE(loadEvents("[{\"frame\": 0}]") == false);
+		REQUIRE(loadEvents("{}") == false);
+
+		std::filesystem::remove_all(path);
+	}
+}
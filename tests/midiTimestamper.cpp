@@ -0,0 +1,78 @@
+#include "../src/core/midiTimestamper.h"
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <random>
+
+TEST_CASE("MidiTimestamper")
+{
+	using namespace giada;
+	using namespace giada::m;
+
+	constexpr int SAMPLE_RATE = 44100;
+	constexpr int BUFFER_SIZE = 1024;
+
+	MidiTimestamper timestamper;
+
+	SECTION("Test audio clock not running")
+	{
+		REQUIRE(timestamper.getFrameOffset(0.0) == 0);
+
+		timestamper.reset(SAMPLE_RATE, BUFFER_SIZE);
+
+		REQUIRE(timestamper.getFrameOffset(0.0) == 0);
+	}
+
+	SECTION("Test offset range")
+	{
+		timestamper.reset(SAMPLE_RATE, BUFFER_SIZE);
+		timestamper.onAudioBlock();
+		timestamper.onAudioBlock();
+
+		for (const double timestamp : {0.0, 0.001, 0.01, 1.0, 10.0})
+		{
+			const Frame offset = timestamper.getFrameOffset(timestamp);
+			REQUIRE(offset >= 0);
+			REQUIRE(offset < BUFFER_SIZE);
+		}
+	}
+
+	SECTION("Test DLL convergence with jittered blocks")
+	{
+		/* The audio device runs slightly faster than nominal and each callback
+		wakes up with up to 1 ms of jitter. Once the DLL has converged, an event
+		that arrives at 25% of a block lands at 25% of the next one on average,
+		and never further than twice the jitter from it. */
+
+		const double period = BUFFER_SIZE / (SAMPLE_RATE + 10.0);
+		const double jitter = 0.001;
+		const Frame  target = BUFFER_SIZE / 4;
+
+		std::mt19937                           rng(1234);
+		std::uniform_real_distribution<double> noise(-jitter, jitter);
+
+		timestamper.reset(SAMPLE_RATE, BUFFER_SIZE);
+
+		double sum   = 0.0;
+		int    count = 0;
+
+		for (int block = 0; block < 2000; block++)
+		{
+			const double blockStart = 100.0 + block * period;
+
+			timestamper.onAudioBlock(blockStart + noise(rng));
+
+			if (block < 1000) // Let the DLL settle first
+				continue;
+
+			const double eventTime = blockStart + period * 0.25;
+			const Frame  offset    = timestamper.getFrameOffset(eventTime, eventTime);
+
+			REQUIRE(std::abs(offset - target) < 2 * jitter * SAMPLE_RATE);
+
+			sum += offset;
+			count++;
+		}
+
+		REQUIRE(std::abs(sum / count - target) < 2.0);
+	}
+}
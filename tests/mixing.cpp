@@ -0,0 +1,81 @@
+#include "../src/core/rendering/mixing.h"
+#include "../src/core/channels/channelShared.h"
+#include <catch2/catch.hpp>
+
+TEST_CASE("rendering::mixing")
+{
+	using namespace giada;
+	using namespace giada::m;
+	using namespace giada::m::rendering;
+
+	constexpr int BUFFER_SIZE  = 64;
+	constexpr int NUM_CHANNELS = 2;
+
+	ChannelShared    shared(0, BUFFER_SIZE);
+	mcl::AudioBuffer src(BUFFER_SIZE, NUM_CHANNELS);
+	mcl::AudioBuffer dst(BUFFER_SIZE, NUM_CHANNELS);
+
+	src.forEachFrame([](float* f, int) {
+		f[0] = 1.0f;
+		f[1] = 1.0f;
+	});
+
+	SECTION("Test volume ramp")
+	{
+		/* First block: nothing to ramp from. */
+
+		sumRamped(dst, src, shared, 1.0f, G_DEFAULT_PAN);
+
+		REQUIRE(dst[0][0] == 1.0f);
+		REQUIRE(dst[BUFFER_SIZE - 1][0] == 1.0f);
+
+		/* Volume change: ramps across one block, from the old gain towards the
+		new one. */
+
+		dst.clear();
+		sumRamped(dst, src, shared, 0.5f, G_DEFAULT_PAN);
+
+		REQUIRE(dst[0][0] == 1.0f);
+		REQUIRE(dst[0][1] == 1.0f);
+		REQUIRE(dst[BUFFER_SIZE / 2][0] == Approx(0.75f));
+		REQUIRE(dst[BUFFER_SIZE - 1][0] == Approx(0.5f).margin(0.01f));
+		REQUIRE(dst[BUFFER_SIZE - 1][0] > 0.5f);
+		REQUIRE(shared.lastGainL == 0.5f);
+		REQUIRE(shared.lastGainR == 0.5f);
+
+		/* Next block: no change, flat gain. */
+
+		dst.clear();
+		sumRamped(dst, src, shared, 0.5f, G_DEFAULT_PAN);
+
+		for (int i = 0; i < BUFFER_SIZE; i++)
+		{
+			REQUIRE(dst[i][0] == 0.5f);
+			REQUIRE(dst[i][1] == 0.5f);
+		}
+	}
+
+	SECTION("Test pan ramp")
+	{
+		sumRamped(dst, src, shared, 1.0f, G_DEFAULT_PAN);
+
+		/* Hard left: the right channel fades out across one block. */
+
+		dst.clear();
+		sumRamped(dst, src, shared, 1.0f, 0.0f);
+
+		REQUIRE(dst[0][0] == 1.0f);
+		REQUIRE(dst[0][1] == 1.0f);
+		REQUIRE(dst[BUFFER_SIZE - 1][0] == 1.0f);
+		REQUIRE(dst[BUFFER_SIZE - 1][1] == Approx(0.0f).margin(0.02f));
+
+		dst.clear();
+		sumRamped(dst, src, shared, 1.0f, 0.0f);
+
+		for (int i = 0; i < BUFFER_SIZE; i++)
+		{
+			REQUIRE(dst[i][0] == 1.0f);
+			REQUIRE(dst[i][1] == 0.0f);
+		}
+	}
+}
@@ -1,9 +1,15 @@
 #include "../src/core/patch.h"
+#include "../src/core/actions/actionFactory.h"
+#include "../src/core/const.h"
+#include "../src/core/midiEvent.h"
+#include "../src/core/patchFactory.h"
 #include <catch2/catch.hpp>
+#include <filesystem>
 
 TEST_CASE("Patch")
 {
 	using namespace giada;
+	using namespace giada::m;
 
 	SECTION("version")
 	{
@@ -12,4 +18,71 @@ TEST_CASE("Patch")
 
 		REQUIRE(patch.version < Patch::Version{1, 0, 0});
 	}
+
+	SECTION("frozen tracks")
+	{
+		const std::string path = (std::filesystem::temp_directory_path() / "giada-patch.gptc").string();
+
+		Patch patch;
+		patch.tracks.push_back({G_DEFAULT_TRACK_WIDTH, /*internal=*/false, {}, /*frozenWaveId=*/5});
+		patch.tracks.push_back({G_DEFAULT_TRACK_WIDTH, /*internal=*/false, {}, /*frozenWaveId=*/0});
+
+		REQUIRE(patchFactory::serialize(patch, path));
+
+		const Patch loaded = patchFactory::deserialize(path);
+
+		REQUIRE(loaded.status == G_FILE_OK);
+		REQUIRE(loaded.tracks.size() == 2);
+		REQUIRE(loaded.tracks[0].frozenWaveId == 5);
+		REQUIRE(loaded.tracks[1].frozenWaveId == 0);
+	}
+
+	SECTION("volume envelope values")
+	{
+		const std::string path     = (std::filesystem::temp_directory_path() / "giada-patch.gptc").string();
+		const uint32_t    envelope = MidiEvent::makeFrom3Bytes(MidiEvent::CHANNEL_CC, 0x00, 0x00, 0).getRaw();
+		const uint32_t    noteOn   = MidiEvent::makeFrom3Bytes(MidiEvent::CHANNEL_NOTE_ON, 0x00, 0x3F, 0).getRaw();
+
+		/* The raw event holds a 7-bit value only: the precise one is stored
+		alongside. */
+
+		Patch patch;
+		patch.actions.push_back({1, 1, 0, envelope, 0, 0, -1, -1, 0.123f});
+		patch.actions.push_back({2, 1, 0, noteOn, 0, 0});
+
+		REQUIRE(patchFactory::serialize(patch, path));
+
+		const Patch loaded = patchFactory::deserialize(path);
+
+		REQUIRE(loaded.status == G_FILE_OK);
+		REQUIRE(loaded.actions.size() == 2);
+		REQUIRE(loaded.actions[0].value == 0.123f);
+		REQUIRE(loaded.actions[1].value.has_value() == false);
+		REQUIRE(actionFactory::makeAction(loaded.actions[0], 22050).event.getVelocityFloat() == 0.123f);
+	}
+
+	SECTION("sends")
+	{
+		const std::string path = (std::filesystem::temp_directory_path() / "giada-patch.gptc").string();
+
+		Patch::Channel channel{};
+		channel.id    = 10;
+		channel.type  = ChannelType::SAMPLE;
+		channel.sends = {{2, 0.5f}, {3, 1.0f}};
+
+		Patch patch;
+		patch.channels.push_back(channel);
+
+		REQUIRE(patchFactory::serialize(patch, path));
+
+		const Patch loaded = patchFactory::deserialize(path);
+
+		REQUIRE(loaded.status == G_FILE_OK);
+		REQUIRE(loaded.channels.size() == 1);
+		REQUIRE(loaded.channels[0].sends.size() == 2);
+		REQUIRE(loaded.channels[0].sends[0].returnId == 2);
+		REQUIRE(loaded.channels[0].sends[0].level == 0.5f);
+		REQUIRE(loaded.channels[0].sends[1].returnId == 3);
+		REQUIRE(loaded.channels[0].sends[1].level == 1.0f);
+	}
 }
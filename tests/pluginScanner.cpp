@@ -0,0 +1,189 @@
+#include "../src/core/plugins/pluginScanner.h"
+#include <catch2/catch.hpp>
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <memory>
+
+namespace
+{
+/* FakeFormat_
+Plug-in format that finds the files in 'files' only. Files are never probed in
+these tests: they are all up to date, or blocklisted, in the scanner's cache. */
+
+class FakeFormat_ : public juce::AudioPluginFormat
+{
+public:
+	FakeFormat_(const juce::StringArray& files)
+	: m_files(files)
+	{
+	}
+
+	juce::String getName() const override { return "Fake"; }
+	void         findAllTypesForFile(juce::OwnedArray<juce::PluginDescription>&, const juce::String&) override {}
+	bool         fileMightContainThisPluginType(const juce::String&) override { return true; }
+	juce::String getNameOfPluginFromIdentifier(const juce::String& id) override { return id; }
+	bool         pluginNeedsRescanning(const juce::PluginDescription&) override { return false; }
+	bool         doesPluginStillExist(const juce::PluginDescription&) override { return true; }
+	bool         canScanForPlugins() const override { return true; }
+	bool         isTrivialToScan() const override { return true; }
+
+	juce::StringArray searchPathsForPlugins(const juce::FileSearchPath&, bool, bool) override { return m_files; }
+	juce::FileSearchPath getDefaultLocationsToSearch() override { return {}; }
+
+	bool requiresUnblockedMessageThreadDuringCreation(const juce::PluginDescription&) const override { return false; }
+
+protected:
+	void createPluginInstance(const juce::PluginDescription&, double, int, PluginCreationCallback) override {}
+
+private:
+	const juce::StringArray& m_files;
+};
+
+/* -------------------------------------------------------------------------- */
+
+juce::PluginDescription makeDescription_(const juce::File& file, int uniqueId)
+{
+	juce::PluginDescription pd;
+	pd.name             = file.getFileNameWithoutExtension();
+	pd.pluginFormatName = "Fake";
+	pd.fileOrIdentifier = file.getFullPathName();
+	pd.uniqueId         = uniqueId;
+	return pd;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* addCacheEntry_
+Adds a cache entry to the XML read by PluginScanner::readXml(), with the
+file's current size and modification time. */
+
+void addCacheEntry_(juce::XmlElement& cache, const juce::File& file, bool blocked)
+{
+	juce::XmlElement* e = cache.createNewChildElement("FILE");
+	e->setAttribute("format", "Fake");
+	e->setAttribute("path", file.getFullPathName());
+	e->setAttribute("size", juce::String(file.getSize()));
+	e->setAttribute("mtime", juce::String(file.getLastModificationTime().toMilliseconds()));
+	e->setAttribute("blocked", blocked);
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+
+TEST_CASE("PluginScanner")
+{
+	using namespace giada::m;
+
+	const juce::ScopedJuceInitialiser_GUI juceInit;
+
+	const juce::File dir = juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("giada-plugin-scanner");
+	const juce::File a   = dir.getChildFile("a.fake");
+	const juce::File b   = dir.getChildFile("b.fake");
+
+	dir.deleteRecursively();
+	REQUIRE(dir.createDirectory());
+	REQUIRE(a.replaceWithText("a"));
+	REQUIRE(b.replaceWithText("bb"));
+
+	juce::StringArray              files = {a.getFullPathName(), b.getFullPathName()};
+	juce::AudioPluginFormatManager formatManager;
+	juce::KnownPluginList          knownPluginList;
+	PluginScanner                  scanner(formatManager, knownPluginList);
+
+	formatManager.addFormat(new FakeFormat_(files));
+
+	juce::XmlElement  parent("PARENT");
+	juce::XmlElement* cache = parent.createNewChildElement("GIADA_SCAN_CACHE");
+
+	SECTION("Test cache XML round-trip")
+	{
+		addCacheEntry_(*cache, a, /*blocked=*/false);
+		addCacheEntry_(*cache, b, /*blocked=*/true);
+
+		scanner.readXml(parent);
+
+		juce::XmlElement out("PARENT");
+		scanner.writeXml(out);
+
+		const juce::XmlElement* outCache = out.getChildByName("GIADA_SCAN_CACHE");
+
+		REQUIRE(outCache != nullptr);
+		REQUIRE(outCache->getNumChildElements() == 2);
+		for (int i = 0; i < 2; i++)
+			REQUIRE(outCache->getChildElement(i)->isEquivalentTo(cache->getChildElement(i), /*ignoreOrderOfAttributes=*/true));
+
+		/* Clearing the cache empties the XML too. */
+
+		scanner.clear();
+
+		juce::XmlElement empty("PARENT");
+		scanner.writeXml(empty);
+
+		REQUIRE(empty.getChildByName("GIADA_SCAN_CACHE")->getNumChildElements() == 0);
+	}
+
+	SECTION("Test up-to-date files")
+	{
+		/* Files that haven't changed since the last scan are not probed again:
+		their plug-ins stay in the list. */
+
+		addCacheEntry_(*cache, a, false);
+		addCacheEntry_(*cache, b, false);
+		scanner.readXml(parent);
+
+		knownPluginList.addType(makeDescription_(a, 1));
+		knownPluginList.addType(makeDescription_(b, 2));
+
+		REQUIRE(scanner.scan(dir.getFullPathName().toStdString(), [](float) { return true; }) == 2);
+		REQUIRE(knownPluginList.getNumTypes() == 2);
+	}
+
+	SECTION("Test prune")
+	{
+		/* 'b' is gone: both its plug-in and its cache entry are dropped. Plug-ins
+		without a cache entry are dropped too. */
+
+		addCacheEntry_(*cache, a, false);
+		addCacheEntry_(*cache, b, false);
+		scanner.readXml(parent);
+
+		knownPluginList.addType(makeDescription_(a, 1));
+		knownPluginList.addType(makeDescription_(b, 2));
+		knownPluginList.addType(makeDescription_(dir.getChildFile("c.fake"), 3));
+
+		files.removeString(b.getFullPathName());
+
+		REQUIRE(scanner.scan(dir.getFullPathName().toStdString(), [](float) { return true; }) == 1);
+		REQUIRE(knownPluginList.getTypes()[0].fileOrIdentifier == a.getFullPathName());
+
+		juce::XmlElement out("PARENT");
+		scanner.writeXml(out);
+
+		REQUIRE(out.getChildByName("GIADA_SCAN_CACHE")->getNumChildElements() == 1);
+	}
+
+	SECTION("Test blocklist")
+	{
+		/* A blocklisted file that hasn't changed is neither probed nor listed,
+		and stays blocklisted. */
+
+		addCacheEntry_(*cache, a, false);
+		addCacheEntry_(*cache, b, /*blocked=*/true);
+		scanner.readXml(parent);
+
+		knownPluginList.addType(makeDescription_(a, 1));
+		knownPluginList.addType(makeDescription_(b, 2));
+
+		REQUIRE(scanner.scan(dir.getFullPathName().toStdString(), [](float) { return true; }) == 1);
+		REQUIRE(knownPluginList.getTypes()[0].fileOrIdentifier == a.getFullPathName());
+
+		juce::XmlElement out("PARENT");
+		scanner.writeXml(out);
+
+		const juce::XmlElement* blocked = out.getChildByName("GIADA_SCAN_CACHE")->getChildElement(1);
+
+		REQUIRE(blocked->getStringAttribute("path") == b.getFullPathName());
+		REQUIRE(blocked->getBoolAttribute("blocked") == true);
+	}
+
+	dir.deleteRecursively();
+}
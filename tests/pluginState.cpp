@@ -0,0 +1,73 @@
+#include "../src/core/plugins/pluginState.h"
+#include "../src/core/const.h"
+#include "../src/core/patch.h"
+#include "../src/core/patchFactory.h"
+#include <catch2/catch.hpp>
+#include <cstring>
+#include <filesystem>
+
+TEST_CASE("PluginState")
+{
+	using namespace giada;
+	using namespace giada::m;
+
+	const std::filesystem::path dir       = std::filesystem::temp_directory_path() / "giada-plugin-state";
+	const std::string           patchPath = (dir / "project.gptc").string();
+	const char                  bytes[]   = {0x00, 0x01, 0x7F, static_cast<char>(0xFF), 'g', 'i', 'a', 'd', 'a'};
+
+	const auto equalsBytes = [&bytes](const PluginState& state)
+	{
+		return state.getSize() == sizeof(bytes) && std::memcmp(state.getData(), bytes, sizeof(bytes)) == 0;
+	};
+
+	std::filesystem::remove_all(dir);
+	std::filesystem::create_directories(dir);
+
+	const PluginState state(juce::MemoryBlock(bytes, sizeof(bytes)));
+
+	SECTION("Test sidecar file round-trip")
+	{
+		/* The patch points to the sidecar file relative to the project folder:
+		it comes back as a full path. */
+
+		REQUIRE(state.save((dir / "plugin_3.state").string()));
+
+		Patch patch;
+		patch.plugins.push_back({3, "plugin", false, {}, /*state=*/"", /*statePath=*/"plugin_3.state", {}});
+
+		REQUIRE(patchFactory::serialize(patch, patchPath));
+
+		const Patch loaded = patchFactory::deserialize(patchPath);
+
+		REQUIRE(loaded.status == G_FILE_OK);
+		REQUIRE(loaded.plugins.size() == 1);
+		REQUIRE(loaded.plugins[0].state.empty());
+		REQUIRE(loaded.plugins[0].statePath == (dir / "plugin_3.state").string());
+		REQUIRE(equalsBytes(PluginState::fromFile(loaded.plugins[0].statePath)));
+	}
+
+	SECTION("Test missing sidecar file")
+	{
+		REQUIRE(PluginState::fromFile((dir / "plugin_4.state").string()).getSize() == 0);
+	}
+
+	SECTION("Test legacy base64 state")
+	{
+		/* Patches written before sidecar files, or whose sidecar file couldn't be
+		written, embed the state as base64. */
+
+		Patch patch;
+		patch.plugins.push_back({3, "plugin", false, {}, state.asBase64(), /*statePath=*/"", {}});
+
+		REQUIRE(patchFactory::serialize(patch, patchPath));
+
+		const Patch loaded = patchFactory::deserialize(patchPath);
+
+		REQUIRE(loaded.status == G_FILE_OK);
+		REQUIRE(loaded.plugins.size() == 1);
+		REQUIRE(loaded.plugins[0].statePath.empty());
+		REQUIRE(equalsBytes(PluginState(loaded.plugins[0].state)));
+	}
+
+	std::filesystem::remove_all(dir);
+}
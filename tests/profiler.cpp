@@ -0,0 +1,90 @@
+#include "../src/core/profiler.h"
+#include <catch2/catch.hpp>
+
+TEST_CASE("Profiler")
+{
+	using namespace giada::m;
+	using namespace std::chrono_literals;
+
+	Profiler profiler;
+	profiler.setBlockPeriod(/*bufferSize=*/441, /*sampleRate=*/44100); // 10 ms
+
+	SECTION("Test histogram")
+	{
+		Profiler::Histogram h;
+		h.record(500ns);
+		h.record(3us);
+		h.record(3us);
+		h.record(1ms);
+
+		const Profiler::Histogram::Stats stats = h.getStats();
+
+		REQUIRE(stats.count == 4);
+		REQUIRE(stats.buckets[0] == 1);  // < 1 us
+		REQUIRE(stats.buckets[2] == 2);  // [2, 4) us
+		REQUIRE(stats.buckets[10] == 1); // [512, 1024) us
+		REQUIRE(stats.maxUs == Approx(1000.0));
+		REQUIRE(stats.p99Us == Approx(1024.0));
+
+		h.clear();
+		REQUIRE(h.getStats().count == 0);
+	}
+
+	SECTION("Test DSP load")
+	{
+		for (int i = 0; i < 200; i++)
+			profiler.recordRender(5ms);
+
+		REQUIRE(profiler.getDspLoad() == Approx(0.5f).epsilon(0.01));
+		REQUIRE(profiler.getReport().dspLoadPeak == Approx(0.5f));
+	}
+
+	SECTION("Test plug-in load")
+	{
+		for (int i = 0; i < 200; i++)
+		{
+			profiler.recordPlugin(/*pluginId=*/1, 1ms);
+			profiler.recordPlugin(/*pluginId=*/2, 2ms);
+		}
+
+		REQUIRE(profiler.getPluginLoad(1) == Approx(0.1f).epsilon(0.01));
+		REQUIRE(profiler.getPluginLoad(2) == Approx(0.2f).epsilon(0.01));
+		REQUIRE(profiler.getPluginLoad(3) == 0.0f);
+		REQUIRE(profiler.getReport().plugins.size() == 2);
+
+		profiler.reset();
+		REQUIRE(profiler.getPluginLoad(1) == 0.0f);
+	}
+
+	SECTION("Test plug-in slots reuse")
+	{
+		/* IDs keep growing during a session: released slots must be given to
+		new plug-ins. */
+
+		for (int id = 1; id <= Profiler::MAX_PLUGINS * 2; id++)
+		{
+			profiler.recordPlugin(id, 1ms);
+			REQUIRE(profiler.getPluginLoad(id) > 0.0f);
+			profiler.releasePlugin(id);
+			REQUIRE(profiler.getPluginLoad(id) == 0.0f);
+		}
+
+		REQUIRE(profiler.getReport().plugins.empty());
+
+		profiler.recordPlugin(/*pluginId=*/1000, 1ms);
+		profiler.releaseAllPlugins();
+
+		REQUIRE(profiler.getReport().plugins.empty());
+	}
+
+	SECTION("Test xruns")
+	{
+		profiler.recordXrun(/*underflow=*/true, /*overflow=*/false);
+		profiler.recordXrun(/*underflow=*/true, /*overflow=*/true);
+
+		const Profiler::Report report = profiler.getReport();
+
+		REQUIRE(report.underflows == 2);
+		REQUIRE(report.overflows == 1);
+	}
+}
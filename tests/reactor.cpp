@@ -0,0 +1,102 @@
+#include "src/core/rendering/reactor.h"
+#include "src/core/actions/actionRecorder.h"
+#include "src/core/channels/channelManager.h"
+#include "src/core/kernelMidi.h"
+#include "src/core/midiMapper.h"
+#include "src/core/model/model.h"
+#include "src/core/rendering/trigger.h"
+#include "src/core/types.h"
+#include <catch2/catch.hpp>
+#include <vector>
+
+TEST_CASE("Reactor")
+{
+	using namespace giada;
+	using namespace giada::m;
+	using namespace giada::m::rendering;
+
+	const int bufferSize = 1024;
+
+	model::Model model;
+
+	model.registerThread(Thread::MAIN, /*realtime=*/false);
+	model.reset();
+
+	KernelMidi             kernelMidi(model);
+	MidiMapper<KernelMidi> midiMapper(kernelMidi);
+	ActionRecorder         actionRecorder(model);
+	ChannelManager         channelManager(model, midiMapper, actionRecorder, kernelMidi);
+	TriggerQueue           triggerQueue(/*size=*/64, /*max_explicit_producers=*/0, /*max_implicit_producers=*/8);
+	Reactor                reactor(model, midiMapper, actionRecorder, kernelMidi, triggerQueue);
+
+	channelManager.onChannelsAltered = []() {};
+	channelManager.reset(bufferSize);
+
+	const std::size_t trackIndex = 1;
+	const ID          sampleId   = channelManager.addChannel(ChannelType::SAMPLE, trackIndex, bufferSize).id;
+	const ID          midiId     = channelManager.addChannel(ChannelType::MIDI, trackIndex, bufferSize).id;
+
+	const auto takeTriggers = [&triggerQueue]()
+	{
+		std::vector<Trigger> out;
+		Trigger              t;
+		while (triggerQueue.try_dequeue(t))
+			out.push_back(t);
+		return out;
+	};
+
+	SECTION("Test ordering and local frame")
+	{
+		reactor.keyPress(sampleId, /*velocity=*/0.5f, /*canRecordActions=*/false, /*canQuantize=*/true, 0, /*localFrame=*/10);
+		reactor.keyRelease(sampleId, false, 0, /*localFrame=*/20);
+		reactor.keyKill(sampleId, false, 0, /*localFrame=*/30);
+
+		const std::vector<Trigger> triggers = takeTriggers();
+
+		REQUIRE(triggers.size() == 3);
+		REQUIRE(triggers[0].type == Trigger::Type::PRESS);
+		REQUIRE(triggers[0].channelId == sampleId);
+		REQUIRE(triggers[0].velocity == 0.5f);
+		REQUIRE(triggers[0].canQuantize == true);
+		REQUIRE(triggers[0].localFrame == 10);
+		REQUIRE(triggers[1].type == Trigger::Type::RELEASE);
+		REQUIRE(triggers[1].localFrame == 20);
+		REQUIRE(triggers[2].type == Trigger::Type::KILL);
+		REQUIRE(triggers[2].localFrame == 30);
+	}
+
+	SECTION("Test Group Channel")
+	{
+		/* Pressing a Group Channel presses all its children, in track order. */
+
+		const ID groupId = model.get().tracks.get(trackIndex).getGroupChannel().id;
+
+		reactor.keyPress(groupId, 1.0f, false, false, 0, /*localFrame=*/5);
+
+		const std::vector<Trigger> triggers = takeTriggers();
+
+		REQUIRE(triggers.size() == 2);
+		REQUIRE(triggers[0].channelId == sampleId);
+		REQUIRE(triggers[1].channelId == midiId);
+		REQUIRE(triggers[0].localFrame == 5);
+		REQUIRE(triggers[1].localFrame == 5);
+	}
+
+	SECTION("Test MIDI all notes off")
+	{
+		/* Killing a playing MIDI channel silences its plug-ins right away, not
+		on the audio thread. */
+
+		ChannelShared& shared = *model.get().tracks.getChannel(midiId).shared;
+
+		reactor.keyKill(midiId, false, 0, 0);
+
+		REQUIRE(shared.midiQueue.size_approx() == 0);
+
+		shared.playStatus.store(ChannelStatus::PLAY);
+		reactor.keyKill(midiId, false, 0, 0);
+
+		REQUIRE(shared.midiQueue.size_approx() == 1);
+		REQUIRE(takeTriggers().size() == 2);
+	}
+}
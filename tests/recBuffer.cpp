@@ -0,0 +1,83 @@
+#include "../src/core/recBuffer.h"
+#include "../src/core/const.h"
+#include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <catch2/catch.hpp>
+
+TEST_CASE("RecBuffer")
+{
+	using namespace giada;
+	using namespace giada::m;
+
+	constexpr int BUFFER_SIZE = 1024;
+
+	RecBuffer        recBuffer;
+	mcl::AudioBuffer in(BUFFER_SIZE, G_MAX_IO_CHANS);
+
+	for (int i = 0; i < in.countFrames(); i++)
+		for (int j = 0; j < in.countChannels(); j++)
+			in[i][j] = 1.0f;
+
+	REQUIRE(recBuffer.countChunks() == 0);
+
+	recBuffer.refill();
+
+	REQUIRE(recBuffer.countChunks() == RecBuffer::CHUNKS_AHEAD);
+
+	SECTION("Test sum across chunks")
+	{
+		const Frame offset = RecBuffer::CHUNK_FRAMES - BUFFER_SIZE / 2;
+
+		recBuffer.sum(in, BUFFER_SIZE, /*srcOffset=*/0, offset, /*gain=*/0.5f);
+
+		REQUIRE(recBuffer.countFrames() == offset + BUFFER_SIZE);
+		REQUIRE(recBuffer.getDroppedFrames() == 0);
+
+		mcl::AudioBuffer out(RecBuffer::CHUNK_FRAMES * 2, G_MAX_IO_CHANS);
+		recBuffer.copyTo(out);
+
+		REQUIRE(out[offset - 1][0] == 0.0f);
+		REQUIRE(out[offset][0] == 0.5f);
+		REQUIRE(out[RecBuffer::CHUNK_FRAMES][1] == 0.5f); // Second chunk
+		REQUIRE(out[offset + BUFFER_SIZE][0] == 0.0f);
+
+		recBuffer.sumTo(out);
+
+		REQUIRE(out[offset][0] == 1.0f);
+	}
+
+	SECTION("Test refill")
+	{
+		const Frame lastChunk = RecBuffer::CHUNK_FRAMES * (RecBuffer::CHUNKS_AHEAD - 1);
+
+		recBuffer.sum(in, BUFFER_SIZE, 0, lastChunk, 1.0f);
+		recBuffer.refill();
+
+		REQUIRE(recBuffer.countChunks() == RecBuffer::CHUNKS_AHEAD * 2);
+	}
+
+	SECTION("Test dropped frames")
+	{
+		const Frame past = RecBuffer::CHUNK_FRAMES * RecBuffer::CHUNKS_AHEAD;
+
+		recBuffer.sum(in, BUFFER_SIZE, 0, past, 1.0f);
+
+		REQUIRE(recBuffer.getDroppedFrames() == BUFFER_SIZE);
+		REQUIRE(recBuffer.countFrames() == past + BUFFER_SIZE);
+	}
+
+	SECTION("Test clear")
+	{
+		recBuffer.sum(in, BUFFER_SIZE, 0, 0, 1.0f);
+		recBuffer.sum(in, BUFFER_SIZE, 0, RecBuffer::CHUNK_FRAMES * (RecBuffer::CHUNKS_AHEAD - 1), 1.0f);
+		recBuffer.refill();
+		recBuffer.clear();
+
+		REQUIRE(recBuffer.countChunks() == RecBuffer::CHUNKS_AHEAD);
+		REQUIRE(recBuffer.countFrames() == 0);
+
+		mcl::AudioBuffer out(BUFFER_SIZE, G_MAX_IO_CHANS);
+		recBuffer.copyTo(out);
+
+		REQUIRE(out[0][0] == 0.0f);
+	}
+}
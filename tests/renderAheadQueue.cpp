@@ -0,0 +1,132 @@
+#include "../src/core/rendering/renderAheadQueue.h"
+#include <catch2/catch.hpp>
+#include <memory>
+
+TEST_CASE("RenderAheadQueue")
+{
+	using namespace giada;
+	using namespace giada::m::rendering;
+
+	using State = RenderAheadQueue::State;
+
+	constexpr int BUFFER_SIZE = 64;
+	constexpr int DEPTH       = 4;
+	constexpr ID  TRACK_ID    = 10;
+
+	auto queue = std::make_unique<RenderAheadQueue>(); // Too big for the stack
+	queue->reset(BUFFER_SIZE, DEPTH);
+
+	RenderAheadQueue::Slot& slot = queue->getSlots()[0];
+
+	SECTION("Test depth")
+	{
+		REQUIRE(RenderAheadQueue::computeDepth(64, 44100) == 7);
+		REQUIRE(RenderAheadQueue::computeDepth(4096, 44100) == 1);
+		REQUIRE(RenderAheadQueue::computeDepth(1, 44100) == RenderAheadQueue::MAX_BLOCKS);
+	}
+
+	SECTION("Test hand over and take back")
+	{
+		REQUIRE(slot.bind(TRACK_ID));
+		REQUIRE_FALSE(slot.bind(TRACK_ID + 1));
+		REQUIRE(queue->find(TRACK_ID) == &slot);
+
+		REQUIRE(slot.request());
+		REQUIRE(slot.getState() == State::REQUESTED);
+
+		slot.accept(/*nextFrame=*/128);
+
+		REQUIRE(slot.getState() == State::AHEAD);
+		REQUIRE(slot.getNextFrame() == 128);
+
+		REQUIRE(slot.acquire());
+		REQUIRE_FALSE(slot.reclaim()); // Worker is busy
+
+		slot.release();
+
+		REQUIRE(slot.reclaim());
+		REQUIRE(slot.getState() == State::IDLE);
+		REQUIRE_FALSE(slot.acquire());
+	}
+
+	SECTION("Test hold after flush")
+	{
+		REQUIRE(slot.bind(TRACK_ID));
+
+		slot.requestFlush();
+
+		REQUIRE_FALSE(slot.request());
+
+		slot.tick(); // Flush consumed, hold period starts
+
+		REQUIRE_FALSE(slot.isFlushRequested());
+		REQUIRE_FALSE(slot.request());
+
+		for (int i = 0; i < RenderAheadQueue::HOLD_BLOCKS; i++)
+			slot.tick();
+
+		REQUIRE(slot.request());
+
+		slot.reject();
+
+		REQUIRE(slot.getState() == State::IDLE);
+		REQUIRE_FALSE(slot.request());
+	}
+
+	SECTION("Test FIFO")
+	{
+		REQUIRE(slot.bind(TRACK_ID));
+		REQUIRE(slot.front() == nullptr);
+
+		for (int i = 0; i < DEPTH; i++)
+		{
+			RenderAheadQueue::Block* block = slot.getWriteBlock();
+			REQUIRE(block != nullptr);
+			REQUIRE(block->audio.countFrames() == BUFFER_SIZE);
+			block->frame = i * BUFFER_SIZE;
+			slot.push();
+		}
+
+		REQUIRE(slot.size() == DEPTH);
+		REQUIRE(slot.getWriteBlock() == nullptr); // Full
+
+		REQUIRE(slot.front()->frame == 0);
+		slot.pop();
+		REQUIRE(slot.front()->frame == BUFFER_SIZE);
+		REQUIRE(slot.getWriteBlock() != nullptr);
+
+		slot.clear();
+
+		REQUIRE(slot.size() == 0);
+		REQUIRE(slot.front() == nullptr);
+	}
+
+	SECTION("Test unbind")
+	{
+		REQUIRE(slot.bind(TRACK_ID));
+		REQUIRE(slot.request());
+		slot.accept(0);
+		REQUIRE(slot.acquire());
+
+		REQUIRE_FALSE(slot.unbind()); // Worker is busy
+
+		slot.getWriteBlock();
+		slot.push();
+		slot.release();
+
+		REQUIRE(slot.unbind());
+		REQUIRE(slot.getState() == State::FREE);
+		REQUIRE(slot.size() == 0);
+		REQUIRE(queue->find(TRACK_ID) == nullptr);
+	}
+
+	SECTION("Test deferred triggers")
+	{
+		for (std::size_t i = 0; i < RenderAheadQueue::MAX_DEFERRED_TRIGGERS; i++)
+			REQUIRE(queue->deferTrigger({Trigger::Type::PRESS, TRACK_ID}));
+
+		REQUIRE_FALSE(queue->deferTrigger({Trigger::Type::PRESS, TRACK_ID}));
+		REQUIRE(queue->takeDeferredTriggers().size() == RenderAheadQueue::MAX_DEFERRED_TRIGGERS);
+		REQUIRE(queue->takeDeferredTriggers().size() == 0);
+	}
+}
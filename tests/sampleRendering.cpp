@@ -1,5 +1,6 @@
 #include "../src/core/rendering/sampleRendering.h"
 #include "../src/core/channels/channel.h"
+#include "../src/utils/alloc.h"
 #include <catch2/catch.hpp>
 
 TEST_CASE("rendering::sampleRendering")
@@ -24,6 +25,18 @@ TEST_CASE("rendering::sampleRendering")
 	channelShared.renderQueue.emplace(/*size=*/16);
 	channelShared.resampler.emplace(Resampler::Quality::LINEAR, G_MAX_IO_CHANS);
 
+	/* Rendering happens on the realtime thread: it must not allocate. */
+
+	const auto render = [&channel]()
+	{
+		const std::size_t violations = u::alloc::getViolations();
+		{
+			G_ALLOC_TRAP();
+			m::rendering::renderSampleChannel(channel, /*seqIsRunning=*/false);
+		}
+		REQUIRE(u::alloc::getViolations() == violations);
+	};
+
 	SECTION("Test initialization")
 	{
 		REQUIRE(channel.sampleChannel->hasWave() == false);
@@ -43,6 +56,7 @@ TEST_CASE("rendering::sampleRendering")
 		for (const float pitch : {1.0f, 0.5f})
 		{
 			channel.sampleChannel->pitch = pitch;
+			channelShared.pitch.store(pitch);
 
 			SECTION("Sub-range [M, N), pitch == " + std::to_string(pitch))
 			{
@@ -54,7 +68,7 @@ TEST_CASE("rendering::sampleRendering")
 
 				channelShared.renderQueue->enqueue({m::rendering::RenderInfo::Mode::NORMAL, 0});
 
-				m::rendering::renderSampleChannel(channel, /*seqIsRunning=*/false);
+				render();
 
 				int numFramesWritten = 0;
 				channelShared.audioBuffer.forEachFrame([&numFramesWritten](float* f, int) {
@@ -72,7 +86,7 @@ TEST_CASE("rendering::sampleRendering")
 
 				channelShared.renderQueue->enqueue({m::rendering::RenderInfo::Mode::REWIND, OFFSET});
 
-				m::rendering::renderSampleChannel(channel, /*seqIsRunning=*/false);
+				render();
 
 				// Rendering should start over again at buffer[OFFSET]
 				REQUIRE(channelShared.audioBuffer[OFFSET][0] == 1.0f);
@@ -85,7 +99,7 @@ TEST_CASE("rendering::sampleRendering")
 
 				channelShared.renderQueue->enqueue({m::rendering::RenderInfo::Mode::STOP, OFFSET});
 
-				m::rendering::renderSampleChannel(channel, /*seqIsRunning=*/false);
+				render();
 
 				int numFramesWritten = 0;
 				channelShared.audioBuffer.forEachFrame([&numFramesWritten](float* f, int) {
@@ -0,0 +1,140 @@
+#include "src/core/sequencer.h"
+#include "src/core/const.h"
+#include "src/core/jackTransport.h"
+#include "src/core/kernelMidi.h"
+#include "src/core/midiEvent.h"
+#include "src/core/midiSynchronizer.h"
+#include "src/core/model/model.h"
+#include "src/core/types.h"
+#include <catch2/catch.hpp>
+#include <vector>
+
+namespace
+{
+std::vector<giada::m::Sequencer::Event> getActions_(const giada::m::Sequencer::Events& events, giada::ID channelId)
+{
+	std::vector<giada::m::Sequencer::Event> out;
+	for (giada::m::Sequencer::ChannelActions a = events.getActions(channelId); !a.done(); a.next())
+		out.push_back(a.get());
+	return out;
+}
+} // namespace
+
+TEST_CASE("Sequencer")
+{
+	using namespace giada;
+	using namespace giada::m;
+
+	const int   sampleRate = 44100;
+	const Frame bufferSize = 1024;
+	const ID    channelId  = 1;
+	const auto  noteOn     = MidiEvent::makeFrom3Bytes(MidiEvent::CHANNEL_NOTE_ON, 0x00, 0x00, 0);
+	const auto  noteOff    = MidiEvent::makeFrom3Bytes(MidiEvent::CHANNEL_NOTE_OFF, 0x00, 0x00, 0);
+
+	model::Model model;
+
+	model.registerThread(Thread::MAIN, /*realtime=*/false);
+	model.reset();
+
+	KernelMidi       kernelMidi(model);
+	MidiSynchronizer midiSynchronizer(kernelMidi);
+	JackTransport    jackTransport;
+	Sequencer        sequencer(model, midiSynchronizer, jackTransport);
+
+	model.get().sequencer.bpm = 120.0f;
+	sequencer.recomputeFrames(sampleRate);
+
+	REQUIRE(sequencer.getFramesInLoop() == 88200);
+
+	/* Actions are stored in ticks: read back the frame the tick falls on. */
+
+	const Tick  tick        = model.get().sequencer.frameToTick(100);
+	const Frame actionFrame = model.get().sequencer.tickToFrame(tick);
+
+	SECTION("Test bpm change in the middle of the loop")
+	{
+		/* Move the play head past the end of the loop it's about to get, then
+		double the speed: the loop shrinks to 44100 frames. */
+
+		model.get().sequencer.a_setCurrentFrame(44100 + 43600, sampleRate);
+		model.get().sequencer.bpm = 240.0f;
+		sequencer.recomputeFrames(sampleRate);
+
+		const Tick  fastTick  = model.get().sequencer.frameToTick(100);
+		const Frame fastFrame = model.get().sequencer.tickToFrame(fastTick);
+		model.get().actions.rec(channelId, fastTick, noteOn);
+		model.swap(model::SwapType::NONE);
+
+		REQUIRE(sequencer.getFramesInLoop() == 44100);
+
+		/* The block starts at frame 43600 and wraps around the loop after 500
+		frames. */
+
+		const Sequencer::Events& events = sequencer.advance(model.get().sequencer,
+		    bufferSize, sampleRate, model.get().actions);
+
+		REQUIRE(events.dropped == 0);
+		REQUIRE(events.timeline.size() == 1);
+		REQUIRE(events.timeline.begin()->type == Sequencer::EventType::FIRST_BEAT);
+		REQUIRE(events.timeline.begin()->delta == 500);
+
+		const auto actions = getActions_(events, channelId);
+
+		REQUIRE(actions.size() == 1);
+		REQUIRE(actions[0].global == fastFrame);
+		REQUIRE(actions[0].delta == 500 + fastFrame);
+
+		REQUIRE(sequencer.getCurrentFrame() == 524);
+	}
+
+	SECTION("Test more channels than events on the same tick")
+	{
+		/* Each channel gets two actions on the same tick, and one more later in
+		the block: none of them must be lost. */
+
+		const int   numChannels = G_MAX_SEQUENCER_EVENTS * 2;
+		const Tick  tick2       = model.get().sequencer.frameToTick(500);
+		const Frame frame2      = model.get().sequencer.tickToFrame(tick2);
+
+		for (ID id = 1; id <= numChannels; id++)
+		{
+			model.get().actions.rec(id, tick, noteOn);
+			model.get().actions.rec(id, tick, noteOff);
+			model.get().actions.rec(id, tick2, noteOff);
+		}
+		model.swap(model::SwapType::NONE);
+
+		const Sequencer::Events& events = sequencer.peek(model.get().sequencer, 0, bufferSize,
+		    model.get().actions);
+
+		REQUIRE(events.dropped == 0);
+
+		for (ID id = 1; id <= numChannels; id++)
+		{
+			const auto actions = getActions_(events, id);
+
+			REQUIRE(actions.size() == 2);
+			REQUIRE(actions[0].type == Sequencer::EventType::ACTIONS);
+			REQUIRE(actions[0].delta == actionFrame);
+			REQUIRE(actions[0].actions.size() == 2);
+			REQUIRE(actions[1].delta == frame2);
+			REQUIRE(actions[1].actions.size() == 1);
+			for (const Sequencer::Event& e : actions)
+				for (const Action* a : e.actions)
+					REQUIRE(a->channelId == id);
+		}
+
+		REQUIRE(getActions_(events, numChannels + 1).empty());
+	}
+
+	SECTION("Test actions outside the block")
+	{
+		model.get().actions.rec(channelId, tick, noteOn);
+		model.swap(model::SwapType::NONE);
+
+		const Sequencer::Events& events = sequencer.peek(model.get().sequencer, bufferSize, bufferSize,
+		    model.get().actions);
+
+		REQUIRE(getActions_(events, channelId).empty());
+	}
+}
@@ -0,0 +1,127 @@
+#include "src/core/model/model.h"
+#include "src/core/model/sharedLock.h"
+#include "src/core/model/transaction.h"
+#include "src/core/types.h"
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Transaction")
+{
+	using namespace giada;
+	using namespace giada::m;
+
+	model::Model model;
+
+	model.registerThread(Thread::MAIN, /*realtime=*/false);
+	model.reset();
+
+	std::vector<model::SwapType> swaps;
+	model.onSwap = [&swaps](model::SwapType t) { swaps.push_back(t); };
+
+	SECTION("Test swaps outside a Transaction")
+	{
+		model.swap(model::SwapType::SOFT);
+
+		REQUIRE(swaps == std::vector{model::SwapType::SOFT});
+	}
+
+	SECTION("Test nested Transactions")
+	{
+		{
+			const model::Transaction outer = model.beginTransaction();
+			model.swap(model::SwapType::NONE);
+			{
+				const model::Transaction inner = model.beginTransaction();
+				model.swap(model::SwapType::NONE);
+			}
+
+			REQUIRE(swaps.empty());
+		}
+
+		REQUIRE(swaps == std::vector{model::SwapType::NONE});
+	}
+
+	SECTION("Test deferred swap type")
+	{
+		{
+			const model::Transaction transaction = model.beginTransaction();
+			model.swap(model::SwapType::NONE);
+			model.swap(model::SwapType::HARD);
+			model.swap(model::SwapType::SOFT);
+		}
+
+		REQUIRE(swaps == std::vector{model::SwapType::HARD});
+	}
+
+	SECTION("Test Transaction without swaps")
+	{
+		{
+			const model::Transaction transaction = model.beginTransaction();
+		}
+
+		REQUIRE(swaps.empty());
+	}
+
+	SECTION("Test swapNow")
+	{
+		{
+			const model::Transaction transaction = model.beginTransaction();
+			model.get().mixer.isRecordingInput = true;
+			model.swapNow(model::SwapType::SOFT);
+
+			REQUIRE(model.get_RT().get().mixer.isRecordingInput == true);
+		}
+
+		/* One swap to publish the Document, plus the deferred one. */
+
+		REQUIRE(swaps == std::vector{model::SwapType::NONE, model::SwapType::SOFT});
+	}
+
+	SECTION("Test SharedLock within a Transaction")
+	{
+		{
+			const model::Transaction transaction = model.beginTransaction();
+			{
+				const model::SharedLock lock = model.lockShared(model::SwapType::HARD);
+
+				REQUIRE(model.get_RT().get().locked == true);
+			}
+
+			/* The realtime thread must not wait for the Transaction to end. */
+
+			REQUIRE(model.get_RT().get().locked == false);
+			REQUIRE(swaps == std::vector{model::SwapType::NONE, model::SwapType::NONE});
+		}
+
+		REQUIRE(swaps == std::vector{model::SwapType::NONE, model::SwapType::NONE, model::SwapType::HARD});
+	}
+
+	SECTION("Test swap from another thread")
+	{
+		std::atomic<bool> swapped = false;
+		std::thread       other;
+		{
+			const model::Transaction transaction = model.beginTransaction();
+			model.swap(model::SwapType::SOFT);
+
+			other = std::thread([&model, &swapped]()
+			{
+				model.registerThread(Thread::EVENTS, /*realtime=*/false);
+				model.swap(model::SwapType::HARD);
+				swapped = true;
+			});
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+			REQUIRE(swapped == false);
+			REQUIRE(swaps.empty());
+		}
+		other.join();
+
+		REQUIRE(swapped == true);
+		REQUIRE(swaps == std::vector{model::SwapType::SOFT, model::SwapType::HARD});
+	}
+}
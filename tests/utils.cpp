@@ -1,7 +1,16 @@
+#include "../src/core/const.h"
+#include "../src/utils/alloc.h"
 #include "../src/utils/fs.h"
+#include "../src/utils/log.h"
 #include "../src/utils/math.h"
 #include "../src/utils/string.h"
+#include "../src/utils/time.h"
+#include "../src/utils/trace.h"
 #include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <thread>
 
 TEST_CASE("u::fs")
 {
@@ -58,3 +67,128 @@ TEST_CASE("::math")
 	REQUIRE(u::math::map(30.0f, 30.0f, 1.0f) == 1.0f);
 	REQUIRE(u::math::map(15.0f, 30.0f, 1.0f) == Approx(0.5f));
 }
+
+TEST_CASE("u::time")
+{
+	using namespace giada;
+
+	SECTION("Test tick to frame conversion")
+	{
+		const int framesInBeat = u::time::beatToFrame(1, 44100, 120.0f);
+
+		REQUIRE(u::time::frameToTick(0, framesInBeat) == 0);
+		REQUIRE(u::time::frameToTick(framesInBeat, framesInBeat) == G_PPQ);
+		REQUIRE(u::time::tickToFrame(G_PPQ / 2, framesInBeat) == framesInBeat / 2);
+		REQUIRE(u::time::frameToTick(100, 0) == 0);
+	}
+
+	SECTION("Test frame round trip at any tempo and sample rate")
+	{
+		for (const int sampleRate : {44100, 48000, 96000, 192000})
+		{
+			for (const float bpm : {G_MIN_BPM, 93.7f, 120.0f, G_MAX_BPM})
+			{
+				const int framesInBeat = u::time::beatToFrame(1, sampleRate, bpm);
+				for (Frame f = 0; f < framesInBeat * 2; f += 997)
+					REQUIRE(u::time::tickToFrame(u::time::frameToTick(f, framesInBeat), framesInBeat) == f);
+			}
+		}
+	}
+}
+
+TEST_CASE("u::log")
+{
+	using namespace giada;
+
+	SECTION("Test realtime record formatting")
+	{
+		const std::string longString(64, 'x');
+
+		const u::log::detail::Record r = u::log::detail::makeRecord("{} {} {:.1f} {} {} {}",
+		    nullptr, nullptr, -3, 42u, 1.5f, true, "literal", longString);
+
+		REQUIRE(r.numArgs == 6);
+		REQUIRE(u::log::detail::format(r) ==
+		        fmt::format("-3 42 1.5 true literal {}", std::string(u::log::detail::MAX_STRING_SIZE - 1, 'x')));
+	}
+
+	SECTION("Test thread registration")
+	{
+		REQUIRE(u::log::isRealtimeThread() == false);
+		u::log::registerThread(true);
+		REQUIRE(u::log::isRealtimeThread() == true);
+		u::log::registerThread(false);
+	}
+}
+
+TEST_CASE("u::trace")
+{
+	using namespace giada;
+
+	const std::string path = (std::filesystem::temp_directory_path() / "giada-timeline.json").string();
+
+	u::trace::registerThread("TEST");
+	u::trace::start();
+	REQUIRE(u::trace::isEnabled() == true);
+	{
+		G_TRACE("test scope");
+		u::trace::instant("test instant");
+	}
+
+	/* Threads not registered are not recorded. */
+
+	std::thread([]()
+	{ u::trace::instant("unregistered instant"); })
+	    .join();
+
+	u::trace::stop();
+	REQUIRE(u::trace::isEnabled() == false);
+
+	REQUIRE(u::trace::save(path) == true);
+
+	std::ifstream     file(path);
+	const std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	REQUIRE(json.find("\"name\":\"test scope\",\"ph\":\"X\"") != std::string::npos);
+	REQUIRE(json.find("\"name\":\"test instant\",\"ph\":\"i\"") != std::string::npos);
+	REQUIRE(json.find("\"args\":{\"name\":\"TEST\"}") != std::string::npos);
+	REQUIRE(json.find("unregistered instant") == std::string::npos);
+}
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef G_DEBUG_MODE
+
+TEST_CASE("u::alloc")
+{
+	using namespace giada;
+
+	const std::size_t violations = u::alloc::getViolations();
+
+	SECTION("Test allocation outside the trap")
+	{
+		auto p = std::make_unique<int>(42);
+		REQUIRE(u::alloc::getViolations() == violations);
+	}
+
+	SECTION("Test allocation inside the trap")
+	{
+		{
+			G_ALLOC_TRAP();
+			auto p = std::make_unique<int>(42);
+		}
+		REQUIRE(u::alloc::getViolations() == violations + 1);
+	}
+
+	SECTION("Test allowed allocation inside the trap")
+	{
+		{
+			G_ALLOC_TRAP();
+			G_ALLOC_ALLOW();
+			auto p = std::make_unique<int>(42);
+		}
+		REQUIRE(u::alloc::getViolations() == violations);
+	}
+}
+
+#endif
@@ -0,0 +1,101 @@
+#include "../src/core/virtualAudioDevice.h"
+#include "../src/core/const.h"
+#include "../src/core/resampler.h"
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <sndfile.h>
+#include <thread>
+
+using namespace giada;
+using namespace giada::m;
+
+TEST_CASE("VirtualAudioDevice")
+{
+	const std::string outputPath = (std::filesystem::temp_directory_path() / "giada-virtual-device.wav").string();
+
+	VirtualAudioDevice device;
+	std::atomic<int>   blocks    = 0;
+	std::atomic<bool>  gotSignal = false;
+
+	device.onAudioCallback = [&](mcl::AudioBuffer& out, const mcl::AudioBuffer& in)
+	{
+		/* Pass-through: input goes straight into the output. */
+
+		for (int i = 0; i < out.countFrames(); i++)
+			for (int j = 0; j < out.countChannels(); j++)
+			{
+				out[i][j] = in.isAllocd() ? in[i][std::min(j, in.countChannels() - 1)] : 0.5f;
+				if (out[i][j] != 0.0f)
+					gotSignal.store(true);
+			}
+		blocks++;
+		return 0;
+	};
+
+	SECTION("Test open failure")
+	{
+		REQUIRE(device.open({44100, 0}, Resampler::Quality::LINEAR) == false);
+		REQUIRE(device.isOpen() == false);
+		REQUIRE(device.start() == false);
+
+		VirtualAudioDevice::Config config;
+		config.channelsInCount = 1;
+		config.inputPath       = "/path/to/nowhere.wav";
+
+		REQUIRE(device.open(config, Resampler::Quality::LINEAR) == false);
+	}
+
+	SECTION("Test freewheel with input and output files")
+	{
+		VirtualAudioDevice::Config config;
+		config.bufferSize      = 256;
+		config.channelsInCount = 2;
+		config.inputPath       = TEST_RESOURCES_DIR "test.wav";
+		config.outputPath      = outputPath;
+		config.freewheel       = true;
+
+		REQUIRE(device.open(config, Resampler::Quality::LINEAR));
+		REQUIRE(device.start());
+		REQUIRE(device.isRunning());
+
+		while (blocks.load() < 32)
+			std::this_thread::yield();
+
+		device.close();
+
+		REQUIRE(device.isRunning() == false);
+		REQUIRE(device.isOpen() == false);
+		REQUIRE(gotSignal.load());
+
+		SF_INFO  header;
+		SNDFILE* file = sf_open(outputPath.c_str(), SFM_READ, &header);
+
+		REQUIRE(file != nullptr);
+		REQUIRE(header.samplerate == G_DEFAULT_SAMPLERATE);
+		REQUIRE(header.channels == G_MAX_IO_CHANS);
+		REQUIRE(header.frames == blocks.load() * config.bufferSize);
+
+		sf_close(file);
+		std::filesystem::remove(outputPath);
+	}
+
+	SECTION("Test realtime pacing")
+	{
+		VirtualAudioDevice::Config config;
+		config.sampleRate = 44100;
+		config.bufferSize = 441; // 10 ms per block
+
+		REQUIRE(device.open(config, Resampler::Quality::LINEAR));
+		REQUIRE(device.start());
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		device.stop();
+
+		/* Roughly 10 blocks in 100 ms, with plenty of tolerance for slow CI
+		machines. Freewheel would have rendered thousands. */
+
+		REQUIRE(blocks.load() >= 2);
+		REQUIRE(blocks.load() <= 20);
+	}
+}